@@ -30,6 +30,7 @@ Description:
 #include "gylib/gy_hash.h"
 #include "gylib/gy_memory.h"
 #include "gylib/gy_scratch_arenas.h"
+#include "gylib/gy_memory_snapshot.h"
 #include "gylib/gy_fifo.h"
 #include "gylib/gy_unicode.h"
 #include "gylib/gy_time.h"
@@ -58,14 +59,19 @@ Description:
 #include "gylib/gy_sorting.h"
 #include "gylib/gy_linked_list.h"
 #include "gylib/gy_variable_array.h"
+#include "gylib/gy_soa_array.h"
 #include "gylib/gy_performance_sections.h"
 #include "gylib/gy_id_map.h"
 #include "gylib/gy_str_hash_dictionary.h"
+#include "gylib/gy_str_hash_dictionary_frozen.h"
+#include "gylib/gy_atom_table.h"
 #include "gylib/gy_word_tree.h"
 #include "gylib/gy_bezier.h"
 #include "gylib/gy_bucket_array.h"
+#include "gylib/gy_slot_map.h"
 #include "gylib/gy_string_fifo.h"
 #include "gylib/gy_process_log.h"
+#include "gylib/gy_stats_page.h"
 #include "gylib/gy_serialization_helpers.h"
 #include "gylib/gy_serializable.h"
 #include "gylib/gy_common_serializables.h"
@@ -0,0 +1,329 @@
+/*
+File:   gy_atom_table.h
+Author: Taylor Robbins
+Date:   10\16\2026
+Description:
+	** Holds AtomTable_t which interns strings and hands back an Atom_t (a u32 id and a cached 32-bit hash).
+	** Interning the same characters always gives back the same id, so comparing two atoms is a single integer
+	** compare instead of a StrEquals, and each unique string is only stored once (in the table's stringArena).
+	** Interned strings never move or get freed until the whole table is freed, so GetAtomStr results stay valid.
+	** Unlike StrHashDict_t the table stores the actual characters and compares them, so two strings with the same hash are still different atoms.
+	** Reads (AtomTableFind, GetAtomStr, and the first check in AtomTableIntern) don't take the mutex:
+	**   - Entries live in chunks that never move, an entry is fully written before numAtoms or the index can point at it
+	**   - The index is append only. Growing it builds a new index and swaps the pointer, old indices are kept until FreeAtomTable
+	**     so a reader that is still probing an old index is fine (it just might miss an atom that was added after the swap)
+	** Adding a new atom takes the mutex (if GYLIB_THREADING_ENABLED)
+*/
+
+#ifndef _GY_ATOM_TABLE_H
+#define _GY_ATOM_TABLE_H
+
+#define ATOM_INVALID_ID               0
+#define ATOM_TABLE_FIRST_CHUNK_SIZE   64 //must be a power of two, each chunk is twice as big as the last
+#define ATOM_TABLE_MAX_NUM_CHUNKS     26 //64 * (2^26 - 1) is way more than a u32 id can reach
+#define ATOM_TABLE_MIN_INDEX_SIZE     128 //must be a power of two
+
+struct Atom_t
+{
+	u32 id;
+	u32 hash; //lower 32 bits of the FNV hash of the string, useful as a ready made hash for the atom
+};
+
+struct AtomTableEntry_t
+{
+	u64 hash;
+	MyStr_t str;
+};
+
+//Each slot packs (hash32 << 32) | id so readers see both with one aligned 64-bit load. 0 means empty
+struct AtomTableIndex_t
+{
+	u64 numSlots; //always a power of two
+	AtomTableIndex_t* prevIndex; //retired indices that readers might still be looking at, freed in FreeAtomTable
+	volatile u64* slots;
+};
+
+struct AtomTable_t
+{
+	MemArena_t* allocArena;
+	MemArena_t* stringArena;
+	GyMutex_t mutex;
+	
+	volatile u32 numAtoms;
+	AtomTableEntry_t* volatile chunks[ATOM_TABLE_MAX_NUM_CHUNKS];
+	AtomTableIndex_t* volatile index;
+};
+
+// +--------------------------------------------------------------+
+// |                            Macros                            |
+// +--------------------------------------------------------------+
+#define IsValidAtom(atom)         ((atom).id != ATOM_INVALID_ID)
+#define AtomsEqual(atom1, atom2)  ((atom1).id == (atom2).id)
+#define Atom_Invalid              NewAtom(ATOM_INVALID_ID, 0)
+
+// +--------------------------------------------------------------+
+// |                         Header Only                          |
+// +--------------------------------------------------------------+
+#ifdef GYLIB_HEADER_ONLY
+	Atom_t NewAtom(u32 id, u32 hash);
+	AtomTableIndex_t* AllocAtomTableIndex(MemArena_t* memArena, u64 numSlots);
+	void FreeAtomTable(AtomTable_t* table);
+	void CreateAtomTable(AtomTable_t* table, MemArena_t* memArena, MemArena_t* stringArena = nullptr);
+	u64 GetAtomTableChunkSize(u64 chunkIndex);
+	AtomTableEntry_t* GetAtomTableEntry(const AtomTable_t* table, u32 id);
+	void InsertIntoAtomTableIndex(AtomTableIndex_t* index, u64 hash, u32 id);
+	Atom_t AtomTableFind(const AtomTable_t* table, MyStr_t str);
+	Atom_t AtomTableFind(const AtomTable_t* table, const char* nullTermStr);
+	Atom_t AtomTableIntern(AtomTable_t* table, MyStr_t str);
+	Atom_t AtomTableIntern(AtomTable_t* table, const char* nullTermStr);
+	MyStr_t GetAtomStr(const AtomTable_t* table, Atom_t atom);
+#else
+
+// +--------------------------------------------------------------+
+// |                       Helper Functions                       |
+// +--------------------------------------------------------------+
+u64 GetAtomTableChunkSize(u64 chunkIndex)
+{
+	return ((u64)ATOM_TABLE_FIRST_CHUNK_SIZE << chunkIndex);
+}
+
+//Safe to call without the mutex for any id that you got back from this table
+AtomTableEntry_t* GetAtomTableEntry(const AtomTable_t* table, u32 id)
+{
+	NotNull(table);
+	if (id == ATOM_INVALID_ID || id > table->numAtoms) { return nullptr; }
+	ThreadingReadBarrier();
+	//Chunk c starts at entry FIRST_CHUNK_SIZE * (2^c - 1)
+	u64 entryIndex = (u64)(id - 1);
+	u64 chunkIndex = FindMsbIndexU64((entryIndex / ATOM_TABLE_FIRST_CHUNK_SIZE) + 1);
+	u64 chunkStart = ATOM_TABLE_FIRST_CHUNK_SIZE * ((1ULL << chunkIndex) - 1);
+	DebugAssert(chunkIndex < ATOM_TABLE_MAX_NUM_CHUNKS && table->chunks[chunkIndex] != nullptr);
+	return &table->chunks[chunkIndex][entryIndex - chunkStart];
+}
+
+//Only called by the thread holding the mutex (or while building a new index nobody can see yet)
+void InsertIntoAtomTableIndex(AtomTableIndex_t* index, u64 hash, u32 id)
+{
+	u64 mask = index->numSlots - 1;
+	u64 slotIndex = ((hash * 0x9E3779B97F4A7C15ULL) >> 32) & mask;
+	while (index->slots[slotIndex] != 0) { slotIndex = (slotIndex + 1) & mask; }
+	index->slots[slotIndex] = (((hash & 0xFFFFFFFF) << 32) | (u64)id);
+}
+
+// +--------------------------------------------------------------+
+// |                       Create and Free                        |
+// +--------------------------------------------------------------+
+Atom_t NewAtom(u32 id, u32 hash)
+{
+	Atom_t result;
+	result.id = id;
+	result.hash = hash;
+	return result;
+}
+
+AtomTableIndex_t* AllocAtomTableIndex(MemArena_t* memArena, u64 numSlots)
+{
+	NotNull(memArena);
+	Assert(numSlots >= ATOM_TABLE_MIN_INDEX_SIZE && (numSlots & (numSlots - 1)) == 0);
+	AtomTableIndex_t* result = (AtomTableIndex_t*)AllocMem(memArena, sizeof(AtomTableIndex_t) + (sizeof(u64) * numSlots));
+	NotNull(result);
+	result->numSlots = numSlots;
+	result->prevIndex = nullptr;
+	result->slots = (volatile u64*)(result + 1);
+	MyMemSet((void*)result->slots, 0x00, sizeof(u64) * numSlots);
+	return result;
+}
+
+//Make sure no other threads are still using the table
+void FreeAtomTable(AtomTable_t* table)
+{
+	NotNull(table);
+	if (table->allocArena != nullptr)
+	{
+		for (u32 aIndex = 0; aIndex < table->numAtoms; aIndex++)
+		{
+			AtomTableEntry_t* entry = GetAtomTableEntry(table, aIndex+1);
+			if (entry->str.chars != nullptr) { FreeMem(table->stringArena, entry->str.chars, entry->str.length+1); }
+		}
+		for (u64 cIndex = 0; cIndex < ATOM_TABLE_MAX_NUM_CHUNKS; cIndex++)
+		{
+			if (table->chunks[cIndex] != nullptr) { FreeMem(table->allocArena, table->chunks[cIndex], sizeof(AtomTableEntry_t) * GetAtomTableChunkSize(cIndex)); }
+		}
+		AtomTableIndex_t* index = table->index;
+		while (index != nullptr)
+		{
+			AtomTableIndex_t* prevIndex = index->prevIndex;
+			FreeMem(table->allocArena, index, sizeof(AtomTableIndex_t) + (sizeof(u64) * index->numSlots));
+			index = prevIndex;
+		}
+		if (IsValidGyMutex(&table->mutex)) { FreeGyMutex(&table->mutex); }
+	}
+	ClearPointer(table);
+}
+
+//stringArena is where the interned characters go, it defaults to memArena
+void CreateAtomTable(AtomTable_t* table, MemArena_t* memArena, MemArena_t* stringArena = nullptr)
+{
+	NotNull2(table, memArena);
+	ClearPointer(table);
+	table->allocArena = memArena;
+	table->stringArena = (stringArena != nullptr) ? stringArena : memArena;
+	InitGyMutex(&table->mutex);
+	table->numAtoms = 0;
+	table->index = AllocAtomTableIndex(memArena, ATOM_TABLE_MIN_INDEX_SIZE);
+}
+
+// +--------------------------------------------------------------+
+// |                             Find                             |
+// +--------------------------------------------------------------+
+//Returns Atom_Invalid if the string hasn't been interned. Doesn't take the mutex
+Atom_t AtomTableFind(const AtomTable_t* table, MyStr_t str)
+{
+	NotNull(table);
+	NotNullStr(&str);
+	u64 hash = FnvHashStr(str);
+	u64 hash32 = (hash & 0xFFFFFFFF);
+	const AtomTableIndex_t* index = table->index;
+	ThreadingReadBarrier();
+	if (index == nullptr) { return Atom_Invalid; }
+	
+	u64 mask = index->numSlots - 1;
+	u64 slotIndex = ((hash * 0x9E3779B97F4A7C15ULL) >> 32) & mask;
+	while (true)
+	{
+		u64 slotValue = index->slots[slotIndex];
+		if (slotValue == 0) { break; }
+		if ((slotValue >> 32) == hash32)
+		{
+			ThreadingReadBarrier();
+			u32 id = (u32)(slotValue & 0xFFFFFFFF);
+			AtomTableEntry_t* entry = GetAtomTableEntry(table, id);
+			if (entry != nullptr && entry->hash == hash && StrEquals(entry->str, str)) { return NewAtom(id, (u32)hash32); }
+		}
+		slotIndex = (slotIndex + 1) & mask;
+	}
+	return Atom_Invalid;
+}
+Atom_t AtomTableFind(const AtomTable_t* table, const char* nullTermStr)
+{
+	return AtomTableFind(table, NewStr(nullTermStr));
+}
+
+// +--------------------------------------------------------------+
+// |                            Intern                            |
+// +--------------------------------------------------------------+
+//Returns the existing atom if str was already interned, otherwise copies str into the stringArena and adds a new atom
+Atom_t AtomTableIntern(AtomTable_t* table, MyStr_t str)
+{
+	NotNull2(table, table->allocArena);
+	NotNullStr(&str);
+	Atom_t result = AtomTableFind(table, str);
+	if (IsValidAtom(result)) { return result; }
+	
+	bool didLock = false;
+	if (IsValidGyMutex(&table->mutex)) { LockGyMutex(&table->mutex); didLock = true; }
+	
+	//Another thread might have added it between our Find and getting the lock
+	result = AtomTableFind(table, str);
+	if (!IsValidAtom(result))
+	{
+		AssertMsg(table->numAtoms < 0xFFFFFFFF, "Ran out of atom ids in AtomTable!");
+		u64 hash = FnvHashStr(str);
+		u32 newId = table->numAtoms + 1;
+		
+		u64 entryIndex = (u64)(newId - 1);
+		u64 chunkIndex = FindMsbIndexU64((entryIndex / ATOM_TABLE_FIRST_CHUNK_SIZE) + 1);
+		u64 chunkStart = ATOM_TABLE_FIRST_CHUNK_SIZE * ((1ULL << chunkIndex) - 1);
+		Assert(chunkIndex < ATOM_TABLE_MAX_NUM_CHUNKS);
+		if (table->chunks[chunkIndex] == nullptr)
+		{
+			AtomTableEntry_t* newChunk = AllocArray(table->allocArena, AtomTableEntry_t, GetAtomTableChunkSize(chunkIndex));
+			NotNull(newChunk);
+			MyMemSet(newChunk, 0x00, sizeof(AtomTableEntry_t) * GetAtomTableChunkSize(chunkIndex));
+			ThreadingWriteBarrier();
+			table->chunks[chunkIndex] = newChunk;
+		}
+		AtomTableEntry_t* newEntry = &table->chunks[chunkIndex][entryIndex - chunkStart];
+		newEntry->hash = hash;
+		newEntry->str = NewStr(str.length, AllocCharsAndFill(table->stringArena, str.length, str.chars));
+		NotNull(newEntry->str.chars);
+		
+		//Keep the index at most half full. Readers on the old index just see a snapshot of it
+		AtomTableIndex_t* index = table->index;
+		if ((u64)newId * 2 > index->numSlots)
+		{
+			AtomTableIndex_t* newIndex = AllocAtomTableIndex(table->allocArena, index->numSlots * 2);
+			for (u32 aIndex = 0; aIndex < table->numAtoms; aIndex++)
+			{
+				InsertIntoAtomTableIndex(newIndex, GetAtomTableEntry(table, aIndex+1)->hash, aIndex+1);
+			}
+			newIndex->prevIndex = index;
+			index = newIndex;
+		}
+		
+		//Publish the entry before anything can point at it
+		ThreadingWriteBarrier();
+		table->numAtoms = newId;
+		ThreadingWriteBarrier();
+		InsertIntoAtomTableIndex(index, hash, newId);
+		ThreadingWriteBarrier();
+		table->index = index;
+		
+		result = NewAtom(newId, (u32)(hash & 0xFFFFFFFF));
+	}
+	
+	if (didLock) { UnlockGyMutex(&table->mutex); }
+	return result;
+}
+Atom_t AtomTableIntern(AtomTable_t* table, const char* nullTermStr)
+{
+	return AtomTableIntern(table, NewStr(nullTermStr));
+}
+
+// +--------------------------------------------------------------+
+// |                            Lookup                            |
+// +--------------------------------------------------------------+
+//Returns MyStr_Empty for Atom_Invalid. The characters are null-terminated and stay valid until the table is freed
+MyStr_t GetAtomStr(const AtomTable_t* table, Atom_t atom)
+{
+	NotNull(table);
+	AtomTableEntry_t* entry = GetAtomTableEntry(table, atom.id);
+	if (entry == nullptr) { return MyStr_Empty; }
+	return entry->str;
+}
+
+#endif //GYLIB_HEADER_ONLY
+
+#endif //  _GY_ATOM_TABLE_H
+
+// +--------------------------------------------------------------+
+// |                   Autocomplete Dictionary                    |
+// +--------------------------------------------------------------+
+/*
+@Defines
+ATOM_INVALID_ID
+ATOM_TABLE_FIRST_CHUNK_SIZE
+ATOM_TABLE_MAX_NUM_CHUNKS
+ATOM_TABLE_MIN_INDEX_SIZE
+@Types
+Atom_t
+AtomTableEntry_t
+AtomTableIndex_t
+AtomTable_t
+@Functions
+#define IsValidAtom(atom)
+#define AtomsEqual(atom1, atom2)
+#define Atom_Invalid
+Atom_t NewAtom(u32 id, u32 hash)
+AtomTableIndex_t* AllocAtomTableIndex(MemArena_t* memArena, u64 numSlots)
+void FreeAtomTable(AtomTable_t* table)
+void CreateAtomTable(AtomTable_t* table, MemArena_t* memArena, MemArena_t* stringArena = nullptr)
+u64 GetAtomTableChunkSize(u64 chunkIndex)
+AtomTableEntry_t* GetAtomTableEntry(const AtomTable_t* table, u32 id)
+void InsertIntoAtomTableIndex(AtomTableIndex_t* index, u64 hash, u32 id)
+Atom_t AtomTableFind(const AtomTable_t* table, MyStr_t str)
+Atom_t AtomTableFind(const AtomTable_t* table, const char* nullTermStr)
+Atom_t AtomTableIntern(AtomTable_t* table, MyStr_t str)
+Atom_t AtomTableIntern(AtomTable_t* table, const char* nullTermStr)
+MyStr_t GetAtomStr(const AtomTable_t* table, Atom_t atom)
+*/
@@ -12,6 +12,9 @@ Description:
 	** If you want to be able to remove items while holding pointers, you should
 	** have flags on your items and rather than actually remove them from the array, you
 	** just clear the flag and reuse the item later.
+	** Alongside the linked list we keep a directory of bucket pointers and the running
+	** item count at the end of each bucket, so getting an item by index is a binary
+	** search over the buckets rather than a walk down the list.
 */
 
 //TODO: Do we want to add a name to our BktArray_t structure? VarArray_t has it.
@@ -50,6 +53,11 @@ struct BktArray_t
 	u64 numBuckets;
 	u64 lastUsedBucket;
 	BktArrayBucket_t* firstBucket;
+	
+	//The directory mirrors the linked list. bucketEnds[b] is the total numItems in buckets 0 through b and is only kept up to date for b <= lastUsedBucket
+	u64 numDirectoryAlloc;
+	u64* bucketEnds;
+	BktArrayBucket_t** buckets;
 };
 
 // +--------------------------------------------------------------+
@@ -67,6 +75,11 @@ struct BktArray_t
 // |                         Header Only                          |
 // +--------------------------------------------------------------+
 #ifdef GYLIB_HEADER_ONLY
+	void BktArrayGrowDirectory(BktArray_t* array, u64 numBucketsRequired);
+	void BktArrayRefreshDirectory(BktArray_t* array);
+	void BktArrayPushDirectoryBucket(BktArray_t* array, BktArrayBucket_t* newBucket);
+	void BktArrayRefreshBucketEnds(BktArray_t* array, u64 startBucketIndex);
+	u64 BktArrayFindBucketIndex(const BktArray_t* array, u64 index);
 	void FreeBktArray(BktArray_t* array);
 	void CreateBktArray(BktArray_t* array, MemArena_t* memArena, u64 itemSize, u64 minBucketSize = 64, u64 initialSizeRequirement = 0);
 	BktArrayBucket_t* BktArrayGetLastUsedBucket(BktArray_t* array);
@@ -87,6 +100,93 @@ struct BktArray_t
 	#endif
 #else
 
+// +--------------------------------------------------------------+
+// |                          Directory                           |
+// +--------------------------------------------------------------+
+//bucketEnds and buckets share one allocation of numDirectoryAlloc entries each
+void BktArrayGrowDirectory(BktArray_t* array, u64 numBucketsRequired)
+{
+	NotNull(array);
+	NotNull(array->allocArena);
+	if (array->numDirectoryAlloc >= numBucketsRequired) { return; }
+	u64 newNumAlloc = (array->numDirectoryAlloc > 0) ? array->numDirectoryAlloc : 8;
+	while (newNumAlloc < numBucketsRequired) { newNumAlloc *= 2; }
+	u64* newBucketEnds = (u64*)AllocMem(array->allocArena, (sizeof(u64) + sizeof(BktArrayBucket_t*)) * newNumAlloc);
+	NotNull(newBucketEnds);
+	BktArrayBucket_t** newBuckets = (BktArrayBucket_t**)(newBucketEnds + newNumAlloc);
+	if (array->bucketEnds != nullptr)
+	{
+		MyMemCopy(newBucketEnds, array->bucketEnds, sizeof(u64) * array->numDirectoryAlloc);
+		MyMemCopy(newBuckets, array->buckets, sizeof(BktArrayBucket_t*) * array->numDirectoryAlloc);
+		FreeMem(array->allocArena, array->bucketEnds, (sizeof(u64) + sizeof(BktArrayBucket_t*)) * array->numDirectoryAlloc);
+	}
+	array->bucketEnds = newBucketEnds;
+	array->buckets = newBuckets;
+	array->numDirectoryAlloc = newNumAlloc;
+}
+
+//Rebuilds the whole directory from the linked list. Used after anything that reorders or frees buckets
+void BktArrayRefreshDirectory(BktArray_t* array)
+{
+	NotNull(array);
+	if (array->numBuckets == 0) { return; }
+	BktArrayGrowDirectory(array, array->numBuckets);
+	u64 itemCount = 0;
+	BktArrayBucket_t* bucket = array->firstBucket;
+	for (u64 bIndex = 0; bIndex < array->numBuckets; bIndex++)
+	{
+		NotNull(bucket);
+		itemCount += bucket->numItems;
+		array->buckets[bIndex] = bucket;
+		array->bucketEnds[bIndex] = itemCount;
+		bucket = bucket->next;
+	}
+	Assert(bucket == nullptr);
+}
+
+//Call this after linking newBucket onto the end of the list and incrementing numBuckets
+void BktArrayPushDirectoryBucket(BktArray_t* array, BktArrayBucket_t* newBucket)
+{
+	NotNull2(array, newBucket);
+	Assert(array->numBuckets > 0);
+	BktArrayGrowDirectory(array, array->numBuckets);
+	array->buckets[array->numBuckets-1] = newBucket;
+	array->bucketEnds[array->numBuckets-1] = (array->numBuckets >= 2 ? array->bucketEnds[array->numBuckets-2] : 0) + newBucket->numItems;
+}
+
+//Recalculates bucketEnds from startBucketIndex through lastUsedBucket (everything before startBucketIndex must already be correct)
+void BktArrayRefreshBucketEnds(BktArray_t* array, u64 startBucketIndex)
+{
+	NotNull(array);
+	if (array->numBuckets == 0) { return; }
+	Assert(array->lastUsedBucket < array->numBuckets);
+	u64 itemCount = (startBucketIndex > 0) ? array->bucketEnds[startBucketIndex-1] : 0;
+	for (u64 bIndex = startBucketIndex; bIndex <= array->lastUsedBucket; bIndex++)
+	{
+		itemCount += array->buckets[bIndex]->numItems;
+		array->bucketEnds[bIndex] = itemCount;
+	}
+}
+
+//Returns the index of the bucket that holds the item at index (index must be < length)
+u64 BktArrayFindBucketIndex(const BktArray_t* array, u64 index)
+{
+	NotNull(array);
+	Assert(index < array->length);
+	Assert(array->lastUsedBucket < array->numBuckets);
+	//Find the first bucket whose end is past index. Empty buckets have the same end as the bucket before them so they are never picked
+	u64 low = 0;
+	u64 high = array->lastUsedBucket;
+	while (low < high)
+	{
+		u64 middle = low + (high - low) / 2;
+		if (array->bucketEnds[middle] > index) { high = middle; }
+		else { low = middle + 1; }
+	}
+	DebugAssertMsg(array->bucketEnds[low] > index && array->buckets[low]->numItems > 0, "BktArray directory is out of date!");
+	return low;
+}
+
 // +--------------------------------------------------------------+
 // |                       Create and Free                        |
 // +--------------------------------------------------------------+
@@ -101,6 +201,10 @@ void FreeBktArray(BktArray_t* array)
 		FreeMem(array->allocArena, bucket, sizeof(BktArrayBucket_t) + (bucket->numItemsAlloc * array->itemSize));
 		bucket = nextBucket;
 	}
+	if (array->bucketEnds != nullptr)
+	{
+		FreeMem(array->allocArena, array->bucketEnds, (sizeof(u64) + sizeof(BktArrayBucket_t*)) * array->numDirectoryAlloc);
+	}
 	ClearPointer(array);
 }
 
@@ -130,6 +234,7 @@ void CreateBktArray(BktArray_t* array, MemArena_t* memArena, u64 itemSize, u64 m
 	MyMemSet(array->firstBucket->items, 0x00, itemSize * firstBucketSize);
 	array->numBuckets = 1;
 	array->lastUsedBucket = 0;
+	BktArrayRefreshDirectory(array);
 }
 
 // +--------------------------------------------------------------+
@@ -140,12 +245,7 @@ BktArrayBucket_t* BktArrayGetLastUsedBucket(BktArray_t* array)
 	NotNull(array);
 	if (array->numBuckets == 0) { return nullptr; }
 	Assert(array->lastUsedBucket < array->numBuckets);
-	BktArrayBucket_t* bucket = array->firstBucket;
-	for (u64 bIndex = 0; bIndex < array->lastUsedBucket; bIndex++)
-	{
-		NotNull(bucket);
-		bucket = bucket->next;
-	}
+	BktArrayBucket_t* bucket = array->buckets[array->lastUsedBucket];
 	NotNull(bucket);
 	return bucket;
 }
@@ -212,6 +312,7 @@ void BktArrayMoveEmptyBucketToEnd(BktArray_t* array, u64 bucketIndex)
 		if (bIndex < bucketIndex) { prevBucket = bucket; }
 		bucket = bucket->next;
 	}
+	BktArrayRefreshDirectory(array);
 }
 
 void BktArrayExpand(BktArray_t* array, u64 numNewItemsRequired)
@@ -243,6 +344,7 @@ void BktArrayExpand(BktArray_t* array, u64 numNewItemsRequired)
 			MyMemSet(newBucket->items, 0x00, array->itemSize * newBucketSize);
 			array->numBuckets++;
 			lastBucket->next = newBucket;
+			BktArrayPushDirectoryBucket(array, newBucket);
 		}
 	}
 	else
@@ -260,6 +362,7 @@ void BktArrayExpand(BktArray_t* array, u64 numNewItemsRequired)
 		MyMemSet(array->firstBucket->items, 0x00, array->itemSize * firstBucketSize);
 		array->numBuckets = 1;
 		array->lastUsedBucket = 0;
+		BktArrayRefreshDirectory(array);
 	}
 }
 
@@ -301,6 +404,7 @@ void BktArrayClear(BktArray_t* array, bool reduceToSingleBucket = false)
 	array->length = 0;
 	array->numUselessSpaces = 0;
 	array->lastUsedBucket = 0;
+	if (array->numBuckets > 0) { array->bucketEnds[0] = 0; }
 	if (reduceToSingleBucket)
 	{
 		NotNull(array->allocArena);
@@ -326,6 +430,7 @@ void BktArrayClear(BktArray_t* array, bool reduceToSingleBucket = false)
 		NotNull(array->firstBucket);
 		Assert(array->numBuckets > 0);
 		Assert(array->lastUsedBucket < array->numBuckets);
+		BktArrayRefreshDirectory(array);
 	}
 }
 
@@ -345,20 +450,11 @@ void* BktArrayGet_(BktArray_t* array, u64 itemSize, u64 index, bool assertOnFail
 		}
 		return nullptr;
 	}
-	u64 foundIndex = 0;
-	BktArrayBucket_t* bucket = array->firstBucket;
-	for (u64 bIndex = 0; bIndex < array->numBuckets; bIndex++)
-	{
-		if (index < foundIndex + bucket->numItems)
-		{
-			void* result = (void*)(((u8*)bucket->items) + (array->itemSize * (index - foundIndex)));
-			return result;
-		}
-		foundIndex += bucket->numItems;
-		bucket = bucket->next;
-	}
-	AssertMsg(false, "BktArray had mismatch between it's recorded length and actual aggregate length from each bucket");
-	return nullptr;
+	u64 bucketIndex = BktArrayFindBucketIndex(array, index);
+	BktArrayBucket_t* bucket = array->buckets[bucketIndex];
+	u64 bucketBaseIndex = array->bucketEnds[bucketIndex] - bucket->numItems;
+	void* result = (void*)(((u8*)bucket->items) + (array->itemSize * (index - bucketBaseIndex)));
+	return result;
 }
 const void* BktArrayGet_(const BktArray_t* array, u64 itemSize, u64 index, bool assertOnFailure) //const version
 {
@@ -382,6 +478,7 @@ void* BktArrayAdd_(BktArray_t* array, u64 itemSize)
 	{
 		bucket = bucket->next;
 		array->lastUsedBucket++;
+		array->bucketEnds[array->lastUsedBucket] = array->bucketEnds[array->lastUsedBucket-1];
 	}
 	NotNull(bucket);
 	Assert(bucket->numItems < bucket->numItemsAlloc);
@@ -389,6 +486,7 @@ void* BktArrayAdd_(BktArray_t* array, u64 itemSize)
 	
 	void* result = ((u8*)bucket->items) + (array->itemSize * bucket->numItems);
 	bucket->numItems += 1;
+	array->bucketEnds[array->lastUsedBucket] += 1;
 	array->length += 1;
 	return result;
 }
@@ -416,6 +514,7 @@ void* BktArrayAddBulk_(BktArray_t* array, u64 itemSize, u64 numItems, bool mustB
 		BktArrayBucket_t* lastBucket = BktArrayGetLastUsedBucket(array);
 		if (lastBucket != nullptr)
 		{
+			u64 firstChangedBucket = array->lastUsedBucket;
 			//TODO: This is a bit inefficient if numItems > minBucketSize of the array and there are empty buckets at the end of the array
 			//      This will skip all those buckets and add a new, larger, one at the end to hold the items thereby adding all the empty
 			//      buckets to our "unused space" count. We really should just insert a bucket after the lastUsedBucket.
@@ -428,6 +527,7 @@ void* BktArrayAddBulk_(BktArray_t* array, u64 itemSize, u64 numItems, bool mustB
 					void* result = ((u8*)lastBucket->items) + (array->itemSize * lastBucket->numItems);
 					lastBucket->numItems += numItems;
 					array->length += numItems;
+					BktArrayRefreshBucketEnds(array, firstChangedBucket);
 					return result;
 				}
 				else
@@ -455,6 +555,8 @@ void* BktArrayAddBulk_(BktArray_t* array, u64 itemSize, u64 numItems, bool mustB
 			MyMemSet(newBucket->items, 0x00, array->itemSize * newBucketSize);
 			array->numBuckets++;
 			array->length += numItems;
+			BktArrayPushDirectoryBucket(array, newBucket);
+			BktArrayRefreshBucketEnds(array, firstChangedBucket);
 			return newBucket->items;
 		}
 		else
@@ -473,6 +575,7 @@ void* BktArrayAddBulk_(BktArray_t* array, u64 itemSize, u64 numItems, bool mustB
 			array->numBuckets = 1;
 			array->lastUsedBucket = 0;
 			array->length = numItems;
+			BktArrayRefreshDirectory(array);
 			return array->firstBucket->items;
 		}
 	}
@@ -511,40 +614,30 @@ void BktArrayRemoveAt(BktArray_t* array, u64 index)
 	Assert(index < array->length);
 	Assert(array->numBuckets > 0);
 	NotNull(array->firstBucket);
-	u64 bucketBaseIndex = 0;
-	BktArrayBucket_t* bucket = array->firstBucket;
-	BktArrayBucket_t* prevBucket = nullptr;
-	for (u64 bIndex = 0; bIndex < array->numBuckets; bIndex++)
+	u64 bIndex = BktArrayFindBucketIndex(array, index);
+	BktArrayBucket_t* bucket = array->buckets[bIndex];
+	u64 bucketBaseIndex = array->bucketEnds[bIndex] - bucket->numItems;
+	u64 removeIndex = (index - bucketBaseIndex);
+	//copy following items down
+	for (u64 iIndex = removeIndex; iIndex+1 < bucket->numItems; iIndex++)
 	{
-		if (index < bucketBaseIndex + bucket->numItems)
-		{
-			u64 removeIndex = (index - bucketBaseIndex);
-			//copy following items down
-			for (u64 iIndex = removeIndex; iIndex+1 < bucket->numItems; iIndex++)
-			{
-				MyMemCopy(((u8*)bucket->items) + (array->itemSize * iIndex), ((u8*)bucket->items) + (array->itemSize * (iIndex+1)), array->itemSize);
-			}
-			bucket->numItems--;
-			array->length--;
-			
-			if (bIndex < array->lastUsedBucket)
-			{
-				//this space at the end of the bucket will become useless until the array is solidified or we become the lastUsedBucket
-				array->numUselessSpaces++;
-				if (bucket->numItems == 0) { BktArrayMoveEmptyBucketToEnd(array, bIndex); }
-			}
-			else
-			{
-				Assert(bIndex == array->lastUsedBucket);
-				if (bucket->numItems == 0) { BktArrayRefreshLastUsedBucket(array); }
-			}
-			return;
-		}
-		bucketBaseIndex += bucket->numItems;
-		prevBucket = bucket;
-		bucket = bucket->next;
+		MyMemCopy(((u8*)bucket->items) + (array->itemSize * iIndex), ((u8*)bucket->items) + (array->itemSize * (iIndex+1)), array->itemSize);
+	}
+	bucket->numItems--;
+	array->length--;
+	for (u64 endIndex = bIndex; endIndex <= array->lastUsedBucket; endIndex++) { array->bucketEnds[endIndex]--; }
+	
+	if (bIndex < array->lastUsedBucket)
+	{
+		//this space at the end of the bucket will become useless until the array is solidified or we become the lastUsedBucket
+		array->numUselessSpaces++;
+		if (bucket->numItems == 0) { BktArrayMoveEmptyBucketToEnd(array, bIndex); }
+	}
+	else
+	{
+		Assert(bIndex == array->lastUsedBucket);
+		if (bucket->numItems == 0) { BktArrayRefreshLastUsedBucket(array); }
 	}
-	AssertMsg(false, "BktArray had mismatch between it's recorded length and actual aggregate length from each bucket");
 }
 void BktArrayRemoveLast(BktArray_t* array)
 {
@@ -599,6 +692,7 @@ void BktArraySolidify(BktArray_t* array, bool deallocateEmptyBuckets = false, bo
 			array->firstBucket = newBucket;
 			array->lastUsedBucket = 0;
 			array->numUselessSpaces = 0;
+			BktArrayRefreshDirectory(array);
 		}
 		else
 		{
@@ -622,6 +716,7 @@ void BktArraySolidify(BktArray_t* array, bool deallocateEmptyBuckets = false, bo
 			array->firstBucket = newBucket;
 			array->lastUsedBucket = 0;
 			array->numUselessSpaces = 0;
+			BktArrayRefreshDirectory(array);
 		}
 	}
 	else
@@ -691,6 +786,7 @@ void BktArraySolidify(BktArray_t* array, bool deallocateEmptyBuckets = false, bo
 			Assert(array->numBuckets > 0);
 			Assert(array->lastUsedBucket < array->numBuckets);
 		}
+		BktArrayRefreshDirectory(array);
 	}
 }
 
@@ -726,6 +822,11 @@ void BktArraySort(BktArray_t* array, CompareFunc_f* compareFunc, void* contextPn
 BktArrayBucket_t
 BktArray_t
 @Functions
+void BktArrayGrowDirectory(BktArray_t* array, u64 numBucketsRequired)
+void BktArrayRefreshDirectory(BktArray_t* array)
+void BktArrayPushDirectoryBucket(BktArray_t* array, BktArrayBucket_t* newBucket)
+void BktArrayRefreshBucketEnds(BktArray_t* array, u64 startBucketIndex)
+u64 BktArrayFindBucketIndex(const BktArray_t* array, u64 index)
 void FreeBktArray(BktArray_t* array)
 void CreateBktArray(BktArray_t* array, MemArena_t* memArena, u64 itemSize, u64 minBucketSize = 64, u64 initialSizeRequirement = 0)
 BktArrayBucket_t* BktArrayGetLastUsedBucket(BktArray_t* array)
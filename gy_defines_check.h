@@ -74,6 +74,13 @@ Date:   09\14\2021
 #define GYLIB_MEM_ARENA_DEBUG_ENABLED 0
 #endif
 
+#if defined(GYLIB_PERF_TIME_TSC_ENABLED)
+#undef GYLIB_PERF_TIME_TSC_ENABLED
+#define GYLIB_PERF_TIME_TSC_ENABLED 1
+#else
+#define GYLIB_PERF_TIME_TSC_ENABLED 0
+#endif
+
 #if PLAYDATE_COMPILATION
 #if defined(PLAYDATE_DEVICE) && defined(PLAYDATE_SIMULATOR)
 #error Both PLAYDATE_DEVICE and PLAYDATE_SIMULATOR were defined, which is not supported!
@@ -114,6 +121,7 @@ ORCA_COMPILATION
 GY_WASM_STD_LIB
 GYLIB_DEBUG_NAMES_ENABLED
 GYLIB_MEM_ARENA_DEBUG_ENABLED
+GYLIB_PERF_TIME_TSC_ENABLED
 PLAYDATE_DEVICE
 PLAYDATE_SIMULATOR
 PLATFORM_32BIT
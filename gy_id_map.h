@@ -10,20 +10,370 @@ Description:
 	** and we expect that ID -> item lookup to be relatively fast.
 	** The IdMap_t also comes with a "nextId" field which can track the next
 	** available u64 that is guaranteed not to conflict with any existing items.
+	** The slots are an open addressing table (linear probing) with a power of two size.
+	** Removing an item shifts the rest of it's probe run backwards instead of leaving
+	** a tombstone, so lookups never get slower because of old removals.
+	** NOTE: ID_MAP_INVALID_ID (0) marks empty slots so it can't be used as an id
 */
 
 #ifndef _GY_ID_MAP_H
 #define _GY_ID_MAP_H
 
+#define ID_MAP_INVALID_ID        0
+#define ID_MAP_MIN_NUM_SLOTS     16
+#define ID_MAP_MAX_LOAD_NUM      3 //grow when the table would be more than 3/4 full
+#define ID_MAP_MAX_LOAD_DENOM    4
+#define ID_MAP_BATCH_SIZE        16 //how many ids IdMapGetBatch prefetches before resolving them
+
+struct IdMapSlot_t
+{
+	u64 id; //ID_MAP_INVALID_ID if the slot is empty
+	void* pntr;
+};
+
 struct IdMap_t
 {
 	MemArena_t* allocArena;
 	u64 nextId;
 	u64 count;
-	u64 numSlots;
-	void** slots;
+	u64 numSlots; //always a power of two (or 0 before the first add)
+	IdMapSlot_t* slots;
 };
 
-//TODO: Implement this!
+// +--------------------------------------------------------------+
+// |                            Macros                            |
+// +--------------------------------------------------------------+
+#define IdMapGetHard(map, id, type)  (type*)IdMapGet_((map), (id), true)
+#define IdMapGetSoft(map, id, type)  (type*)IdMapGet_((map), (id), false)
+#define IdMapGet(map, id, type)      IdMapGetHard((map), (id), type)
+#define IdMapContains(map, id)       (IdMapGet_((map), (id), false) != nullptr)
+#define IdMapGetBatch(map, numIds, ids, pntrsOut) IdMapGetBatch_((map), (numIds), (ids), (void**)(pntrsOut))
+
+#define IdMapRemoveHard(map, id) IdMapRemove_((map), (id), true)
+#define IdMapRemoveSoft(map, id) IdMapRemove_((map), (id), false)
+#define IdMapRemove(map, id)     IdMapRemoveHard((map), (id))
+
+// +--------------------------------------------------------------+
+// |                         Header Only                          |
+// +--------------------------------------------------------------+
+#ifdef GYLIB_HEADER_ONLY
+	void FreeIdMap(IdMap_t* map);
+	void CreateIdMap(IdMap_t* map, MemArena_t* memArena, u64 initialRequiredCapacity = 0);
+	void ClearIdMap(IdMap_t* map);
+	u64 GetIdMapSlotIndex(const IdMap_t* map, u64 id);
+	void InsertIntoIdMapSlots(IdMap_t* map, u64 id, void* pntr);
+	void ResizeIdMap(IdMap_t* map, u64 newNumSlots);
+	u64 GetIdMapNumSlotsFor(u64 numItems);
+	bool IdMapReserve(IdMap_t* map, u64 numItemsRequired);
+	bool IdMapShrink(IdMap_t* map);
+	bool IdMapAdd(IdMap_t* map, u64 id, void* pntr, bool assertOnDuplicate = true);
+	u64 IdMapAddNew(IdMap_t* map, void* pntr);
+	void* IdMapGet_(IdMap_t* map, u64 id, bool assertOnFailure);
+	const void* IdMapGet_(const IdMap_t* map, u64 id, bool assertOnFailure);
+	u64 IdMapGetBatch_(const IdMap_t* map, u64 numIds, const u64* ids, void** pntrsOut);
+	bool IdMapRemove_(IdMap_t* map, u64 id, bool assertOnFailure);
+	bool IdMapIter(const IdMap_t* map, u64* slotIndexPntr, u64* idOut = nullptr, void** pntrOut = nullptr);
+#else
+
+// +--------------------------------------------------------------+
+// |                       Helper Functions                       |
+// +--------------------------------------------------------------+
+//Ids are usually sequential so we use fibonacci hashing (multiply and take the top bits) to spread them out
+u64 GetIdMapSlotIndex(const IdMap_t* map, u64 id)
+{
+	DebugAssert(map->numSlots >= ID_MAP_MIN_NUM_SLOTS && (map->numSlots & (map->numSlots - 1)) == 0);
+	u64 hash = id * 0x9E3779B97F4A7C15ULL;
+	return (hash >> (64 - FindMsbIndexU64(map->numSlots)));
+}
+
+//Doesn't check if the id is already in the map and doesn't grow the slots
+void InsertIntoIdMapSlots(IdMap_t* map, u64 id, void* pntr)
+{
+	u64 slotIndex = GetIdMapSlotIndex(map, id);
+	while (map->slots[slotIndex].id != ID_MAP_INVALID_ID) { slotIndex = (slotIndex + 1) & (map->numSlots - 1); }
+	map->slots[slotIndex].id = id;
+	map->slots[slotIndex].pntr = pntr;
+	map->count++;
+}
+
+void ResizeIdMap(IdMap_t* map, u64 newNumSlots)
+{
+	NotNull2(map, map->allocArena);
+	Assert(newNumSlots >= ID_MAP_MIN_NUM_SLOTS && (newNumSlots & (newNumSlots - 1)) == 0);
+	Assert(map->count * ID_MAP_MAX_LOAD_DENOM <= newNumSlots * ID_MAP_MAX_LOAD_NUM);
+	IdMapSlot_t* newSlots = AllocArray(map->allocArena, IdMapSlot_t, newNumSlots);
+	NotNull(newSlots);
+	MyMemSet(newSlots, 0x00, sizeof(IdMapSlot_t) * newNumSlots);
+	
+	IdMapSlot_t* oldSlots = map->slots;
+	u64 oldNumSlots = map->numSlots;
+	map->slots = newSlots;
+	map->numSlots = newNumSlots;
+	map->count = 0;
+	for (u64 sIndex = 0; sIndex < oldNumSlots; sIndex++)
+	{
+		if (oldSlots[sIndex].id != ID_MAP_INVALID_ID) { InsertIntoIdMapSlots(map, oldSlots[sIndex].id, oldSlots[sIndex].pntr); }
+	}
+	if (oldSlots != nullptr) { FreeMem(map->allocArena, oldSlots, sizeof(IdMapSlot_t) * oldNumSlots); }
+}
+
+//The smallest power of two number of slots that can hold numItems without going over the max load
+u64 GetIdMapNumSlotsFor(u64 numItems)
+{
+	u64 result = ID_MAP_MIN_NUM_SLOTS;
+	while (numItems * ID_MAP_MAX_LOAD_DENOM > result * ID_MAP_MAX_LOAD_NUM) { result *= 2; }
+	return result;
+}
+
+//Returns true if the slots were reallocated
+bool IdMapReserve(IdMap_t* map, u64 numItemsRequired)
+{
+	NotNull(map);
+	u64 requiredNumSlots = GetIdMapNumSlotsFor(numItemsRequired);
+	if (map->numSlots >= requiredNumSlots) { return false; }
+	ResizeIdMap(map, requiredNumSlots);
+	return true;
+}
+
+//Reallocates the slots to the smallest size that fits the current count. Returns true if the slots were reallocated
+bool IdMapShrink(IdMap_t* map)
+{
+	NotNull(map);
+	if (map->slots == nullptr) { return false; }
+	if (map->count == 0)
+	{
+		FreeMem(map->allocArena, map->slots, sizeof(IdMapSlot_t) * map->numSlots);
+		map->slots = nullptr;
+		map->numSlots = 0;
+		return true;
+	}
+	u64 requiredNumSlots = GetIdMapNumSlotsFor(map->count);
+	if (map->numSlots <= requiredNumSlots) { return false; }
+	ResizeIdMap(map, requiredNumSlots);
+	return true;
+}
+
+// +--------------------------------------------------------------+
+// |                       Create and Free                        |
+// +--------------------------------------------------------------+
+void FreeIdMap(IdMap_t* map)
+{
+	NotNull(map);
+	if (map->slots != nullptr)
+	{
+		NotNull(map->allocArena);
+		FreeMem(map->allocArena, map->slots, sizeof(IdMapSlot_t) * map->numSlots);
+	}
+	ClearPointer(map);
+}
+
+void CreateIdMap(IdMap_t* map, MemArena_t* memArena, u64 initialRequiredCapacity = 0)
+{
+	NotNull(map);
+	NotNull(memArena);
+	ClearPointer(map);
+	map->allocArena = memArena;
+	map->nextId = 1;
+	if (initialRequiredCapacity > 0) { IdMapReserve(map, initialRequiredCapacity); }
+}
+
+//Removes all the items but keeps the slots allocated. nextId is not reset so old ids don't get handed out again
+void ClearIdMap(IdMap_t* map)
+{
+	NotNull(map);
+	if (map->slots != nullptr) { MyMemSet(map->slots, 0x00, sizeof(IdMapSlot_t) * map->numSlots); }
+	map->count = 0;
+}
+
+// +--------------------------------------------------------------+
+// |                             Add                              |
+// +--------------------------------------------------------------+
+//Returns true if the id was new. If the id was already in the map it's pntr gets replaced (and we assert if assertOnDuplicate)
+bool IdMapAdd(IdMap_t* map, u64 id, void* pntr, bool assertOnDuplicate = true)
+{
+	NotNull2(map, map->allocArena);
+	Assert(id != ID_MAP_INVALID_ID);
+	if (map->nextId <= id) { map->nextId = id+1; }
+	
+	if (map->count > 0)
+	{
+		u64 slotIndex = GetIdMapSlotIndex(map, id);
+		while (map->slots[slotIndex].id != ID_MAP_INVALID_ID)
+		{
+			if (map->slots[slotIndex].id == id)
+			{
+				AssertIfMsg(assertOnDuplicate, false, "Duplicate id added to IdMap!");
+				map->slots[slotIndex].pntr = pntr;
+				return false;
+			}
+			slotIndex = (slotIndex + 1) & (map->numSlots - 1);
+		}
+	}
+	
+	IdMapReserve(map, map->count+1);
+	InsertIntoIdMapSlots(map, id, pntr);
+	return true;
+}
+
+//Adds the pntr with nextId and returns the id it was given
+u64 IdMapAddNew(IdMap_t* map, void* pntr)
+{
+	NotNull(map);
+	if (map->nextId == ID_MAP_INVALID_ID) { map->nextId = 1; }
+	u64 result = map->nextId;
+	IdMapAdd(map, result, pntr, true);
+	return result;
+}
+
+// +--------------------------------------------------------------+
+// |                             Get                              |
+// +--------------------------------------------------------------+
+void* IdMapGet_(IdMap_t* map, u64 id, bool assertOnFailure)
+{
+	NotNull(map);
+	if (map->count > 0 && id != ID_MAP_INVALID_ID)
+	{
+		u64 slotIndex = GetIdMapSlotIndex(map, id);
+		while (map->slots[slotIndex].id != ID_MAP_INVALID_ID)
+		{
+			if (map->slots[slotIndex].id == id) { return map->slots[slotIndex].pntr; }
+			slotIndex = (slotIndex + 1) & (map->numSlots - 1);
+		}
+	}
+	AssertIfMsg(assertOnFailure, false, "Id not found in IdMap!");
+	return nullptr;
+}
+const void* IdMapGet_(const IdMap_t* map, u64 id, bool assertOnFailure) //const variant
+{
+	return (const void*)IdMapGet_((IdMap_t*)map, id, assertOnFailure);
+}
+
+//Fills pntrsOut[i] with the pntr for ids[i] (or nullptr). Returns how many were found.
+//Prefetches the home slots for ID_MAP_BATCH_SIZE ids at a time before probing any of them so the cache misses overlap
+u64 IdMapGetBatch_(const IdMap_t* map, u64 numIds, const u64* ids, void** pntrsOut)
+{
+	NotNull(map);
+	Assert(numIds == 0 || (ids != nullptr && pntrsOut != nullptr));
+	u64 numFound = 0;
+	for (u64 batchStart = 0; batchStart < numIds; batchStart += ID_MAP_BATCH_SIZE)
+	{
+		u64 batchSize = MinU64(ID_MAP_BATCH_SIZE, numIds - batchStart);
+		if (map->count > 0)
+		{
+			for (u64 iIndex = 0; iIndex < batchSize; iIndex++) { PrefetchForRead(&map->slots[GetIdMapSlotIndex(map, ids[batchStart + iIndex])]); }
+		}
+		for (u64 iIndex = 0; iIndex < batchSize; iIndex++)
+		{
+			void* pntr = IdMapGet_((IdMap_t*)map, ids[batchStart + iIndex], false);
+			pntrsOut[batchStart + iIndex] = pntr;
+			if (pntr != nullptr) { numFound++; }
+		}
+	}
+	return numFound;
+}
+
+// +--------------------------------------------------------------+
+// |                            Remove                            |
+// +--------------------------------------------------------------+
+bool IdMapRemove_(IdMap_t* map, u64 id, bool assertOnFailure)
+{
+	NotNull(map);
+	u64 holeIndex = map->numSlots;
+	if (map->count > 0 && id != ID_MAP_INVALID_ID)
+	{
+		u64 slotIndex = GetIdMapSlotIndex(map, id);
+		while (map->slots[slotIndex].id != ID_MAP_INVALID_ID)
+		{
+			if (map->slots[slotIndex].id == id) { holeIndex = slotIndex; break; }
+			slotIndex = (slotIndex + 1) & (map->numSlots - 1);
+		}
+	}
+	if (holeIndex >= map->numSlots)
+	{
+		AssertIfMsg(assertOnFailure, false, "Id not found in IdMap!");
+		return false;
+	}
+	
+	//Walk the rest of the probe run and pull back any item whose home slot is at or before the hole
+	u64 mask = map->numSlots - 1;
+	u64 nextIndex = (holeIndex + 1) & mask;
+	while (map->slots[nextIndex].id != ID_MAP_INVALID_ID)
+	{
+		u64 homeIndex = GetIdMapSlotIndex(map, map->slots[nextIndex].id);
+		if (((nextIndex - homeIndex) & mask) >= ((nextIndex - holeIndex) & mask))
+		{
+			map->slots[holeIndex] = map->slots[nextIndex];
+			holeIndex = nextIndex;
+		}
+		nextIndex = (nextIndex + 1) & mask;
+	}
+	map->slots[holeIndex].id = ID_MAP_INVALID_ID;
+	map->slots[holeIndex].pntr = nullptr;
+	map->count--;
+	return true;
+}
+
+// +--------------------------------------------------------------+
+// |                           Iterate                            |
+// +--------------------------------------------------------------+
+//Start slotIndexPntr at 0 and call this until it returns false. Don't add or remove items while iterating
+bool IdMapIter(const IdMap_t* map, u64* slotIndexPntr, u64* idOut = nullptr, void** pntrOut = nullptr)
+{
+	NotNull2(map, slotIndexPntr);
+	while (*slotIndexPntr < map->numSlots)
+	{
+		const IdMapSlot_t* slot = &map->slots[*slotIndexPntr];
+		(*slotIndexPntr)++;
+		if (slot->id != ID_MAP_INVALID_ID)
+		{
+			SetOptionalOutPntr(idOut, slot->id);
+			SetOptionalOutPntr(pntrOut, slot->pntr);
+			return true;
+		}
+	}
+	return false;
+}
+
+#endif //GYLIB_HEADER_ONLY
 
 #endif //  _GY_ID_MAP_H
+
+// +--------------------------------------------------------------+
+// |                   Autocomplete Dictionary                    |
+// +--------------------------------------------------------------+
+/*
+@Defines
+ID_MAP_INVALID_ID
+ID_MAP_MIN_NUM_SLOTS
+ID_MAP_MAX_LOAD_NUM
+ID_MAP_MAX_LOAD_DENOM
+ID_MAP_BATCH_SIZE
+@Types
+IdMapSlot_t
+IdMap_t
+@Functions
+#define IdMapGetHard(map, id, type)
+#define IdMapGetSoft(map, id, type)
+#define IdMapGet(map, id, type)
+#define IdMapContains(map, id)
+#define IdMapGetBatch(map, numIds, ids, pntrsOut)
+#define IdMapRemoveHard(map, id)
+#define IdMapRemoveSoft(map, id)
+#define IdMapRemove(map, id)
+void FreeIdMap(IdMap_t* map)
+void CreateIdMap(IdMap_t* map, MemArena_t* memArena, u64 initialRequiredCapacity = 0)
+void ClearIdMap(IdMap_t* map)
+u64 GetIdMapSlotIndex(const IdMap_t* map, u64 id)
+void InsertIntoIdMapSlots(IdMap_t* map, u64 id, void* pntr)
+void ResizeIdMap(IdMap_t* map, u64 newNumSlots)
+u64 GetIdMapNumSlotsFor(u64 numItems)
+bool IdMapReserve(IdMap_t* map, u64 numItemsRequired)
+bool IdMapShrink(IdMap_t* map)
+bool IdMapAdd(IdMap_t* map, u64 id, void* pntr, bool assertOnDuplicate = true)
+u64 IdMapAddNew(IdMap_t* map, void* pntr)
+void* IdMapGet_(IdMap_t* map, u64 id, bool assertOnFailure)
+const void* IdMapGet_(const IdMap_t* map, u64 id, bool assertOnFailure)
+u64 IdMapGetBatch_(const IdMap_t* map, u64 numIds, const u64* ids, void** pntrsOut)
+bool IdMapRemove_(IdMap_t* map, u64 id, bool assertOnFailure)
+bool IdMapIter(const IdMap_t* map, u64* slotIndexPntr, u64* idOut = nullptr, void** pntrOut = nullptr)
+*/
@@ -283,6 +283,11 @@ Description:
 	i32 RoundUpToI32(i32 value, i32 chunkSize);
 	i64 RoundUpToI64(i64 value, i64 chunkSize);
 	
+	u8 FindMsbIndexU32(u32 value);
+	u8 FindMsbIndexU64(u64 value);
+	u8 FindLsbIndexU32(u32 value);
+	u8 FindLsbIndexU64(u64 value);
+	
 	r32 SubAnimAmountR32(r32 animAmount, r32 subPieceStart, r32 subPieceEnd);
 	r64 SubAnimAmountR64(r64 animAmount, r64 subPieceStart, r64 subPieceEnd);
 	
@@ -1461,6 +1466,55 @@ i64 RoundUpToI64(i64 value, i64 chunkSize)
 	return (isNegative ? -1 : 1) * result;
 }
 
+// +==============================+
+// |           Bit Scan           |
+// +==============================+
+//NOTE: value must not be 0! The result is the index of the highest (Msb) or lowest (Lsb) set bit
+u8 FindMsbIndexU32(u32 value)
+{
+	DebugAssert_(value != 0);
+	#if WINDOWS_COMPILATION
+	unsigned long result = 0;
+	_BitScanReverse(&result, (unsigned long)value);
+	return (u8)result;
+	#else
+	return (u8)(31 - __builtin_clz(value));
+	#endif
+}
+u8 FindMsbIndexU64(u64 value)
+{
+	DebugAssert_(value != 0);
+	#if WINDOWS_COMPILATION
+	unsigned long result = 0;
+	_BitScanReverse64(&result, value);
+	return (u8)result;
+	#else
+	return (u8)(63 - __builtin_clzll(value));
+	#endif
+}
+u8 FindLsbIndexU32(u32 value)
+{
+	DebugAssert_(value != 0);
+	#if WINDOWS_COMPILATION
+	unsigned long result = 0;
+	_BitScanForward(&result, (unsigned long)value);
+	return (u8)result;
+	#else
+	return (u8)__builtin_ctz(value);
+	#endif
+}
+u8 FindLsbIndexU64(u64 value)
+{
+	DebugAssert_(value != 0);
+	#if WINDOWS_COMPILATION
+	unsigned long result = 0;
+	_BitScanForward64(&result, value);
+	return (u8)result;
+	#else
+	return (u8)__builtin_ctzll(value);
+	#endif
+}
+
 //TODO: Rename these LinearStep and LinearSpike
 // +==============================+
 // | Normalized Float Operations  |
@@ -1589,15 +1643,75 @@ r64 AngleLerpR64(r64 angleFrom, r64 angleTo, r64 amount)
 #define ThreadingReadBarrier()              _ReadBarrier()
 #define ThreadSafeIncrement(variablePntr)   InterlockedIncrement(variablePntr)
 #define ThreadSafeClaimByBool(variablePntr) !_interlockedbittestandset((LONG volatile*)(variablePntr), 0)
+#define ThreadSafeIncrementU64(variablePntr) (u64)InterlockedIncrement64((LONG64 volatile*)(variablePntr))
+//These return the value that was in destPntr before the operation
+#define ThreadSafeExchangePntr(destPntr, newValue) InterlockedExchangePointer((PVOID volatile*)(destPntr), (newValue))
+#define ThreadSafeCompareExchangePntr(destPntr, newValue, expectedValue) InterlockedCompareExchangePointer((PVOID volatile*)(destPntr), (newValue), (expectedValue))
+#define ThreadSafeCompareExchangeU64(destPntr, newValue, expectedValue) (u64)InterlockedCompareExchange64((LONG64 volatile*)(destPntr), (LONG64)(newValue), (LONG64)(expectedValue))
+//Nothing written before a release store can be seen after it, and nothing read after an acquire load can be seen before it
+#define ThreadSafeLoadAcquirePntr(srcPntr) ReadPointerAcquire((PVOID const volatile*)(srcPntr))
+#define ThreadSafeStoreReleasePntr(destPntr, newValue) WritePointerRelease((PVOID volatile*)(destPntr), (PVOID)(newValue))
+#define ThreadSafeLoadAcquireU32(srcPntr) (u32)ReadAcquire((LONG const volatile*)(srcPntr))
+#define ThreadSafeStoreReleaseU32(destPntr, newValue) WriteRelease((LONG volatile*)(destPntr), (LONG)(newValue))
+
+#elif OSX_COMPILATION || LINUX_COMPILATION
+
+#define ThreadingWriteBarrier()             __atomic_thread_fence(__ATOMIC_RELEASE)
+#define ThreadingReadBarrier()              __atomic_thread_fence(__ATOMIC_ACQUIRE)
+#define ThreadSafeIncrement(variablePntr)   __atomic_add_fetch((variablePntr), 1, __ATOMIC_SEQ_CST)
+#define ThreadSafeClaimByBool(variablePntr) ((__atomic_fetch_or((volatile u32*)(variablePntr), 1, __ATOMIC_SEQ_CST) & 1) == 0)
+#define ThreadSafeIncrementU64(variablePntr) __atomic_add_fetch((volatile u64*)(variablePntr), 1, __ATOMIC_SEQ_CST)
+//These return the value that was in destPntr before the operation
+#define ThreadSafeExchangePntr(destPntr, newValue) __atomic_exchange_n((destPntr), (newValue), __ATOMIC_ACQ_REL)
+inline void* ThreadSafeCompareExchangePntr_(void* volatile* destPntr, void* newValue, void* expectedValue)
+{
+	__atomic_compare_exchange_n(destPntr, &expectedValue, newValue, false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE);
+	return expectedValue; //on failure this gets filled with the current value
+}
+#define ThreadSafeCompareExchangePntr(destPntr, newValue, expectedValue) ThreadSafeCompareExchangePntr_((void* volatile*)(destPntr), (void*)(newValue), (void*)(expectedValue))
+inline u64 ThreadSafeCompareExchangeU64_(volatile u64* destPntr, u64 newValue, u64 expectedValue)
+{
+	__atomic_compare_exchange_n(destPntr, &expectedValue, newValue, false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE);
+	return expectedValue; //on failure this gets filled with the current value
+}
+#define ThreadSafeCompareExchangeU64(destPntr, newValue, expectedValue) ThreadSafeCompareExchangeU64_((volatile u64*)(destPntr), (u64)(newValue), (u64)(expectedValue))
+//Nothing written before a release store can be seen after it, and nothing read after an acquire load can be seen before it
+#define ThreadSafeLoadAcquirePntr(srcPntr) (void*)__atomic_load_n((srcPntr), __ATOMIC_ACQUIRE)
+#define ThreadSafeStoreReleasePntr(destPntr, newValue) __atomic_store_n((destPntr), (newValue), __ATOMIC_RELEASE)
+#define ThreadSafeLoadAcquireU32(srcPntr) (u32)__atomic_load_n((volatile u32*)(srcPntr), __ATOMIC_ACQUIRE)
+#define ThreadSafeStoreReleaseU32(destPntr, newValue) __atomic_store_n((volatile u32*)(destPntr), (u32)(newValue), __ATOMIC_RELEASE)
+
+#elif ORCA_COMPILATION
+
+//Orca applications are single threaded so these don't need to be atomic
+#define ThreadingWriteBarrier()             //nothing
+#define ThreadingReadBarrier()              //nothing
+#define ThreadSafeIncrement(variablePntr)   (++(*(variablePntr)))
+#define ThreadSafeClaimByBool(variablePntr) ((*(variablePntr)) ? false : ((*(variablePntr)) = 1, true))
+#define ThreadSafeIncrementU64(variablePntr) (++(*(variablePntr)))
+inline void* ThreadSafeExchangePntr_(void** destPntr, void* newValue) { void* result = *destPntr; *destPntr = newValue; return result; }
+inline void* ThreadSafeCompareExchangePntr_(void** destPntr, void* newValue, void* expectedValue) { void* result = *destPntr; if (result == expectedValue) { *destPntr = newValue; } return result; }
+#define ThreadSafeExchangePntr(destPntr, newValue) ThreadSafeExchangePntr_((void**)(destPntr), (void*)(newValue))
+#define ThreadSafeCompareExchangePntr(destPntr, newValue, expectedValue) ThreadSafeCompareExchangePntr_((void**)(destPntr), (void*)(newValue), (void*)(expectedValue))
+inline u64 ThreadSafeCompareExchangeU64_(u64* destPntr, u64 newValue, u64 expectedValue) { u64 result = *destPntr; if (result == expectedValue) { *destPntr = newValue; } return result; }
+#define ThreadSafeCompareExchangeU64(destPntr, newValue, expectedValue) ThreadSafeCompareExchangeU64_((u64*)(destPntr), (u64)(newValue), (u64)(expectedValue))
+#define ThreadSafeLoadAcquirePntr(srcPntr) (void*)(*(srcPntr))
+#define ThreadSafeStoreReleasePntr(destPntr, newValue) (*(destPntr) = (newValue))
+#define ThreadSafeLoadAcquireU32(srcPntr) (u32)(*(srcPntr))
+#define ThreadSafeStoreReleaseU32(destPntr, newValue) (*(destPntr) = (newValue))
 
-#elif OSX_COMPILATION
-
-//TODO: Implement these intrinsics
-
-#elif LINUX_COMPILATION
-
-//TODO: Implement these intrinsics
+#endif
 
+// +--------------------------------------------------------------+
+// |                       Cache Intrinsics                       |
+// +--------------------------------------------------------------+
+//Hints that we are going to read from this address soon so the cache line can start loading. Never faults, even on bad addresses
+#if WINDOWS_COMPILATION && GYLIB_SSE2_AVAILABLE
+#define PrefetchForRead(pntr) _mm_prefetch((const char*)(pntr), _MM_HINT_T0)
+#elif (OSX_COMPILATION || LINUX_COMPILATION || WASM_COMPILATION) && (defined(__GNUC__) || defined(__clang__))
+#define PrefetchForRead(pntr) __builtin_prefetch((const void*)(pntr), 0, 3)
+#else
+#define PrefetchForRead(pntr) //nothing
 #endif
 
 #endif //  _GY_INTRINSICS_H
@@ -1742,6 +1856,10 @@ u32 RoundUpToU32(u32 value, u32 chunkSize)
 u64 RoundUpToU64(u64 value, u64 chunkSize)
 i32 RoundUpToI32(i32 value, i32 chunkSize)
 i64 RoundUpToI64(i64 value, i64 chunkSize)
+u8 FindMsbIndexU32(u32 value)
+u8 FindMsbIndexU64(u64 value)
+u8 FindLsbIndexU32(u32 value)
+u8 FindLsbIndexU64(u64 value)
 r32 SubAnimAmountR32(r32 animAmount, r32 subPieceStart, r32 subPieceEnd)
 r64 SubAnimAmountR64(r64 animAmount, r64 subPieceStart, r64 subPieceEnd)
 r32 SubAnimAmountTwoWayR32(r32 animAmount, r32 subPieceStart, r32 subPieceEnd)
@@ -1762,4 +1880,13 @@ r64 AngleLerpR64(r64 angleFrom, r64 angleTo, r64 amount)
 #define ThreadingReadBarrier()
 #define ThreadSafeIncrement(variablePntr)
 #define ThreadSafeClaimByBool(variablePntr)
+#define ThreadSafeIncrementU64(variablePntr)
+#define ThreadSafeExchangePntr(destPntr, newValue)
+#define ThreadSafeCompareExchangePntr(destPntr, newValue, expectedValue)
+#define ThreadSafeCompareExchangeU64(destPntr, newValue, expectedValue)
+#define ThreadSafeLoadAcquirePntr(srcPntr)
+#define ThreadSafeStoreReleasePntr(destPntr, newValue)
+#define ThreadSafeLoadAcquireU32(srcPntr)
+#define ThreadSafeStoreReleaseU32(destPntr, newValue)
+#define PrefetchForRead(pntr)
 */
\ No newline at end of file
@@ -18,6 +18,11 @@ Description:
 	@MemArenaType_StdHeap An arena that simply redirects to standard library functions malloc, free, and realloc.
 	The used value only increases since the free function does not provide size information. (unless allocSize is always provided to FreeMem)
 	Alignment is not supported.
+	On Linux allocations of STD_HEAP_REMAP_THRESHOLD bytes or more get a mapping of their own (with a small prefix) instead of going
+	through malloc. ReallocMem resizes these with mremap, which moves pages around without copying. GrowMemQuery reports the rest of the
+	mapping's last page, and GrowMem past that tries to extend the mapping in place (asserting if the neighboring address space is taken).
+	These mappings are tracked in a global table (so we never have to peek in front of a pointer that malloc gave us). If more than
+	STD_HEAP_MAX_MAPPED_ALLOCS of them are alive at once the rest simply go through malloc.
 	
 	@MemArenaType_FixedHeap An arena that manages a space of fixed size and provides
 	general purpose allocation/deallocation functionality.
@@ -25,6 +30,9 @@ Description:
 	@MemArenaType_PagedHeap An arena that manages pages of memory and can allocate more pages from a base
 	arena (or through allocFunc and freeFunc) when it runs out. On the outside this provides the same
 	general purpose allocation/deallocation functionality as FixedHeap.
+	Free sections are tracked in a two-level segregated fit (TLSF) index and carry a size footer so AllocMem, FreeMem,
+	GrowMem and ShrinkMem all run in bounded time and free sections are coalesced immediately with their neighbors.
+	Each page ends with a zero-sized filled sentinel section so merging never has to check page bounds.
 	
 	@MemArenaType_MarkedStack An arena that acts like a "stack" where direct deallocation is not allowed
 	but "marks" can be pushed and then later popped (freeing any memory allocated since the push)
@@ -36,13 +44,55 @@ Description:
 	
 	@MemArenaType_VirtualStack Similar to MarkedStack but this arena reserves a massive amount of space
 	through VirtualAlloc (or equivalent) and only commits no pages of that space as needed. This allows
-	it to be completely sequential in memory but also grow to a massive size if needed
+	it to be completely sequential in memory but also grow to a massive size if needed.
+	Pass useHugePages to reserve on a huge page boundary and commit in huge page sized chunks, which lets the
+	OS back the arena with transparent huge pages (Linux only for now, other platforms silently use regular pages).
+	MemArenaFlag_HugePages is set if the OS accepted the request.
+	VirtualStack arenas can also be checkpointed and rolled back with MemArenaSnapshot_t (see gy_memory_snapshot.h)
 	
 	@MemArenaType_Buffer An arena that provides a simple first in last out style allocation structure within
 	a predefined space (usually a buffer from somewhere). When freeing memory you generally have to pass the
 	size of the allocation you are freeing (except for simple single allocation scenarios).
 	You can quickly create one of these buffer-backed arenas on the stack with CreateBufferArenaOnStack(arenaName, bufferName, size).
 	(TODO: Add support for quickly taking a preallocated pntr and size and turning into a Buffer arena)
+	
+	@MemArenaType_Slab An arena that serves small allocations (16 to 4096 bytes) out of power-of-two size classes.
+	Each page from the sourceArena is dedicated to a single size class and freed slots are kept in a per-class
+	free list so AllocMem and FreeMem don't have to walk any sections. Allocations bigger than the largest
+	size class are passed through to the sourceArena with a small prefix in front that remembers their size.
+	The used value counts whole slots for small allocations and requested sizes for passed through ones.
+	Alignment is supported up to AllocAlignment_Max (the size class is bumped up to at least the alignment), anything more aligned is passed through
+	
+	@MemArenaType_ThreadCached A front-end for a sourceArena (usually a PagedHeap) that is shared between threads.
+	Each thread gets it's own cache of recently freed blocks for each Slab size class so most AllocMem/FreeMem calls never
+	touch a lock. Caches refill and flush in batches under a single lock of the sourceArena. Blocks freed on a different
+	thread than the one that allocated them are pushed onto the owning thread's lock-free return stack and picked up the
+	next time that thread runs out of blocks. Don't give this arena it's own mutex (that would defeat the purpose), instead
+	it locks it's internal sourceMutex around access to the sourceArena. Call ReleaseThreadCache before a thread exits.
+	size counts bytes held from the sourceArena (including blocks sitting in caches). used and numAllocations are
+	tracked per thread and only folded into the arena when a thread touches the sourceArena (or calls FlushThreadCache).
+	Allocations bigger than SLAB_MAX_SLOT_SIZE or with more alignment than the arena's alignment go straight to the sourceArena.
+	Every live ThreadCached arena registers it's id in a global table, so when an arena is freed the other threads' entries for
+	it are recognized as stale and get reused the next time those threads need a slot (this caps the program at THREAD_CACHE_MAX_LIVE_ARENAS).
+	
+	@MemArenaType_Ring An arena for transient per-frame (or per-epoch) allocations that hands out memory from a single
+	circular buffer. Allocations always go in the current frame. AdvanceRingFrame starts a new frame and returns it's id,
+	which you can pair with a fence. Once the fence signals, RetireRingFrame(id) reclaims that frame (and any older frames)
+	in O(1). Allocations never straddle the end of the buffer, they skip to the beginning instead, so used can include
+	some wasted space. FreeMem only reclaims space if it was the most recent allocation, otherwise the space is held
+	until the frame is retired. Up to maxNumFrames frames can be live at once (including the current frame).
+	
+	@MemArenaType_MappedFile Works just like a MarkedStack but the memory is an mmap'd file (see OsMapFile), so the
+	contents (including the marks) persist between runs and the page cache can share them between processes.
+	SyncMappedFileArena writes used and numAllocations into the file header and flushes the pages to disk, so the file
+	always reopens at the state of the last sync (FreeMemArena does not sync for you). Store offsets (GetMappedFileOffset) rather than pointers inside the file
+	since we may not get the same base address when reopening. If we do (DidMappedFileRelocate returns false) then raw
+	pointers stored in the file are still valid. Use SetMappedFileRoot to remember where your top-level data lives.
+	Pass copyOnWrite to open an existing file where all writes stay private to this process.
+	
+	Any arena can keep log-bucketed histograms of allocation sizes and of the latency of each AllocMem, FreeMem, ReallocMem and GrowMem call.
+	Hand EnableMemArenaHistograms a MemArenaHistograms_t that lives as long as the arena, then use TakeMemArenaHistogramsSnapshot
+	and DiffMemArenaHistograms to look at a window of time and GetMemArenaHistogramPercentile (or GetMemArenaLatencyPercentile) to query them.
 */
 
 //TODO: Add some standard way to copy an arena, perform some operations that should leave no changes, and then compare the
@@ -69,6 +119,10 @@ enum MemArenaType_t
 	MemArenaType_PagedStack,
 	MemArenaType_VirtualStack,
 	MemArenaType_Buffer,
+	MemArenaType_Slab,
+	MemArenaType_ThreadCached,
+	MemArenaType_Ring,
+	MemArenaType_MappedFile,
 	MemArenaType_NumTypes,
 };
 #ifdef GYLIB_HEADER_ONLY
@@ -88,40 +142,85 @@ const char* GetMemArenaTypeStr(MemArenaType_t arenaType)
 		case MemArenaType_PagedStack:   return "PagedStack";
 		case MemArenaType_VirtualStack: return "VirtualStack";
 		case MemArenaType_Buffer:       return "Buffer";
+		case MemArenaType_Slab:         return "Slab";
+		case MemArenaType_ThreadCached: return "ThreadCached";
+		case MemArenaType_Ring:         return "Ring";
+		case MemArenaType_MappedFile:   return "MappedFile";
 		default: return "Unknown";
 	}
 }
 #endif
 
-enum AllocAlignment_t
+enum AllocAlignment_t : u32 //fixed underlying type so test/gy_test_memory.h can forward declare it
 {
-	AllocAlignment_None    = 0,
-	AllocAlignment_4Bytes  = 4,
-	AllocAlignment_8Bytes  = 8,
-	AllocAlignment_16Bytes = 16,
-	AllocAlignment_64Bytes = 64,
-	AllocAlignment_Max = AllocAlignment_64Bytes,
+	AllocAlignment_None        = 0,
+	AllocAlignment_4Bytes      = 4,
+	AllocAlignment_8Bytes      = 8,
+	AllocAlignment_16Bytes     = 16,
+	AllocAlignment_64Bytes     = 64,
+	AllocAlignment_Max = AllocAlignment_64Bytes, //the largest alignment that every arena type supports
+	AllocAlignment_4Kilobytes  = 4096, //a regular memory page, only supported by stack and buffer style arenas
+	AllocAlignment_2Megabytes  = 2097152, //a huge page, only supported by stack and buffer style arenas
 };
 
 typedef void* AllocationFunction_f(u64 numBytes);
 typedef void* ReallocFunction_f(void* memPntr, u64 newSize);
 typedef void FreeFunction_f(void* memPntr);
 
-#define CACHED_FREE_MIN_SIZE 128 //bytes
+#if LINUX_COMPILATION && defined(MREMAP_MAYMOVE)
+#define STD_HEAP_REMAP_SUPPORTED 1
+#else
+#define STD_HEAP_REMAP_SUPPORTED 0
+#endif
+#define STD_HEAP_REMAP_THRESHOLD   Megabytes(1)
+#define STD_HEAP_MAX_MAPPED_ALLOCS 256 //how many allocations can have a mapping of their own at once (across all StdHeap arenas)
+
+struct StdHeapMappedPrefix_t
+{
+	u64 mappedSize; //includes the prefix
+	u64 tableIndex; //where this allocation is registered in StdHeapMappedAllocs
+};
 
-#define HEAP_ALLOC_FILLED_FLAG 0x8000000000000000ULL
-#define HEAP_ALLOC_SIZE_MASK   0x7FFFFFFFFFFFFFFFULL
+#define HEAP_ALLOC_FILLED_FLAG    0x8000000000000000ULL
+#define HEAP_ALLOC_PREV_FREE_FLAG 0x4000000000000000ULL //PagedHeap only, the section before this one is free and has a footer holding it's size
+#define HEAP_ALLOC_FIRST_FLAG     0x2000000000000000ULL //PagedHeap only, this is the first section in the page
+#define HEAP_ALLOC_SIZE_MASK      0x1FFFFFFFFFFFFFFFULL
 struct HeapAllocPrefix_t
 {
-	u64 size; //top-bit is used as "filled" flag, includes prefix size
+	u64 size; //top-bits are used as flags, includes prefix size
 };
 
+#define HEAP_SECTION_GRANULARITY 8  //bytes, PagedHeap section sizes are always a multiple of this
+#define HEAP_MIN_SECTION_SIZE    32 //bytes, PagedHeap sections need to be able to hold a HeapFreeSection_t and footer when they are freed
+
+//PagedHeap free sections are indexed with a two-level segregated fit (TLSF) scheme. The first level is the power of two
+//of the section size and the second level splits each power of two range into HEAP_FREE_INDEX_SL_COUNT linear steps
+#define HEAP_FREE_INDEX_SL_LOG2  4
+#define HEAP_FREE_INDEX_SL_COUNT (1 << HEAP_FREE_INDEX_SL_LOG2)
+#define HEAP_FREE_INDEX_FL_SHIFT (HEAP_FREE_INDEX_SL_LOG2 + 3) //sections smaller than 128 bytes all go in first level 0 (in 8 byte steps)
+#define HEAP_FREE_INDEX_FL_MAX   48 //sections must be smaller than 2^49 bytes
+#define HEAP_FREE_INDEX_FL_COUNT (HEAP_FREE_INDEX_FL_MAX - HEAP_FREE_INDEX_FL_SHIFT + 2)
+
 struct HeapPageHeader_t
 {
+	HeapPageHeader_t* prev;
 	HeapPageHeader_t* next;
-	u64 size;
-	u64 used;
-	u64 cachedFreeOffset; //first free section >= CACHED_FREE_MIN_SIZE bytes in the page
+	u64 size; //doesn't include this header or the sentinel HeapAllocPrefix_t at the end of the page
+};
+
+//A free PagedHeap section also has a u64 footer in it's last 8 bytes that holds the section size
+struct HeapFreeSection_t
+{
+	HeapAllocPrefix_t prefix;
+	HeapFreeSection_t* nextFree;
+	HeapFreeSection_t* prevFree;
+};
+
+struct HeapFreeIndex_t
+{
+	u64 firstLevelBitmap;
+	u16 secondLevelBitmaps[HEAP_FREE_INDEX_FL_COUNT];
+	HeapFreeSection_t* lists[HEAP_FREE_INDEX_FL_COUNT][HEAP_FREE_INDEX_SL_COUNT];
 };
 
 struct MarkedStackArenaHeader_t
@@ -133,6 +232,111 @@ struct MarkedStackArenaHeader_t
 	u64 thisPageSize; //only used by PagedStack
 };
 
+struct RingArenaFrame_t
+{
+	u64 startPos; //position in the ring where this frame's first allocation could go
+	u64 numAllocations;
+};
+struct RingArenaHeader_t
+{
+	u64 maxNumFrames;
+	u64 headPos; //positions only ever increase, take them modulo arena->size to get an offset from mainPntr
+	u64 tailPos; //startPos of the oldest frame that hasn't been retired yet
+	u64 oldestFrameId;
+	u64 currentFrameId;
+	u64 highFrameCount;
+};
+
+#define MAPPED_FILE_ARENA_MAGIC   0x4D464147 //"GAFM" in little-endian
+#define MAPPED_FILE_ARENA_VERSION 1
+
+struct MappedFileArenaHeader_t
+{
+	MarkedStackArenaHeader_t stackHeader; //must be first so the MarkedStack code paths can treat headerPntr as a MarkedStackArenaHeader_t
+	u32 magic;
+	u32 version;
+	u64 headerAndMarksSize;
+	u64 used; //only updated by SyncMappedFileArena
+	u64 numAllocations; //only updated by SyncMappedFileArena
+	u64 baseAddress; //where the file was mapped when it was last synced
+	u64 rootOffset;
+};
+
+#define SLAB_MIN_SLOT_SIZE_POWER 4  //16 bytes
+#define SLAB_MAX_SLOT_SIZE_POWER 12 //4096 bytes
+#define SLAB_NUM_SIZE_CLASSES    (SLAB_MAX_SLOT_SIZE_POWER - SLAB_MIN_SLOT_SIZE_POWER + 1)
+#define SLAB_MIN_SLOT_SIZE       (1ULL << SLAB_MIN_SLOT_SIZE_POWER)
+#define SLAB_MAX_SLOT_SIZE       (1ULL << SLAB_MAX_SLOT_SIZE_POWER)
+#define SLAB_PAGE_LIST_MIN_SIZE  8 //pntrs
+
+struct SlabPageHeader_t
+{
+	u64 sizeClass;
+	u64 slotSize;
+	u64 numSlots;
+	u64 pageSize; //includes this header
+	u8* slotsBase; //aligned to AllocAlignment_Max
+};
+
+struct SlabArenaHeader_t
+{
+	void* freeLists[SLAB_NUM_SIZE_CLASSES]; //each free slot holds a pntr to the next free slot of the same size class
+	u8* carvePntrs[SLAB_NUM_SIZE_CLASSES]; //next never-used slot in the newest page of each size class
+	u8* carveEnds[SLAB_NUM_SIZE_CLASSES];
+	u64 pageListSize;
+	SlabPageHeader_t** pages; //sorted by address so we can binary search for the page that owns a pntr
+};
+
+//Lives right before every allocation that a Slab arena passed through to it's sourceArena
+struct SlabPassthroughPrefix_t
+{
+	u64 size; //the size that was requested, this is what the allocation counts for in used
+	u64 rawOffset; //from the start of the sourceArena allocation to the block we handed out
+};
+
+#define THREAD_CACHE_DEFAULT_MAGAZINE_SIZE 64 //blocks per size class that a thread keeps before flushing half of them back to the sourceArena
+#define THREAD_CACHE_MAX_ARENAS_PER_THREAD 8  //a thread can only have caches in this many ThreadCached arenas at once (others fall back to the sourceArena)
+#define THREAD_CACHE_MAX_LIVE_ARENAS       64 //how many ThreadCached arenas can exist at once across the whole program
+
+struct ThreadCache_t
+{
+	ThreadCache_t* next; //caches are never removed from this list until FreeMemArena
+	volatile u32 isClaimed; //released caches get adopted by the next thread that needs one
+	void* freeLists[SLAB_NUM_SIZE_CLASSES]; //only touched by the thread that claimed this cache
+	u64 numCached[SLAB_NUM_SIZE_CLASSES];
+	void* volatile remoteFreeHead; //lock-free stack of blocks that other threads freed, each block holds a pntr to the next
+	i64 usedDelta; //folded into arena->used whenever this thread locks the sourceMutex
+	i64 allocationsDelta; //folded into arena->numAllocations whenever this thread locks the sourceMutex
+};
+
+//Lives right before every allocation handed out by a ThreadCached arena
+struct ThreadCacheBlockPrefix_t
+{
+	union
+	{
+		ThreadCache_t* owner; //for blocks in one of our size classes
+		u64 passthroughSize; //for allocations that were passed through to the sourceArena
+	};
+	u32 sizeClass; //SLAB_NUM_SIZE_CLASSES if the allocation was passed through to the sourceArena
+	u32 rawOffset; //from the start of the sourceArena allocation to the start of the block
+};
+
+struct ThreadCacheArenaHeader_t
+{
+	GyMutex_t sourceMutex;
+	u64 arenaId; //distinguishes a re-initialized arena at the same address in the thread local tables
+	u64 magazineSize;
+	u64 numCaches;
+	ThreadCache_t* volatile firstCache;
+};
+
+struct ThreadCacheTlsEntry_t
+{
+	MemArena_t* arena;
+	u64 arenaId;
+	ThreadCache_t* cache;
+};
+
 enum MemArenaFlag_t
 {
 	MemArenaFlag_TelemetryEnabled = 0x0001,
@@ -142,9 +346,76 @@ enum MemArenaFlag_t
 	MemArenaFlag_BreakOnAlloc     = 0x0010,
 	MemArenaFlag_BreakOnFree      = 0x0020,
 	MemArenaFlag_BreakOnRealloc   = 0x0040,
-	MemArenaFlag_CacheFreeOffset  = 0x0080, //An experimental option for PagedHeap arenas that optimizes AllocMem by storing an offset to first free section of some size or bigger (Doesn't work with GrowMem/ShrinkMem yet)
-	MemArenaFlag_NumFlags         = 7,
+	MemArenaFlag_HugePages        = 0x0080,
+	MemArenaFlag_Snapshotted      = 0x0100,
+	MemArenaFlag_Histograms       = 0x0200,
+	MemArenaFlag_NumFlags         = 10,
+};
+
+enum MemArenaOp_t
+{
+	MemArenaOp_Alloc = 0,
+	MemArenaOp_Free,
+	MemArenaOp_Realloc,
+	MemArenaOp_Grow,
+	MemArenaOp_NumOps,
+};
+#ifdef GYLIB_HEADER_ONLY
+const char* GetMemArenaOpStr(MemArenaOp_t arenaOp);
+#else
+const char* GetMemArenaOpStr(MemArenaOp_t arenaOp)
+{
+	switch (arenaOp)
+	{
+		case MemArenaOp_Alloc:   return "Alloc";
+		case MemArenaOp_Free:    return "Free";
+		case MemArenaOp_Realloc: return "Realloc";
+		case MemArenaOp_Grow:    return "Grow";
+		default: return "Unknown";
+	}
+}
+#endif
+
+//Values below 2^SUB_BITS get a bucket each, after that every power of two is split into 2^SUB_BITS linear steps
+//so a bucket never spans more than 25% of the values in it
+#define MEM_ARENA_HISTOGRAM_SUB_BITS    2
+#define MEM_ARENA_HISTOGRAM_NUM_BUCKETS ((64 - MEM_ARENA_HISTOGRAM_SUB_BITS + 1) << MEM_ARENA_HISTOGRAM_SUB_BITS)
+
+struct MemArenaHistogram_t
+{
+	u64 count;
+	u64 total;
+	u64 minValue;
+	u64 maxValue;
+	u64 buckets[MEM_ARENA_HISTOGRAM_NUM_BUCKETS]; //see GetMemArenaHistogramBucket
+};
+
+struct MemArenaHistograms_t
+{
+	MemArenaHistogram_t allocSizes; //numBytes of each AllocMem and newSize of each ReallocMem
+	MemArenaHistogram_t latencies[MemArenaOp_NumOps]; //in perf time counts, GetMemArenaLatencyPercentile converts to nanoseconds
+};
+
+#define MEM_ARENA_ALLOC_INFO_TABLE_MIN_CAPACITY    256
+#define MEM_ARENA_ALLOC_INFO_TABLE_MAX_LOAD_NUM    3 //grow when the table would be more than 3/4 full
+#define MEM_ARENA_ALLOC_INFO_TABLE_MAX_LOAD_DENOM  4
+
+#if GYLIB_MEM_ARENA_DEBUG_ENABLED
+struct MemArenaAllocInfo_t
+{
+	void* allocPntr;
+	u64 allocSize;
+	const char* filePath;
+	u64 lineNumber;
+	const char* funcName;
+};
+struct MemArenaAllocInfoTable_t
+{
+	u64 capacity; //always a power of two (or 0 before the first StoreAllocInfo)
+	u64 count;
+	MemArenaAllocInfo_t* slots; //allocated from the debugArena, empty slots have allocPntr == nullptr
 };
+#endif
 
 struct MemArena_t
 {
@@ -160,6 +431,7 @@ struct MemArena_t
 	u64 debugBreakThreshold;
 	PerfTimeTotal_t totalTimeSpentAllocating;
 	u64 totalTimedAllocationActions;
+	MemArenaHistograms_t* histograms; //only filled while MemArenaFlag_Histograms is set
 	
 	u64 size;
 	u64 used;
@@ -178,6 +450,7 @@ struct MemArena_t
 	MemArena_t* sourceArena;
 	#if GYLIB_MEM_ARENA_DEBUG_ENABLED
 	MemArena_t* debugArena;
+	MemArenaAllocInfoTable_t allocInfoTable;
 	#endif
 	#ifdef _GY_TEST_MEMORY_PREDECLARED //#include gy_test_memory.h with GYLIB_PREDECLARE_ONLY #defined before #including gy_memory.h
 	MemArenaTestSet_t* testSetOut;
@@ -190,19 +463,11 @@ struct GrowMemToken_t
 	MemArena_t* memArena;
 	void* nextSectionPntr;
 	u64 nextSectionSize;
+	//PagedHeap only: the next section may get overwritten before GrowMem so we save it's free list links here
+	HeapFreeSection_t* nextSectionNextFree;
+	HeapFreeSection_t* nextSectionPrevFree;
 };
 
-#if GYLIB_MEM_ARENA_DEBUG_ENABLED
-struct MemArenaAllocInfo_t
-{
-	void* allocPntr;
-	u64 allocSize;
-	const char* filePath;
-	u64 lineNumber;
-	const char* funcName;
-};
-#endif
-
 // +--------------------------------------------------------------+
 // |                            Macros                            |
 // +--------------------------------------------------------------+
@@ -256,6 +521,9 @@ while(0)
 	#define AllocArray(arena, structName, numItems) (structName*)AllocMem_(__FILE__, __LINE__, __func__, (arena), sizeof(structName) * (numItems))
 	#define AllocBytes(arena, numBytes)             (u8*)AllocMem_(__FILE__, __LINE__, __func__, (arena), (numBytes))
 	#define AllocChars(arena, numBytes)             (char*)AllocMem_(__FILE__, __LINE__, __func__, (arena), (numBytes))
+	#define AllocMemFast(arena, numBytes, ...)          AllocMemFast_(__FILE__, __LINE__, __func__, (arena), (numBytes), ##__VA_ARGS__)
+	#define AllocStructFast(arena, structName)          (structName*)AllocMemFast_(__FILE__, __LINE__, __func__, (arena), sizeof(structName))
+	#define AllocArrayFast(arena, structName, numItems) (structName*)AllocMemFast_(__FILE__, __LINE__, __func__, (arena), sizeof(structName) * (numItems))
 #else //!GYLIB_MEM_ARENA_DEBUG_ENABLED
 	#define AllocMem(arena, numBytes, ...) AllocMem_((arena), (numBytes), ##__VA_ARGS__)
 	#define ReallocMem(arena, allocPntr, newSize, ...) ReallocMem_((arena), (allocPntr), (newSize), ##__VA_ARGS__)
@@ -265,6 +533,9 @@ while(0)
 	#define AllocArray(arena, structName, numItems) (structName*)AllocMem_((arena), sizeof(structName) * (numItems))
 	#define AllocBytes(arena, numBytes)             (u8*)AllocMem_((arena), (numBytes))
 	#define AllocChars(arena, numBytes)             (char*)AllocMem_((arena), (numBytes))
+	#define AllocMemFast(arena, numBytes, ...)          AllocMemFast_((arena), (numBytes), ##__VA_ARGS__)
+	#define AllocStructFast(arena, structName)          (structName*)AllocMemFast_((arena), sizeof(structName))
+	#define AllocArrayFast(arena, structName, numItems) (structName*)AllocMemFast_((arena), sizeof(structName) * (numItems))
 #endif //GYLIB_MEM_ARENA_DEBUG_ENABLED
 
 #define HardFreeMem(arena, allocPntr) FreeMem((arena), (allocPntr), 0, false)
@@ -285,13 +556,111 @@ while(0)
 	bool FreeMem(MemArena_t* arena, void* allocPntr, u64 allocSize = 0, bool ignoreNullptr = false, u64* oldSizeOut = nullptr, bool isSubCall = false);
 #endif //GYLIB_MEM_ARENA_DEBUG_ENABLED
 
+// +--------------------------------------------------------------+
+// |                    Fast Stack Allocation                     |
+// +--------------------------------------------------------------+
+//Any of these flags being set sends AllocMemFast down the full AllocMem path (TelemetryEnabled is on by default so we handle it inline)
+#define MEM_ARENA_FAST_PATH_BLOCKING_FLAGS (MemArenaFlag_SingleAlloc | MemArenaFlag_TrackTime | MemArenaFlag_BreakOnAlloc | MemArenaFlag_Histograms)
+
+//Defined in both header-only and implementation mode so the compiler can always inline it.
+//For MarkedStack, VirtualStack, MappedFile and Buffer arenas an allocation that fits in the memory the arena already has (already committed
+//memory for VirtualStack) is just an aligned bump of the used value. Everything else (other arena types, committing new pages,
+//time tracking, debug breaks, alloc info tracking, test set recording, arenas with a mutex) goes through the regular AllocMem_.
+//That makes it safe to call on any arena, but it only pays off for unshared stack-like arenas (like scratch arenas)
+#if GYLIB_MEM_ARENA_DEBUG_ENABLED
+inline void* AllocMemFast_(const char* filePath, u64 lineNumber, const char* funcName, MemArena_t* arena, u64 numBytes, AllocAlignment_t alignOverride = AllocAlignment_None)
+#else
+inline void* AllocMemFast_(MemArena_t* arena, u64 numBytes, AllocAlignment_t alignOverride = AllocAlignment_None)
+#endif
+{
+	bool canTakeFastPath = ((arena->type == MemArenaType_MarkedStack || arena->type == MemArenaType_VirtualStack || arena->type == MemArenaType_MappedFile || arena->type == MemArenaType_Buffer) &&
+		(arena->flags & MEM_ARENA_FAST_PATH_BLOCKING_FLAGS) == 0 && numBytes > 0 && !IsValidGyMutex(&arena->mutex));
+	#if GYLIB_MEM_ARENA_DEBUG_ENABLED
+	if (arena->debugArena != nullptr) { canTakeFastPath = false; }
+	#endif
+	#ifdef _GY_TEST_MEMORY_PREDECLARED
+	if (arena->testSetOut != nullptr) { canTakeFastPath = false; }
+	#endif
+	
+	if (canTakeFastPath)
+	{
+		AllocAlignment_t alignment = (alignOverride != AllocAlignment_None) ? alignOverride : arena->alignment;
+		u8* usedEndPntr = ((u8*)arena->mainPntr) + arena->used;
+		u64 alignOffset = (alignment != AllocAlignment_None) ? ((0 - (u64)usedEndPntr) & ((u64)alignment - 1)) : 0; //all alignment values are powers of two
+		if (alignOffset + numBytes <= arena->size - arena->used)
+		{
+			arena->used += alignOffset + numBytes;
+			arena->numAllocations++;
+			if (IsFlagSet(arena->flags, MemArenaFlag_TelemetryEnabled))
+			{
+				if (arena->highUsedMark < arena->used) { arena->highUsedMark = arena->used; }
+				if (arena->resettableHighUsedMark < arena->used) { arena->resettableHighUsedMark = arena->used; }
+				if (arena->type == MemArenaType_Buffer && arena->highAllocMark < arena->numAllocations) { arena->highAllocMark = arena->numAllocations; }
+			}
+			return (void*)(usedEndPntr + alignOffset);
+		}
+	}
+	
+	#if GYLIB_MEM_ARENA_DEBUG_ENABLED
+	return AllocMem_(filePath, lineNumber, funcName, arena, numBytes, alignOverride);
+	#else
+	return AllocMem_(arena, numBytes, alignOverride);
+	#endif
+}
+
 // +--------------------------------------------------------------+
 // |                         Header Only                          |
 // +--------------------------------------------------------------+
 #ifdef GYLIB_HEADER_ONLY
 	bool IsAlignedTo(const void* memoryPntr, AllocAlignment_t alignment);
-	u8 OffsetToAlign(const void* memoryPntr, AllocAlignment_t alignment);
+	u64 OffsetToAlign(const void* memoryPntr, AllocAlignment_t alignment);
 	bool IsPntrInsideRange(const void* testPntr, const void* rangeBase, u64 rangeSize, bool inclusive = false);
+	u64 GetMemArenaHistogramBucket(u64 value);
+	u64 GetMemArenaHistogramBucketMin(u64 bucketIndex);
+	u64 GetMemArenaHistogramBucketMax(u64 bucketIndex);
+	void AddToMemArenaHistogram(MemArenaHistogram_t* histogram, u64 value);
+	void RecordMemArenaHistograms(MemArena_t* arena, MemArenaOp_t arenaOp, const PerfTime_t* startTime, u64 allocSize);
+	u64 GetSlabSizeClass(u64 numBytes, AllocAlignment_t alignment);
+	u64 GetSlabPassthroughRawOffset(AllocAlignment_t alignment);
+	u64 FindSlabPageUpperBound(const MemArena_t* arena, const void* pntr);
+	SlabPageHeader_t* FindSlabPageFor(const MemArena_t* arena, const void* allocPntr);
+	SlabPageHeader_t* AllocSlabPage(MemArena_t* arena, u64 sizeClass);
+	extern u64 ThreadCacheNextArenaId;
+	extern volatile u64 ThreadCacheLiveArenaIds[THREAD_CACHE_MAX_LIVE_ARENAS];
+	extern thread_local ThreadCacheTlsEntry_t ThreadCacheTlsEntries[THREAD_CACHE_MAX_ARENAS_PER_THREAD];
+	u64 GetThreadCacheRawOffset(AllocAlignment_t alignment);
+	void RegisterThreadCacheArenaId(u64 arenaId);
+	void UnregisterThreadCacheArenaId(u64 arenaId);
+	bool IsThreadCacheArenaIdLive(u64 arenaId);
+	void LockThreadCacheSource(MemArena_t* arena, ThreadCache_t* cache);
+	void UnlockThreadCacheSource(MemArena_t* arena);
+	ThreadCache_t* FindThreadCache(const MemArena_t* arena);
+	ThreadCache_t* GetThreadCache(MemArena_t* arena);
+	void DrainThreadCacheRemoteFrees(ThreadCache_t* cache);
+	void PushThreadCacheRemoteFree(ThreadCache_t* owner, void* blockPntr);
+	bool RefillThreadCache(MemArena_t* arena, ThreadCache_t* cache, u64 sizeClass);
+	void FlushThreadCacheClass(MemArena_t* arena, ThreadCache_t* cache, u64 sizeClass, u64 numToKeep);
+	u64 GetRingAllocPos(const MemArena_t* arena, const void* allocPntr);
+	RingArenaFrame_t* FindRingFrameFor(const MemArena_t* arena, u64 allocPos);
+	#if STD_HEAP_REMAP_SUPPORTED
+	extern StdHeapMappedPrefix_t* volatile StdHeapMappedAllocs[STD_HEAP_MAX_MAPPED_ALLOCS];
+	StdHeapMappedPrefix_t* GetStdHeapMappedPrefix(const void* allocPntr);
+	u8* AllocStdHeapMapped(u64 numBytes);
+	void FreeStdHeapMapped(StdHeapMappedPrefix_t* prefix);
+	u8* ResizeStdHeapMapped(StdHeapMappedPrefix_t* prefix, u64 newSize, bool allowMove);
+	#endif
+	u64 GetHeapSectionSizeFor(u64 numBytes, u64 alignOffset);
+	HeapAllocPrefix_t* GetHeapAllocPrefix(const void* allocPntr);
+	HeapPageHeader_t* FindHeapPageFor(const MemArena_t* arena, const void* pntr);
+	void GetHeapFreeIndexMapping(u64 sectionSize, u64* firstLevelOut, u64* secondLevelOut);
+	void InsertHeapFreeSection(HeapFreeIndex_t* freeIndex, HeapAllocPrefix_t* prefixPntr);
+	void UnlinkHeapFreeSection(HeapFreeIndex_t* freeIndex, const void* sectionPntr, u64 sectionSize, HeapFreeSection_t* nextFree, HeapFreeSection_t* prevFree);
+	void RemoveHeapFreeSection(HeapFreeIndex_t* freeIndex, HeapAllocPrefix_t* prefixPntr);
+	HeapAllocPrefix_t* TakeHeapFreeSection(HeapFreeIndex_t* freeIndex, u64 minSectionSize);
+	HeapAllocPrefix_t* FreeHeapSection(MemArena_t* arena, HeapAllocPrefix_t* prefixPntr);
+	HeapFreeIndex_t* GetHeapFreeIndex(MemArena_t* arena);
+	HeapAllocPrefix_t* AllocHeapPage(MemArena_t* arena, u64 minSectionSize);
+	void ReleaseHeapPage(MemArena_t* arena, HeapPageHeader_t* pageHeader);
 	void InitMemArena_Redirect(MemArena_t* arena, AllocationFunction_f* allocFunc, FreeFunction_f* freeFunc, ReallocFunction_f* reallocFunc = nullptr);
 	void InitMemArena_Alias(MemArena_t* arena, MemArena_t* sourceArena);
 	void InitMemArena_StdHeap(MemArena_t* arena);
@@ -300,8 +669,12 @@ while(0)
 	void InitMemArena_MarkedStack(MemArena_t* arena, u64 size, void* memoryPntr, u64 maxNumMarks, AllocAlignment_t alignment = AllocAlignment_None);
 	void InitMemArena_PagedStackArena(MemArena_t* arena, u64 pageSize, MemArena_t* sourceArena, u64 maxNumMarks, AllocAlignment_t alignment = AllocAlignment_None);
 	void InitMemArena_PagedStackFuncs(MemArena_t* arena, u64 pageSize, AllocationFunction_f* allocFunc, FreeFunction_f* freeFunc, u64 maxNumMarks, AllocAlignment_t alignment = AllocAlignment_None);
-	void InitMemArena_VirtualStack(MemArena_t* arena, u64 maxSize, u64 maxNumMarks, AllocAlignment_t alignment = AllocAlignment_None);
+	void InitMemArena_VirtualStack(MemArena_t* arena, u64 maxSize, u64 maxNumMarks, AllocAlignment_t alignment = AllocAlignment_None, bool useHugePages = false);
 	void InitMemArena_Buffer(MemArena_t* arena, u64 bufferSize, void* bufferPntr, bool singleAlloc = false, AllocAlignment_t alignment = AllocAlignment_None);
+	void InitMemArena_Slab(MemArena_t* arena, u64 pageSize, MemArena_t* sourceArena, u64 maxNumPages = 0, AllocAlignment_t alignment = AllocAlignment_None);
+	void InitMemArena_ThreadCached(MemArena_t* arena, MemArena_t* sourceArena, u64 magazineSize = THREAD_CACHE_DEFAULT_MAGAZINE_SIZE, AllocAlignment_t alignment = AllocAlignment_None);
+	void InitMemArena_Ring(MemArena_t* arena, u64 size, void* memoryPntr, u64 maxNumFrames, AllocAlignment_t alignment = AllocAlignment_None);
+	bool InitMemArena_MappedFile(MemArena_t* arena, const char* filePath, u64 maxSize, u64 maxNumMarks, bool copyOnWrite = false, void* desiredBase = nullptr, AllocAlignment_t alignment = AllocAlignment_None);
 	void UpdateMemArenaFuncPntrs(MemArena_t* arena, AllocationFunction_f* allocFunc, FreeFunction_f* freeFunc, ReallocFunction_f* reallocFunc = nullptr);
 	bool IsInitialized(const MemArena_t* arena);
 	bool DoesMemArenaSupportFreeing(MemArena_t* arena);
@@ -310,9 +683,14 @@ while(0)
 	bool TryGetAllocSize(const MemArena_t* arena, const void* allocPntr, u64* sizeOut = nullptr);
 	u64 GetAllocSize(const MemArena_t* arena, const void* allocPntr);
 	#if GYLIB_MEM_ARENA_DEBUG_ENABLED
-	void StoreAllocInfo(const MemArena_t* refArena, MemArena_t* arena, void* allocPntr, u64 allocSize, const char* filePath, u64 lineNumber, const char* funcName);
-	MemArenaAllocInfo_t* FindAllocInfoFor(MemArena_t* arena, void* allocPntr);
-	MemArenaAllocInfo_t* FindExtraAllocInfoInArena(MemArena_t* arena, MemArena_t* realArena);
+	u64 GetAllocInfoTableIndex(const MemArenaAllocInfoTable_t* table, const void* allocPntr);
+	void InsertAllocInfoIntoTable(MemArenaAllocInfoTable_t* table, const MemArenaAllocInfo_t* allocInfo);
+	void GrowAllocInfoTable(MemArena_t* arena, MemArenaAllocInfoTable_t* table);
+	void FreeAllocInfoTable(MemArena_t* refArena);
+	void StoreAllocInfo(MemArena_t* refArena, MemArena_t* arena, void* allocPntr, u64 allocSize, const char* filePath, u64 lineNumber, const char* funcName);
+	MemArenaAllocInfo_t* FindAllocInfoFor(const MemArena_t* refArena, const void* allocPntr);
+	MemArenaAllocInfo_t* FindAllocInfoForHeapSection(const MemArena_t* refArena, u8* afterPrefixPntr, u64 afterPrefixSize);
+	MemArenaAllocInfo_t* FindExtraAllocInfoInArena(MemArena_t* refArena);
 	void* FindMissingAllocInfoInArena(MemArena_t* arena, u64* allocSizeOut = nullptr);
 	void FreeAllocInfo(MemArena_t* refArena, MemArena_t* arena, void* allocPntr);
 	#endif
@@ -325,6 +703,25 @@ while(0)
 	void ShrinkMem(MemArena_t* arena, const void* prevAllocPntr, u64 prevAllocSize, u64 newAllocSize);
 	void FreeMemArena(MemArena_t* arena);
 	void ClearMemArena(MemArena_t* arena);
+	void FlushThreadCache(MemArena_t* arena);
+	void ReleaseThreadCache(MemArena_t* arena);
+	u64 GetCurrentRingFrame(const MemArena_t* arena);
+	u64 AdvanceRingFrame(MemArena_t* arena);
+	void RetireRingFrame(MemArena_t* arena, u64 frameId);
+	bool SyncMappedFileArena(MemArena_t* arena, bool waitForWrite = true);
+	u64 GetMappedFileOffset(const MemArena_t* arena, const void* pntr);
+	void* GetMappedFilePntr(const MemArena_t* arena, u64 offset);
+	void SetMappedFileRoot(MemArena_t* arena, const void* rootPntr);
+	void* GetMappedFileRoot(const MemArena_t* arena);
+	bool DidMappedFileRelocate(const MemArena_t* arena);
+	void EnableMemArenaHistograms(MemArena_t* arena, MemArenaHistograms_t* histograms);
+	void ResetMemArenaHistograms(MemArena_t* arena);
+	void TakeMemArenaHistogramsSnapshot(MemArena_t* arena, MemArenaHistograms_t* snapshotOut);
+	void DiffMemArenaHistogram(const MemArenaHistogram_t* before, const MemArenaHistogram_t* after, MemArenaHistogram_t* diffOut);
+	void DiffMemArenaHistograms(const MemArenaHistograms_t* before, const MemArenaHistograms_t* after, MemArenaHistograms_t* diffOut);
+	u64 GetMemArenaHistogramPercentile(const MemArenaHistogram_t* histogram, r64 percentile);
+	r64 GetMemArenaHistogramAverage(const MemArenaHistogram_t* histogram);
+	r64 GetMemArenaLatencyPercentile(const MemArenaHistograms_t* histograms, MemArenaOp_t arenaOp, r64 percentile);
 	u64 PushMemMark(MemArena_t* arena);
 	void PopMemMark(MemArena_t* arena, u64 mark = 0xFFFFFFFFFFFFFFFFULL);
 	char* PrintInArena(MemArena_t* arena, const char* formatString, ...);
@@ -343,12 +740,12 @@ bool IsAlignedTo(const void* memoryPntr, AllocAlignment_t alignment)
 	return ((address % (u64)alignment) == 0);
 }
 
-u8 OffsetToAlign(const void* memoryPntr, AllocAlignment_t alignment)
+u64 OffsetToAlign(const void* memoryPntr, AllocAlignment_t alignment)
 {
 	if (alignment == AllocAlignment_None) { return 0; }
 	u64 address = (u64)(memoryPntr);
 	if ((address % (u64)alignment) == 0) { return 0; }
-	else { return (u8)alignment - (u8)(address % (u64)alignment); }
+	else { return (u64)alignment - (address % (u64)alignment); }
 }
 
 bool IsPntrInsideRange(const void* testPntr, const void* rangeBase, u64 rangeSize, bool inclusive = false)
@@ -359,131 +756,808 @@ bool IsPntrInsideRange(const void* testPntr, const void* rangeBase, u64 rangeSiz
 	return true;
 }
 
-// +--------------------------------------------------------------+
-// |                        Init Functions                        |
-// +--------------------------------------------------------------+
-void InitMemArena_Redirect(MemArena_t* arena, AllocationFunction_f* allocFunc, FreeFunction_f* freeFunc, ReallocFunction_f* reallocFunc = nullptr)
+// +==============================+
+// |      Histogram Helpers       |
+// +==============================+
+u64 GetMemArenaHistogramBucket(u64 value)
 {
-	NotNull(arena);
-	NotNull(allocFunc);
-	ClearPointer(arena);
-	arena->type = MemArenaType_Redirect;
-	arena->allocFunc = allocFunc;
-	arena->reallocFunc = reallocFunc;
-	arena->freeFunc = freeFunc;
-	arena->used = 0; //NOTE: This only tracks allocations, not deallocations, so it only goes up
-	arena->numAllocations = 0;
-	
-	FlagSet(arena->flags, MemArenaFlag_TelemetryEnabled);
-	arena->highAllocMark = arena->numAllocations;
+	if (value < (1ULL << MEM_ARENA_HISTOGRAM_SUB_BITS)) { return value; }
+	u8 msbIndex = FindMsbIndexU64(value);
+	u64 subIndex = (value >> (msbIndex - MEM_ARENA_HISTOGRAM_SUB_BITS)) & ((1ULL << MEM_ARENA_HISTOGRAM_SUB_BITS) - 1);
+	return ((u64)(msbIndex - MEM_ARENA_HISTOGRAM_SUB_BITS + 1) << MEM_ARENA_HISTOGRAM_SUB_BITS) + subIndex;
 }
-void InitMemArena_Alias(MemArena_t* arena, MemArena_t* sourceArena)
+//Smallest value that lands in the bucket
+u64 GetMemArenaHistogramBucketMin(u64 bucketIndex)
 {
-	NotNull(arena);
-	NotNull(sourceArena);
-	ClearPointer(arena);
-	arena->type = MemArenaType_Alias;
-	arena->sourceArena = sourceArena;
-	arena->used = 0; //NOTE: This MAY not track deallocations, it depends on if the sourceArena supports returning the size on FreeMem
-	arena->numAllocations = 0;
-	
-	FlagSet(arena->flags, MemArenaFlag_TelemetryEnabled);
-	arena->highUsedMark = arena->used;
-	arena->resettableHighUsedMark = arena->used;
-	arena->highAllocMark = arena->numAllocations;
+	Assert(bucketIndex < MEM_ARENA_HISTOGRAM_NUM_BUCKETS);
+	if (bucketIndex < (1ULL << MEM_ARENA_HISTOGRAM_SUB_BITS)) { return bucketIndex; }
+	u64 shift = (bucketIndex >> MEM_ARENA_HISTOGRAM_SUB_BITS) - 1;
+	u64 subIndex = bucketIndex & ((1ULL << MEM_ARENA_HISTOGRAM_SUB_BITS) - 1);
+	return (((1ULL << MEM_ARENA_HISTOGRAM_SUB_BITS) + subIndex) << shift);
 }
-void InitMemArena_StdHeap(MemArena_t* arena)
+//Largest value that lands in the bucket
+u64 GetMemArenaHistogramBucketMax(u64 bucketIndex)
 {
-	NotNull(arena);
-	ClearPointer(arena);
-	arena->type = MemArenaType_StdHeap;
-	arena->used = 0; //NOTE: This only tracks allocations, not deallocations, so it only goes up
-	arena->numAllocations = 0;
-	
-	FlagSet(arena->flags, MemArenaFlag_TelemetryEnabled);
-	arena->highAllocMark = arena->numAllocations;
+	if (bucketIndex + 1 >= MEM_ARENA_HISTOGRAM_NUM_BUCKETS) { return UINT64_MAX; }
+	return GetMemArenaHistogramBucketMin(bucketIndex + 1) - 1;
 }
-void InitMemArena_FixedHeap(MemArena_t* arena, u64 size, void* memoryPntr, AllocAlignment_t alignment = AllocAlignment_None)
+
+void AddToMemArenaHistogram(MemArenaHistogram_t* histogram, u64 value)
 {
-	NotNull(arena);
-	u64 prefixSize = sizeof(HeapAllocPrefix_t);
-	Assert(size > prefixSize);
-	NotNull(memoryPntr);
-	Assert(IsAlignedTo(memoryPntr, alignment));
-	ClearPointer(arena);
-	arena->type = MemArenaType_FixedHeap;
-	arena->alignment = alignment;
-	arena->mainPntr = memoryPntr;
-	arena->size = size;
-	HeapAllocPrefix_t* firstAlloc = (HeapAllocPrefix_t*)arena->mainPntr;
-	ClearPointer(firstAlloc);
-	firstAlloc->size = PackAllocPrefixSize(false, arena->size);
-	arena->used = prefixSize;
-	arena->numAllocations = 0;
-	
-	FlagSet(arena->flags, MemArenaFlag_TelemetryEnabled);
-	arena->highUsedMark = arena->used;
-	arena->resettableHighUsedMark = arena->used;
-	arena->highAllocMark = arena->numAllocations;
+	NotNull(histogram);
+	if (histogram->count == 0 || histogram->minValue > value) { histogram->minValue = value; }
+	if (histogram->count == 0 || histogram->maxValue < value) { histogram->maxValue = value; }
+	histogram->count++;
+	histogram->total += value;
+	histogram->buckets[GetMemArenaHistogramBucket(value)]++;
 }
-void InitMemArena_PagedHeapFuncs(MemArena_t* arena, u64 pageSize, AllocationFunction_f* allocFunc, FreeFunction_f* freeFunc, u64 maxNumPages = 0, AllocAlignment_t alignment = AllocAlignment_None)
+
+//Called right before the arena's mutex is unlocked (or with the sourceMutex held for ThreadCached arenas) so we don't need our own lock. allocSize is only recorded for Alloc and Realloc
+void RecordMemArenaHistograms(MemArena_t* arena, MemArenaOp_t arenaOp, const PerfTime_t* startTime, u64 allocSize)
 {
-	NotNull(arena);
-	NotNull(allocFunc);
-	ClearPointer(arena);
-	arena->type = MemArenaType_PagedHeap;
-	arena->alignment = alignment;
-	arena->pageSize = pageSize;
-	arena->maxNumPages = maxNumPages;
-	arena->allocFunc = allocFunc;
-	arena->freeFunc = freeFunc;
-	FlagSet(arena->flags, MemArenaFlag_AutoFreePages);
-	arena->size = 0;
-	arena->used = 0;
-	arena->numPages = 0;
-	arena->numAllocations = 0;
-	arena->headerPntr = nullptr;
-	arena->mainPntr = nullptr;
-	arena->otherPntr = nullptr;
-	FlagSet(arena->flags, MemArenaFlag_TelemetryEnabled);
-	arena->highUsedMark = 0;
-	arena->resettableHighUsedMark = 0;
-	arena->highAllocMark = 0;
+	NotNull3(arena, arena->histograms, startTime);
+	Assert(arenaOp < MemArenaOp_NumOps);
+	PerfTime_t endTime = GetPerfTime();
+	PerfTimeTotal_t elapsed = {};
+	AddToPerfTimeTotal(startTime, &endTime, &elapsed);
+	AddToMemArenaHistogram(&arena->histograms->latencies[arenaOp], elapsed.totalCounterAmount);
+	if (arenaOp == MemArenaOp_Alloc || arenaOp == MemArenaOp_Realloc) { AddToMemArenaHistogram(&arena->histograms->allocSizes, allocSize); }
 }
-void InitMemArena_PagedHeapArena(MemArena_t* arena, u64 pageSize, MemArena_t* sourceArena, u64 maxNumPages = 0, AllocAlignment_t alignment = AllocAlignment_None)
+
+// +==============================+
+// |         Slab Helpers         |
+// +==============================+
+//Returns SLAB_NUM_SIZE_CLASSES if the allocation is too big (or too aligned) for any size class
+u64 GetSlabSizeClass(u64 numBytes, AllocAlignment_t alignment)
 {
-	ClearPointer(arena);
-	arena->type = MemArenaType_PagedHeap;
-	arena->alignment = alignment;
-	arena->pageSize = pageSize;
-	arena->maxNumPages = maxNumPages;
-	arena->sourceArena = sourceArena;
-	arena->size = 0;
-	arena->used = 0;
-	arena->numPages = 0;
-	arena->numAllocations = 0;
-	arena->headerPntr = nullptr;
-	arena->mainPntr = nullptr;
-	arena->otherPntr = nullptr;
-	FlagSet(arena->flags, MemArenaFlag_TelemetryEnabled);
-	arena->highUsedMark = 0;
-	arena->resettableHighUsedMark = 0;
-	arena->highAllocMark = 0;
+	if (alignment > AllocAlignment_Max) { return SLAB_NUM_SIZE_CLASSES; } //slots are only aligned to AllocAlignment_Max
+	u64 neededSize = MaxU64(numBytes, (u64)alignment);
+	if (neededSize <= SLAB_MIN_SLOT_SIZE) { return 0; }
+	if (neededSize > SLAB_MAX_SLOT_SIZE) { return SLAB_NUM_SIZE_CLASSES; }
+	return (u64)FindMsbIndexU64(neededSize - 1) + 1 - SLAB_MIN_SLOT_SIZE_POWER;
 }
-void InitMemArena_MarkedStack(MemArena_t* arena, u64 size, void* memoryPntr, u64 maxNumMarks, AllocAlignment_t alignment = AllocAlignment_None)
+
+//Distance from the start of a sourceArena allocation to the passthrough block we hand out, leaves room for the prefix and keeps the alignment
+u64 GetSlabPassthroughRawOffset(AllocAlignment_t alignment)
 {
-	NotNull(arena);
-	NotNull(memoryPntr);
-	Assert(size > 0);
-	Assert(maxNumMarks > 0);
-	Assert(size > sizeof(MarkedStackArenaHeader_t) + (maxNumMarks * sizeof(u64)));
+	return MaxU64(sizeof(SlabPassthroughPrefix_t), (u64)alignment);
+}
+
+//Returns the index of the first page that starts after the pntr (so the owning page, if any, is at index-1)
+u64 FindSlabPageUpperBound(const MemArena_t* arena, const void* pntr)
+{
+	const SlabArenaHeader_t* slabHeader = (const SlabArenaHeader_t*)arena->headerPntr;
+	u64 lowIndex = 0;
+	u64 highIndex = arena->numPages;
+	while (lowIndex < highIndex)
+	{
+		u64 midIndex = lowIndex + (highIndex - lowIndex) / 2;
+		if ((const u8*)slabHeader->pages[midIndex] <= (const u8*)pntr) { lowIndex = midIndex + 1; }
+		else { highIndex = midIndex; }
+	}
+	return lowIndex;
+}
+
+//Returns nullptr if the pntr isn't inside any of our pages (i.e. it was passed through to the sourceArena)
+SlabPageHeader_t* FindSlabPageFor(const MemArena_t* arena, const void* allocPntr)
+{
+	NotNull2(arena, arena->headerPntr);
+	const SlabArenaHeader_t* slabHeader = (const SlabArenaHeader_t*)arena->headerPntr;
+	u64 pageIndex = FindSlabPageUpperBound(arena, allocPntr);
+	if (pageIndex == 0) { return nullptr; }
+	SlabPageHeader_t* pageHeader = slabHeader->pages[pageIndex-1];
+	if (!IsPntrInsideRange(allocPntr, pageHeader, pageHeader->pageSize)) { return nullptr; }
+	return pageHeader;
+}
+
+//Allocates a page from the sourceArena, inserts it into the sorted page list, and makes it the carve page for sizeClass
+SlabPageHeader_t* AllocSlabPage(MemArena_t* arena, u64 sizeClass)
+{
+	NotNull3(arena, arena->headerPntr, arena->sourceArena);
+	Assert(sizeClass < SLAB_NUM_SIZE_CLASSES);
+	SlabArenaHeader_t* slabHeader = (SlabArenaHeader_t*)arena->headerPntr;
+	if (arena->maxNumPages > 0 && arena->numPages >= arena->maxNumPages) { return nullptr; }
 	
-	ClearPointer(arena);
-	arena->type = MemArenaType_MarkedStack;
-	arena->alignment = alignment;
-	arena->headerPntr = (((u8*)memoryPntr) + 0);
-	arena->otherPntr  = (((u8*)memoryPntr) + sizeof(MarkedStackArenaHeader_t));
-	arena->mainPntr   = (((u8*)memoryPntr) + sizeof(MarkedStackArenaHeader_t) + (maxNumMarks * sizeof(u64)));
+	if (arena->numPages >= slabHeader->pageListSize)
+	{
+		u64 newPageListSize = MaxU64(SLAB_PAGE_LIST_MIN_SIZE, slabHeader->pageListSize * 2);
+		SlabPageHeader_t** newPageList = AllocArray(arena->sourceArena, SlabPageHeader_t*, newPageListSize);
+		if (newPageList == nullptr) { return nullptr; }
+		if (slabHeader->pages != nullptr)
+		{
+			if (arena->numPages > 0) { MyMemCopy(newPageList, slabHeader->pages, sizeof(SlabPageHeader_t*) * arena->numPages); }
+			FreeMem(arena->sourceArena, slabHeader->pages, sizeof(SlabPageHeader_t*) * slabHeader->pageListSize);
+		}
+		slabHeader->pages = newPageList;
+		slabHeader->pageListSize = newPageListSize;
+	}
+	
+	u8* pageBytes = (u8*)AllocMem(arena->sourceArena, arena->pageSize);
+	if (pageBytes == nullptr) { return nullptr; }
+	SlabPageHeader_t* newPage = (SlabPageHeader_t*)pageBytes;
+	ClearPointer(newPage);
+	newPage->sizeClass = sizeClass;
+	newPage->slotSize = (SLAB_MIN_SLOT_SIZE << sizeClass);
+	newPage->pageSize = arena->pageSize;
+	newPage->slotsBase = pageBytes + sizeof(SlabPageHeader_t);
+	newPage->slotsBase += OffsetToAlign(newPage->slotsBase, AllocAlignment_Max);
+	newPage->numSlots = (u64)((pageBytes + arena->pageSize) - newPage->slotsBase) / newPage->slotSize;
+	Assert(newPage->numSlots > 0);
+	
+	u64 insertIndex = FindSlabPageUpperBound(arena, newPage);
+	if (insertIndex < arena->numPages)
+	{
+		MyMemMove(&slabHeader->pages[insertIndex+1], &slabHeader->pages[insertIndex], sizeof(SlabPageHeader_t*) * (arena->numPages - insertIndex));
+	}
+	slabHeader->pages[insertIndex] = newPage;
+	arena->numPages++;
+	arena->size += newPage->numSlots * newPage->slotSize;
+	
+	slabHeader->carvePntrs[sizeClass] = newPage->slotsBase;
+	slabHeader->carveEnds[sizeClass] = newPage->slotsBase + (newPage->numSlots * newPage->slotSize);
+	return newPage;
+}
+
+// +==============================+
+// |         Ring Helpers         |
+// +==============================+
+//Only valid for pntrs in the live part of the ring. Each offset maps to exactly one position between tailPos and tailPos+size
+u64 GetRingAllocPos(const MemArena_t* arena, const void* allocPntr)
+{
+	const RingArenaHeader_t* ringHeader = (const RingArenaHeader_t*)arena->headerPntr;
+	u64 allocOffset = (u64)((const u8*)allocPntr - (const u8*)arena->mainPntr);
+	u64 tailOffset = ringHeader->tailPos % arena->size;
+	return ringHeader->tailPos + ((allocOffset >= tailOffset) ? (allocOffset - tailOffset) : (arena->size - tailOffset + allocOffset));
+}
+//Returns nullptr if the position is not inside any live frame
+RingArenaFrame_t* FindRingFrameFor(const MemArena_t* arena, u64 allocPos)
+{
+	const RingArenaHeader_t* ringHeader = (const RingArenaHeader_t*)arena->headerPntr;
+	RingArenaFrame_t* frames = (RingArenaFrame_t*)arena->otherPntr;
+	if (allocPos < ringHeader->tailPos || allocPos >= ringHeader->headPos) { return nullptr; }
+	//Walk from newest to oldest, there's usually only 2 or 3 live frames
+	for (u64 frameId = ringHeader->currentFrameId + 1; frameId > ringHeader->oldestFrameId; frameId--)
+	{
+		RingArenaFrame_t* frame = &frames[(frameId-1) % ringHeader->maxNumFrames];
+		if (frame->startPos <= allocPos) { return frame; }
+	}
+	return nullptr;
+}
+
+// +==============================+
+// |      StdHeap Remapping       |
+// +==============================+
+#if STD_HEAP_REMAP_SUPPORTED
+StdHeapMappedPrefix_t* volatile StdHeapMappedAllocs[STD_HEAP_MAX_MAPPED_ALLOCS] = {};
+
+//Returns nullptr if the allocation came from malloc. This never reads the memory around allocPntr, malloc'd pointers can sit anywhere in a page
+StdHeapMappedPrefix_t* GetStdHeapMappedPrefix(const void* allocPntr)
+{
+	if (allocPntr == nullptr) { return nullptr; }
+	//Our allocations always sit right after the prefix at the start of a page, so most malloc'd pointers don't need to search the table
+	if (((u64)allocPntr % OsGetMemoryPageSize()) != sizeof(StdHeapMappedPrefix_t)) { return nullptr; }
+	const StdHeapMappedPrefix_t* prefix = ((const StdHeapMappedPrefix_t*)allocPntr) - 1;
+	for (u64 mIndex = 0; mIndex < STD_HEAP_MAX_MAPPED_ALLOCS; mIndex++)
+	{
+		if (StdHeapMappedAllocs[mIndex] == prefix) { return StdHeapMappedAllocs[mIndex]; }
+	}
+	return nullptr;
+}
+
+//Returns nullptr if the mapping failed or the table is full, callers should fall back to malloc
+u8* AllocStdHeapMapped(u64 numBytes)
+{
+	u64 mappedSize = RoundUpToU64(sizeof(StdHeapMappedPrefix_t) + numBytes, OsGetMemoryPageSize());
+	StdHeapMappedPrefix_t* prefix = (StdHeapMappedPrefix_t*)OsReserveMemory(mappedSize);
+	if (prefix == nullptr) { return nullptr; }
+	prefix->mappedSize = mappedSize;
+	for (u64 mIndex = 0; mIndex < STD_HEAP_MAX_MAPPED_ALLOCS; mIndex++)
+	{
+		if (StdHeapMappedAllocs[mIndex] == nullptr && ThreadSafeCompareExchangePntr(&StdHeapMappedAllocs[mIndex], prefix, nullptr) == nullptr)
+		{
+			prefix->tableIndex = mIndex;
+			return (u8*)(prefix + 1);
+		}
+	}
+	OsFreeReservedMemory(prefix, mappedSize);
+	return nullptr;
+}
+
+void FreeStdHeapMapped(StdHeapMappedPrefix_t* prefix)
+{
+	NotNull(prefix);
+	Assert(prefix->tableIndex < STD_HEAP_MAX_MAPPED_ALLOCS && StdHeapMappedAllocs[prefix->tableIndex] == prefix);
+	u64 mappedSize = prefix->mappedSize;
+	StdHeapMappedAllocs[prefix->tableIndex] = nullptr;
+	OsFreeReservedMemory(prefix, mappedSize);
+}
+
+//Returns nullptr (and leaves the allocation alone) if the mapping couldn't be resized, which can happen when !allowMove and the neighboring address space is taken
+u8* ResizeStdHeapMapped(StdHeapMappedPrefix_t* prefix, u64 newSize, bool allowMove)
+{
+	NotNull(prefix);
+	u64 newMappedSize = RoundUpToU64(sizeof(StdHeapMappedPrefix_t) + newSize, OsGetMemoryPageSize());
+	if (newMappedSize == prefix->mappedSize) { return (u8*)(prefix + 1); }
+	StdHeapMappedPrefix_t* newPrefix = (StdHeapMappedPrefix_t*)OsRemapMemory(prefix, prefix->mappedSize, newMappedSize, allowMove);
+	if (newPrefix == nullptr) { return nullptr; }
+	newPrefix->mappedSize = newMappedSize;
+	StdHeapMappedAllocs[newPrefix->tableIndex] = newPrefix; //only we ever touch our own slot, so this doesn't need to be atomic
+	return (u8*)(newPrefix + 1);
+}
+#endif //STD_HEAP_REMAP_SUPPORTED
+
+// +==============================+
+// |       Heap Free Index        |
+// +==============================+
+u64 GetHeapSectionSizeFor(u64 numBytes, u64 alignOffset)
+{
+	return MaxU64(RoundUpToU64(sizeof(HeapAllocPrefix_t) + alignOffset + numBytes, HEAP_SECTION_GRANULARITY), HEAP_MIN_SECTION_SIZE);
+}
+
+//If a PagedHeap allocation needed an alignment offset we store that offset in the byte right before the allocation.
+//Otherwise that byte is the top byte of the prefix which always has HEAP_ALLOC_FILLED_FLAG set (this assumes little-endian)
+HeapAllocPrefix_t* GetHeapAllocPrefix(const void* allocPntr)
+{
+	u8 markerByte = ((const u8*)allocPntr)[-1];
+	u64 alignOffset = ((markerByte & 0x80) != 0) ? 0 : markerByte;
+	return (HeapAllocPrefix_t*)(((u8*)allocPntr) - alignOffset - sizeof(HeapAllocPrefix_t));
+}
+
+//Returns nullptr if the pntr isn't inside any of the pages in this PagedHeap
+HeapPageHeader_t* FindHeapPageFor(const MemArena_t* arena, const void* pntr)
+{
+	HeapPageHeader_t* pageHeader = (HeapPageHeader_t*)arena->headerPntr;
+	while (pageHeader != nullptr)
+	{
+		if (IsPntrInsideRange(pntr, pageHeader + 1, pageHeader->size)) { return pageHeader; }
+		pageHeader = pageHeader->next;
+	}
+	return nullptr;
+}
+
+void GetHeapFreeIndexMapping(u64 sectionSize, u64* firstLevelOut, u64* secondLevelOut)
+{
+	if (sectionSize < (1ULL << HEAP_FREE_INDEX_FL_SHIFT))
+	{
+		*firstLevelOut = 0;
+		*secondLevelOut = sectionSize / HEAP_SECTION_GRANULARITY;
+	}
+	else
+	{
+		u64 msbIndex = FindMsbIndexU64(sectionSize);
+		*firstLevelOut = msbIndex - (HEAP_FREE_INDEX_FL_SHIFT - 1);
+		*secondLevelOut = (sectionSize >> (msbIndex - HEAP_FREE_INDEX_SL_LOG2)) ^ HEAP_FREE_INDEX_SL_COUNT;
+	}
+}
+
+//Also writes the footer and sets HEAP_ALLOC_PREV_FREE_FLAG on the following section
+void InsertHeapFreeSection(HeapFreeIndex_t* freeIndex, HeapAllocPrefix_t* prefixPntr)
+{
+	NotNull2(freeIndex, prefixPntr);
+	u64 sectionSize = UnpackAllocPrefixSize(prefixPntr->size);
+	DebugAssert(!IsAllocPrefixFilled(prefixPntr->size));
+	DebugAssert(sectionSize >= HEAP_MIN_SECTION_SIZE && (sectionSize % HEAP_SECTION_GRANULARITY) == 0);
+	*((u64*)(((u8*)prefixPntr) + sectionSize - sizeof(u64))) = sectionSize;
+	HeapAllocPrefix_t* nextPrefix = (HeapAllocPrefix_t*)(((u8*)prefixPntr) + sectionSize);
+	FlagSet(nextPrefix->size, HEAP_ALLOC_PREV_FREE_FLAG);
+	
+	u64 firstLevel, secondLevel;
+	GetHeapFreeIndexMapping(sectionSize, &firstLevel, &secondLevel);
+	AssertMsg(firstLevel < HEAP_FREE_INDEX_FL_COUNT, "PagedHeap section is too large for the free index");
+	HeapFreeSection_t* section = (HeapFreeSection_t*)prefixPntr;
+	section->prevFree = nullptr;
+	section->nextFree = freeIndex->lists[firstLevel][secondLevel];
+	if (section->nextFree != nullptr) { section->nextFree->prevFree = section; }
+	freeIndex->lists[firstLevel][secondLevel] = section;
+	FlagSet(freeIndex->secondLevelBitmaps[firstLevel], (u16)(1 << secondLevel));
+	FlagSet(freeIndex->firstLevelBitmap, (1ULL << firstLevel));
+}
+
+//The links are passed separately because GrowMem needs to remove a section that may have already been overwritten
+void UnlinkHeapFreeSection(HeapFreeIndex_t* freeIndex, const void* sectionPntr, u64 sectionSize, HeapFreeSection_t* nextFree, HeapFreeSection_t* prevFree)
+{
+	NotNull2(freeIndex, sectionPntr);
+	u64 firstLevel, secondLevel;
+	GetHeapFreeIndexMapping(sectionSize, &firstLevel, &secondLevel);
+	Assert(firstLevel < HEAP_FREE_INDEX_FL_COUNT);
+	if (prevFree != nullptr) { prevFree->nextFree = nextFree; }
+	else
+	{
+		AssertMsg(freeIndex->lists[firstLevel][secondLevel] == sectionPntr, "PagedHeap free index is corrupt. Section without a prevFree was not at the head of it's list");
+		freeIndex->lists[firstLevel][secondLevel] = nextFree;
+	}
+	if (nextFree != nullptr) { nextFree->prevFree = prevFree; }
+	if (freeIndex->lists[firstLevel][secondLevel] == nullptr)
+	{
+		FlagUnset(freeIndex->secondLevelBitmaps[firstLevel], (u16)(1 << secondLevel));
+		if (freeIndex->secondLevelBitmaps[firstLevel] == 0) { FlagUnset(freeIndex->firstLevelBitmap, (1ULL << firstLevel)); }
+	}
+}
+void RemoveHeapFreeSection(HeapFreeIndex_t* freeIndex, HeapAllocPrefix_t* prefixPntr)
+{
+	HeapFreeSection_t* section = (HeapFreeSection_t*)prefixPntr;
+	UnlinkHeapFreeSection(freeIndex, section, UnpackAllocPrefixSize(prefixPntr->size), section->nextFree, section->prevFree);
+}
+
+//Finds and removes a free section that is at least minSectionSize. Returns nullptr if there isn't one
+HeapAllocPrefix_t* TakeHeapFreeSection(HeapFreeIndex_t* freeIndex, u64 minSectionSize)
+{
+	NotNull(freeIndex);
+	//Round up to the next list so that any section in the list we land on is big enough
+	u64 searchSize = minSectionSize;
+	if (searchSize >= (1ULL << HEAP_FREE_INDEX_FL_SHIFT)) { searchSize += (1ULL << (FindMsbIndexU64(searchSize) - HEAP_FREE_INDEX_SL_LOG2)) - 1; }
+	u64 firstLevel, secondLevel;
+	GetHeapFreeIndexMapping(searchSize, &firstLevel, &secondLevel);
+	if (firstLevel >= HEAP_FREE_INDEX_FL_COUNT) { return nullptr; }
+	
+	u64 secondLevelMap = (u64)freeIndex->secondLevelBitmaps[firstLevel] & (~0ULL << secondLevel);
+	if (secondLevelMap == 0)
+	{
+		u64 firstLevelMap = freeIndex->firstLevelBitmap & (~0ULL << (firstLevel + 1));
+		if (firstLevelMap == 0) { return nullptr; }
+		firstLevel = FindLsbIndexU64(firstLevelMap);
+		secondLevelMap = (u64)freeIndex->secondLevelBitmaps[firstLevel];
+		Assert(secondLevelMap != 0);
+	}
+	secondLevel = FindLsbIndexU64(secondLevelMap);
+	HeapFreeSection_t* section = freeIndex->lists[firstLevel][secondLevel];
+	NotNull(section);
+	RemoveHeapFreeSection(freeIndex, &section->prefix);
+	return &section->prefix;
+}
+
+//Marks a filled section as free, merges it with any free neighbors, and puts the result in the free index.
+//Returns the prefix of the (possibly merged) free section
+HeapAllocPrefix_t* FreeHeapSection(MemArena_t* arena, HeapAllocPrefix_t* prefixPntr)
+{
+	NotNull2(arena->otherPntr, prefixPntr);
+	HeapFreeIndex_t* freeIndex = (HeapFreeIndex_t*)arena->otherPntr;
+	u64 sectionSize = UnpackAllocPrefixSize(prefixPntr->size);
+	u64 firstFlag = (prefixPntr->size & HEAP_ALLOC_FIRST_FLAG);
+	
+	HeapAllocPrefix_t* nextPrefix = (HeapAllocPrefix_t*)(((u8*)prefixPntr) + sectionSize);
+	if (!IsAllocPrefixFilled(nextPrefix->size)) //the sentinel at the end of the page is always filled
+	{
+		RemoveHeapFreeSection(freeIndex, nextPrefix);
+		sectionSize += UnpackAllocPrefixSize(nextPrefix->size);
+		AssertMsg(arena->used >= sizeof(HeapAllocPrefix_t), "Paged Heap used tracker was corrupted. Reached 0 too soon.");
+		arena->used -= sizeof(HeapAllocPrefix_t);
+	}
+	if (IsFlagSet(prefixPntr->size, HEAP_ALLOC_PREV_FREE_FLAG))
+	{
+		u64 prevSectionSize = *(((u64*)prefixPntr) - 1);
+		HeapAllocPrefix_t* prevPrefix = (HeapAllocPrefix_t*)(((u8*)prefixPntr) - prevSectionSize);
+		AssertMsg(!IsAllocPrefixFilled(prevPrefix->size) && UnpackAllocPrefixSize(prevPrefix->size) == prevSectionSize, "Paged Heap footer of the previous section doesn't match it's prefix. Did someone write out of bounds?");
+		RemoveHeapFreeSection(freeIndex, prevPrefix);
+		firstFlag = (prevPrefix->size & HEAP_ALLOC_FIRST_FLAG);
+		sectionSize += prevSectionSize;
+		prefixPntr = prevPrefix;
+		AssertMsg(arena->used >= sizeof(HeapAllocPrefix_t), "Paged Heap used tracker was corrupted. Reached 0 too soon.");
+		arena->used -= sizeof(HeapAllocPrefix_t);
+	}
+	
+	prefixPntr->size = PackAllocPrefixSize(false, sectionSize) | firstFlag;
+	InsertHeapFreeSection(freeIndex, prefixPntr);
+	return prefixPntr;
+}
+
+//The free index is allocated alongside the first page and lives in arena->otherPntr
+HeapFreeIndex_t* GetHeapFreeIndex(MemArena_t* arena)
+{
+	if (arena->otherPntr == nullptr)
+	{
+		HeapFreeIndex_t* newIndex = nullptr;
+		if (arena->sourceArena != nullptr) { newIndex = AllocStruct(arena->sourceArena, HeapFreeIndex_t); }
+		else if (arena->allocFunc != nullptr) { newIndex = (HeapFreeIndex_t*)arena->allocFunc(sizeof(HeapFreeIndex_t)); }
+		else { AssertMsg(false, "sourceArena and allocFunc are both not filled!"); }
+		if (newIndex == nullptr) { return nullptr; }
+		ClearPointer(newIndex);
+		arena->otherPntr = newIndex;
+	}
+	return (HeapFreeIndex_t*)arena->otherPntr;
+}
+
+//Returns the single free section that fills the new page. It is NOT put into the free index
+HeapAllocPrefix_t* AllocHeapPage(MemArena_t* arena, u64 minSectionSize)
+{
+	if (arena->maxNumPages != 0 && arena->numPages >= arena->maxNumPages) { return nullptr; }
+	u64 newPageSize = RoundUpToU64(MaxU64(arena->pageSize, minSectionSize), HEAP_SECTION_GRANULARITY);
+	u64 pageAllocSize = sizeof(HeapPageHeader_t) + newPageSize + sizeof(HeapAllocPrefix_t);
+	
+	HeapPageHeader_t* newPageHeader = nullptr;
+	if (arena->sourceArena != nullptr)
+	{
+		DebugAssert(arena->sourceArena != arena);
+		//NOTE: Intentionally not putting the onus on the sourceArena to align the page. We will align allocations inside the page as requested
+		newPageHeader = (HeapPageHeader_t*)AllocMem(arena->sourceArena, pageAllocSize);
+	}
+	else if (arena->allocFunc != nullptr)
+	{
+		newPageHeader = (HeapPageHeader_t*)arena->allocFunc(pageAllocSize);
+	}
+	else { AssertMsg(false, "sourceArena and allocFunc are both not filled!"); }
+	if (newPageHeader == nullptr) { return nullptr; }
+	
+	ClearPointer(newPageHeader);
+	newPageHeader->size = newPageSize;
+	//New pages go right after the first page so we don't have to walk the list (the first page is never auto-freed)
+	HeapPageHeader_t* firstPageHeader = (HeapPageHeader_t*)arena->headerPntr;
+	if (firstPageHeader == nullptr)
+	{
+		Assert(arena->numPages == 0);
+		arena->headerPntr = newPageHeader;
+	}
+	else
+	{
+		newPageHeader->prev = firstPageHeader;
+		newPageHeader->next = firstPageHeader->next;
+		if (firstPageHeader->next != nullptr) { firstPageHeader->next->prev = newPageHeader; }
+		firstPageHeader->next = newPageHeader;
+	}
+	arena->numPages++;
+	arena->size += newPageSize;
+	arena->used += sizeof(HeapAllocPrefix_t);
+	
+	//The sentinel is a zero-sized filled section right after the end of the page so we never try to merge past the end
+	u8* pageBase = (u8*)(newPageHeader + 1);
+	HeapAllocPrefix_t* sentinelPrefix = (HeapAllocPrefix_t*)(pageBase + newPageSize);
+	sentinelPrefix->size = PackAllocPrefixSize(true, 0) | HEAP_ALLOC_PREV_FREE_FLAG;
+	HeapAllocPrefix_t* firstSection = (HeapAllocPrefix_t*)pageBase;
+	firstSection->size = PackAllocPrefixSize(false, newPageSize) | HEAP_ALLOC_FIRST_FLAG;
+	return firstSection;
+}
+
+//Only gives the memory back, doesn't unlink the page or change any arena stats
+void ReleaseHeapPage(MemArena_t* arena, HeapPageHeader_t* pageHeader)
+{
+	if (arena->sourceArena != nullptr)
+	{
+		FreeMem(arena->sourceArena, pageHeader, sizeof(HeapPageHeader_t) + pageHeader->size + sizeof(HeapAllocPrefix_t));
+	}
+	else if (arena->freeFunc != nullptr)
+	{
+		arena->freeFunc(pageHeader);
+	}
+	else
+	{
+		AssertMsg(false, "This PagedHeap page cannot be freed because the arena doesn't have a sourceArena or freeFunc pointer!");
+	}
+}
+
+// +==============================+
+// |     Thread Cache Helpers     |
+// +==============================+
+u64 ThreadCacheNextArenaId = 0;
+volatile u64 ThreadCacheLiveArenaIds[THREAD_CACHE_MAX_LIVE_ARENAS] = {}; //0 means the slot is empty, arenaIds start at 1
+thread_local ThreadCacheTlsEntry_t ThreadCacheTlsEntries[THREAD_CACHE_MAX_ARENAS_PER_THREAD] = {};
+
+//Distance from the start of a sourceArena allocation to the block we hand out, leaves room for the prefix and keeps the alignment
+u64 GetThreadCacheRawOffset(AllocAlignment_t alignment)
+{
+	return MaxU64(sizeof(ThreadCacheBlockPrefix_t), (u64)alignment);
+}
+
+void RegisterThreadCacheArenaId(u64 arenaId)
+{
+	Assert(arenaId != 0);
+	for (u64 lIndex = 0; lIndex < THREAD_CACHE_MAX_LIVE_ARENAS; lIndex++)
+	{
+		if (ThreadCacheLiveArenaIds[lIndex] == 0 && ThreadSafeCompareExchangeU64(&ThreadCacheLiveArenaIds[lIndex], arenaId, 0) == 0) { return; }
+	}
+	AssertMsg(false, "Too many ThreadCached arenas exist at once. Increase THREAD_CACHE_MAX_LIVE_ARENAS");
+}
+void UnregisterThreadCacheArenaId(u64 arenaId)
+{
+	for (u64 lIndex = 0; lIndex < THREAD_CACHE_MAX_LIVE_ARENAS; lIndex++)
+	{
+		if (ThreadCacheLiveArenaIds[lIndex] == arenaId) { ThreadCacheLiveArenaIds[lIndex] = 0; ThreadingWriteBarrier(); return; }
+	}
+}
+//Only looks at the global table, never at the arena itself, so it's safe to call with the arenaId of an arena that has already been freed
+bool IsThreadCacheArenaIdLive(u64 arenaId)
+{
+	ThreadingReadBarrier();
+	for (u64 lIndex = 0; lIndex < THREAD_CACHE_MAX_LIVE_ARENAS; lIndex++)
+	{
+		if (ThreadCacheLiveArenaIds[lIndex] == arenaId) { return true; }
+	}
+	return false;
+}
+
+//Also folds the calling thread's stats into the arena (cache can be nullptr)
+void LockThreadCacheSource(MemArena_t* arena, ThreadCache_t* cache)
+{
+	ThreadCacheArenaHeader_t* cacheHeader = (ThreadCacheArenaHeader_t*)arena->headerPntr;
+	if (IsValidGyMutex(&cacheHeader->sourceMutex)) { LockGyMutex(&cacheHeader->sourceMutex); }
+	if (cache != nullptr && (cache->usedDelta != 0 || cache->allocationsDelta != 0))
+	{
+		//NOTE: These can temporarily wrap below 0 when one thread frees blocks that another thread hasn't reported allocating yet
+		arena->used += (u64)cache->usedDelta;
+		arena->numAllocations += (u64)cache->allocationsDelta;
+		cache->usedDelta = 0;
+		cache->allocationsDelta = 0;
+		if (IsFlagSet(arena->flags, MemArenaFlag_TelemetryEnabled) && (i64)arena->used >= 0 && (i64)arena->numAllocations >= 0)
+		{
+			if (arena->highUsedMark < arena->used) { arena->highUsedMark = arena->used; }
+			if (arena->resettableHighUsedMark < arena->used) { arena->resettableHighUsedMark = arena->used; }
+			if (arena->highAllocMark < arena->numAllocations) { arena->highAllocMark = arena->numAllocations; }
+		}
+	}
+}
+void UnlockThreadCacheSource(MemArena_t* arena)
+{
+	ThreadCacheArenaHeader_t* cacheHeader = (ThreadCacheArenaHeader_t*)arena->headerPntr;
+	if (IsValidGyMutex(&cacheHeader->sourceMutex)) { UnlockGyMutex(&cacheHeader->sourceMutex); }
+}
+
+ThreadCache_t* FindThreadCache(const MemArena_t* arena)
+{
+	const ThreadCacheArenaHeader_t* cacheHeader = (const ThreadCacheArenaHeader_t*)arena->headerPntr;
+	for (u64 eIndex = 0; eIndex < THREAD_CACHE_MAX_ARENAS_PER_THREAD; eIndex++)
+	{
+		ThreadCacheTlsEntry_t* entry = &ThreadCacheTlsEntries[eIndex];
+		if (entry->arena == arena && entry->arenaId == cacheHeader->arenaId) { return entry->cache; }
+	}
+	return nullptr;
+}
+
+//Finds the calling thread's cache, adopting a released one or allocating a new one if needed.
+//Returns nullptr if this thread's table is full (or we ran out of memory). Callers should fall back to the sourceArena
+ThreadCache_t* GetThreadCache(MemArena_t* arena)
+{
+	ThreadCache_t* result = FindThreadCache(arena);
+	if (result != nullptr) { return result; }
+	ThreadCacheArenaHeader_t* cacheHeader = (ThreadCacheArenaHeader_t*)arena->headerPntr;
+	
+	ThreadCacheTlsEntry_t* tlsEntry = nullptr;
+	for (u64 eIndex = 0; eIndex < THREAD_CACHE_MAX_ARENAS_PER_THREAD; eIndex++)
+	{
+		if (ThreadCacheTlsEntries[eIndex].arena == nullptr) { tlsEntry = &ThreadCacheTlsEntries[eIndex]; break; }
+	}
+	if (tlsEntry == nullptr)
+	{
+		//Entries for arenas that were freed by another thread are never cleared for us, so reuse the first one we find.
+		//The cache it points to was freed along with the arena so we just forget about it
+		for (u64 eIndex = 0; eIndex < THREAD_CACHE_MAX_ARENAS_PER_THREAD; eIndex++)
+		{
+			if (!IsThreadCacheArenaIdLive(ThreadCacheTlsEntries[eIndex].arenaId))
+			{
+				tlsEntry = &ThreadCacheTlsEntries[eIndex];
+				ClearPointer(tlsEntry);
+				break;
+			}
+		}
+	}
+	if (tlsEntry == nullptr) { return nullptr; }
+	
+	//Other threads can be publishing new caches while we walk the list without the lock
+	ThreadCache_t* walkCache = (ThreadCache_t*)ThreadSafeLoadAcquirePntr(&cacheHeader->firstCache);
+	while (walkCache != nullptr)
+	{
+		if (ThreadSafeLoadAcquireU32(&walkCache->isClaimed) == 0 && ThreadSafeClaimByBool(&walkCache->isClaimed)) { result = walkCache; break; }
+		walkCache = (ThreadCache_t*)ThreadSafeLoadAcquirePntr(&walkCache->next);
+	}
+	
+	if (result == nullptr)
+	{
+		LockThreadCacheSource(arena, nullptr);
+		result = AllocStruct(arena->sourceArena, ThreadCache_t);
+		if (result != nullptr)
+		{
+			ClearPointer(result);
+			result->isClaimed = 1;
+			result->next = cacheHeader->firstCache;
+			cacheHeader->numCaches++;
+			ThreadSafeStoreReleasePntr(&cacheHeader->firstCache, result); //other threads may be walking the list without the lock, so only publish once it's filled out
+		}
+		UnlockThreadCacheSource(arena);
+		if (result == nullptr) { return nullptr; }
+	}
+	
+	tlsEntry->arena = arena;
+	tlsEntry->arenaId = cacheHeader->arenaId;
+	tlsEntry->cache = result;
+	return result;
+}
+
+//Takes everything other threads have freed for us and puts it in our own free lists
+void DrainThreadCacheRemoteFrees(ThreadCache_t* cache)
+{
+	if (ThreadSafeLoadAcquirePntr(&cache->remoteFreeHead) == nullptr) { return; }
+	//NOTE: Only the owning thread takes from this stack and it always takes the whole thing, so we don't have to worry about ABA
+	void* blockPntr = (void*)ThreadSafeExchangePntr(&cache->remoteFreeHead, (void*)nullptr);
+	while (blockPntr != nullptr)
+	{
+		void* nextBlockPntr = *((void**)blockPntr);
+		ThreadCacheBlockPrefix_t* prefix = ((ThreadCacheBlockPrefix_t*)blockPntr) - 1;
+		DebugAssertMsg(prefix->owner == cache && prefix->sizeClass < SLAB_NUM_SIZE_CLASSES, "Found a corrupt block in a ThreadCache remote free stack!");
+		*((void**)blockPntr) = cache->freeLists[prefix->sizeClass];
+		cache->freeLists[prefix->sizeClass] = blockPntr;
+		cache->numCached[prefix->sizeClass]++;
+		blockPntr = nextBlockPntr;
+	}
+}
+
+void PushThreadCacheRemoteFree(ThreadCache_t* owner, void* blockPntr)
+{
+	void* oldHead = nullptr;
+	do
+	{
+		oldHead = ThreadSafeLoadAcquirePntr(&owner->remoteFreeHead);
+		*((void**)blockPntr) = oldHead;
+	}
+	while ((void*)ThreadSafeCompareExchangePntr(&owner->remoteFreeHead, blockPntr, oldHead) != oldHead);
+}
+
+//Allocates a batch of blocks from the sourceArena under a single lock
+bool RefillThreadCache(MemArena_t* arena, ThreadCache_t* cache, u64 sizeClass)
+{
+	ThreadCacheArenaHeader_t* cacheHeader = (ThreadCacheArenaHeader_t*)arena->headerPntr;
+	u64 slotSize = (SLAB_MIN_SLOT_SIZE << sizeClass);
+	u64 rawOffset = GetThreadCacheRawOffset(arena->alignment);
+	u64 batchSize = MaxU64(cacheHeader->magazineSize / 2, 1);
+	LockThreadCacheSource(arena, cache);
+	for (u64 bIndex = 0; bIndex < batchSize; bIndex++)
+	{
+		u8* rawPntr = (u8*)AllocMem(arena->sourceArena, rawOffset + slotSize, arena->alignment);
+		if (rawPntr == nullptr) { break; }
+		arena->size += rawOffset + slotSize;
+		void* blockPntr = rawPntr + rawOffset;
+		ThreadCacheBlockPrefix_t* prefix = ((ThreadCacheBlockPrefix_t*)blockPntr) - 1;
+		prefix->owner = cache;
+		prefix->sizeClass = (u32)sizeClass;
+		prefix->rawOffset = (u32)rawOffset;
+		*((void**)blockPntr) = cache->freeLists[sizeClass];
+		cache->freeLists[sizeClass] = blockPntr;
+		cache->numCached[sizeClass]++;
+	}
+	UnlockThreadCacheSource(arena);
+	return (cache->freeLists[sizeClass] != nullptr);
+}
+
+//Gives blocks back to the sourceArena until only numToKeep are left. The caller must have called LockThreadCacheSource
+void FlushThreadCacheClass(MemArena_t* arena, ThreadCache_t* cache, u64 sizeClass, u64 numToKeep)
+{
+	u64 slotSize = (SLAB_MIN_SLOT_SIZE << sizeClass);
+	while (cache->numCached[sizeClass] > numToKeep)
+	{
+		void* blockPntr = cache->freeLists[sizeClass];
+		NotNull(blockPntr);
+		cache->freeLists[sizeClass] = *((void**)blockPntr);
+		cache->numCached[sizeClass]--;
+		ThreadCacheBlockPrefix_t* prefix = ((ThreadCacheBlockPrefix_t*)blockPntr) - 1;
+		u64 blockSize = prefix->rawOffset + slotSize;
+		FreeMem(arena->sourceArena, ((u8*)blockPntr) - prefix->rawOffset, blockSize);
+		AssertMsg(arena->size >= blockSize, "ThreadCached size tracker was corrupted. Reached 0 too soon!");
+		arena->size -= blockSize;
+	}
+}
+
+// +--------------------------------------------------------------+
+// |                        Init Functions                        |
+// +--------------------------------------------------------------+
+void InitMemArena_Redirect(MemArena_t* arena, AllocationFunction_f* allocFunc, FreeFunction_f* freeFunc, ReallocFunction_f* reallocFunc = nullptr)
+{
+	NotNull(arena);
+	NotNull(allocFunc);
+	ClearPointer(arena);
+	arena->type = MemArenaType_Redirect;
+	arena->allocFunc = allocFunc;
+	arena->reallocFunc = reallocFunc;
+	arena->freeFunc = freeFunc;
+	arena->used = 0; //NOTE: This only tracks allocations, not deallocations, so it only goes up
+	arena->numAllocations = 0;
+	
+	FlagSet(arena->flags, MemArenaFlag_TelemetryEnabled);
+	arena->highAllocMark = arena->numAllocations;
+}
+void InitMemArena_Alias(MemArena_t* arena, MemArena_t* sourceArena)
+{
+	NotNull(arena);
+	NotNull(sourceArena);
+	ClearPointer(arena);
+	arena->type = MemArenaType_Alias;
+	arena->sourceArena = sourceArena;
+	arena->used = 0; //NOTE: This MAY not track deallocations, it depends on if the sourceArena supports returning the size on FreeMem
+	arena->numAllocations = 0;
+	
+	FlagSet(arena->flags, MemArenaFlag_TelemetryEnabled);
+	arena->highUsedMark = arena->used;
+	arena->resettableHighUsedMark = arena->used;
+	arena->highAllocMark = arena->numAllocations;
+}
+void InitMemArena_StdHeap(MemArena_t* arena)
+{
+	NotNull(arena);
+	ClearPointer(arena);
+	arena->type = MemArenaType_StdHeap;
+	arena->used = 0; //NOTE: This only tracks allocations, not deallocations, so it only goes up
+	arena->numAllocations = 0;
+	
+	FlagSet(arena->flags, MemArenaFlag_TelemetryEnabled);
+	arena->highAllocMark = arena->numAllocations;
+}
+void InitMemArena_FixedHeap(MemArena_t* arena, u64 size, void* memoryPntr, AllocAlignment_t alignment = AllocAlignment_None)
+{
+	NotNull(arena);
+	u64 prefixSize = sizeof(HeapAllocPrefix_t);
+	Assert(size > prefixSize);
+	NotNull(memoryPntr);
+	Assert(IsAlignedTo(memoryPntr, alignment));
+	ClearPointer(arena);
+	arena->type = MemArenaType_FixedHeap;
+	arena->alignment = alignment;
+	arena->mainPntr = memoryPntr;
+	arena->size = size;
+	HeapAllocPrefix_t* firstAlloc = (HeapAllocPrefix_t*)arena->mainPntr;
+	ClearPointer(firstAlloc);
+	firstAlloc->size = PackAllocPrefixSize(false, arena->size);
+	arena->used = prefixSize;
+	arena->numAllocations = 0;
+	
+	FlagSet(arena->flags, MemArenaFlag_TelemetryEnabled);
+	arena->highUsedMark = arena->used;
+	arena->resettableHighUsedMark = arena->used;
+	arena->highAllocMark = arena->numAllocations;
+}
+void InitMemArena_PagedHeapFuncs(MemArena_t* arena, u64 pageSize, AllocationFunction_f* allocFunc, FreeFunction_f* freeFunc, u64 maxNumPages = 0, AllocAlignment_t alignment = AllocAlignment_None)
+{
+	NotNull(arena);
+	NotNull(allocFunc);
+	ClearPointer(arena);
+	arena->type = MemArenaType_PagedHeap;
+	arena->alignment = alignment;
+	arena->pageSize = pageSize;
+	arena->maxNumPages = maxNumPages;
+	arena->allocFunc = allocFunc;
+	arena->freeFunc = freeFunc;
+	FlagSet(arena->flags, MemArenaFlag_AutoFreePages);
+	arena->size = 0;
+	arena->used = 0;
+	arena->numPages = 0;
+	arena->numAllocations = 0;
+	arena->headerPntr = nullptr;
+	arena->mainPntr = nullptr;
+	arena->otherPntr = nullptr;
+	FlagSet(arena->flags, MemArenaFlag_TelemetryEnabled);
+	arena->highUsedMark = 0;
+	arena->resettableHighUsedMark = 0;
+	arena->highAllocMark = 0;
+}
+void InitMemArena_PagedHeapArena(MemArena_t* arena, u64 pageSize, MemArena_t* sourceArena, u64 maxNumPages = 0, AllocAlignment_t alignment = AllocAlignment_None)
+{
+	ClearPointer(arena);
+	arena->type = MemArenaType_PagedHeap;
+	arena->alignment = alignment;
+	arena->pageSize = pageSize;
+	arena->maxNumPages = maxNumPages;
+	arena->sourceArena = sourceArena;
+	arena->size = 0;
+	arena->used = 0;
+	arena->numPages = 0;
+	arena->numAllocations = 0;
+	arena->headerPntr = nullptr;
+	arena->mainPntr = nullptr;
+	arena->otherPntr = nullptr;
+	FlagSet(arena->flags, MemArenaFlag_TelemetryEnabled);
+	arena->highUsedMark = 0;
+	arena->resettableHighUsedMark = 0;
+	arena->highAllocMark = 0;
+}
+void InitMemArena_MarkedStack(MemArena_t* arena, u64 size, void* memoryPntr, u64 maxNumMarks, AllocAlignment_t alignment = AllocAlignment_None)
+{
+	NotNull(arena);
+	NotNull(memoryPntr);
+	Assert(size > 0);
+	Assert(maxNumMarks > 0);
+	Assert(size > sizeof(MarkedStackArenaHeader_t) + (maxNumMarks * sizeof(u64)));
+	
+	ClearPointer(arena);
+	arena->type = MemArenaType_MarkedStack;
+	arena->alignment = alignment;
+	arena->headerPntr = (((u8*)memoryPntr) + 0);
+	arena->otherPntr  = (((u8*)memoryPntr) + sizeof(MarkedStackArenaHeader_t));
+	arena->mainPntr   = (((u8*)memoryPntr) + sizeof(MarkedStackArenaHeader_t) + (maxNumMarks * sizeof(u64)));
 	arena->size = size - (sizeof(MarkedStackArenaHeader_t) + (maxNumMarks * sizeof(u64)));
 	arena->used = 0;
 	arena->numAllocations = 0;
@@ -571,7 +1645,7 @@ void InitMemArena_PagedStackFuncs(MemArena_t* arena, u64 pageSize, AllocationFun
 	arena->resettableHighUsedMark = 0;
 	firstPage->highMarkCount = 0;
 }
-void InitMemArena_VirtualStack(MemArena_t* arena, u64 maxSize, u64 maxNumMarks, AllocAlignment_t alignment = AllocAlignment_None)
+void InitMemArena_VirtualStack(MemArena_t* arena, u64 maxSize, u64 maxNumMarks, AllocAlignment_t alignment = AllocAlignment_None, bool useHugePages = false)
 {
 	#if !ORCA_COMPILATION
 	NotNull(arena);
@@ -585,9 +1659,23 @@ void InitMemArena_VirtualStack(MemArena_t* arena, u64 maxSize, u64 maxNumMarks,
 	arena->numAllocations = 0;
 	
 	arena->pageSize = OsGetMemoryPageSize();
-	arena->maxSize = RoundUpToU64(maxSize, arena->pageSize);
-	u8* reservedMemPntr = (u8*)OsReserveMemory(arena->maxSize);
-	NotNull(reservedMemPntr);
+	u64 hugePageSize = (useHugePages ? OsGetHugePageSize() : 0);
+	u8* reservedMemPntr = nullptr;
+	if (hugePageSize > arena->pageSize)
+	{
+		//Huge pages only get used for ranges that are aligned to a huge page boundary, so we reserve aligned and commit in huge page sized chunks
+		arena->pageSize = hugePageSize;
+		arena->maxSize = RoundUpToU64(maxSize, arena->pageSize);
+		reservedMemPntr = (u8*)OsReserveMemoryAligned(arena->maxSize, arena->pageSize);
+		NotNull(reservedMemPntr);
+		if (OsAdviseHugePages(reservedMemPntr, arena->maxSize)) { FlagSet(arena->flags, MemArenaFlag_HugePages); }
+	}
+	else
+	{
+		arena->maxSize = RoundUpToU64(maxSize, arena->pageSize);
+		reservedMemPntr = (u8*)OsReserveMemory(arena->maxSize);
+		NotNull(reservedMemPntr);
+	}
 	u64 headerAndMarksSize = sizeof(MarkedStackArenaHeader_t) + (maxNumMarks * sizeof(u64));
 	u64 headerAndMarksSizeRoundedUp = RoundUpToU64(headerAndMarksSize, arena->pageSize);
 	OsCommitReservedMemory(reservedMemPntr, headerAndMarksSizeRoundedUp);
@@ -629,6 +1717,158 @@ void InitMemArena_Buffer(MemArena_t* arena, u64 bufferSize, void* bufferPntr, bo
 	arena->highAllocMark = arena->numAllocations;
 }
 
+void InitMemArena_Slab(MemArena_t* arena, u64 pageSize, MemArena_t* sourceArena, u64 maxNumPages = 0, AllocAlignment_t alignment = AllocAlignment_None)
+{
+	NotNull(arena);
+	NotNull(sourceArena);
+	AssertMsg(pageSize >= sizeof(SlabPageHeader_t) + AllocAlignment_Max + SLAB_MAX_SLOT_SIZE, "Slab pageSize must be big enough to hold at least one slot of the largest size class");
+	ClearPointer(arena);
+	arena->type = MemArenaType_Slab;
+	arena->alignment = alignment;
+	arena->pageSize = pageSize;
+	arena->maxNumPages = maxNumPages;
+	arena->sourceArena = sourceArena;
+	FlagSet(arena->flags, MemArenaFlag_AutoFreePages);
+	arena->size = 0;
+	arena->used = 0;
+	arena->numPages = 0;
+	arena->numAllocations = 0;
+	
+	SlabArenaHeader_t* slabHeader = AllocStruct(sourceArena, SlabArenaHeader_t);
+	NotNull(slabHeader);
+	ClearPointer(slabHeader);
+	arena->headerPntr = slabHeader;
+	
+	FlagSet(arena->flags, MemArenaFlag_TelemetryEnabled);
+	arena->highUsedMark = 0;
+	arena->resettableHighUsedMark = 0;
+	arena->highAllocMark = 0;
+}
+
+void InitMemArena_ThreadCached(MemArena_t* arena, MemArena_t* sourceArena, u64 magazineSize = THREAD_CACHE_DEFAULT_MAGAZINE_SIZE, AllocAlignment_t alignment = AllocAlignment_None)
+{
+	NotNull(arena);
+	NotNull(sourceArena);
+	Assert(magazineSize > 0);
+	ClearPointer(arena);
+	arena->type = MemArenaType_ThreadCached;
+	arena->alignment = alignment;
+	arena->sourceArena = sourceArena;
+	arena->size = 0;
+	arena->used = 0;
+	arena->numAllocations = 0;
+	
+	ThreadCacheArenaHeader_t* cacheHeader = AllocStruct(sourceArena, ThreadCacheArenaHeader_t);
+	NotNull(cacheHeader);
+	ClearPointer(cacheHeader);
+	cacheHeader->arenaId = ThreadSafeIncrementU64(&ThreadCacheNextArenaId);
+	RegisterThreadCacheArenaId(cacheHeader->arenaId);
+	cacheHeader->magazineSize = magazineSize;
+	InitGyMutex(&cacheHeader->sourceMutex);
+	arena->headerPntr = cacheHeader;
+	
+	FlagSet(arena->flags, MemArenaFlag_TelemetryEnabled);
+	arena->highUsedMark = 0;
+	arena->resettableHighUsedMark = 0;
+	arena->highAllocMark = 0;
+}
+
+void InitMemArena_Ring(MemArena_t* arena, u64 size, void* memoryPntr, u64 maxNumFrames, AllocAlignment_t alignment = AllocAlignment_None)
+{
+	NotNull(arena);
+	NotNull(memoryPntr);
+	Assert(maxNumFrames > 0);
+	Assert(size > sizeof(RingArenaHeader_t) + (maxNumFrames * sizeof(RingArenaFrame_t)));
+	
+	ClearPointer(arena);
+	arena->type = MemArenaType_Ring;
+	arena->alignment = alignment;
+	arena->headerPntr = (((u8*)memoryPntr) + 0);
+	arena->otherPntr  = (((u8*)memoryPntr) + sizeof(RingArenaHeader_t));
+	arena->mainPntr   = (((u8*)memoryPntr) + sizeof(RingArenaHeader_t) + (maxNumFrames * sizeof(RingArenaFrame_t)));
+	arena->size = size - (sizeof(RingArenaHeader_t) + (maxNumFrames * sizeof(RingArenaFrame_t)));
+	arena->used = 0;
+	arena->numAllocations = 0;
+	
+	RingArenaHeader_t* ringHeader = (RingArenaHeader_t*)arena->headerPntr;
+	ClearPointer(ringHeader);
+	ringHeader->maxNumFrames = maxNumFrames;
+	MyMemSet(arena->otherPntr, 0x00, maxNumFrames * sizeof(RingArenaFrame_t)); //frame 0 starts at position 0
+	
+	FlagSet(arena->flags, MemArenaFlag_TelemetryEnabled);
+	arena->highUsedMark = 0;
+	arena->resettableHighUsedMark = 0;
+	arena->highAllocMark = 0;
+	ringHeader->highFrameCount = 1;
+}
+
+//Opens (or creates) the file and maps it. If the file already holds an arena then it's contents, used and marks are
+//picked back up (and maxNumMarks is ignored), if the file is smaller than maxSize it gets extended. Returns false if the
+//file couldn't be mapped or it holds something other than a MappedFile arena
+bool InitMemArena_MappedFile(MemArena_t* arena, const char* filePath, u64 maxSize, u64 maxNumMarks, bool copyOnWrite = false, void* desiredBase = nullptr, AllocAlignment_t alignment = AllocAlignment_None)
+{
+	NotNull2(arena, filePath);
+	Assert(maxNumMarks > 0);
+	ClearPointer(arena);
+	
+	u64 pageSize = OsGetMemoryPageSize();
+	u64 minFileSize = (copyOnWrite ? 0 : RoundUpToU64(maxSize, pageSize));
+	u64 fileSize = 0;
+	u8* basePntr = (u8*)OsMapFile(filePath, minFileSize, copyOnWrite, desiredBase, &fileSize);
+	if (basePntr == nullptr)
+	{
+		GyLibPrintLine_E("Failed to map file for MappedFile arena: \"%s\"", filePath);
+		return false;
+	}
+	
+	MappedFileArenaHeader_t* fileHeader = (MappedFileArenaHeader_t*)basePntr;
+	if (fileSize >= sizeof(MappedFileArenaHeader_t) && fileHeader->magic == MAPPED_FILE_ARENA_MAGIC)
+	{
+		if (fileHeader->version != MAPPED_FILE_ARENA_VERSION || fileHeader->headerAndMarksSize > fileSize || fileHeader->used > fileSize - fileHeader->headerAndMarksSize ||
+			fileHeader->stackHeader.numMarks > fileHeader->stackHeader.maxNumMarks)
+		{
+			GyLibPrintLine_E("MappedFile arena header is invalid or from another version (v%u) in \"%s\"", fileHeader->version, filePath);
+			OsUnmapFile(basePntr, fileSize);
+			return false;
+		}
+	}
+	else
+	{
+		//Only initialize a brand new (zeroed) file, we don't want to stomp on a file that holds something else
+		u64 headerAndMarksSize = sizeof(MappedFileArenaHeader_t) + (maxNumMarks * sizeof(u64));
+		bool isEmptyFile = (fileSize >= sizeof(MappedFileArenaHeader_t));
+		for (u64 bIndex = 0; isEmptyFile && bIndex < sizeof(MappedFileArenaHeader_t); bIndex++) { if (basePntr[bIndex] != 0x00) { isEmptyFile = false; } }
+		if (copyOnWrite || !isEmptyFile || headerAndMarksSize >= fileSize)
+		{
+			GyLibPrintLine_E("File is not a MappedFile arena (or is too small to be one): \"%s\"", filePath);
+			OsUnmapFile(basePntr, fileSize);
+			return false;
+		}
+		fileHeader->stackHeader.maxNumMarks = maxNumMarks;
+		fileHeader->magic = MAPPED_FILE_ARENA_MAGIC;
+		fileHeader->version = MAPPED_FILE_ARENA_VERSION;
+		fileHeader->headerAndMarksSize = headerAndMarksSize;
+		fileHeader->baseAddress = (u64)basePntr;
+	}
+	
+	arena->type = MemArenaType_MappedFile;
+	arena->alignment = alignment;
+	arena->pageSize = pageSize;
+	arena->maxSize = fileSize;
+	arena->headerPntr = basePntr;
+	arena->otherPntr  = basePntr + sizeof(MappedFileArenaHeader_t);
+	arena->mainPntr   = basePntr + fileHeader->headerAndMarksSize;
+	arena->size = fileSize - fileHeader->headerAndMarksSize;
+	arena->used = fileHeader->used;
+	arena->numAllocations = fileHeader->numAllocations;
+	
+	FlagSet(arena->flags, MemArenaFlag_TelemetryEnabled);
+	arena->highUsedMark = arena->used;
+	arena->resettableHighUsedMark = arena->used;
+	fileHeader->stackHeader.highMarkCount = fileHeader->stackHeader.numMarks;
+	return true;
+}
+
 #define CreateBufferArenaOnStack(arenaName, bufferName, size) MemArena_t arenaName; u8 bufferName[size]; InitMemArena_Buffer(&arenaName, (size), &bufferName[0])
 
 void UpdateMemArenaFuncPntrs(MemArena_t* arena, AllocationFunction_f* allocFunc, FreeFunction_f* freeFunc, ReallocFunction_f* reallocFunc = nullptr)
@@ -657,8 +1897,10 @@ bool DoesMemArenaSupportFreeing(MemArena_t* arena)
 	{
 		case MemArenaType_Alias: return DoesMemArenaSupportFreeing(arena->sourceArena);
 		case MemArenaType_MarkedStack:
+		case MemArenaType_MappedFile:
 		case MemArenaType_PagedStack:
 		case MemArenaType_VirtualStack: return false; //stacks have a very narrow case that FreeMem actually works but they generally don't support freeing in arbitrary order
+		case MemArenaType_Ring: return false; //FreeMem only updates counts, the space comes back when the frame is retired
 		default: return true;
 	}
 }
@@ -670,6 +1912,7 @@ bool DoesMemArenaSupportPushAndPop(MemArena_t* arena)
 	{
 		case MemArenaType_Alias: return DoesMemArenaSupportPushAndPop(arena->sourceArena);
 		case MemArenaType_MarkedStack:
+		case MemArenaType_MappedFile:
 		case MemArenaType_PagedStack:
 		case MemArenaType_VirtualStack: return true;
 		default: return false;
@@ -690,6 +1933,7 @@ u64 GetNumMarks(MemArena_t* arena)
 		// | MemArenaType_MarkedStack GetNumMarks |
 		// +======================================+
 		case MemArenaType_MarkedStack:
+		case MemArenaType_MappedFile:
 		{
 			NotNull(arena->headerPntr);
 			MarkedStackArenaHeader_t* stackHeader = (MarkedStackArenaHeader_t*)arena->headerPntr;
@@ -783,42 +2027,52 @@ bool TryGetAllocSize(const MemArena_t* arena, const void* allocPntr, u64* sizeOu
 		// +======================================+
 		case MemArenaType_PagedHeap:
 		{
-			HeapPageHeader_t* pageHeader = (HeapPageHeader_t*)arena->headerPntr;
-			while (pageHeader != nullptr)
+			HeapPageHeader_t* pageHeader = FindHeapPageFor(arena, allocPntr);
+			if (pageHeader == nullptr) { return false; }
+			HeapAllocPrefix_t* prefixPntr = GetHeapAllocPrefix(allocPntr);
+			u8* pageBase = (u8*)(pageHeader + 1);
+			AssertMsg(IsPntrInsideRange(prefixPntr, pageBase, pageHeader->size), "Tried to GetAllocSize on a pointer that didn't decode to a Paged Heap prefix. This is a corrupt pointer!");
+			AssertMsg(IsAllocPrefixFilled(prefixPntr->size), "Tried to GetAllocSize on a pntr that was previously freed in PagedHeap");
+			u64 sectionSize = UnpackAllocPrefixSize(prefixPntr->size);
+			AssertMsg(sectionSize >= HEAP_MIN_SECTION_SIZE && (u8*)prefixPntr + sectionSize <= pageBase + pageHeader->size, "Tried to GetAllocSize on a pointer that pointed to the middle of a Paged Heap section. This is a corrupt pointer!");
+			//Aligned allocations start alignOffset bytes after the prefix, so count from allocPntr instead of from the end of the prefix
+			SetOptionalOutPntr(sizeOut, (u64)((((u8*)prefixPntr) + sectionSize) - (const u8*)allocPntr));
+			return true;
+		} break;
+		
+		// +==================================+
+		// |  MemArenaType_Slab GetAllocSize  |
+		// +==================================+
+		case MemArenaType_Slab:
+		{
+			const SlabPageHeader_t* pageHeader = FindSlabPageFor(arena, allocPntr);
+			if (pageHeader == nullptr)
 			{
-				u8* pageBase = (u8*)(pageHeader + 1);
-				if (IsPntrWithin(pageBase, pageHeader->size, allocPntr))
-				{
-					u64 allocOffset = 0;
-					u8* allocBytePntr = pageBase;
-					while (allocOffset < pageHeader->size)
-					{
-						HeapAllocPrefix_t* prefixPntr = (HeapAllocPrefix_t*)allocBytePntr;
-						u8* afterPrefixPntr = (allocBytePntr + sizeof(HeapAllocPrefix_t));
-						bool isSectionFilled = IsAllocPrefixFilled(prefixPntr->size);
-						u64 sectionSize = UnpackAllocPrefixSize(prefixPntr->size);
-						AssertMsg(sectionSize >= sizeof(HeapAllocPrefix_t), "Found an allocation header that claimed to be smaller than the header itself in Paged Heap");
-						u64 afterPrefixSize = sectionSize - sizeof(HeapAllocPrefix_t);
-						
-						if (IsPntrWithin(allocBytePntr, sectionSize, allocPntr))
-						{
-							AssertMsg((u8*)allocPntr >= afterPrefixPntr, "Tried to GetAllocSize on a pointer that pointed into a Paged Heap header. This is a corrupt pointer!");
-							//TODO: Check if the allocation was actually aligned. Be more strict if it wasn't aligned
-							AssertMsg((u8*)allocPntr <= afterPrefixPntr + OffsetToAlign(afterPrefixPntr, AllocAlignment_Max), "Tried to GetAllocSize on a pointer that pointed to the middle of a Paged Heap section. This is a corrupt pointer!");
-							AssertMsg(isSectionFilled, "Tried to GetAllocSize on a pntr that was previously freed in PagedHeap");
-							SetOptionalOutPntr(sizeOut, afterPrefixSize);
-							return true;
-						}
-						
-						allocOffset += sectionSize;
-						allocBytePntr += sectionSize;
-					}
-					AssertMsg(false, "We have a bug in our GetAllocSize walk. Couldn't find section that contained the pntr in this page!");
-					return false;
-				}
-				pageHeader = pageHeader->next;
+				const SlabPassthroughPrefix_t* prefix = ((const SlabPassthroughPrefix_t*)allocPntr) - 1;
+				SetOptionalOutPntr(sizeOut, prefix->size);
+				return true;
 			}
-			return false;
+			AssertMsg((u8*)allocPntr >= pageHeader->slotsBase, "Tried to GetAllocSize on a pointer that pointed into a Slab page header. This is a corrupt pointer!");
+			AssertMsg((((u8*)allocPntr - pageHeader->slotsBase) % pageHeader->slotSize) == 0, "Tried to GetAllocSize on a pointer that pointed to the middle of a Slab slot. This is a corrupt pointer!");
+			SetOptionalOutPntr(sizeOut, pageHeader->slotSize);
+			return true;
+		} break;
+		
+		// +==========================================+
+		// |  MemArenaType_ThreadCached GetAllocSize  |
+		// +==========================================+
+		case MemArenaType_ThreadCached:
+		{
+			const ThreadCacheBlockPrefix_t* prefix = ((const ThreadCacheBlockPrefix_t*)allocPntr) - 1;
+			if (prefix->sizeClass >= SLAB_NUM_SIZE_CLASSES)
+			{
+				AssertMsg(prefix->sizeClass == SLAB_NUM_SIZE_CLASSES, "Tried to GetAllocSize on a pointer that didn't have a valid ThreadCached prefix. This is a corrupt pointer!");
+				SetOptionalOutPntr(sizeOut, prefix->passthroughSize);
+				return true;
+			}
+			AssertMsg(prefix->sizeClass < SLAB_NUM_SIZE_CLASSES, "Tried to GetAllocSize on a pointer that didn't have a valid ThreadCached prefix. This is a corrupt pointer!");
+			SetOptionalOutPntr(sizeOut, (SLAB_MIN_SLOT_SIZE << prefix->sizeClass));
+			return true;
 		} break;
 		
 		default: AssertMsg(false, "Tried to GetAllocSize on a MemArenaType that does not track allocation sizes!"); return false;
@@ -836,133 +2090,108 @@ u64 GetAllocSize(const MemArena_t* arena, const void* allocPntr)
 // |                       Debug Alloc Info                       |
 // +--------------------------------------------------------------+
 #if GYLIB_MEM_ARENA_DEBUG_ENABLED
-void StoreAllocInfo(const MemArena_t* refArena, MemArena_t* arena, void* allocPntr, u64 allocSize, const char* filePath, u64 lineNumber, const char* funcName)
+//Fibonacci hashing of the pointer. The low bits are mostly alignment so we let the multiply mix the upper bits down
+u64 GetAllocInfoTableIndex(const MemArenaAllocInfoTable_t* table, const void* allocPntr)
+{
+	DebugAssert(table->capacity > 0 && (table->capacity & (table->capacity - 1)) == 0);
+	u64 hash = ((u64)allocPntr) * 0x9E3779B97F4A7C15ULL;
+	return (hash >> 32) & (table->capacity - 1);
+}
+//Doesn't check if allocPntr is already in the table and doesn't grow the table
+void InsertAllocInfoIntoTable(MemArenaAllocInfoTable_t* table, const MemArenaAllocInfo_t* allocInfo)
+{
+	u64 slotIndex = GetAllocInfoTableIndex(table, allocInfo->allocPntr);
+	while (table->slots[slotIndex].allocPntr != nullptr) { slotIndex = (slotIndex + 1) & (table->capacity - 1); }
+	MyMemCopy(&table->slots[slotIndex], allocInfo, sizeof(MemArenaAllocInfo_t));
+	table->count++;
+}
+void GrowAllocInfoTable(MemArena_t* arena, MemArenaAllocInfoTable_t* table)
+{
+	u64 newCapacity = (table->capacity > 0) ? table->capacity * 2 : MEM_ARENA_ALLOC_INFO_TABLE_MIN_CAPACITY;
+	MemArenaAllocInfo_t* newSlots = AllocArray(arena, MemArenaAllocInfo_t, newCapacity);
+	NotNull(newSlots);
+	MyMemSet(newSlots, 0x00, sizeof(MemArenaAllocInfo_t) * newCapacity);
+	
+	MemArenaAllocInfo_t* oldSlots = table->slots;
+	u64 oldCapacity = table->capacity;
+	table->slots = newSlots;
+	table->capacity = newCapacity;
+	table->count = 0;
+	for (u64 sIndex = 0; sIndex < oldCapacity; sIndex++)
+	{
+		if (oldSlots[sIndex].allocPntr != nullptr) { InsertAllocInfoIntoTable(table, &oldSlots[sIndex]); }
+	}
+	if (oldSlots != nullptr) { FreeMem(arena, oldSlots, sizeof(MemArenaAllocInfo_t) * oldCapacity); }
+}
+void FreeAllocInfoTable(MemArena_t* refArena)
+{
+	MemArenaAllocInfoTable_t* table = &refArena->allocInfoTable;
+	if (table->slots != nullptr)
+	{
+		NotNull(refArena->debugArena);
+		FreeMem(refArena->debugArena, table->slots, sizeof(MemArenaAllocInfo_t) * table->capacity);
+	}
+	ClearPointer(table);
+}
+
+MemArenaAllocInfo_t* FindAllocInfoFor(const MemArena_t* refArena, const void* allocPntr)
+{
+	const MemArenaAllocInfoTable_t* table = &refArena->allocInfoTable;
+	if (table->count == 0 || allocPntr == nullptr) { return nullptr; }
+	u64 slotIndex = GetAllocInfoTableIndex(table, allocPntr);
+	while (table->slots[slotIndex].allocPntr != nullptr)
+	{
+		if (table->slots[slotIndex].allocPntr == allocPntr) { return &table->slots[slotIndex]; }
+		slotIndex = (slotIndex + 1) & (table->capacity - 1);
+	}
+	return nullptr;
+}
+//The alloc info lives in an open addressing (linear probing) table in refArena, the slots are allocated from arena (the debugArena)
+void StoreAllocInfo(MemArena_t* refArena, MemArena_t* arena, void* allocPntr, u64 allocSize, const char* filePath, u64 lineNumber, const char* funcName)
 {
-	UNUSED(refArena);
-	MemArenaAllocInfo_t* allocInfo = (MemArenaAllocInfo_t*)AllocMem(arena, sizeof(MemArenaAllocInfo_t));
-	if (allocInfo == nullptr) { return; }
-	// ClearPointer(allocInfo);
-	// if (refArena->numAllocations != arena->numAllocations) { MyDebugBreak(); }
+	NotNull3(refArena, arena, allocPntr);
+	MemArenaAllocInfoTable_t* table = &refArena->allocInfoTable;
+	MemArenaAllocInfo_t* allocInfo = FindAllocInfoFor(refArena, allocPntr);
+	if (allocInfo == nullptr)
+	{
+		if ((table->count + 1) * MEM_ARENA_ALLOC_INFO_TABLE_MAX_LOAD_DENOM > table->capacity * MEM_ARENA_ALLOC_INFO_TABLE_MAX_LOAD_NUM)
+		{
+			GrowAllocInfoTable(arena, table);
+		}
+		MemArenaAllocInfo_t newInfo = {};
+		newInfo.allocPntr = allocPntr;
+		InsertAllocInfoIntoTable(table, &newInfo);
+		allocInfo = FindAllocInfoFor(refArena, allocPntr);
+		NotNull(allocInfo);
+	}
 	allocInfo->allocPntr = allocPntr;
 	allocInfo->allocSize = allocSize;
 	allocInfo->filePath = filePath;
 	allocInfo->lineNumber = lineNumber;
 	allocInfo->funcName = funcName;
 }
-MemArenaAllocInfo_t* FindAllocInfoFor(MemArena_t* arena, void* allocPntr)
+//Heap sections don't record where the pntr we handed out is if it was aligned, so we check each offset that has a matching marker byte (see GetHeapAllocPrefix)
+MemArenaAllocInfo_t* FindAllocInfoForHeapSection(const MemArena_t* refArena, u8* afterPrefixPntr, u64 afterPrefixSize)
 {
-	bool didLock = false;
-	if (IsValidGyMutex(&arena->mutex)) { LockGyMutex(&arena->mutex); didLock = true; }
-	
-	switch (arena->type)
+	MemArenaAllocInfo_t* result = FindAllocInfoFor(refArena, afterPrefixPntr);
+	for (u64 alignOffset = 1; result == nullptr && alignOffset < AllocAlignment_Max && alignOffset < afterPrefixSize; alignOffset++)
 	{
-		// +======================================+
-		// | MemArenaType_PagedHeap FindAllocInfo |
-		// +======================================+
-		case MemArenaType_PagedHeap:
-		{
-			HeapPageHeader_t* pageHeader = (HeapPageHeader_t*)arena->headerPntr;
-			u64 pageIndex = 0;
-			while (pageHeader != nullptr)
-			{
-				u64 allocOffset = 0;
-				u8* allocBytePntr = (u8*)(pageHeader + 1);
-				u64 sectionIndex = 0;
-				while (allocOffset < pageHeader->size)
-				{
-					HeapAllocPrefix_t* allocPrefix = (HeapAllocPrefix_t*)allocBytePntr;
-					u8* allocAfterPrefixPntr = (allocBytePntr + sizeof(HeapAllocPrefix_t));
-					bool isAllocFilled = IsAllocPrefixFilled(allocPrefix->size);
-					u64 allocSize = UnpackAllocPrefixSize(allocPrefix->size);
-					AssertMsg(allocSize >= sizeof(HeapAllocPrefix_t), "Found an allocation header that claimed to be smaller than the header itself in Fixed Heap");
-					AssertMsg(allocOffset + allocSize <= pageHeader->size, "Found an allocation header with invalid size. Would extend past the end of a page!");
-					u64 allocAfterPrefixSize = allocSize - sizeof(HeapAllocPrefix_t);
-					if (isAllocFilled && allocAfterPrefixSize == sizeof(MemArenaAllocInfo_t))
-					{
-						MemArenaAllocInfo_t* allocInfo = (MemArenaAllocInfo_t*)allocAfterPrefixPntr;
-						if (allocInfo->allocPntr == allocPntr)
-						{
-							if (didLock) { UnlockGyMutex(&arena->mutex); }
-							return allocInfo;
-						}
-					}
-					
-					allocBytePntr += allocSize;
-					allocOffset += allocSize;
-					sectionIndex++;
-				}
-				UNUSED(sectionIndex); //used for debug purposes
-				
-				pageHeader = pageHeader->next;
-				pageIndex++;
-			}
-		} break;
-		
-		default:
-		{
-			DebugAssertMsg(false, "Arena type not supported for store debug info! We need to implement a walk where we find allocInfo by reference pntr");
-		} break;
+		if (afterPrefixPntr[alignOffset-1] == alignOffset) { result = FindAllocInfoFor(refArena, afterPrefixPntr + alignOffset); }
 	}
-	
-	if (didLock) { UnlockGyMutex(&arena->mutex); }
-	return nullptr;
+	return result;
 }
-MemArenaAllocInfo_t* FindExtraAllocInfoInArena(MemArena_t* arena, MemArena_t* realArena)
+//Returns the first alloc info that refers to memory that is not a live allocation in refArena (this happens when frees are missed)
+MemArenaAllocInfo_t* FindExtraAllocInfoInArena(MemArena_t* refArena)
 {
-	bool didLock = false;
-	if (IsValidGyMutex(&arena->mutex)) { LockGyMutex(&arena->mutex); didLock = true; }
-	
-	switch (arena->type)
+	MemArenaAllocInfoTable_t* table = &refArena->allocInfoTable;
+	for (u64 sIndex = 0; sIndex < table->capacity; sIndex++)
 	{
-		// +======================================+
-		// | MemArenaType_PagedHeap FreeAllocInfo |
-		// +======================================+
-		case MemArenaType_PagedHeap:
-		{
-			HeapPageHeader_t* pageHeader = (HeapPageHeader_t*)arena->headerPntr;
-			u64 pageIndex = 0;
-			while (pageHeader != nullptr)
-			{
-				u64 allocOffset = 0;
-				u8* allocBytePntr = (u8*)(pageHeader + 1);
-				u64 sectionIndex = 0;
-				while (allocOffset < pageHeader->size)
-				{
-					HeapAllocPrefix_t* allocPrefix = (HeapAllocPrefix_t*)allocBytePntr;
-					u8* allocAfterPrefixPntr = (allocBytePntr + sizeof(HeapAllocPrefix_t));
-					bool isAllocFilled = IsAllocPrefixFilled(allocPrefix->size);
-					u64 allocSize = UnpackAllocPrefixSize(allocPrefix->size);
-					AssertMsg(allocSize >= sizeof(HeapAllocPrefix_t), "Found an allocation header that claimed to be smaller than the header itself in Fixed Heap");
-					AssertMsg(allocOffset + allocSize <= pageHeader->size, "Found an allocation header with invalid size. Would extend past the end of a page!");
-					u64 allocAfterPrefixSize = allocSize - sizeof(HeapAllocPrefix_t);
-					if (isAllocFilled && allocAfterPrefixSize == sizeof(MemArenaAllocInfo_t))
-					{
-						MemArenaAllocInfo_t* allocInfo = (MemArenaAllocInfo_t*)allocAfterPrefixPntr;
-						if (!FreeMem(realArena, allocInfo->allocPntr, allocInfo->allocSize))
-						{
-							if (didLock) { UnlockGyMutex(&arena->mutex); }
-							return allocInfo;
-						}
-					}
-					
-					allocBytePntr += allocSize;
-					allocOffset += allocSize;
-					sectionIndex++;
-				}
-				UNUSED(sectionIndex); //used for debug purposes
-				
-				pageHeader = pageHeader->next;
-				pageIndex++;
-			}
-		} break;
-		
-		default:
+		MemArenaAllocInfo_t* allocInfo = &table->slots[sIndex];
+		if (allocInfo->allocPntr != nullptr && !TryGetAllocSize(refArena, allocInfo->allocPntr))
 		{
-			DebugAssertMsg(false, "Arena type not supported for store debug info! We need to implement a walk where we find allocInfo by reference pntr");
-		} break;
+			return allocInfo;
+		}
 	}
-	
-	if (didLock) { UnlockGyMutex(&arena->mutex); }
 	return nullptr;
 }
 void* FindMissingAllocInfoInArena(MemArena_t* arena, u64* allocSizeOut = nullptr)
@@ -996,7 +2225,7 @@ void* FindMissingAllocInfoInArena(MemArena_t* arena, u64* allocSizeOut = nullptr
 					u64 allocAfterPrefixSize = allocSize - sizeof(HeapAllocPrefix_t);
 					if (isAllocFilled)
 					{
-						MemArenaAllocInfo_t* allocInfo = FindAllocInfoFor(arena->debugArena, allocAfterPrefixPntr);
+						MemArenaAllocInfo_t* allocInfo = FindAllocInfoForHeapSection(arena, allocAfterPrefixPntr, allocAfterPrefixSize);
 						if (allocInfo == nullptr)
 						{
 							MyDebugBreak();
@@ -1019,23 +2248,38 @@ void* FindMissingAllocInfoInArena(MemArena_t* arena, u64* allocSizeOut = nullptr
 		
 		default:
 		{
-			DebugAssertMsg(false, "Arena type not supported for store debug info! We need to implement a walk where we find allocInfo by reference pntr");
+			DebugAssertMsg(false, "Arena type not supported for FindMissingAllocInfoInArena! We need to implement a walk over the arena's allocations");
 		} break;
 	}
 	
 	if (didLock) { UnlockGyMutex(&arena->mutex); }
 	return nullptr;
 }
-//TODO: Add const back to refArena
+//Removes the entry with backward shift deletion so we never need tombstones
 void FreeAllocInfo(MemArena_t* refArena, MemArena_t* arena, void* allocPntr)
 {
-	UNUSED(refArena);
-	MemArenaAllocInfo_t* allocInfo = FindAllocInfoFor(arena, allocPntr);
+	UNUSED(arena);
+	MemArenaAllocInfoTable_t* table = &refArena->allocInfoTable;
+	MemArenaAllocInfo_t* allocInfo = FindAllocInfoFor(refArena, allocPntr);
 	if (allocInfo != nullptr)
 	{
-		FreeMem(arena, allocInfo, sizeof(MemArenaAllocInfo_t));
+		u64 holeIndex = (u64)(allocInfo - table->slots);
+		u64 slotIndex = (holeIndex + 1) & (table->capacity - 1);
+		while (table->slots[slotIndex].allocPntr != nullptr)
+		{
+			u64 homeIndex = GetAllocInfoTableIndex(table, table->slots[slotIndex].allocPntr);
+			//Move the entry back into the hole if the hole sits between it's home slot and where it is now (cyclically)
+			if (((slotIndex - homeIndex) & (table->capacity - 1)) >= ((slotIndex - holeIndex) & (table->capacity - 1)))
+			{
+				MyMemCopy(&table->slots[holeIndex], &table->slots[slotIndex], sizeof(MemArenaAllocInfo_t));
+				holeIndex = slotIndex;
+			}
+			slotIndex = (slotIndex + 1) & (table->capacity - 1);
+		}
+		ClearStruct(table->slots[holeIndex]);
+		Decrement(table->count);
 	}
-	if (refArena->numAllocations != arena->numAllocations)
+	if (refArena->numAllocations != table->count)
 	{
 		#if 1
 		MyDebugBreak();
@@ -1043,10 +2287,8 @@ void FreeAllocInfo(MemArena_t* refArena, MemArena_t* arena, void* allocPntr)
 		void* missingInfoPntr = FindMissingAllocInfoInArena(refArena, &missingInfoSize);
 		UNUSED(missingInfoSize);
 		UNUSED(missingInfoPntr);
-		refArena->debugArena = nullptr;
-		MemArenaAllocInfo_t* extraAllocInfo = FindExtraAllocInfoInArena(arena, refArena);
+		MemArenaAllocInfo_t* extraAllocInfo = FindExtraAllocInfoInArena(refArena);
 		UNUSED(extraAllocInfo);
-		refArena->debugArena = arena;
 		MyDebugBreak();
 		#endif
 	}
@@ -1264,9 +2506,9 @@ bool MemArenaVerify(MemArena_t* arena, bool assertOnFailure = false)
 				if (didLock) { UnlockGyMutex(&arena->mutex); }
 				return false;
 			}
-			if (arena->otherPntr != nullptr)
+			if (arena->otherPntr == nullptr && arena->numPages > 0)
 			{
-				AssertIfMsg(assertOnFailure, false, "otherPntr was filled when it shouldn't be!");
+				AssertIfMsg(assertOnFailure, false, "otherPntr (free index) was empty but numPages > 0!");
 				if (didLock) { UnlockGyMutex(&arena->mutex); }
 				return false;
 			}
@@ -1285,9 +2527,13 @@ bool MemArenaVerify(MemArena_t* arena, bool assertOnFailure = false)
 			
 			u64 numAllocations = 0;
 			u64 totalNumSections = 0;
+			u64 numFreeSections = 0;
+			u64 totalSize = 0;
+			u64 totalUsed = 0;
 			bool missingDebugForAllocation = false;
 			
 			HeapPageHeader_t* pageHeader = (HeapPageHeader_t*)arena->headerPntr;
+			HeapPageHeader_t* prevPageHeader = nullptr;
 			u64 pageIndex = 0;
 			while (pageHeader != nullptr)
 			{
@@ -1309,95 +2555,59 @@ bool MemArenaVerify(MemArena_t* arena, bool assertOnFailure = false)
 					if (didLock) { UnlockGyMutex(&arena->mutex); }
 					return false;
 				}
-				if (pageHeader->used > pageHeader->size)
-				{
-					AssertIfMsg(assertOnFailure, false, "Page used is higher than size! That's not right!");
-					if (didLock) { UnlockGyMutex(&arena->mutex); }
-					return false;
-				}
-				if (pageIndex >= arena->numPages)
-				{
-					AssertIfMsg(assertOnFailure, false, "The numPages in this paged heap is off. We have too many pages or the last pointer to a page was corrupt!");
-					if (didLock) { UnlockGyMutex(&arena->mutex); }
-					return false;
-				}
-				if (IsFlagSet(arena->flags, MemArenaFlag_CacheFreeOffset))
-				{
-					if (pageHeader->cachedFreeOffset > pageHeader->size)
-					{
-						AssertIfMsg(assertOnFailure, false, "The cachedFreeOffset is outside the bounds of the page!");
-						if (didLock) { UnlockGyMutex(&arena->mutex); }
-						return false;
-					}
-					if (pageHeader->cachedFreeOffset < pageHeader->size && pageHeader->cachedFreeOffset + sizeof(HeapAllocPrefix_t) > pageHeader->size)
-					{
-						AssertIfMsg(assertOnFailure, false, "The cachedFreeOffset points to a spot that leaks off the end of the page!");
-						if (didLock) { UnlockGyMutex(&arena->mutex); }
-						return false;
-					}
+				if (pageHeader->prev != prevPageHeader)
+				{
+					AssertIfMsg(assertOnFailure, false, "Page prev pntr doesn't point to the previous page in the chain!");
+					if (didLock) { UnlockGyMutex(&arena->mutex); }
+					return false;
+				}
+				if (pageIndex >= arena->numPages)
+				{
+					AssertIfMsg(assertOnFailure, false, "The numPages in this paged heap is off. We have too many pages or the last pointer to a page was corrupt!");
+					if (didLock) { UnlockGyMutex(&arena->mutex); }
+					return false;
 				}
 				
 				u8* pageBase = (u8*)(pageHeader + 1);
-				
-				if (IsFlagSet(arena->flags, MemArenaFlag_CacheFreeOffset) && pageHeader->cachedFreeOffset < pageHeader->size)
+				HeapAllocPrefix_t* sentinelPrefix = (HeapAllocPrefix_t*)(pageBase + pageHeader->size);
+				if (!IsAllocPrefixFilled(sentinelPrefix->size) || UnpackAllocPrefixSize(sentinelPrefix->size) != 0)
 				{
-					HeapAllocPrefix_t* freePrefixPntr = (HeapAllocPrefix_t*)(pageBase + pageHeader->cachedFreeOffset);
-					bool isSectionFilled = IsAllocPrefixFilled(freePrefixPntr->size);
-					u64 sectionSize = UnpackAllocPrefixSize(freePrefixPntr->size);
-					if (isSectionFilled)
-					{
-						AssertIfMsg(assertOnFailure, false, "The cachedFreeOffset points to a filled section!");
-						if (didLock) { UnlockGyMutex(&arena->mutex); }
-						return false;
-					}
-					if (sectionSize < CACHED_FREE_MIN_SIZE)
-					{
-						AssertIfMsg(assertOnFailure, false, "The cachedFreeOffset points to a section that is smaller than CACHED_FREE_MIN_SIZE!");
-						if (didLock) { UnlockGyMutex(&arena->mutex); }
-						return false;
-					}
-					if (pageHeader->cachedFreeOffset + sectionSize > pageHeader->size)
-					{
-						AssertIfMsg(assertOnFailure, false, "The cachedFreeOffset points to a section leaks off the end of the page!");
-						if (didLock) { UnlockGyMutex(&arena->mutex); }
-						return false;
-					}
+					AssertIfMsg(assertOnFailure, false, "The sentinel section at the end of a page was corrupt. Did someone write past the end of an allocation?");
+					if (didLock) { UnlockGyMutex(&arena->mutex); }
+					return false;
 				}
 				
 				u64 allocOffset = 0;
 				u8* allocBytePntr = pageBase;
 				u64 sectionIndex = 0;
-				HeapAllocPrefix_t* prevPrefixPntr = nullptr;
-				bool foundCachedFreeSection = false;
+				bool prevSectionFree = false;
 				while (allocOffset < pageHeader->size)
 				{
 					HeapAllocPrefix_t* prefixPntr = (HeapAllocPrefix_t*)allocBytePntr;
 					u8* afterPrefixPntr = (allocBytePntr + sizeof(HeapAllocPrefix_t));
 					bool isSectionFilled = IsAllocPrefixFilled(prefixPntr->size);
 					u64 sectionSize = UnpackAllocPrefixSize(prefixPntr->size);
-					if (sectionSize < sizeof(HeapAllocPrefix_t))
+					if (sectionSize < HEAP_MIN_SECTION_SIZE || (sectionSize % HEAP_SECTION_GRANULARITY) != 0)
 					{
-						AssertIfMsg(assertOnFailure, false, "Found an allocation header that claimed to be smaller than the header itself in Paged Heap");
+						AssertIfMsg(assertOnFailure, false, "Found a section that was smaller than HEAP_MIN_SECTION_SIZE or not a multiple of HEAP_SECTION_GRANULARITY in Paged Heap");
 						if (didLock) { UnlockGyMutex(&arena->mutex); }
 						return false;
 					}
-					u64 afterPrefixSize = sectionSize - sizeof(HeapAllocPrefix_t);
-					if (afterPrefixSize == 0)
+					if (allocOffset + sectionSize > pageHeader->size)
 					{
-						AssertIfMsg(assertOnFailure, false, "Found an empty section that was only big enough to contain the allocation header");
+						AssertIfMsg(assertOnFailure, false, "Found a corrupt allocation header size. It would step us past the end of a page!");
 						if (didLock) { UnlockGyMutex(&arena->mutex); }
 						return false;
 					}
-					if (allocOffset + sectionSize > pageHeader->size)
+					if (IsFlagSet(prefixPntr->size, HEAP_ALLOC_FIRST_FLAG) != (sectionIndex == 0))
 					{
-						AssertIfMsg(assertOnFailure, false, "Found a corrupt allocation header size. It would step us past the end of a page!");
+						AssertIfMsg(assertOnFailure, false, "HEAP_ALLOC_FIRST_FLAG should be set on the first section of each page and nowhere else!");
 						if (didLock) { UnlockGyMutex(&arena->mutex); }
 						return false;
 					}
-					if (allocOffset == pageHeader->cachedFreeOffset) { foundCachedFreeSection = true; }
-					else if (pageHeader->cachedFreeOffset > allocOffset && pageHeader->cachedFreeOffset < allocOffset + sectionSize)
+					if (IsFlagSet(prefixPntr->size, HEAP_ALLOC_PREV_FREE_FLAG) != prevSectionFree)
 					{
-						AssertIfMsg(assertOnFailure, false, "The cachedFreeOffset points to the middle of a section!");
+						AssertIfMsg(assertOnFailure, false, "HEAP_ALLOC_PREV_FREE_FLAG doesn't match the state of the previous section!");
 						if (didLock) { UnlockGyMutex(&arena->mutex); }
 						return false;
 					}
@@ -1407,7 +2617,7 @@ bool MemArenaVerify(MemArena_t* arena, bool assertOnFailure = false)
 						#if GYLIB_MEM_ARENA_DEBUG_ENABLED
 						if (arena->debugArena != nullptr)
 						{
-							MemArenaAllocInfo_t* allocInfo = FindAllocInfoFor(arena, afterPrefixPntr);
+							MemArenaAllocInfo_t* allocInfo = FindAllocInfoForHeapSection(arena, afterPrefixPntr, sectionSize - sizeof(HeapAllocPrefix_t));
 							if (allocInfo == nullptr)
 							{
 								AssertIfMsg(assertOnFailure, false, "An allocation does NOT have associated metadata backing it in the debugArena!");
@@ -1420,26 +2630,112 @@ bool MemArenaVerify(MemArena_t* arena, bool assertOnFailure = false)
 						#endif
 						
 						numAllocations++;
+						totalUsed += sectionSize;
+					}
+					else
+					{
+						if (prevSectionFree)
+						{
+							AssertIfMsg(assertOnFailure, false, "Found two free sections next to each other. They should have been merged!");
+							if (didLock) { UnlockGyMutex(&arena->mutex); }
+							return false;
+						}
+						if (*((u64*)(allocBytePntr + sectionSize - sizeof(u64))) != sectionSize)
+						{
+							AssertIfMsg(assertOnFailure, false, "The footer of a free section doesn't match it's size. Did someone write to freed memory?");
+							if (didLock) { UnlockGyMutex(&arena->mutex); }
+							return false;
+						}
+						numFreeSections++;
+						totalUsed += sizeof(HeapAllocPrefix_t);
 					}
 					
-					prevPrefixPntr = prefixPntr;
+					prevSectionFree = !isSectionFilled;
 					allocOffset += sectionSize;
 					allocBytePntr += sectionSize;
 					totalNumSections++;
 					sectionIndex++;
 				}
-				
-				if (IsFlagSet(arena->flags, MemArenaFlag_CacheFreeOffset) && !foundCachedFreeSection && pageHeader->cachedFreeOffset < pageHeader->size)
+				if (IsFlagSet(sentinelPrefix->size, HEAP_ALLOC_PREV_FREE_FLAG) != prevSectionFree)
 				{
-					AssertIfMsg(assertOnFailure, false, "Couldn't find cachedFreeOffset section somehow?!");
+					AssertIfMsg(assertOnFailure, false, "HEAP_ALLOC_PREV_FREE_FLAG on the sentinel doesn't match the state of the last section in the page!");
 					if (didLock) { UnlockGyMutex(&arena->mutex); }
 					return false;
 				}
 				
+				totalSize += pageHeader->size;
+				prevPageHeader = pageHeader;
 				pageHeader = pageHeader->next;
 				pageIndex++;
 			}
 			
+			if (totalSize != arena->size)
+			{
+				AssertIfMsg(assertOnFailure, false, "PagedHeap size doesn't match the sum of it's page sizes");
+				if (didLock) { UnlockGyMutex(&arena->mutex); }
+				return false;
+			}
+			if (totalUsed != arena->used)
+			{
+				AssertIfMsg(assertOnFailure, false, "PagedHeap used doesn't match the actual sum of filled sections and free prefixes");
+				if (didLock) { UnlockGyMutex(&arena->mutex); }
+				return false;
+			}
+			
+			if (arena->otherPntr != nullptr)
+			{
+				HeapFreeIndex_t* freeIndex = (HeapFreeIndex_t*)arena->otherPntr;
+				u64 numIndexedSections = 0;
+				for (u64 firstLevel = 0; firstLevel < HEAP_FREE_INDEX_FL_COUNT; firstLevel++)
+				{
+					bool firstLevelBitSet = IsFlagSet(freeIndex->firstLevelBitmap, (1ULL << firstLevel));
+					if (firstLevelBitSet != (freeIndex->secondLevelBitmaps[firstLevel] != 0))
+					{
+						AssertIfMsg(assertOnFailure, false, "PagedHeap free index first level bitmap doesn't match the second level bitmaps");
+						if (didLock) { UnlockGyMutex(&arena->mutex); }
+						return false;
+					}
+					for (u64 secondLevel = 0; secondLevel < HEAP_FREE_INDEX_SL_COUNT; secondLevel++)
+					{
+						HeapFreeSection_t* section = freeIndex->lists[firstLevel][secondLevel];
+						if (IsFlagSet(freeIndex->secondLevelBitmaps[firstLevel], (u16)(1 << secondLevel)) != (section != nullptr))
+						{
+							AssertIfMsg(assertOnFailure, false, "PagedHeap free index second level bitmap doesn't match the lists");
+							if (didLock) { UnlockGyMutex(&arena->mutex); }
+							return false;
+						}
+						HeapFreeSection_t* prevSection = nullptr;
+						while (section != nullptr)
+						{
+							if (IsAllocPrefixFilled(section->prefix.size) || section->prevFree != prevSection)
+							{
+								AssertIfMsg(assertOnFailure, false, "PagedHeap free index contains a corrupt section");
+								if (didLock) { UnlockGyMutex(&arena->mutex); }
+								return false;
+							}
+							u64 sectionFirstLevel, sectionSecondLevel;
+							GetHeapFreeIndexMapping(UnpackAllocPrefixSize(section->prefix.size), &sectionFirstLevel, &sectionSecondLevel);
+							if (sectionFirstLevel != firstLevel || sectionSecondLevel != secondLevel)
+							{
+								AssertIfMsg(assertOnFailure, false, "PagedHeap free index has a section in the wrong list for it's size");
+								if (didLock) { UnlockGyMutex(&arena->mutex); }
+								return false;
+							}
+							numIndexedSections++;
+							if (numIndexedSections > numFreeSections) { break; }
+							prevSection = section;
+							section = section->nextFree;
+						}
+					}
+				}
+				if (numIndexedSections != numFreeSections)
+				{
+					AssertIfMsg(assertOnFailure, false, "PagedHeap free index doesn't hold the same number of sections as we found walking the pages");
+					if (didLock) { UnlockGyMutex(&arena->mutex); }
+					return false;
+				}
+			}
+			
 			if (IsFlagSet(arena->flags, MemArenaFlag_TelemetryEnabled) && numAllocations != arena->numAllocations)
 			{
 				AssertIfMsg(assertOnFailure, false, "Actual allocation count in paged heap did not match tracked numAllocations");
@@ -1455,6 +2751,7 @@ bool MemArenaVerify(MemArena_t* arena, bool assertOnFailure = false)
 		// | MemArenaType_MarkedStack MemArenaVerify  |
 		// +==========================================+
 		case MemArenaType_MarkedStack:
+		case MemArenaType_MappedFile:
 		{
 			if (arena->size == 0)
 			{
@@ -1532,7 +2829,8 @@ bool MemArenaVerify(MemArena_t* arena, bool assertOnFailure = false)
 					return false;
 				}
 			}
-			u8* expectedOtherPntr = ((u8*)arena->headerPntr) + sizeof(MarkedStackArenaHeader_t);
+			u64 headerSize = (arena->type == MemArenaType_MappedFile) ? sizeof(MappedFileArenaHeader_t) : sizeof(MarkedStackArenaHeader_t);
+			u8* expectedOtherPntr = ((u8*)arena->headerPntr) + headerSize;
 			if (arena->otherPntr != expectedOtherPntr)
 			{
 				AssertIfMsg(assertOnFailure, false, "otherPntr is not where it's supposed to be compared to headerPntr");
@@ -1798,6 +3096,244 @@ bool MemArenaVerify(MemArena_t* arena, bool assertOnFailure = false)
 		// 	//TODO: Implement me!
 		// } break;
 		
+		// +==================================+
+		// | MemArenaType_Slab MemArenaVerify |
+		// +==================================+
+		case MemArenaType_Slab:
+		{
+			if (arena->headerPntr == nullptr)
+			{
+				AssertIfMsg(assertOnFailure, false, "Slab arena has nullptr headerPntr!");
+				if (didLock) { UnlockGyMutex(&arena->mutex); }
+				return false;
+			}
+			if (arena->sourceArena == nullptr)
+			{
+				AssertIfMsg(assertOnFailure, false, "Slab arena has nullptr sourceArena!");
+				if (didLock) { UnlockGyMutex(&arena->mutex); }
+				return false;
+			}
+			SlabArenaHeader_t* slabHeader = (SlabArenaHeader_t*)arena->headerPntr;
+			if (arena->numPages > slabHeader->pageListSize || (arena->numPages > 0 && slabHeader->pages == nullptr))
+			{
+				AssertIfMsg(assertOnFailure, false, "Slab arena numPages doesn't fit in the page list!");
+				if (didLock) { UnlockGyMutex(&arena->mutex); }
+				return false;
+			}
+			
+			u64 totalSize = 0;
+			u64 numSlotsInClass[SLAB_NUM_SIZE_CLASSES] = {};
+			for (u64 pIndex = 0; pIndex < arena->numPages; pIndex++)
+			{
+				SlabPageHeader_t* pageHeader = slabHeader->pages[pIndex];
+				if (pIndex > 0 && (u8*)slabHeader->pages[pIndex-1] + slabHeader->pages[pIndex-1]->pageSize > (u8*)pageHeader)
+				{
+					AssertIfMsg(assertOnFailure, false, "Slab arena page list is not sorted or has overlapping pages!");
+					if (didLock) { UnlockGyMutex(&arena->mutex); }
+					return false;
+				}
+				if (pageHeader->sizeClass >= SLAB_NUM_SIZE_CLASSES || pageHeader->slotSize != (SLAB_MIN_SLOT_SIZE << pageHeader->sizeClass))
+				{
+					AssertIfMsg(assertOnFailure, false, "Slab page has an invalid sizeClass or slotSize!");
+					if (didLock) { UnlockGyMutex(&arena->mutex); }
+					return false;
+				}
+				if (pageHeader->slotsBase < (u8*)(pageHeader + 1) || pageHeader->slotsBase + (pageHeader->numSlots * pageHeader->slotSize) > (u8*)pageHeader + pageHeader->pageSize)
+				{
+					AssertIfMsg(assertOnFailure, false, "Slab page slots extend outside the page!");
+					if (didLock) { UnlockGyMutex(&arena->mutex); }
+					return false;
+				}
+				numSlotsInClass[pageHeader->sizeClass] += pageHeader->numSlots;
+				totalSize += pageHeader->numSlots * pageHeader->slotSize;
+			}
+			if (totalSize != arena->size)
+			{
+				AssertIfMsg(assertOnFailure, false, "Slab arena size doesn't match the total size of the slots in it's pages!");
+				if (didLock) { UnlockGyMutex(&arena->mutex); }
+				return false;
+			}
+			
+			u64 totalSlotsUsed = 0;
+			for (u64 cIndex = 0; cIndex < SLAB_NUM_SIZE_CLASSES; cIndex++)
+			{
+				u64 slotSize = (SLAB_MIN_SLOT_SIZE << cIndex);
+				u64 numFreeSlots = 0;
+				void* freeSlot = slabHeader->freeLists[cIndex];
+				while (freeSlot != nullptr)
+				{
+					SlabPageHeader_t* pageHeader = FindSlabPageFor(arena, freeSlot);
+					if (pageHeader == nullptr || pageHeader->sizeClass != cIndex || (((u8*)freeSlot - pageHeader->slotsBase) % slotSize) != 0)
+					{
+						AssertIfMsg(assertOnFailure, false, "Slab free list contains a pntr that isn't a slot of the correct size class!");
+						if (didLock) { UnlockGyMutex(&arena->mutex); }
+						return false;
+					}
+					numFreeSlots++;
+					if (numFreeSlots > numSlotsInClass[cIndex])
+					{
+						AssertIfMsg(assertOnFailure, false, "Slab free list is longer than the number of slots in the size class. Maybe it has a loop?");
+						if (didLock) { UnlockGyMutex(&arena->mutex); }
+						return false;
+					}
+					freeSlot = *((void**)freeSlot);
+				}
+				u64 numUncarvedSlots = (u64)(slabHeader->carveEnds[cIndex] - slabHeader->carvePntrs[cIndex]) / slotSize;
+				if (numFreeSlots + numUncarvedSlots > numSlotsInClass[cIndex])
+				{
+					AssertIfMsg(assertOnFailure, false, "Slab size class has more free slots than slots!");
+					if (didLock) { UnlockGyMutex(&arena->mutex); }
+					return false;
+				}
+				totalSlotsUsed += (numSlotsInClass[cIndex] - numFreeSlots - numUncarvedSlots) * slotSize;
+			}
+			if (totalSlotsUsed > arena->used)
+			{
+				AssertIfMsg(assertOnFailure, false, "Slab arena used is less than the total size of the filled slots!");
+				if (didLock) { UnlockGyMutex(&arena->mutex); }
+				return false;
+			}
+		} break;
+		
+		// +==========================================+
+		// | MemArenaType_ThreadCached MemArenaVerify |
+		// +==========================================+
+		case MemArenaType_ThreadCached:
+		{
+			if (arena->headerPntr == nullptr)
+			{
+				AssertIfMsg(assertOnFailure, false, "ThreadCached arena has nullptr headerPntr!");
+				if (didLock) { UnlockGyMutex(&arena->mutex); }
+				return false;
+			}
+			if (arena->sourceArena == nullptr)
+			{
+				AssertIfMsg(assertOnFailure, false, "ThreadCached arena has nullptr sourceArena!");
+				if (didLock) { UnlockGyMutex(&arena->mutex); }
+				return false;
+			}
+			//NOTE: Other threads can be changing their caches while we look at them, so we only check the calling thread's cache in depth
+			ThreadCacheArenaHeader_t* cacheHeader = (ThreadCacheArenaHeader_t*)arena->headerPntr;
+			ThreadCache_t* ourCache = FindThreadCache(arena);
+			//Caches are only ever added to the front of the list under the sourceMutex, so everything after this firstCache stays put
+			LockThreadCacheSource(arena, nullptr);
+			ThreadCache_t* firstCache = cacheHeader->firstCache;
+			u64 maxNumCaches = cacheHeader->numCaches;
+			UnlockThreadCacheSource(arena);
+			u64 numCaches = 0;
+			bool foundOurCache = false;
+			ThreadCache_t* cache = firstCache;
+			while (cache != nullptr)
+			{
+				numCaches++;
+				if (numCaches > maxNumCaches)
+				{
+					AssertIfMsg(assertOnFailure, false, "ThreadCached arena has more caches in it's list than numCaches. Maybe the list has a loop?");
+					if (didLock) { UnlockGyMutex(&arena->mutex); }
+					return false;
+				}
+				if (cache == ourCache) { foundOurCache = true; }
+				cache = cache->next;
+			}
+			if (ourCache != nullptr && !foundOurCache)
+			{
+				AssertIfMsg(assertOnFailure, false, "The calling thread's ThreadCache is not in the ThreadCached arena's list!");
+				if (didLock) { UnlockGyMutex(&arena->mutex); }
+				return false;
+			}
+			if (ourCache != nullptr)
+			{
+				for (u64 cIndex = 0; cIndex < SLAB_NUM_SIZE_CLASSES; cIndex++)
+				{
+					u64 numBlocks = 0;
+					void* blockPntr = ourCache->freeLists[cIndex];
+					while (blockPntr != nullptr)
+					{
+						ThreadCacheBlockPrefix_t* prefix = ((ThreadCacheBlockPrefix_t*)blockPntr) - 1;
+						if (prefix->owner != ourCache || prefix->sizeClass != cIndex)
+						{
+							AssertIfMsg(assertOnFailure, false, "ThreadCache free list contains a block that belongs to a different cache or size class!");
+							if (didLock) { UnlockGyMutex(&arena->mutex); }
+							return false;
+						}
+						numBlocks++;
+						if (numBlocks > ourCache->numCached[cIndex])
+						{
+							AssertIfMsg(assertOnFailure, false, "ThreadCache free list is longer than numCached. Maybe it has a loop?");
+							if (didLock) { UnlockGyMutex(&arena->mutex); }
+							return false;
+						}
+						blockPntr = *((void**)blockPntr);
+					}
+					if (numBlocks != ourCache->numCached[cIndex])
+					{
+						AssertIfMsg(assertOnFailure, false, "ThreadCache free list is shorter than numCached!");
+						if (didLock) { UnlockGyMutex(&arena->mutex); }
+						return false;
+					}
+				}
+			}
+		} break;
+		
+		// +==================================+
+		// | MemArenaType_Ring MemArenaVerify |
+		// +==================================+
+		case MemArenaType_Ring:
+		{
+			if (arena->headerPntr == nullptr || arena->otherPntr == nullptr || arena->mainPntr == nullptr)
+			{
+				AssertIfMsg(assertOnFailure, false, "Ring arena has a nullptr headerPntr, otherPntr, or mainPntr!");
+				if (didLock) { UnlockGyMutex(&arena->mutex); }
+				return false;
+			}
+			RingArenaHeader_t* ringHeader = (RingArenaHeader_t*)arena->headerPntr;
+			RingArenaFrame_t* frames = (RingArenaFrame_t*)arena->otherPntr;
+			if (ringHeader->tailPos > ringHeader->headPos || ringHeader->headPos - ringHeader->tailPos > arena->size)
+			{
+				AssertIfMsg(assertOnFailure, false, "Ring arena head is behind the tail or more than size ahead of it!");
+				if (didLock) { UnlockGyMutex(&arena->mutex); }
+				return false;
+			}
+			if (arena->used != ringHeader->headPos - ringHeader->tailPos)
+			{
+				AssertIfMsg(assertOnFailure, false, "Ring arena used doesn't match the distance between head and tail!");
+				if (didLock) { UnlockGyMutex(&arena->mutex); }
+				return false;
+			}
+			if (ringHeader->oldestFrameId > ringHeader->currentFrameId || ringHeader->currentFrameId - ringHeader->oldestFrameId >= ringHeader->maxNumFrames)
+			{
+				AssertIfMsg(assertOnFailure, false, "Ring arena has an invalid number of live frames!");
+				if (didLock) { UnlockGyMutex(&arena->mutex); }
+				return false;
+			}
+			if (frames[ringHeader->oldestFrameId % ringHeader->maxNumFrames].startPos != ringHeader->tailPos)
+			{
+				AssertIfMsg(assertOnFailure, false, "Ring arena tail doesn't match the start of the oldest live frame!");
+				if (didLock) { UnlockGyMutex(&arena->mutex); }
+				return false;
+			}
+			u64 prevStartPos = ringHeader->tailPos;
+			u64 numAllocations = 0;
+			for (u64 frameId = ringHeader->oldestFrameId; frameId <= ringHeader->currentFrameId; frameId++)
+			{
+				RingArenaFrame_t* frame = &frames[frameId % ringHeader->maxNumFrames];
+				if (frame->startPos < prevStartPos || frame->startPos > ringHeader->headPos)
+				{
+					AssertIfMsg(assertOnFailure, false, "Ring arena frames are out of order!");
+					if (didLock) { UnlockGyMutex(&arena->mutex); }
+					return false;
+				}
+				prevStartPos = frame->startPos;
+				numAllocations += frame->numAllocations;
+			}
+			if (numAllocations != arena->numAllocations)
+			{
+				AssertIfMsg(assertOnFailure, false, "Ring arena numAllocations doesn't match the sum of it's live frames!");
+				if (didLock) { UnlockGyMutex(&arena->mutex); }
+				return false;
+			}
+		} break;
+		
 		// +====================================+
 		// | Unsupported or Corrupt Arena Type  |
 		// +====================================+
@@ -1827,12 +3363,13 @@ void* AllocMem_(MemArena_t* arena, u64 numBytes, AllocAlignment_t alignOverride,
 	AssertMsg(arena->type != MemArenaType_None, "Tried to allocate from uninitialized arena");
 	
 	PerfTime_t startTime;
-	if (IsFlagSet(arena->flags, MemArenaFlag_TrackTime)) { startTime = GetPerfTime(); }
+	if (IsFlagSet(arena->flags, MemArenaFlag_TrackTime) || IsFlagSet(arena->flags, MemArenaFlag_Histograms)) { startTime = GetPerfTime(); }
 	
 	bool didLock = false;
 	if (IsValidGyMutex(&arena->mutex)) { LockGyMutex(&arena->mutex); didLock = true; }
 	
-	if (IsFlagSet(arena->flags, MemArenaFlag_TelemetryEnabled) && arena->resettableHighUsedMark < arena->used) { arena->resettableHighUsedMark = arena->used; }
+	//ThreadCached arenas are used from many threads without arena->mutex, their stats are only touched while holding the sourceMutex (see LockThreadCacheSource)
+	if (IsFlagSet(arena->flags, MemArenaFlag_TelemetryEnabled) && arena->type != MemArenaType_ThreadCached && arena->resettableHighUsedMark < arena->used) { arena->resettableHighUsedMark = arena->used; }
 	
 	if (IsFlagSet(arena->flags, MemArenaFlag_BreakOnAlloc) && (arena->debugBreakThreshold == 0 || numBytes >= arena->debugBreakThreshold))
 	{
@@ -1901,7 +3438,12 @@ void* AllocMem_(MemArena_t* arena, u64 numBytes, AllocAlignment_t alignOverride,
 		case MemArenaType_StdHeap:
 		{
 			AssertMsg(alignment == AllocAlignment_None, "Tried to align memory in StdHeap arena type");
+			#if STD_HEAP_REMAP_SUPPORTED
+			result = (numBytes >= STD_HEAP_REMAP_THRESHOLD) ? AllocStdHeapMapped(numBytes) : nullptr;
+			if (result == nullptr) { result = (u8*)MyMalloc(numBytes); }
+			#else
 			result = (u8*)MyMalloc(numBytes);
+			#endif
 			if (result == nullptr) { break; }
 			IncrementU64(arena->numAllocations);
 			arena->used += numBytes;
@@ -1917,6 +3459,7 @@ void* AllocMem_(MemArena_t* arena, u64 numBytes, AllocAlignment_t alignOverride,
 		case MemArenaType_FixedHeap:
 		{
 			NotNull(arena->mainPntr);
+			AssertMsg(alignment <= AllocAlignment_Max, "FixedHeap doesn't support alignment above AllocAlignment_Max");
 			
 			//TODO: Assert a maximum sized based off the fact that our top bit stores filled info
 			
@@ -1934,7 +3477,7 @@ void* AllocMem_(MemArena_t* arena, u64 numBytes, AllocAlignment_t alignOverride,
 				u64 allocAfterPrefixSize = allocSize - sizeof(HeapAllocPrefix_t);
 				if (!isAllocFilled)
 				{
-					u8 alignOffset = OffsetToAlign(allocAfterPrefixPntr, alignment);
+					u8 alignOffset = (u8)OffsetToAlign(allocAfterPrefixPntr, alignment);
 					if (allocAfterPrefixSize >= alignOffset + numBytes)
 					{
 						result = allocAfterPrefixPntr + alignOffset;
@@ -1957,230 +3500,74 @@ void* AllocMem_(MemArena_t* arena, u64 numBytes, AllocAlignment_t alignOverride,
 						arena->numAllocations++;
 						if (IsFlagSet(arena->flags, MemArenaFlag_TelemetryEnabled))
 						{
-							if (arena->highUsedMark < arena->used) { arena->highUsedMark = arena->used; }
-							if (arena->resettableHighUsedMark < arena->used) { arena->resettableHighUsedMark = arena->used; }
-							if (arena->highAllocMark < arena->numAllocations) { arena->highAllocMark = arena->numAllocations; }
-						}
-						break;
-					}
-				}
-				allocOffset += allocSize;
-				allocBytePntr += allocSize;
-				sectionIndex++;
-			}
-			UNUSED(sectionIndex); //used for debug purposes
-			AssertIfMsg(result == nullptr, allocOffset == arena->size, "A Fixed Heap is corrupt. The last allocation size does not perfectly match the size of the arena");
-			
-			// MemArenaVerify(arena, true); //TODO: Remove me when not debugging
-		} break;
-		
-		// +==================================+
-		// | MemArenaType_PagedHeap AllocMem  |
-		// +==================================+
-		case MemArenaType_PagedHeap:
-		{
-			HeapPageHeader_t* pageHeader = (HeapPageHeader_t*)arena->headerPntr;
-			u64 pageIndex = 0;
-			while (pageHeader != nullptr)
-			{
-				if (pageHeader->size - pageHeader->used < numBytes)
-				{
-					pageHeader = pageHeader->next;
-					pageIndex++;
-					continue;
-				}
-				
-				u64 allocOffset = (IsFlagSet(arena->flags, MemArenaFlag_CacheFreeOffset) && pageHeader->cachedFreeOffset < pageHeader->size) ? pageHeader->cachedFreeOffset : 0;
-				u8* allocBytePntr = ((u8*)(pageHeader + 1)) + allocOffset;
-				u64 walkIndex = 0;
-				bool searchingForNextFreeSection = false;
-				while (allocOffset < pageHeader->size)
-				{
-					HeapAllocPrefix_t* allocPntr = (HeapAllocPrefix_t*)allocBytePntr;
-					u8* allocAfterPrefixPntr = (allocBytePntr + sizeof(HeapAllocPrefix_t));
-					bool isAllocFilled = IsAllocPrefixFilled(allocPntr->size);
-					u64 allocSize = UnpackAllocPrefixSize(allocPntr->size);
-					AssertMsg(allocSize >= sizeof(HeapAllocPrefix_t), "Found an allocation header that claimed to be smaller than the header itself in Fixed Heap");
-					AssertMsg(allocOffset + allocSize <= pageHeader->size, "Found an allocation header with invalid size. Would extend past the end of a page!");
-					u64 allocAfterPrefixSize = allocSize - sizeof(HeapAllocPrefix_t);
-					if (!isAllocFilled)
-					{
-						if (searchingForNextFreeSection)
-						{
-							if (allocAfterPrefixSize >= CACHED_FREE_MIN_SIZE)
-							{
-								pageHeader->cachedFreeOffset = allocOffset;
-								searchingForNextFreeSection = false;
-								break;
-							}
-						}
-						else
-						{
-							u8 alignOffset = OffsetToAlign(allocAfterPrefixPntr, alignment);
-							if (allocAfterPrefixSize >= alignOffset + numBytes)
-							{
-								result = allocAfterPrefixPntr + alignOffset;
-								if (allocAfterPrefixSize > alignOffset + numBytes + sizeof(HeapAllocPrefix_t))
-								{
-									//Split the section into 2 (one filled and one empty)
-									allocPntr->size = PackAllocPrefixSize(true, sizeof(HeapAllocPrefix_t) + alignOffset + numBytes);
-									HeapAllocPrefix_t* newSection = (HeapAllocPrefix_t*)(allocAfterPrefixPntr + alignOffset + numBytes);
-									u64 newSectionSize = allocAfterPrefixSize - (alignOffset + numBytes);
-									newSection->size = PackAllocPrefixSize(false, newSectionSize);
-									pageHeader->used += alignOffset + numBytes + sizeof(HeapAllocPrefix_t);
-									arena->used += alignOffset + numBytes + sizeof(HeapAllocPrefix_t);
-									Assert(pageHeader->used <= pageHeader->size);
-									Assert(arena->used <= arena->size);
-									
-									if (allocOffset == pageHeader->cachedFreeOffset && IsFlagSet(arena->flags, MemArenaFlag_CacheFreeOffset))
-									{
-										if (newSectionSize - sizeof(HeapAllocPrefix_t) >= CACHED_FREE_MIN_SIZE)
-										{
-											pageHeader->cachedFreeOffset = allocOffset + sizeof(HeapAllocPrefix_t) + alignOffset + numBytes;
-										}
-										else
-										{
-											allocSize = sizeof(HeapAllocPrefix_t) + alignOffset + numBytes;
-											pageHeader->cachedFreeOffset = pageHeader->size;
-											searchingForNextFreeSection = true;
-										}
-									}
-								}
-								else
-								{
-									//This entire section is getting used (or there's not enough extra room to make another empty section)
-									allocPntr->size = PackAllocPrefixSize(true, allocSize);
-									pageHeader->used += allocSize - sizeof(HeapAllocPrefix_t);
-									arena->used += allocSize - sizeof(HeapAllocPrefix_t);
-									Assert(pageHeader->used <= pageHeader->size);
-									Assert(arena->used <= arena->size);
-									if (allocOffset == pageHeader->cachedFreeOffset && IsFlagSet(arena->flags, MemArenaFlag_CacheFreeOffset))
-									{
-										pageHeader->cachedFreeOffset = pageHeader->size;
-										searchingForNextFreeSection = true;
-									}
-								}
-								arena->numAllocations++;
-								if (IsFlagSet(arena->flags, MemArenaFlag_TelemetryEnabled))
-								{
-									if (arena->highUsedMark < arena->used) { arena->highUsedMark = arena->used; }
-									if (arena->resettableHighUsedMark < arena->used) { arena->resettableHighUsedMark = arena->used; }
-									if (arena->highAllocMark < arena->numAllocations) { arena->highAllocMark = arena->numAllocations; }
-								}
-								if (!searchingForNextFreeSection) { break; }
-							}
+							if (arena->highUsedMark < arena->used) { arena->highUsedMark = arena->used; }
+							if (arena->resettableHighUsedMark < arena->used) { arena->resettableHighUsedMark = arena->used; }
+							if (arena->highAllocMark < arena->numAllocations) { arena->highAllocMark = arena->numAllocations; }
 						}
+						break;
 					}
-					
-					allocBytePntr += allocSize;
-					allocOffset += allocSize;
-					walkIndex++;
 				}
-				UNUSED(walkIndex); //used for debug purposes
-				
-				if (result != nullptr) { break; }
-				pageHeader = pageHeader->next;
-				pageIndex++;
+				allocOffset += allocSize;
+				allocBytePntr += allocSize;
+				sectionIndex++;
 			}
+			UNUSED(sectionIndex); //used for debug purposes
+			AssertIfMsg(result == nullptr, allocOffset == arena->size, "A Fixed Heap is corrupt. The last allocation size does not perfectly match the size of the arena");
 			
-			// +==============================+
-			// |      Allocate New Page       |
-			// +==============================+
-			if (result == nullptr && (arena->maxNumPages == 0 || arena->numPages < arena->maxNumPages))
+			// MemArenaVerify(arena, true); //TODO: Remove me when not debugging
+		} break;
+		
+		// +==================================+
+		// | MemArenaType_PagedHeap AllocMem  |
+		// +==================================+
+		case MemArenaType_PagedHeap:
+		{
+			AssertMsg(alignment <= AllocAlignment_Max, "PagedHeap doesn't support alignment above AllocAlignment_Max");
+			HeapFreeIndex_t* freeIndex = GetHeapFreeIndex(arena);
+			if (freeIndex == nullptr) { break; }
+			
+			//We don't know where the section will land so we have to ask for enough room for the worst case alignment offset
+			u64 maxAlignOffset = (alignment > AllocAlignment_None) ? (u64)alignment - 1 : 0;
+			u64 minSectionSize = GetHeapSectionSizeFor(numBytes, maxAlignOffset);
+			HeapAllocPrefix_t* prefixPntr = TakeHeapFreeSection(freeIndex, minSectionSize);
+			if (prefixPntr == nullptr)
 			{
-				u64 maxNeededSize = sizeof(HeapAllocPrefix_t) + numBytes + AllocAlignment_Max;
-				u64 newPageSize = arena->pageSize;
-				if (newPageSize < maxNeededSize)
-				{
-					newPageSize = maxNeededSize;
-				}
-				
-				HeapPageHeader_t* newPageHeader = nullptr;
-				if (arena->sourceArena != nullptr)
-				{
-					DebugAssert(arena->sourceArena != arena);
-					//NOTE: Intentionally not putting the onus on the sourceArena to align the page. We will align allocations inside the page as requested
-					newPageHeader = (HeapPageHeader_t*)AllocMem(arena->sourceArena, sizeof(HeapPageHeader_t) + newPageSize);
-					// NotNullMsg(newPageHeader, "Failed to allocate new page from arena for paged heap");
-					if (newPageHeader == nullptr) { break; }
-				}
-				else if (arena->allocFunc != nullptr)
-				{
-					newPageHeader = (HeapPageHeader_t*)arena->allocFunc(sizeof(HeapPageHeader_t) + newPageSize);
-					// NotNullMsg(newPageHeader, "Failed to allocate new page for paged heap");
-					if (newPageHeader == nullptr) { break; }
-				}
-				NotNullMsg(newPageHeader, "sourceArena and allocFunc are both not filled!");
-				
-				arena->size += newPageSize;
-				arena->used += sizeof(HeapAllocPrefix_t);
-				
-				ClearPointer(newPageHeader);
-				newPageHeader->next = nullptr;
-				newPageHeader->size = newPageSize;
-				newPageHeader->used = sizeof(HeapAllocPrefix_t);
-				newPageHeader->cachedFreeOffset = newPageSize;
-				
-				u8* pageBase = (u8*)(newPageHeader + 1);
-				HeapAllocPrefix_t* allocPntr = (HeapAllocPrefix_t*)pageBase;
-				u8* allocAfterPrefixPntr = (pageBase + sizeof(HeapAllocPrefix_t));
-				u64 allocAfterPrefixSize = newPageSize - sizeof(HeapAllocPrefix_t);
-				u8 alignOffset = OffsetToAlign(allocAfterPrefixPntr, alignment);
-				AssertMsg(allocAfterPrefixSize >= alignOffset + numBytes, "Paged heap has a bug where we didn't allocate enough space in the new page to fit the allocation");
-				result = allocAfterPrefixPntr + alignOffset;
-				if (allocAfterPrefixSize > alignOffset + numBytes + sizeof(HeapAllocPrefix_t))
-				{
-					//Split the section into 2 (one filled and one empty)
-					allocPntr->size = PackAllocPrefixSize(true, sizeof(HeapAllocPrefix_t) + alignOffset + numBytes);
-					HeapAllocPrefix_t* newSection = (HeapAllocPrefix_t*)(allocAfterPrefixPntr + alignOffset + numBytes);
-					u64 newSectionSize = allocAfterPrefixSize - (alignOffset + numBytes);
-					newSection->size = PackAllocPrefixSize(false, newSectionSize);
-					newPageHeader->used += alignOffset + numBytes + sizeof(HeapAllocPrefix_t);
-					arena->used += alignOffset + numBytes + sizeof(HeapAllocPrefix_t);
-					Assert(newPageHeader->used <= newPageHeader->size);
-					Assert(arena->used <= arena->size);
-					if (IsFlagSet(arena->flags, MemArenaFlag_CacheFreeOffset) && newSectionSize >= sizeof(HeapAllocPrefix_t) + CACHED_FREE_MIN_SIZE)
-					{
-						newPageHeader->cachedFreeOffset = sizeof(HeapAllocPrefix_t) + alignOffset + numBytes;
-					}
-				}
-				else
-				{
-					//This entire section is getting used (or there's not enough extra room to make another empty section)
-					allocPntr->size = PackAllocPrefixSize(true, newPageSize);
-					newPageHeader->used += newPageSize - sizeof(HeapAllocPrefix_t);
-					arena->used += newPageSize - sizeof(HeapAllocPrefix_t);
-					Assert(newPageHeader->used <= newPageHeader->size);
-					Assert(arena->used <= arena->size);
-				}
-				arena->numAllocations++;
-				
-				if (arena->numPages == 0)
-				{
-					Assert(arena->headerPntr == nullptr);
-					arena->headerPntr = newPageHeader;
-				}
-				else
-				{
-					NotNull(arena->headerPntr);
-					HeapPageHeader_t* walkPntr = (HeapPageHeader_t*)arena->headerPntr;
-					for (u64 pIndex = 0; pIndex < arena->numPages-1; pIndex++)
-					{
-						walkPntr = walkPntr->next;
-					}
-					NotNull(walkPntr);
-					Assert(walkPntr->next == nullptr);
-					walkPntr->next = newPageHeader;
-				}
-				arena->numPages++;
-				
-				if (IsFlagSet(arena->flags, MemArenaFlag_TelemetryEnabled))
-				{
-					if (arena->highUsedMark < arena->used) { arena->highUsedMark = arena->used; }
-					if (arena->resettableHighUsedMark < arena->used) { arena->resettableHighUsedMark = arena->used; }
-					if (arena->highAllocMark < arena->numAllocations) { arena->highAllocMark = arena->numAllocations; }
-				}
-				break;
+				prefixPntr = AllocHeapPage(arena, minSectionSize);
+				if (prefixPntr == nullptr) { break; }
+			}
+			
+			u64 freeSectionSize = UnpackAllocPrefixSize(prefixPntr->size);
+			u8* afterPrefixPntr = (u8*)(prefixPntr + 1);
+			u8 alignOffset = (u8)OffsetToAlign(afterPrefixPntr, alignment);
+			u64 sectionSize = GetHeapSectionSizeFor(numBytes, alignOffset);
+			AssertMsg(sectionSize <= freeSectionSize, "Paged heap has a bug where the free index gave us a section that was too small");
+			if (freeSectionSize - sectionSize >= HEAP_MIN_SECTION_SIZE)
+			{
+				//Split the section into 2 (one filled and one empty)
+				prefixPntr->size = PackAllocPrefixSize(true, sectionSize) | (prefixPntr->size & HEAP_ALLOC_FIRST_FLAG);
+				HeapAllocPrefix_t* newSection = (HeapAllocPrefix_t*)(((u8*)prefixPntr) + sectionSize);
+				newSection->size = PackAllocPrefixSize(false, freeSectionSize - sectionSize);
+				InsertHeapFreeSection(freeIndex, newSection);
+				arena->used += sectionSize;
+			}
+			else
+			{
+				//This entire section is getting used (there's not enough extra room to make another empty section)
+				prefixPntr->size = PackAllocPrefixSize(true, freeSectionSize) | (prefixPntr->size & HEAP_ALLOC_FIRST_FLAG);
+				HeapAllocPrefix_t* nextPrefix = (HeapAllocPrefix_t*)(((u8*)prefixPntr) + freeSectionSize);
+				FlagUnset(nextPrefix->size, HEAP_ALLOC_PREV_FREE_FLAG);
+				arena->used += freeSectionSize - sizeof(HeapAllocPrefix_t);
+			}
+			Assert(arena->used <= arena->size);
+			
+			result = afterPrefixPntr + alignOffset;
+			if (alignOffset > 0) { result[-1] = alignOffset; } //see GetHeapAllocPrefix
+			arena->numAllocations++;
+			if (IsFlagSet(arena->flags, MemArenaFlag_TelemetryEnabled))
+			{
+				if (arena->highUsedMark < arena->used) { arena->highUsedMark = arena->used; }
+				if (arena->resettableHighUsedMark < arena->used) { arena->resettableHighUsedMark = arena->used; }
+				if (arena->highAllocMark < arena->numAllocations) { arena->highAllocMark = arena->numAllocations; }
 			}
 		} break;
 		
@@ -2188,10 +3575,11 @@ void* AllocMem_(MemArena_t* arena, u64 numBytes, AllocAlignment_t alignOverride,
 		// | MemArenaType_MarkedStack AllocMem  |
 		// +====================================+
 		case MemArenaType_MarkedStack:
+		case MemArenaType_MappedFile: //uses the MarkedStack layout, see MappedFileArenaHeader_t
 		{
 			NotNull(arena->headerPntr);
 			NotNull(arena->otherPntr);
-			u8 alignOffset = OffsetToAlign(((u8*)arena->mainPntr) + arena->used, alignment);
+			u64 alignOffset = OffsetToAlign(((u8*)arena->mainPntr) + arena->used, alignment);
 			if (arena->used + alignOffset + numBytes > arena->size)
 			{
 				break;
@@ -2231,13 +3619,13 @@ void* AllocMem_(MemArena_t* arena, u64 numBytes, AllocAlignment_t alignOverride,
 					Assert(pageIndex == arena->numPages-1);
 					Assert(pageHeader->next == nullptr);
 					
-					u8 alignOffset = OffsetToAlign(&pageBase[arena->used], alignment);
+					u64 alignOffset = OffsetToAlign(&pageBase[arena->used], alignment);
 					if (arena->used + alignOffset + numBytes > arena->size)
 					{
 						// Allocate a new page!
 						
 						u8* newPageBytes = nullptr;
-						u64 newPageSize = MaxU64(arena->pageSize, sizeof(MarkedStackArenaHeader_t) + numBytes);
+						u64 newPageSize = MaxU64(arena->pageSize, sizeof(MarkedStackArenaHeader_t) + (u64)alignment + numBytes);
 						if (arena->allocFunc != nullptr)
 						{
 							newPageBytes = (u8*)arena->allocFunc(newPageSize);
@@ -2303,7 +3691,7 @@ void* AllocMem_(MemArena_t* arena, u64 numBytes, AllocAlignment_t alignOverride,
 			u8* basePntr = (u8*)arena->mainPntr;
 			u64 neededSize = numBytes;
 			result = basePntr + arena->used;
-			u8 alignOffset = OffsetToAlign(result, alignment);
+			u64 alignOffset = OffsetToAlign(result, alignment);
 			neededSize += alignOffset;
 			if (arena->size - arena->used < neededSize) { result = nullptr; break; }
 			result += alignOffset;
@@ -2325,7 +3713,7 @@ void* AllocMem_(MemArena_t* arena, u64 numBytes, AllocAlignment_t alignOverride,
 		{
 			NotNull(arena->headerPntr);
 			NotNull(arena->otherPntr);
-			u8 alignOffset = OffsetToAlign(((u8*)arena->mainPntr) + arena->used, alignment);
+			u64 alignOffset = OffsetToAlign(((u8*)arena->mainPntr) + arena->used, alignment);
 			if (arena->used + alignOffset + numBytes > arena->size)
 			{
 				if (arena->used + alignOffset + numBytes <= arena->maxSize)
@@ -2352,6 +3740,151 @@ void* AllocMem_(MemArena_t* arena, u64 numBytes, AllocAlignment_t alignOverride,
 		} break;
 		#endif //!ORCA_COMPILATION
 		
+		// +==============================+
+		// |  MemArenaType_Slab AllocMem  |
+		// +==============================+
+		case MemArenaType_Slab:
+		{
+			NotNull2(arena->headerPntr, arena->sourceArena);
+			SlabArenaHeader_t* slabHeader = (SlabArenaHeader_t*)arena->headerPntr;
+			u64 sizeClass = GetSlabSizeClass(numBytes, alignment);
+			if (sizeClass >= SLAB_NUM_SIZE_CLASSES)
+			{
+				//Too big for our size classes, let the sourceArena handle it
+				u64 rawOffset = GetSlabPassthroughRawOffset(alignment);
+				#if GYLIB_MEM_ARENA_DEBUG_ENABLED
+				u8* rawPntr = (u8*)AllocMem_(filePath, lineNumber, funcName, arena->sourceArena, rawOffset + numBytes, alignment, false);
+				#else
+				u8* rawPntr = (u8*)AllocMem(arena->sourceArena, rawOffset + numBytes, alignment, false);
+				#endif
+				if (rawPntr == nullptr) { break; }
+				result = rawPntr + rawOffset;
+				SlabPassthroughPrefix_t* prefix = ((SlabPassthroughPrefix_t*)result) - 1;
+				prefix->size = numBytes;
+				prefix->rawOffset = rawOffset;
+				arena->used += numBytes;
+			}
+			else
+			{
+				u64 slotSize = (SLAB_MIN_SLOT_SIZE << sizeClass);
+				if (slabHeader->freeLists[sizeClass] != nullptr)
+				{
+					result = (u8*)slabHeader->freeLists[sizeClass];
+					slabHeader->freeLists[sizeClass] = *((void**)result);
+				}
+				else
+				{
+					if (slabHeader->carvePntrs[sizeClass] == slabHeader->carveEnds[sizeClass])
+					{
+						SlabPageHeader_t* newPage = AllocSlabPage(arena, sizeClass);
+						if (newPage == nullptr) { break; }
+					}
+					result = slabHeader->carvePntrs[sizeClass];
+					slabHeader->carvePntrs[sizeClass] += slotSize;
+				}
+				arena->used += slotSize;
+			}
+			IncrementU64(arena->numAllocations);
+			if (IsFlagSet(arena->flags, MemArenaFlag_TelemetryEnabled))
+			{
+				if (arena->highUsedMark < arena->used) { arena->highUsedMark = arena->used; }
+				if (arena->resettableHighUsedMark < arena->used) { arena->resettableHighUsedMark = arena->used; }
+				if (arena->highAllocMark < arena->numAllocations) { arena->highAllocMark = arena->numAllocations; }
+			}
+		} break;
+		
+		// +====================================+
+		// | MemArenaType_ThreadCached AllocMem |
+		// +====================================+
+		case MemArenaType_ThreadCached:
+		{
+			NotNull2(arena->headerPntr, arena->sourceArena);
+			u64 sizeClass = GetSlabSizeClass(numBytes, alignment);
+			bool alignmentFits = (alignment == AllocAlignment_None || alignment <= arena->alignment);
+			ThreadCache_t* cache = (sizeClass < SLAB_NUM_SIZE_CLASSES && alignmentFits) ? GetThreadCache(arena) : nullptr;
+			if (cache == nullptr)
+			{
+				//Too big, too aligned, or this thread can't get a cache. Let the sourceArena handle it
+				u64 rawOffset = GetThreadCacheRawOffset(alignment);
+				LockThreadCacheSource(arena, FindThreadCache(arena));
+				#if GYLIB_MEM_ARENA_DEBUG_ENABLED
+				u8* rawPntr = (u8*)AllocMem_(filePath, lineNumber, funcName, arena->sourceArena, rawOffset + numBytes, alignment, false);
+				#else
+				u8* rawPntr = (u8*)AllocMem(arena->sourceArena, rawOffset + numBytes, alignment, false);
+				#endif
+				if (rawPntr != nullptr)
+				{
+					result = rawPntr + rawOffset;
+					ThreadCacheBlockPrefix_t* prefix = ((ThreadCacheBlockPrefix_t*)result) - 1;
+					prefix->passthroughSize = numBytes;
+					prefix->sizeClass = SLAB_NUM_SIZE_CLASSES;
+					prefix->rawOffset = (u32)rawOffset;
+					arena->size += rawOffset + numBytes;
+					arena->used += numBytes;
+					IncrementU64(arena->numAllocations);
+					if (IsFlagSet(arena->flags, MemArenaFlag_TelemetryEnabled))
+					{
+						if (arena->highUsedMark < arena->used) { arena->highUsedMark = arena->used; }
+						if (arena->resettableHighUsedMark < arena->used) { arena->resettableHighUsedMark = arena->used; }
+						if (arena->highAllocMark < arena->numAllocations) { arena->highAllocMark = arena->numAllocations; }
+					}
+				}
+				UnlockThreadCacheSource(arena);
+				break;
+			}
+			
+			if (cache->freeLists[sizeClass] == nullptr) { DrainThreadCacheRemoteFrees(cache); }
+			if (cache->freeLists[sizeClass] == nullptr && !RefillThreadCache(arena, cache, sizeClass)) { break; }
+			result = (u8*)cache->freeLists[sizeClass];
+			cache->freeLists[sizeClass] = *((void**)result);
+			cache->numCached[sizeClass]--;
+			cache->usedDelta += (i64)(SLAB_MIN_SLOT_SIZE << sizeClass);
+			cache->allocationsDelta++;
+		} break;
+		
+		// +==============================+
+		// |  MemArenaType_Ring AllocMem  |
+		// +==============================+
+		case MemArenaType_Ring:
+		{
+			NotNull2(arena->headerPntr, arena->otherPntr);
+			RingArenaHeader_t* ringHeader = (RingArenaHeader_t*)arena->headerPntr;
+			RingArenaFrame_t* frames = (RingArenaFrame_t*)arena->otherPntr;
+			RingArenaFrame_t* frame = &frames[ringHeader->currentFrameId % ringHeader->maxNumFrames];
+			if (ringHeader->headPos == ringHeader->tailPos && (ringHeader->headPos % arena->size) != 0)
+			{
+				//Nothing is live, so start over at the beginning of the buffer rather than wasting the space before the end on a wrap.
+				//Every live frame is empty and starts at tailPos, so they all move with it (positions still only ever increase)
+				u64 restartPos = ringHeader->headPos + (arena->size - (ringHeader->headPos % arena->size));
+				for (u64 frameId = ringHeader->oldestFrameId; frameId <= ringHeader->currentFrameId; frameId++) { frames[frameId % ringHeader->maxNumFrames].startPos = restartPos; }
+				ringHeader->headPos = restartPos;
+				ringHeader->tailPos = restartPos;
+			}
+			u64 headOffset = ringHeader->headPos % arena->size;
+			u64 alignOffset = OffsetToAlign(((u8*)arena->mainPntr) + headOffset, alignment);
+			u64 allocPos = ringHeader->headPos + alignOffset;
+			if (headOffset + alignOffset + numBytes > arena->size)
+			{
+				//Allocations can't straddle the end of the buffer, so skip the rest of it and start again at the beginning
+				alignOffset = OffsetToAlign(arena->mainPntr, alignment);
+				allocPos = ringHeader->headPos + (arena->size - headOffset) + alignOffset;
+				if (alignOffset + numBytes > arena->size) { break; }
+			}
+			if ((allocPos + numBytes) - ringHeader->tailPos > arena->size) { break; } //would run into a frame that hasn't been retired yet
+			
+			result = ((u8*)arena->mainPntr) + (allocPos % arena->size);
+			ringHeader->headPos = allocPos + numBytes;
+			arena->used = ringHeader->headPos - ringHeader->tailPos;
+			frame->numAllocations++;
+			arena->numAllocations++;
+			if (IsFlagSet(arena->flags, MemArenaFlag_TelemetryEnabled))
+			{
+				if (arena->highUsedMark < arena->used) { arena->highUsedMark = arena->used; }
+				if (arena->resettableHighUsedMark < arena->used) { arena->resettableHighUsedMark = arena->used; }
+				if (arena->highAllocMark < arena->numAllocations) { arena->highAllocMark = arena->numAllocations; }
+			}
+		} break;
+		
 		// +==================================+
 		// | Unsupported Arena Type AllocMem  |
 		// +==================================+
@@ -2371,6 +3904,9 @@ void* AllocMem_(MemArena_t* arena, u64 numBytes, AllocAlignment_t alignOverride,
 	#endif
 	
 	AssertIfMsg(result != nullptr, IsAlignedTo(result, alignment), "An arena has a bug where it tried to return mis-aligned memory");
+	bool lockSharedStats = (arena->type == MemArenaType_ThreadCached && (IsFlagSet(arena->flags, MemArenaFlag_TrackTime) || IsFlagSet(arena->flags, MemArenaFlag_Histograms)));
+	if (lockSharedStats) { LockThreadCacheSource(arena, nullptr); }
+	if (!isSubCall && IsFlagSet(arena->flags, MemArenaFlag_Histograms)) { RecordMemArenaHistograms(arena, MemArenaOp_Alloc, &startTime, numBytes); }
 	if (didLock) { UnlockGyMutex(&arena->mutex); }
 	if (IsFlagSet(arena->flags, MemArenaFlag_TrackTime))
 	{
@@ -2378,6 +3914,7 @@ void* AllocMem_(MemArena_t* arena, u64 numBytes, AllocAlignment_t alignOverride,
 		AddToPerfTimeTotal(&startTime, &endTime, &arena->totalTimeSpentAllocating);
 		IncrementU64(arena->totalTimedAllocationActions);
 	}
+	if (lockSharedStats) { UnlockThreadCacheSource(arena); }
 	return (void*)result;
 }
 
@@ -2428,12 +3965,13 @@ bool FreeMem(MemArena_t* arena, void* allocPntr, u64 allocSize, bool ignoreNullp
 	if (allocPntr == nullptr) { return false; }
 	
 	PerfTime_t startTime;
-	if (IsFlagSet(arena->flags, MemArenaFlag_TrackTime)) { startTime = GetPerfTime(); }
+	if (IsFlagSet(arena->flags, MemArenaFlag_TrackTime) || IsFlagSet(arena->flags, MemArenaFlag_Histograms)) { startTime = GetPerfTime(); }
 	
 	bool didLock = false;
 	if (IsValidGyMutex(&arena->mutex)) { LockGyMutex(&arena->mutex); didLock = true; }
 	
-	if (IsFlagSet(arena->flags, MemArenaFlag_TelemetryEnabled) && arena->resettableHighUsedMark < arena->used) { arena->resettableHighUsedMark = arena->used; }
+	//ThreadCached arenas are used from many threads without arena->mutex, their stats are only touched while holding the sourceMutex (see LockThreadCacheSource)
+	if (IsFlagSet(arena->flags, MemArenaFlag_TelemetryEnabled) && arena->type != MemArenaType_ThreadCached && arena->resettableHighUsedMark < arena->used) { arena->resettableHighUsedMark = arena->used; }
 	
 	if (IsFlagSet(arena->flags, MemArenaFlag_BreakOnFree) && (arena->debugBreakThreshold == 0 || allocSize >= arena->debugBreakThreshold))
 	{
@@ -2473,7 +4011,13 @@ bool FreeMem(MemArena_t* arena, void* allocPntr, u64 allocSize, bool ignoreNullp
 		// +==============================+
 		case MemArenaType_StdHeap:
 		{
+			#if STD_HEAP_REMAP_SUPPORTED
+			StdHeapMappedPrefix_t* mappedPrefix = GetStdHeapMappedPrefix(allocPntr);
+			if (mappedPrefix != nullptr) { FreeStdHeapMapped(mappedPrefix); }
+			else { MyFree(allocPntr); }
+			#else
 			MyFree(allocPntr);
+			#endif
 			Decrement(arena->numAllocations);
 			DecrementBy(arena->used, allocSize);
 			result = true;
@@ -2561,142 +4105,57 @@ bool FreeMem(MemArena_t* arena, void* allocPntr, u64 allocSize, bool ignoreNullp
 		// +================================+
 		case MemArenaType_PagedHeap:
 		{
-			HeapPageHeader_t* prevPageHeader = nullptr;
-			HeapPageHeader_t* pageHeader = (HeapPageHeader_t*)arena->headerPntr;
-			u64 pageIndex = 0;
-			while (pageHeader != nullptr)
+			DebugAssertMsg(FindHeapPageFor(arena, allocPntr) != nullptr, "Tried to free pntr that isn't in any of the pages of this arena!");
+			HeapAllocPrefix_t* prefixPntr = GetHeapAllocPrefix(allocPntr);
+			u8* afterPrefixPntr = (u8*)(prefixPntr + 1);
+			AssertMsg(IsAllocPrefixFilled(prefixPntr->size), "Tried to double free section in Paged Heap. This is a memory management bug");
+			u64 sectionSize = UnpackAllocPrefixSize(prefixPntr->size);
+			AssertMsg(sectionSize >= HEAP_MIN_SECTION_SIZE && (u8*)allocPntr < (u8*)prefixPntr + sectionSize, "Tried to free a pointer that pointed to the middle of a Paged Heap section. This is a corrupt pointer!");
+			u64 afterPrefixSize = sectionSize - sizeof(HeapAllocPrefix_t);
+			if (allocSize != 0)
 			{
-				u8* pageBase = (u8*)(pageHeader + 1);
-				if (allocPntr >= pageBase && allocPntr < pageBase + pageHeader->size)
+				//NOTE: We allow for slop in the alignment offset, the rounding up to HEAP_SECTION_GRANULARITY/HEAP_MIN_SECTION_SIZE, and scenarios
+				//      where the section that was used was only slighly larger than needed and the remainder couldn't become it's own section
+				u64 allowedSlop = (u64)((u8*)allocPntr - afterPrefixPntr) + 2*HEAP_MIN_SECTION_SIZE;
+				AssertMsg(AbsDiffU64(allocSize, afterPrefixSize) <= allowedSlop, "Given size did not match actual allocation size in Paged Heap during FreeMem. This is a memory management bug");
+			}
+			
+			result = true;
+			if (oldSizeOut != nullptr) { *oldSizeOut = afterPrefixSize; }
+			AssertMsg(arena->used >= afterPrefixSize, "Paged Heap used tracker was corrupted. Reached 0 too soon!");
+			arena->used -= afterPrefixSize;
+			AssertMsg(arena->numAllocations > 0, "Paged Heap numAllocations was corrupted. Reached 0 too soon!");
+			arena->numAllocations--;
+			
+			HeapAllocPrefix_t* freePrefixPntr = FreeHeapSection(arena, prefixPntr);
+			
+			// +==============================+
+			// |       Free Empty Page        |
+			// +==============================+
+			HeapAllocPrefix_t* nextPrefixPntr = (HeapAllocPrefix_t*)(((u8*)freePrefixPntr) + UnpackAllocPrefixSize(freePrefixPntr->size));
+			if (IsFlagSet(freePrefixPntr->size, HEAP_ALLOC_FIRST_FLAG) && UnpackAllocPrefixSize(nextPrefixPntr->size) == 0 && IsFlagSet(arena->flags, MemArenaFlag_AutoFreePages))
+			{
+				HeapPageHeader_t* pageHeader = ((HeapPageHeader_t*)freePrefixPntr) - 1;
+				if (pageHeader != (HeapPageHeader_t*)arena->headerPntr)
 				{
-					bool foundAlloc = false;
-					u64 allocOffset = 0;
-					u8* allocBytePntr = pageBase;
-					u64 sectionIndex = 0;
-					u64 prevPrefixOffset = 0;
-					HeapAllocPrefix_t* prevPrefixPntr = nullptr;
-					while (allocOffset < pageHeader->size)
-					{
-						HeapAllocPrefix_t* prefixPntr = (HeapAllocPrefix_t*)allocBytePntr;
-						u8* afterPrefixPntr = (allocBytePntr + sizeof(HeapAllocPrefix_t));
-						bool isSectionFilled = IsAllocPrefixFilled(prefixPntr->size);
-						u64 sectionSize = UnpackAllocPrefixSize(prefixPntr->size);
-						AssertMsg(sectionSize >= sizeof(HeapAllocPrefix_t), "Found an allocation header that claimed to be smaller than the header itself in Paged Heap");
-						u64 afterPrefixSize = sectionSize - sizeof(HeapAllocPrefix_t);
-						
-						if ((u8*)allocPntr >= allocBytePntr && (u8*)allocPntr < allocBytePntr + sectionSize)
-						{
-							AssertMsg((u8*)allocPntr >= afterPrefixPntr, "Tried to free a pointer that pointed into a Paged Heap header. This is a corrupt pointer!");
-							//TODO: Check if the allocation was actually aligned. Be more strict if it wasn't aligned
-							AssertMsg((u8*)allocPntr <= afterPrefixPntr + OffsetToAlign(afterPrefixPntr, AllocAlignment_Max), "Tried to free a pointer that pointed to the middle of a Paged Heap section. This is a corrupt pointer!");
-							AssertMsg(isSectionFilled, "Tried to double free section in Paged Heap. This is a memory management bug");
-							if (allocSize != 0)
-							{
-								//TODO: Handle scenarios where the alignment offset or bad-fit scenarios caused the section to be slightly larger than the requested allocation size
-								//NOTE: Right now we allow for slop in both the alignment offset and scenarios where the section that was used was only slighly larger than needed
-								//      and a second section couldn't be created because there wasn't even enough room for a HeapAllocPrefix_t
-								u64 allowedSlop = OffsetToAlign(afterPrefixPntr, AllocAlignment_Max) + sizeof(HeapAllocPrefix_t);
-								AssertMsg(AbsDiffU64(allocSize, afterPrefixSize) <= allowedSlop, "Given size did not match actual allocation size in Paged Heap during FreeMem. This is a memory management bug");
-							}
-							
-							result = true;
-							foundAlloc = true;
-							if (oldSizeOut != nullptr) { *oldSizeOut = afterPrefixSize; }
-							
-							// +==============================+
-							// |   Free Paged Heap Section    |
-							// +==============================+
-							prefixPntr->size = PackAllocPrefixSize(false, sectionSize);
-							if (IsFlagSet(arena->flags, MemArenaFlag_CacheFreeOffset) && afterPrefixSize >= CACHED_FREE_MIN_SIZE && allocOffset < pageHeader->cachedFreeOffset)
-							{
-								pageHeader->cachedFreeOffset = allocOffset;
-							}
-							AssertMsg(pageHeader->used >= afterPrefixSize, "Paged Heap used tracker was corrupted. Reached 0 too soon!");
-							AssertMsg(arena->used >= afterPrefixSize, "Paged Heap used tracker was corrupted. Reached 0 too soon!");
-							pageHeader->used -= afterPrefixSize;
-							arena->used -= afterPrefixSize;
-							AssertMsg(arena->numAllocations > 0, "Paged Heap numAllocations was corrupted. Reached 0 too soon!");
-							arena->numAllocations--;
-							
-							// +==============================+
-							// | Merge Sections After Freeing |
-							// +==============================+
-							if (allocOffset + sectionSize < pageHeader->size)
-							{
-								Assert(allocOffset + sectionSize + sizeof(HeapAllocPrefix_t) <= pageHeader->size);
-								HeapAllocPrefix_t* nextPrefixPntr = (HeapAllocPrefix_t*)(allocBytePntr + sectionSize);
-								if (!IsAllocPrefixFilled(nextPrefixPntr->size))
-								{
-									// Merge the next section with this one by making this section bigger
-									if (IsFlagSet(arena->flags, MemArenaFlag_CacheFreeOffset) && pageHeader->cachedFreeOffset == allocOffset + sectionSize)
-									{
-										pageHeader->cachedFreeOffset = allocOffset;
-									}
-									sectionSize += UnpackAllocPrefixSize(nextPrefixPntr->size);
-									prefixPntr->size = PackAllocPrefixSize(false, sectionSize);
-									AssertMsg(pageHeader->used >= sizeof(HeapAllocPrefix_t), "Paged Heap page->used tracker was corrupted. Reached 0 too soon.");
-									AssertMsg(arena->used >= sizeof(HeapAllocPrefix_t), "Paged Heap used tracker was corrupted. Reached 0 too soon.");
-									pageHeader->used -= sizeof(HeapAllocPrefix_t);
-									arena->used -= sizeof(HeapAllocPrefix_t);
-								}
-							}
-							if (prevPrefixPntr != nullptr && !IsAllocPrefixFilled(prevPrefixPntr->size))
-							{
-								// Merge the previous section with this one by making it's sectionSize bigger
-								prevPrefixPntr->size = PackAllocPrefixSize(false, UnpackAllocPrefixSize(prevPrefixPntr->size) + sectionSize);
-								AssertMsg(pageHeader->used >= sizeof(HeapAllocPrefix_t), "Paged Heap page->used tracker was corrupted. Reached 0 too soon.");
-								AssertMsg(arena->used >= sizeof(HeapAllocPrefix_t), "Paged Heap used tracker was corrupted. Reached 0 too soon.");
-								pageHeader->used -= sizeof(HeapAllocPrefix_t);
-								arena->used -= sizeof(HeapAllocPrefix_t);
-								if (IsFlagSet(arena->flags, MemArenaFlag_CacheFreeOffset) && pageHeader->cachedFreeOffset == allocOffset)
-								{
-									pageHeader->cachedFreeOffset = prevPrefixOffset;
-								}
-							}
-							
-							// +==============================+
-							// |       Free Empty Page        |
-							// +==============================+
-							if (pageHeader->used <= sizeof(HeapAllocPrefix_t) && IsFlagSet(arena->flags, MemArenaFlag_AutoFreePages) && pageIndex > 0)
-							{
-								prevPageHeader->next = pageHeader->next;
-								arena->size -= pageHeader->size;
-								arena->used -= sizeof(HeapAllocPrefix_t);
-								if (arena->freeFunc != nullptr)
-								{
-									arena->freeFunc(pageHeader);
-								}
-								else if (arena->sourceArena != nullptr)
-								{
-									FreeMem(arena->sourceArena, pageHeader, sizeof(HeapPageHeader_t) + pageHeader->size);
-								}
-								arena->numPages--;
-							}
-							
-							break;
-						}
-						
-						prevPrefixPntr = prefixPntr;
-						prevPrefixOffset = allocOffset;
-						allocOffset += sectionSize;
-						allocBytePntr += sectionSize;
-						sectionIndex++;
-					}
-					AssertMsg(foundAlloc, "We have a bug in our freeing walk. Couldn't find section that contained the pntr in this page!");
-					break;
+					RemoveHeapFreeSection((HeapFreeIndex_t*)arena->otherPntr, freePrefixPntr);
+					NotNull(pageHeader->prev);
+					pageHeader->prev->next = pageHeader->next;
+					if (pageHeader->next != nullptr) { pageHeader->next->prev = pageHeader->prev; }
+					arena->size -= pageHeader->size;
+					AssertMsg(arena->used >= sizeof(HeapAllocPrefix_t), "Paged Heap used tracker was corrupted. Reached 0 too soon.");
+					arena->used -= sizeof(HeapAllocPrefix_t);
+					arena->numPages--;
+					ReleaseHeapPage(arena, pageHeader);
 				}
-				
-				prevPageHeader = pageHeader;
-				pageHeader = pageHeader->next;
-				pageIndex++;
 			}
-			AssertMsg(result == true, "Tried to free pntr that isn't in any of the pages of this arena!");
 		} break;
 		
 		// +==================================+
 		// | MemArenaType_MarkedStack FreeMem |
 		// +==================================+
 		case MemArenaType_MarkedStack:
+		case MemArenaType_MappedFile:
 		{
 			Assert(IsPntrInsideRange(allocPntr, arena->mainPntr, arena->size));
 			Assert(IsPntrInsideRange(((u8*)allocPntr) + allocSize, arena->mainPntr, arena->size));
@@ -2818,6 +4277,131 @@ bool FreeMem(MemArena_t* arena, void* allocPntr, u64 allocSize, bool ignoreNullp
 			result = true;
 		} break;
 		
+		// +==============================+
+		// |  MemArenaType_Slab FreeMem   |
+		// +==============================+
+		case MemArenaType_Slab:
+		{
+			NotNull2(arena->headerPntr, arena->sourceArena);
+			SlabArenaHeader_t* slabHeader = (SlabArenaHeader_t*)arena->headerPntr;
+			SlabPageHeader_t* pageHeader = FindSlabPageFor(arena, allocPntr);
+			if (pageHeader == nullptr)
+			{
+				//Not in any of our pages so it must have been passed through to the sourceArena
+				SlabPassthroughPrefix_t* prefix = ((SlabPassthroughPrefix_t*)allocPntr) - 1;
+				AssertMsg(allocSize == 0 || allocSize == prefix->size, "Given size did not match actual allocation size in Slab FreeMem. This is a memory management bug");
+				u64 oldSize = prefix->size;
+				u64 rawOffset = prefix->rawOffset;
+				result = FreeMem(arena->sourceArena, ((u8*)allocPntr) - rawOffset, rawOffset + oldSize, ignoreNullptr, nullptr, false);
+				if (!result) { break; }
+				SetOptionalOutPntr(oldSizeOut, oldSize);
+				Decrement(arena->numAllocations);
+				AssertMsg(arena->used >= oldSize, "Slab used tracker was corrupted. Reached 0 too soon!");
+				arena->used -= oldSize;
+				break;
+			}
+			AssertMsg((u8*)allocPntr >= pageHeader->slotsBase, "Tried to free a pointer that pointed into a Slab page header. This is a corrupt pointer!");
+			AssertMsg((((u8*)allocPntr - pageHeader->slotsBase) % pageHeader->slotSize) == 0, "Tried to free a pointer that pointed to the middle of a Slab slot. This is a corrupt pointer!");
+			AssertMsg(allocSize <= pageHeader->slotSize, "Given size was larger than the slot the allocation lives in during Slab FreeMem. This is a memory management bug");
+			*((void**)allocPntr) = slabHeader->freeLists[pageHeader->sizeClass];
+			slabHeader->freeLists[pageHeader->sizeClass] = allocPntr;
+			AssertMsg(arena->used >= pageHeader->slotSize, "Slab used tracker was corrupted. Reached 0 too soon!");
+			arena->used -= pageHeader->slotSize;
+			Decrement(arena->numAllocations);
+			SetOptionalOutPntr(oldSizeOut, (allocSize != 0) ? allocSize : pageHeader->slotSize);
+			result = true;
+		} break;
+		
+		// +===================================+
+		// | MemArenaType_ThreadCached FreeMem |
+		// +===================================+
+		case MemArenaType_ThreadCached:
+		{
+			NotNull2(arena->headerPntr, arena->sourceArena);
+			ThreadCacheArenaHeader_t* cacheHeader = (ThreadCacheArenaHeader_t*)arena->headerPntr;
+			ThreadCacheBlockPrefix_t* prefix = ((ThreadCacheBlockPrefix_t*)allocPntr) - 1;
+			ThreadCache_t* cache = FindThreadCache(arena);
+			if (prefix->sizeClass >= SLAB_NUM_SIZE_CLASSES)
+			{
+				//Was passed through to the sourceArena
+				AssertMsg(prefix->sizeClass == SLAB_NUM_SIZE_CLASSES, "Tried to free a pointer that didn't have a valid ThreadCached prefix. This is a corrupt pointer!");
+				AssertMsg(allocSize == 0 || allocSize == prefix->passthroughSize, "Given size did not match actual allocation size in ThreadCached FreeMem. This is a memory management bug");
+				u64 rawOffset = prefix->rawOffset;
+				u64 oldSize = prefix->passthroughSize;
+				LockThreadCacheSource(arena, cache);
+				result = FreeMem(arena->sourceArena, ((u8*)allocPntr) - rawOffset, rawOffset + oldSize, ignoreNullptr, nullptr, false);
+				if (result)
+				{
+					DecrementBy(arena->size, rawOffset + oldSize);
+					DecrementBy(arena->used, oldSize);
+					Decrement(arena->numAllocations);
+					SetOptionalOutPntr(oldSizeOut, oldSize);
+				}
+				UnlockThreadCacheSource(arena);
+				break;
+			}
+			
+			AssertMsg(prefix->sizeClass < SLAB_NUM_SIZE_CLASSES, "Tried to free a pointer that didn't have a valid ThreadCached prefix. This is a corrupt pointer!");
+			u64 slotSize = (SLAB_MIN_SLOT_SIZE << prefix->sizeClass);
+			AssertMsg(allocSize <= slotSize, "Given size was larger than the block the allocation lives in during ThreadCached FreeMem. This is a memory management bug");
+			if (prefix->owner == cache)
+			{
+				*((void**)allocPntr) = cache->freeLists[prefix->sizeClass];
+				cache->freeLists[prefix->sizeClass] = allocPntr;
+				cache->numCached[prefix->sizeClass]++;
+				if (cache->numCached[prefix->sizeClass] > cacheHeader->magazineSize)
+				{
+					LockThreadCacheSource(arena, cache);
+					FlushThreadCacheClass(arena, cache, prefix->sizeClass, cacheHeader->magazineSize / 2);
+					UnlockThreadCacheSource(arena);
+				}
+			}
+			else
+			{
+				//Belongs to another thread's cache (which may have been released, in which case whoever adopts it will pick this up)
+				PushThreadCacheRemoteFree(prefix->owner, allocPntr);
+			}
+			SetOptionalOutPntr(oldSizeOut, (allocSize != 0) ? allocSize : slotSize);
+			if (cache != nullptr)
+			{
+				cache->usedDelta -= (i64)slotSize;
+				cache->allocationsDelta--;
+			}
+			else
+			{
+				LockThreadCacheSource(arena, nullptr);
+				arena->used -= slotSize;
+				arena->numAllocations--;
+				UnlockThreadCacheSource(arena);
+			}
+			result = true;
+		} break;
+		
+		// +==============================+
+		// |  MemArenaType_Ring FreeMem   |
+		// +==============================+
+		case MemArenaType_Ring:
+		{
+			NotNull2(arena->headerPntr, arena->otherPntr);
+			RingArenaHeader_t* ringHeader = (RingArenaHeader_t*)arena->headerPntr;
+			AssertMsg(IsPntrInsideRange(allocPntr, arena->mainPntr, arena->size), "Tried to free a pointer that is not inside this Ring arena!");
+			u64 allocPos = GetRingAllocPos(arena, allocPntr);
+			RingArenaFrame_t* frame = FindRingFrameFor(arena, allocPos);
+			AssertMsg(frame != nullptr, "Tried to free a pointer from a Ring arena frame that was already retired!");
+			if (frame == nullptr) { break; }
+			// If the allocation is the last one in the ring then we can actually free it by just moving our head back.
+			// Otherwise the space is reclaimed when the frame is retired
+			if (allocSize > 0 && allocPos + allocSize == ringHeader->headPos && ringHeader->headPos - allocSize >= frame->startPos)
+			{
+				ringHeader->headPos -= allocSize;
+				arena->used = ringHeader->headPos - ringHeader->tailPos;
+			}
+			Decrement(frame->numAllocations);
+			Decrement(arena->numAllocations);
+			SetOptionalOutPntr(oldSizeOut, allocSize);
+			result = true;
+		} break;
+		
 		// +================================+
 		// | Unsupported Arena Type FreeMem |
 		// +================================+
@@ -2836,6 +4420,9 @@ bool FreeMem(MemArena_t* arena, void* allocPntr, u64 allocSize, bool ignoreNullp
 	if (!isSubCall && arena->testSetOut != nullptr) { MemArenaTestSetRecordFreeMemAction(arena->testSetOut, allocPntr, allocSize); }
 	#endif
 	
+	bool lockSharedStats = (arena->type == MemArenaType_ThreadCached && (IsFlagSet(arena->flags, MemArenaFlag_TrackTime) || IsFlagSet(arena->flags, MemArenaFlag_Histograms)));
+	if (lockSharedStats) { LockThreadCacheSource(arena, nullptr); }
+	if (!isSubCall && IsFlagSet(arena->flags, MemArenaFlag_Histograms)) { RecordMemArenaHistograms(arena, MemArenaOp_Free, &startTime, 0); }
 	if (didLock) { UnlockGyMutex(&arena->mutex); }
 	if (IsFlagSet(arena->flags, MemArenaFlag_TrackTime))
 	{
@@ -2843,6 +4430,7 @@ bool FreeMem(MemArena_t* arena, void* allocPntr, u64 allocSize, bool ignoreNullp
 		AddToPerfTimeTotal(&startTime, &endTime, &arena->totalTimeSpentAllocating);
 		IncrementU64(arena->totalTimedAllocationActions);
 	}
+	if (lockSharedStats) { UnlockThreadCacheSource(arena); }
 	return result;
 }
 
@@ -2859,9 +4447,12 @@ void* ReallocMem_(MemArena_t* arena, void* allocPntr, u64 newSize, u64 oldSize,
 	NotNull(arena);
 	AssertMsg(arena->type != MemArenaType_None, "Tried to realloc from uninitialized arena");
 	Assert(ignoreNullptr || allocPntr != nullptr);
+	#ifdef _GY_TEST_MEMORY_PREDECLARED
+	u64 givenOldSize = oldSize; //oldSize gets replaced with the arena's idea of the size below, but a replay against another arena type needs what the caller gave us
+	#endif
 	
 	PerfTime_t startTime;
-	if (IsFlagSet(arena->flags, MemArenaFlag_TrackTime)) { startTime = GetPerfTime(); }
+	if (IsFlagSet(arena->flags, MemArenaFlag_TrackTime) || IsFlagSet(arena->flags, MemArenaFlag_Histograms)) { startTime = GetPerfTime(); }
 	
 	bool didLock = false;
 	if (IsValidGyMutex(&arena->mutex)) { LockGyMutex(&arena->mutex); didLock = true; }
@@ -2877,8 +4468,14 @@ void* ReallocMem_(MemArena_t* arena, void* allocPntr, u64 newSize, u64 oldSize,
 	// #endif
 	
 	AllocAlignment_t alignment = (alignOverride != AllocAlignment_None) ? alignOverride : arena->alignment;
+	//The two early outs below still count as a ReallocMem in the histograms
+	bool recordEarlyOut = (!isSubCall && IsFlagSet(arena->flags, MemArenaFlag_Histograms));
+	bool lockEarlyOutStats = (recordEarlyOut && arena->type == MemArenaType_ThreadCached);
 	if (newSize == oldSize && (allocPntr != nullptr || oldSize != 0) && IsAlignedTo(allocPntr, alignment)) //not resizing, just keep the memory where it's at
 	{
+		if (lockEarlyOutStats) { LockThreadCacheSource(arena, nullptr); }
+		if (recordEarlyOut) { RecordMemArenaHistograms(arena, MemArenaOp_Realloc, &startTime, newSize); }
+		if (lockEarlyOutStats) { UnlockThreadCacheSource(arena); }
 		if (didLock) { UnlockGyMutex(&arena->mutex); }
 		return allocPntr;
 	}
@@ -2886,6 +4483,12 @@ void* ReallocMem_(MemArena_t* arena, void* allocPntr, u64 newSize, u64 oldSize,
 	{
 		bool freeSuccess = FreeMem(arena, allocPntr, oldSize, ignoreNullptr, oldSizeOut, true);
 		AssertMsg(freeSuccess, "Failed attempt to free memory in arena when Realloc'd to 0 bytes");
+		#ifdef _GY_TEST_MEMORY_PREDECLARED
+		if (!isSubCall && arena->testSetOut != nullptr) { MemArenaTestSetRecordReallocMemAction(arena->testSetOut, allocPntr, newSize, givenOldSize, alignOverride, nullptr); }
+		#endif
+		if (lockEarlyOutStats) { LockThreadCacheSource(arena, nullptr); }
+		if (recordEarlyOut) { RecordMemArenaHistograms(arena, MemArenaOp_Realloc, &startTime, newSize); }
+		if (lockEarlyOutStats) { UnlockThreadCacheSource(arena); }
 		if (didLock) { UnlockGyMutex(&arena->mutex); }
 		return nullptr;
 	}
@@ -2907,11 +4510,70 @@ void* ReallocMem_(MemArena_t* arena, void* allocPntr, u64 newSize, u64 oldSize,
 		case MemArenaType_FixedHeap:
 		case MemArenaType_PagedHeap:
 		case MemArenaType_Buffer:
+		case MemArenaType_Slab:
+		case MemArenaType_ThreadCached:
 		{
 			if (arena->type == MemArenaType_Redirect && arena->reallocFunc != nullptr)
 			{
-				result = (u8*)arena->reallocFunc(allocPntr, newSize);
-				break;
+				result = (u8*)arena->reallocFunc(allocPntr, newSize);
+				break;
+			}
+			if (arena->type == MemArenaType_Slab && allocPntr != nullptr)
+			{
+				const SlabPageHeader_t* pageHeader = FindSlabPageFor(arena, allocPntr);
+				u64 newSizeClass = GetSlabSizeClass(newSize, alignment);
+				const SlabPassthroughPrefix_t* passthroughPrefix = (pageHeader == nullptr) ? (((const SlabPassthroughPrefix_t*)allocPntr) - 1) : nullptr;
+				if (passthroughPrefix != nullptr && newSizeClass >= SLAB_NUM_SIZE_CLASSES && passthroughPrefix->rawOffset == GetSlabPassthroughRawOffset(alignment))
+				{
+					//Was passed through to the sourceArena and still doesn't fit in our size classes, so let the sourceArena realloc it
+					NotNull(arena->sourceArena);
+					AssertMsg(oldSize == 0 || oldSize == passthroughPrefix->size, "Given size did not match actual allocation size in Slab ReallocMem. This is a memory management bug");
+					oldSize = passthroughPrefix->size;
+					u64 rawOffset = passthroughPrefix->rawOffset;
+					u8* rawPntr = (u8*)ReallocMem(arena->sourceArena, ((u8*)allocPntr) - rawOffset, rawOffset + newSize, rawOffset + oldSize, alignment, ignoreNullptr, nullptr, false);
+					SetOptionalOutPntr(oldSizeOut, oldSize);
+					AssertMsg(arena->used >= oldSize, "Slab used tracker was corrupted. Reached 0 too soon!");
+					arena->used -= oldSize;
+					if (rawPntr == nullptr) { result = nullptr; Decrement(arena->numAllocations); break; }
+					result = rawPntr + rawOffset;
+					((SlabPassthroughPrefix_t*)result)[-1].size = newSize;
+					arena->used += newSize;
+					if (IsFlagSet(arena->flags, MemArenaFlag_TelemetryEnabled))
+					{
+						if (arena->highUsedMark < arena->used) { arena->highUsedMark = arena->used; }
+						if (arena->resettableHighUsedMark < arena->used) { arena->resettableHighUsedMark = arena->used; }
+					}
+					increasingSize = (newSize > oldSize);
+					decreasingSize = (newSize < oldSize);
+					sizeChangeAmount = (newSize >= oldSize) ? (newSize - oldSize) : (oldSize - newSize);
+					break;
+				}
+				if (pageHeader != nullptr && newSizeClass == pageHeader->sizeClass)
+				{
+					//The new size still lands in the same size class so the slot already has room for it
+					result = (u8*)allocPntr;
+					if (oldSize == 0) { oldSize = pageHeader->slotSize; }
+					SetOptionalOutPntr(oldSizeOut, oldSize);
+					increasingSize = (newSize > oldSize);
+					decreasingSize = (newSize < oldSize);
+					sizeChangeAmount = (newSize >= oldSize) ? (newSize - oldSize) : (oldSize - newSize);
+					break;
+				}
+			}
+			if (arena->type == MemArenaType_ThreadCached && allocPntr != nullptr)
+			{
+				const ThreadCacheBlockPrefix_t* prefix = ((const ThreadCacheBlockPrefix_t*)allocPntr) - 1;
+				if (prefix->sizeClass < SLAB_NUM_SIZE_CLASSES && GetSlabSizeClass(newSize, alignment) == prefix->sizeClass && IsAlignedTo(allocPntr, alignment))
+				{
+					//The new size still lands in the same size class so the block already has room for it
+					result = (u8*)allocPntr;
+					if (oldSize == 0) { oldSize = (SLAB_MIN_SLOT_SIZE << prefix->sizeClass); }
+					SetOptionalOutPntr(oldSizeOut, oldSize);
+					increasingSize = (newSize > oldSize);
+					decreasingSize = (newSize < oldSize);
+					sizeChangeAmount = (newSize >= oldSize) ? (newSize - oldSize) : (oldSize - newSize);
+					break;
+				}
 			}
 			
 			#if GYLIB_MEM_ARENA_DEBUG_ENABLED
@@ -2933,7 +4595,7 @@ void* ReallocMem_(MemArena_t* arena, void* allocPntr, u64 newSize, u64 oldSize,
 						//TODO: Handle scenarios where the alignment offset or bad-fit scenarios caused the section to be slightly larger than the requested allocation size
 						//NOTE: Right now we allow for slop in both the alignment offset and scenarios where the section that was used was only slighly larger than needed
 						//      and a second section couldn't be created because there wasn't even enough room for a HeapAllocPrefix_t
-						u64 allowedSlop = OffsetToAlign(allocPntr, AllocAlignment_Max) + sizeof(HeapAllocPrefix_t);
+						u64 allowedSlop = (arena->type == MemArenaType_PagedHeap) ? (AllocAlignment_Max + 2*HEAP_MIN_SECTION_SIZE) : (OffsetToAlign(allocPntr, AllocAlignment_Max) + sizeof(HeapAllocPrefix_t));
 						AssertMsg(AbsDiffU64(oldSize, reportedOldSize) <= allowedSlop, "Given size did not match actual allocation size in Fixed Heap during ReallocMem. This is a memory management bug");
 					}
 					oldSize = reportedOldSize;
@@ -2962,7 +4624,7 @@ void* ReallocMem_(MemArena_t* arena, void* allocPntr, u64 newSize, u64 oldSize,
 					//TODO: Handle scenarios where the alignment offset or bad-fit scenarios caused the section to be slightly larger than the requested allocation size
 					//NOTE: Right now we allow for slop in both the alignment offset and scenarios where the section that was used was only slighly larger than needed
 					//      and a second section couldn't be created because there wasn't even enough room for a HeapAllocPrefix_t
-					u64 allowedSlop = OffsetToAlign(allocPntr, AllocAlignment_Max) + sizeof(HeapAllocPrefix_t);
+					u64 allowedSlop = (arena->type == MemArenaType_PagedHeap) ? (AllocAlignment_Max + 2*HEAP_MIN_SECTION_SIZE) : (OffsetToAlign(allocPntr, AllocAlignment_Max) + sizeof(HeapAllocPrefix_t));
 					AssertMsg(AbsDiffU64(oldSize, reportedOldSize) <= allowedSlop, "Given size did not match actual allocation size in Fixed Heap during ReallocMem. This is a memory management bug");
 				}
 				oldSize = reportedOldSize;
@@ -3012,7 +4674,30 @@ void* ReallocMem_(MemArena_t* arena, void* allocPntr, u64 newSize, u64 oldSize,
 		case MemArenaType_StdHeap:
 		{
 			AssertMsg(alignment == AllocAlignment_None, "Tried to align memory in StdHeap type arena");
+			#if STD_HEAP_REMAP_SUPPORTED
+			StdHeapMappedPrefix_t* mappedPrefix = GetStdHeapMappedPrefix(allocPntr);
+			bool wantsMapping = (newSize >= STD_HEAP_REMAP_THRESHOLD && (knownOldSize || mappedPrefix != nullptr)); //we need to know how much to copy when moving out of malloc
+			if (mappedPrefix != nullptr && wantsMapping)
+			{
+				result = ResizeStdHeapMapped(mappedPrefix, newSize, true);
+			}
+			else if (mappedPrefix != nullptr || wantsMapping)
+			{
+				//Moving between malloc and a mapping of it's own takes one copy, after that the allocation can be resized without copying
+				u64 copySize = (mappedPrefix != nullptr) ? (mappedPrefix->mappedSize - sizeof(StdHeapMappedPrefix_t)) : oldSize;
+				result = wantsMapping ? AllocStdHeapMapped(newSize) : nullptr;
+				if (result == nullptr) { result = (u8*)MyMalloc(newSize); }
+				if (result != nullptr && allocPntr != nullptr)
+				{
+					MyMemCopy(result, allocPntr, MinU64(copySize, newSize));
+					if (mappedPrefix != nullptr) { FreeStdHeapMapped(mappedPrefix); }
+					else { MyFree(allocPntr); }
+				}
+			}
+			else { result = (u8*)MyRealloc(allocPntr, newSize); }
+			#else
 			result = (u8*)MyRealloc(allocPntr, newSize);
+			#endif
 			if (result == nullptr)
 			{
 				DecrementBy(arena->used, oldSize);
@@ -3078,6 +4763,49 @@ void* ReallocMem_(MemArena_t* arena, void* allocPntr, u64 newSize, u64 oldSize,
 		// 	//TODO: Implement me, and remove from above!
 		// } break;
 		
+		// +==============================+
+		// | MemArenaType_Ring ReallocMem |
+		// +==============================+
+		case MemArenaType_Ring:
+		{
+			NotNull2(arena->headerPntr, arena->otherPntr);
+			RingArenaHeader_t* ringHeader = (RingArenaHeader_t*)arena->headerPntr;
+			AssertMsg(knownOldSize, "Ring arenas don't know the size of their allocations. You must pass oldSize to ReallocMem");
+			SetOptionalOutPntr(oldSizeOut, oldSize);
+			if (allocPntr != nullptr && IsAlignedTo(allocPntr, alignment))
+			{
+				//If this is the most recent allocation in the current frame then we can resize it in place
+				u64 allocPos = GetRingAllocPos(arena, allocPntr);
+				const RingArenaFrame_t* currentFrame = &((RingArenaFrame_t*)arena->otherPntr)[ringHeader->currentFrameId % ringHeader->maxNumFrames];
+				u64 allocOffset = (u64)((u8*)allocPntr - (u8*)arena->mainPntr);
+				if (allocPos + oldSize == ringHeader->headPos && allocPos >= currentFrame->startPos &&
+					allocOffset + newSize <= arena->size && (allocPos + newSize) - ringHeader->tailPos <= arena->size)
+				{
+					result = (u8*)allocPntr;
+					ringHeader->headPos = allocPos + newSize;
+					arena->used = ringHeader->headPos - ringHeader->tailPos;
+					if (IsFlagSet(arena->flags, MemArenaFlag_TelemetryEnabled))
+					{
+						if (arena->highUsedMark < arena->used) { arena->highUsedMark = arena->used; }
+						if (arena->resettableHighUsedMark < arena->used) { arena->resettableHighUsedMark = arena->used; }
+					}
+					break;
+				}
+			}
+			
+			#if GYLIB_MEM_ARENA_DEBUG_ENABLED
+			result = (u8*)AllocMem_(filePath, lineNumber, funcName, arena, newSize, alignOverride, true);
+			#else
+			result = (u8*)AllocMem(arena, newSize, alignOverride, true);
+			#endif
+			if (allocPntr != nullptr)
+			{
+				if (result != nullptr) { MyMemCopy(result, allocPntr, MinU64(oldSize, newSize)); }
+				bool freeSuccess = FreeMem(arena, allocPntr, oldSize, ignoreNullptr, nullptr, true);
+				AssertMsg(freeSuccess, "Failed to FreeMem in ReallocMem for Ring arena!");
+			}
+		} break;
+		
 		// +====================================+
 		// | Unsupported Arena Type ReallocMem  |
 		// +====================================+
@@ -3097,9 +4825,12 @@ void* ReallocMem_(MemArena_t* arena, void* allocPntr, u64 newSize, u64 oldSize,
 	#endif
 	
 	#ifdef _GY_TEST_MEMORY_PREDECLARED
-	if (!isSubCall && arena->testSetOut != nullptr) { MemArenaTestSetRecordReallocMemAction(arena->testSetOut, allocPntr, newSize, oldSize, alignOverride, result); }
+	if (!isSubCall && arena->testSetOut != nullptr) { MemArenaTestSetRecordReallocMemAction(arena->testSetOut, allocPntr, newSize, givenOldSize, alignOverride, result); }
 	#endif
 	
+	bool lockSharedStats = (arena->type == MemArenaType_ThreadCached && (IsFlagSet(arena->flags, MemArenaFlag_TrackTime) || IsFlagSet(arena->flags, MemArenaFlag_Histograms)));
+	if (lockSharedStats) { LockThreadCacheSource(arena, nullptr); }
+	if (!isSubCall && IsFlagSet(arena->flags, MemArenaFlag_Histograms)) { RecordMemArenaHistograms(arena, MemArenaOp_Realloc, &startTime, newSize); }
 	if (didLock) { UnlockGyMutex(&arena->mutex); }
 	if (IsFlagSet(arena->flags, MemArenaFlag_TrackTime))
 	{
@@ -3107,6 +4838,7 @@ void* ReallocMem_(MemArena_t* arena, void* allocPntr, u64 newSize, u64 oldSize,
 		AddToPerfTimeTotal(&startTime, &endTime, &arena->totalTimeSpentAllocating);
 		IncrementU64(arena->totalTimedAllocationActions);
 	}
+	if (lockSharedStats) { UnlockThreadCacheSource(arena); }
 	return result;
 }
 
@@ -3132,9 +4864,32 @@ u64 GrowMemQuery(MemArena_t* arena, const void* prevAllocPntr, u64 prevAllocSize
 	
 	switch (arena->type)
 	{
-		case MemArenaType_StdHeap: break; //no support
 		case MemArenaType_Redirect: break; //no support
 		
+		// +===================================+
+		// | MemArenaType_StdHeap GrowMemQuery |
+		// +===================================+
+		case MemArenaType_StdHeap:
+		{
+			//Only allocations with a mapping of their own can grow, malloc'd ones report 0.
+			//We only report the rest of the current mapping, GrowMem is the one that tries to extend the mapping in place
+			#if STD_HEAP_REMAP_SUPPORTED
+			StdHeapMappedPrefix_t* mappedPrefix = GetStdHeapMappedPrefix(prevAllocPntr);
+			if (mappedPrefix != nullptr)
+			{
+				u64 allocEnd = sizeof(StdHeapMappedPrefix_t) + prevAllocSize;
+				Assert(allocEnd <= mappedPrefix->mappedSize);
+				result = mappedPrefix->mappedSize - allocEnd;
+				if (tokenOut != nullptr)
+				{
+					tokenOut->memArena = arena;
+					tokenOut->nextSectionPntr = ((u8*)prevAllocPntr) + prevAllocSize;
+					tokenOut->nextSectionSize = result;
+				}
+			}
+			#endif
+		} break;
+		
 		// +==================================+
 		// | MemArenaType_Alias GrowMemQuery  |
 		// +==================================+
@@ -3199,70 +4954,36 @@ u64 GrowMemQuery(MemArena_t* arena, const void* prevAllocPntr, u64 prevAllocSize
 		// +======================================+
 		case MemArenaType_PagedHeap:
 		{
-			HeapPageHeader_t* pageHeader = (HeapPageHeader_t*)arena->headerPntr;
-			u64 pageIndex = 0;
-			while (pageHeader != nullptr)
+			DebugAssertMsg(FindHeapPageFor(arena, prevAllocPntr) != nullptr, "prevAllocPntr passed to GrowMemQuery is not in any of the pages of this PagedHeap!");
+			HeapAllocPrefix_t* prefixPntr = GetHeapAllocPrefix(prevAllocPntr);
+			Assert(IsAllocPrefixFilled(prefixPntr->size));
+			u8* sectionEndPntr = ((u8*)prefixPntr) + UnpackAllocPrefixSize(prefixPntr->size);
+			u8* prevAllocEndPntr = ((u8*)prevAllocPntr) + prevAllocSize;
+			AssertMsg(prevAllocEndPntr <= sectionEndPntr, "prevAllocSize passed to GrowMemQuery was too large");
+			result += (u64)(sectionEndPntr - prevAllocEndPntr);
+			
+			HeapAllocPrefix_t* nextPrefixPntr = (HeapAllocPrefix_t*)sectionEndPntr;
+			if (!IsAllocPrefixFilled(nextPrefixPntr->size)) //the sentinel at the end of the page is always filled
 			{
-				u8* allocBytePntr = (u8*)(pageHeader + 1);
-				if (!IsPntrInsideRange(prevAllocPntr, allocBytePntr, pageHeader->size))
-				{
-					pageHeader = pageHeader->next;
-					pageIndex++;
-					continue;
-				}
-				
-				u64 allocOffset = 0;
-				u64 sectionIndex = 0;
-				bool foundPrevAlloc = false;
-				while (allocOffset < pageHeader->size)
+				HeapFreeSection_t* nextSection = (HeapFreeSection_t*)nextPrefixPntr;
+				u64 nextSectionSize = UnpackAllocPrefixSize(nextPrefixPntr->size);
+				if (tokenOut != nullptr)
 				{
-					HeapAllocPrefix_t* allocPntr = (HeapAllocPrefix_t*)allocBytePntr;
-					u8* allocAfterPrefixPntr = (allocBytePntr + sizeof(HeapAllocPrefix_t));
-					bool isAllocFilled = IsAllocPrefixFilled(allocPntr->size);
-					u64 allocSize = UnpackAllocPrefixSize(allocPntr->size);
-					AssertMsg(allocSize >= sizeof(HeapAllocPrefix_t), "Found an allocation header that claimed to be smaller than the header itself in Paged Heap");
-					AssertMsg(allocOffset + allocSize <= pageHeader->size, "Found an allocation header with invalid size. Would extend past the end of a page!");
-					u64 allocAfterPrefixSize = allocSize - sizeof(HeapAllocPrefix_t);
-					if (allocAfterPrefixPntr == prevAllocPntr)
-					{
-						Assert(isAllocFilled);
-						AssertMsg(allocAfterPrefixSize >= prevAllocSize, "prevAllocSize passed to GrowMemQuery was too large");
-						AssertMsg(allocAfterPrefixSize <= prevAllocSize + AllocAlignment_Max, "prevAllocSize passed to GrowMemQuery was too small (even given some slop for alignment)");
-						u64 extraBytesInThisAlloc = allocAfterPrefixSize - prevAllocSize;
-						result += extraBytesInThisAlloc;
-						if (allocOffset + allocSize < pageHeader->size)
-						{
-							HeapAllocPrefix_t* nextAllocPntr = (HeapAllocPrefix_t*)(allocBytePntr + allocSize);
-							u64 nextAllocSize = UnpackAllocPrefixSize(nextAllocPntr->size);
-							if (!IsAllocPrefixFilled(nextAllocPntr->size))
-							{
-								if (tokenOut != nullptr)
-								{
-									tokenOut->memArena = arena;
-									tokenOut->nextSectionPntr = nextAllocPntr;
-									tokenOut->nextSectionSize = nextAllocSize;
-								}
-								result += nextAllocSize;
-							}
-						}
-						foundPrevAlloc = true;
-						break;
-					}
-					allocOffset += allocSize;
-					allocBytePntr += allocSize;
-					sectionIndex++;
+					tokenOut->memArena = arena;
+					tokenOut->nextSectionPntr = nextPrefixPntr;
+					tokenOut->nextSectionSize = nextSectionSize;
+					tokenOut->nextSectionNextFree = nextSection->nextFree;
+					tokenOut->nextSectionPrevFree = nextSection->prevFree;
 				}
-				UNUSED(sectionIndex); //used for debug purposes
-				
-				if (foundPrevAlloc) { break; }
+				result += nextSectionSize;
 			}
-			UNUSED(pageIndex); //used for debug purposes
 		} break;
 		
 		// +========================================+
 		// | MemArenaType_MarkedStack GrowMemQuery  |
 		// +========================================+
 		case MemArenaType_MarkedStack:
+		case MemArenaType_MappedFile:
 		{
 			AssertMsg(IsPntrInsideRange(prevAllocPntr, arena->mainPntr, arena->size), "prevAllocPntr passed to GrowMemQuery is not in this MarkedStack arena!");
 			AssertMsg(IsPntrInsideRange(prevAllocPntr, arena->mainPntr, arena->used), "prevAllocPntr passed to GrowMemQuery is not in this MarkedStack arena's used space");
@@ -3283,6 +5004,31 @@ u64 GrowMemQuery(MemArena_t* arena, const void* prevAllocPntr, u64 prevAllocSize
 			}
 		} break;
 		
+		// +==================================+
+		// | MemArenaType_Ring GrowMemQuery   |
+		// +==================================+
+		case MemArenaType_Ring:
+		{
+			NotNull(arena->headerPntr);
+			RingArenaHeader_t* ringHeader = (RingArenaHeader_t*)arena->headerPntr;
+			AssertMsg(IsPntrInsideRange(prevAllocPntr, arena->mainPntr, arena->size), "prevAllocPntr passed to GrowMemQuery is not in this Ring arena!");
+			u64 prevAllocPos = GetRingAllocPos(arena, prevAllocPntr);
+			if (prevAllocPos + prevAllocSize == ringHeader->headPos)
+			{
+				//We can only grow up to the end of the buffer (allocations never wrap) and up to the tail of the oldest live frame
+				u64 headOffset = ringHeader->headPos % arena->size;
+				if (headOffset == 0 && ringHeader->headPos > ringHeader->tailPos) { break; } //prevAlloc ended exactly at the end of the buffer
+				u64 spaceAvailable = MinU64(arena->size - headOffset, arena->size - arena->used);
+				if (tokenOut != nullptr)
+				{
+					tokenOut->memArena = arena;
+					tokenOut->nextSectionPntr = ((u8*)arena->mainPntr) + headOffset;
+					tokenOut->nextSectionSize = spaceAvailable;
+				}
+				result = spaceAvailable;
+			}
+		} break;
+		
 		// +======================================+
 		// | MemArenaType_PagedStack GrowMemQuery |
 		// +======================================+
@@ -3327,6 +5073,56 @@ u64 GrowMemQuery(MemArena_t* arena, const void* prevAllocPntr, u64 prevAllocSize
 			Unimplemented(); //TODO: Implement me!
 		} break;
 		
+		// +==================================+
+		// |  MemArenaType_Slab GrowMemQuery  |
+		// +==================================+
+		case MemArenaType_Slab:
+		{
+			const SlabPageHeader_t* pageHeader = FindSlabPageFor(arena, prevAllocPntr);
+			if (pageHeader == nullptr)
+			{
+				NotNull(arena->sourceArena);
+				const SlabPassthroughPrefix_t* prefix = ((const SlabPassthroughPrefix_t*)prevAllocPntr) - 1;
+				result = GrowMemQuery(arena->sourceArena, ((const u8*)prevAllocPntr) - prefix->rawOffset, prefix->rawOffset + prevAllocSize, tokenOut);
+				break;
+			}
+			AssertMsg((((u8*)prevAllocPntr - pageHeader->slotsBase) % pageHeader->slotSize) == 0, "prevAllocPntr passed to GrowMemQuery pointed to the middle of a Slab slot!");
+			AssertMsg(prevAllocSize <= pageHeader->slotSize, "prevAllocSize passed to GrowMemQuery was larger than the Slab slot");
+			//We can only grow into the rest of the slot, the next slot may be in use
+			result = pageHeader->slotSize - prevAllocSize;
+			if (tokenOut != nullptr)
+			{
+				tokenOut->memArena = arena;
+				tokenOut->nextSectionPntr = ((u8*)prevAllocPntr) + prevAllocSize;
+				tokenOut->nextSectionSize = result;
+			}
+		} break;
+		
+		// +==========================================+
+		// |  MemArenaType_ThreadCached GrowMemQuery  |
+		// +==========================================+
+		case MemArenaType_ThreadCached:
+		{
+			const ThreadCacheBlockPrefix_t* prefix = ((const ThreadCacheBlockPrefix_t*)prevAllocPntr) - 1;
+			if (prefix->sizeClass >= SLAB_NUM_SIZE_CLASSES)
+			{
+				NotNull(arena->sourceArena);
+				LockThreadCacheSource(arena, nullptr);
+				result = GrowMemQuery(arena->sourceArena, ((const u8*)prevAllocPntr) - prefix->rawOffset, prefix->rawOffset + prevAllocSize, tokenOut);
+				UnlockThreadCacheSource(arena);
+				break;
+			}
+			u64 slotSize = (SLAB_MIN_SLOT_SIZE << prefix->sizeClass);
+			AssertMsg(prevAllocSize <= slotSize, "prevAllocSize passed to GrowMemQuery was larger than the ThreadCached block");
+			result = slotSize - prevAllocSize;
+			if (tokenOut != nullptr)
+			{
+				tokenOut->memArena = arena;
+				tokenOut->nextSectionPntr = ((u8*)prevAllocPntr) + prevAllocSize;
+				tokenOut->nextSectionSize = result;
+			}
+		} break;
+		
 		// +======================================+
 		// | Unsupported Arena Type GrowMemQuery  |
 		// +======================================+
@@ -3350,14 +5146,42 @@ void GrowMem(MemArena_t* arena, const void* prevAllocPntr, u64 prevAllocSize, u6
 	Assert(newAllocSize >= prevAllocSize);
 	if (newAllocSize == prevAllocSize) { return; } //no work to do
 	
+	PerfTime_t startTime;
+	if (IsFlagSet(arena->flags, MemArenaFlag_Histograms)) { startTime = GetPerfTime(); }
+	
 	bool didLock = false;
 	if (IsValidGyMutex(&arena->mutex)) { LockGyMutex(&arena->mutex); didLock = true; }
 	
 	switch (arena->type)
 	{
-		case MemArenaType_StdHeap: Unimplemented(); break; //no support
 		case MemArenaType_Redirect: Unimplemented(); break; //no support
 		
+		// +==============================+
+		// | MemArenaType_StdHeap GrowMem |
+		// +==============================+
+		case MemArenaType_StdHeap:
+		{
+			#if STD_HEAP_REMAP_SUPPORTED
+			StdHeapMappedPrefix_t* mappedPrefix = GetStdHeapMappedPrefix(prevAllocPntr);
+			AssertMsg(mappedPrefix != nullptr, "GrowMem in StdHeap is only supported for allocations that have their own mapping. GrowMemQuery should have returned 0");
+			if (sizeof(StdHeapMappedPrefix_t) + newAllocSize > mappedPrefix->mappedSize)
+			{
+				//Past what GrowMemQuery reported. We can still try to extend the mapping in place, but it can't move since the caller already has pointers into it
+				u8* remappedPntr = ResizeStdHeapMapped(mappedPrefix, newAllocSize, false);
+				AssertMsg(remappedPntr != nullptr, "Tried to GrowMem in StdHeap past the space reported by GrowMemQuery and the mapping couldn't be extended in place!");
+				UNUSED(remappedPntr);
+			}
+			arena->used += newAllocSize - prevAllocSize;
+			if (IsFlagSet(arena->flags, MemArenaFlag_TelemetryEnabled))
+			{
+				if (arena->highUsedMark < arena->used) { arena->highUsedMark = arena->used; }
+				if (arena->resettableHighUsedMark < arena->used) { arena->resettableHighUsedMark = arena->used; }
+			}
+			#else
+			Unimplemented(); //no support
+			#endif
+		} break;
+		
 		// +==============================+
 		// |  MemArenaType_Alias GrowMem  |
 		// +==============================+
@@ -3475,115 +5299,63 @@ void GrowMem(MemArena_t* arena, const void* prevAllocPntr, u64 prevAllocSize, u6
 		// +================================+
 		case MemArenaType_PagedHeap:
 		{
-			bool foundAllocation = false;
-			HeapPageHeader_t* pageHeader = (HeapPageHeader_t*)arena->headerPntr;
-			u64 pageIndex = 0;
-			while (pageHeader != nullptr)
+			DebugAssertMsg(FindHeapPageFor(arena, prevAllocPntr) != nullptr, "Tried to grow an allocation from the incorrect arena. Maybe the arena is corrupt or the memory pntr was mishandled?");
+			HeapAllocPrefix_t* prefixPntr = GetHeapAllocPrefix(prevAllocPntr);
+			Assert(IsAllocPrefixFilled(prefixPntr->size));
+			u64 sectionSize = UnpackAllocPrefixSize(prefixPntr->size);
+			u8* sectionEndPntr = ((u8*)prefixPntr) + sectionSize;
+			u8* newAllocEndPntr = ((u8*)prevAllocPntr) + newAllocSize;
+			AssertMsg(((u8*)prevAllocPntr) + prevAllocSize <= sectionEndPntr, "prevAllocSize passed to GrowMem was too large");
+			if (newAllocEndPntr <= sectionEndPntr)
 			{
-				u8* allocBytePntr = (u8*)(pageHeader + 1);
-				if (!IsPntrInsideRange(prevAllocPntr, allocBytePntr, pageHeader->size))
-				{
-					pageHeader = pageHeader->next;
-					pageIndex++;
-					continue;
-				}
-				
-				u64 allocOffset = 0;
-				u64 sectionIndex = 0;
-				while (allocOffset < pageHeader->size)
-				{
-					HeapAllocPrefix_t* allocPntr = (HeapAllocPrefix_t*)allocBytePntr;
-					u8* allocAfterPrefixPntr = (allocBytePntr + sizeof(HeapAllocPrefix_t));
-					bool isAllocFilled = IsAllocPrefixFilled(allocPntr->size);
-					u64 allocSize = UnpackAllocPrefixSize(allocPntr->size);
-					AssertMsg(allocSize >= sizeof(HeapAllocPrefix_t), "Found an allocation header that claimed to be smaller than the header itself in Fixed Heap");
-					AssertMsg(allocOffset + allocSize <= pageHeader->size, "Found an allocation header with invalid size. Would extend past the end of a page!");
-					u64 allocAfterPrefixSize = allocSize - sizeof(HeapAllocPrefix_t);
-					if (allocAfterPrefixPntr == prevAllocPntr)
-					{
-						Assert(isAllocFilled);
-						AssertMsg(allocSize >= prevAllocSize, "prevAllocSize passed to GrowMemQuery was too large");
-						AssertMsg(allocSize <= prevAllocSize + AllocAlignment_Max, "prevAllocSize passed to GrowMemQuery was too small (even given some slop for alignment)");
-						foundAllocation = true;
-						
-						if (allocAfterPrefixSize >= newAllocSize)
-						{
-							//the calling code grew into it's already available extra space. No fixup work is needed
-							break;
-						}
-						u64 extraBytesInThisAlloc = allocAfterPrefixSize - prevAllocSize;
-						u64 numNewBytesUsed = (newAllocSize - prevAllocSize) - extraBytesInThisAlloc;
-						Assert(numNewBytesUsed <= token->nextSectionSize);
-						AssertMsg(allocBytePntr + prevAllocSize >= ((u8*)token->nextSectionPntr) - AllocAlignment_Max, "GrowMemQuery token had invalid nextSectionPntr based on info passed to GrowMem. Are you re-using a token to grow? Or is the token corrupt?");
-						AssertMsg(allocBytePntr + prevAllocSize <= ((u8*)token->nextSectionPntr) + AllocAlignment_Max, "GrowMemQuery token had invalid nextSectionPntr based on info passed to GrowMem. Are you re-using a token to grow? Or is the token corrupt?");
-						
-						allocSize = newAllocSize + sizeof(HeapAllocPrefix_t);
-						allocPntr->size = PackAllocPrefixSize(isAllocFilled, allocSize);
-						arena->used += numNewBytesUsed;
-						
-						if (token->nextSectionSize - numNewBytesUsed > sizeof(HeapAllocPrefix_t))
-						{
-							//shrink the next section
-							HeapAllocPrefix_t* nextAllocPntr = (HeapAllocPrefix_t*)(allocBytePntr + allocSize);
-							u64 nextAllocSize = token->nextSectionSize - numNewBytesUsed;
-							nextAllocPntr->size = PackAllocPrefixSize(false, nextAllocSize);
-							#if ASSERTIONS_ENABLED
-							//Let's try and check the integrity of our linked list of sections to make sure we didn't make any mistakes (and make sure the calling code didn't write out of bounds)
-							if (allocOffset + allocSize + nextAllocSize < pageHeader->size)
-							{
-								HeapAllocPrefix_t* nextNextAllocPntr = (HeapAllocPrefix_t*)(allocBytePntr + allocSize + nextAllocSize);
-								Assert(IsAllocPrefixFilled(nextNextAllocPntr->size)); //we shouldn't have any consecutive unfilled sections
-								Assert(allocOffset + allocSize + nextAllocSize + UnpackAllocPrefixSize(nextNextAllocPntr->size) <= pageHeader->size);
-							}
-							#endif
-						}
-						else
-						{
-							//next section got too small or was entirely used up
-							u64 numBytesLeftover = token->nextSectionSize - numNewBytesUsed;
-							if (numBytesLeftover > 0)
-							{
-								allocSize += numBytesLeftover;
-								allocPntr->size = PackAllocPrefixSize(isAllocFilled, allocSize);
-								arena->used += numBytesLeftover;
-								arena->used -= sizeof(HeapAllocPrefix_t); //a section went away, so it's usage needs to be subtracted
-							}
-							#if ASSERTIONS_ENABLED
-							//Let's try and check the integrity of our linked list of sections to make sure we didn't make any mistakes (and make sure the calling code didn't write out of bounds)
-							if (allocOffset + allocSize < pageHeader->size)
-							{
-								HeapAllocPrefix_t* nextAllocPntr = (HeapAllocPrefix_t*)(allocBytePntr + allocSize);
-								Assert(IsAllocPrefixFilled(nextAllocPntr->size)); //we shouldn't have any consecutive unfilled sections
-								Assert(allocOffset + allocSize + UnpackAllocPrefixSize(nextAllocPntr->size) <= pageHeader->size);
-							}
-							#endif
-						}
-						
-						if (IsFlagSet(arena->flags, MemArenaFlag_TelemetryEnabled))
-						{
-							if (arena->highUsedMark < arena->used) { arena->highUsedMark = arena->used; }
-							if (arena->resettableHighUsedMark < arena->used) { arena->resettableHighUsedMark = arena->used; }
-							if (arena->highAllocMark < arena->numAllocations) { arena->highAllocMark = arena->numAllocations; }
-						}
-						
-						break;
-					}
-					allocOffset += allocSize;
-					allocBytePntr += allocSize;
-					sectionIndex++;
-				}
-				UNUSED(sectionIndex); //used for debug purposes
-				
-				if (foundAllocation) { break; }
+				//the calling code grew into it's already available extra space. No fixup work is needed
+				break;
+			}
+			
+			Assert(token->memArena == arena);
+			AssertMsg(token->nextSectionPntr == sectionEndPntr, "GrowMemQuery token had invalid nextSectionPntr based on info passed to GrowMem. Are you re-using a token to grow? Or is the token corrupt?");
+			AssertMsg(newAllocEndPntr <= sectionEndPntr + token->nextSectionSize, "Tried to GrowMem past the amount that GrowMemQuery returned");
+			HeapFreeIndex_t* freeIndex = (HeapFreeIndex_t*)arena->otherPntr;
+			NotNull(freeIndex);
+			//The calling code has probably already written over the next section's prefix so we have to use the links saved in the token
+			UnlinkHeapFreeSection(freeIndex, token->nextSectionPntr, token->nextSectionSize, token->nextSectionNextFree, token->nextSectionPrevFree);
+			
+			u64 newSectionSize = MaxU64(RoundUpToU64((u64)(newAllocEndPntr - (u8*)prefixPntr), HEAP_SECTION_GRANULARITY), HEAP_MIN_SECTION_SIZE);
+			u64 combinedSize = sectionSize + token->nextSectionSize;
+			u64 keepFlags = (prefixPntr->size & (HEAP_ALLOC_FIRST_FLAG | HEAP_ALLOC_PREV_FREE_FLAG));
+			if (combinedSize - newSectionSize >= HEAP_MIN_SECTION_SIZE)
+			{
+				//shrink the next section
+				prefixPntr->size = PackAllocPrefixSize(true, newSectionSize) | keepFlags;
+				HeapAllocPrefix_t* newNextPrefix = (HeapAllocPrefix_t*)(((u8*)prefixPntr) + newSectionSize);
+				newNextPrefix->size = PackAllocPrefixSize(false, combinedSize - newSectionSize);
+				InsertHeapFreeSection(freeIndex, newNextPrefix);
+				arena->used += newSectionSize - sectionSize;
+			}
+			else
+			{
+				//next section got too small or was entirely used up
+				prefixPntr->size = PackAllocPrefixSize(true, combinedSize) | keepFlags;
+				HeapAllocPrefix_t* nextNextPrefix = (HeapAllocPrefix_t*)(((u8*)prefixPntr) + combinedSize);
+				Assert(IsAllocPrefixFilled(nextNextPrefix->size)); //we shouldn't have any consecutive unfilled sections
+				FlagUnset(nextNextPrefix->size, HEAP_ALLOC_PREV_FREE_FLAG);
+				arena->used += token->nextSectionSize - sizeof(HeapAllocPrefix_t); //a section went away, so it's prefix is now part of our allocation
+			}
+			Assert(arena->used <= arena->size);
+			
+			if (IsFlagSet(arena->flags, MemArenaFlag_TelemetryEnabled))
+			{
+				if (arena->highUsedMark < arena->used) { arena->highUsedMark = arena->used; }
+				if (arena->resettableHighUsedMark < arena->used) { arena->resettableHighUsedMark = arena->used; }
+				if (arena->highAllocMark < arena->numAllocations) { arena->highAllocMark = arena->numAllocations; }
 			}
-			UNUSED(pageIndex); //used for debug purposes
-			AssertMsg(foundAllocation, "Tried to grow an allocation from the incorrect arena. Or the prevAllocPntr was misaligned. Maybe the arena is corrupt or the memory pntr was mishandled?");
 		} break;
 		
 		// +==================================+
 		// | MemArenaType_MarkedStack GrowMem |
 		// +==================================+
 		case MemArenaType_MarkedStack:
+		case MemArenaType_MappedFile:
 		{
 			AssertMsg(IsPntrInsideRange(prevAllocPntr, arena->mainPntr, arena->size), "prevAllocPntr passed to GrowMemQuery is not in this MarkedStack arena!");
 			AssertMsg(IsPntrInsideRange(prevAllocPntr, arena->mainPntr, arena->used), "prevAllocPntr passed to GrowMemQuery is not in this MarkedStack arena's used space");
@@ -3597,6 +5369,26 @@ void GrowMem(MemArena_t* arena, const void* prevAllocPntr, u64 prevAllocSize, u6
 			Assert(arena->used <= arena->size);
 		} break;
 		
+		// +==============================+
+		// |  MemArenaType_Ring GrowMem   |
+		// +==============================+
+		case MemArenaType_Ring:
+		{
+			NotNull(arena->headerPntr);
+			RingArenaHeader_t* ringHeader = (RingArenaHeader_t*)arena->headerPntr;
+			AssertMsg(IsPntrInsideRange(prevAllocPntr, arena->mainPntr, arena->size), "prevAllocPntr passed to GrowMem is not in this Ring arena!");
+			AssertMsg(GetRingAllocPos(arena, prevAllocPntr) + prevAllocSize == ringHeader->headPos, "Something went wrong between GrowMemQuery and GrowMem in Ring. The grown section isn't at the head of the ring!");
+			AssertMsg(token->nextSectionSize >= newAllocSize - prevAllocSize, "Tried to GrowMem in Ring arena past the space reported by GrowMemQuery!");
+			ringHeader->headPos += newAllocSize - prevAllocSize;
+			arena->used = ringHeader->headPos - ringHeader->tailPos;
+			if (IsFlagSet(arena->flags, MemArenaFlag_TelemetryEnabled))
+			{
+				if (arena->highUsedMark < arena->used) { arena->highUsedMark = arena->used; }
+				if (arena->resettableHighUsedMark < arena->used) { arena->resettableHighUsedMark = arena->used; }
+			}
+			Assert(arena->used <= arena->size);
+		} break;
+		
 		// +==================================+
 		// | MemArenaType_PagedStack GrowMem  |
 		// +==================================+
@@ -3632,6 +5424,61 @@ void GrowMem(MemArena_t* arena, const void* prevAllocPntr, u64 prevAllocSize, u6
 			Unimplemented(); //TODO: Implement me!
 		} break;
 		
+		// +==============================+
+		// |  MemArenaType_Slab GrowMem   |
+		// +==============================+
+		case MemArenaType_Slab:
+		{
+			if (FindSlabPageFor(arena, prevAllocPntr) == nullptr)
+			{
+				//The GrowMemQuery was passed through to the sourceArena
+				NotNull(arena->sourceArena);
+				SlabPassthroughPrefix_t* prefix = ((SlabPassthroughPrefix_t*)prevAllocPntr) - 1;
+				GrowMem(arena->sourceArena, ((const u8*)prevAllocPntr) - prefix->rawOffset, prefix->rawOffset + prevAllocSize, prefix->rawOffset + newAllocSize, token);
+				prefix->size = newAllocSize;
+				arena->used += (newAllocSize - prevAllocSize);
+				if (IsFlagSet(arena->flags, MemArenaFlag_TelemetryEnabled))
+				{
+					if (arena->highUsedMark < arena->used) { arena->highUsedMark = arena->used; }
+					if (arena->resettableHighUsedMark < arena->used) { arena->resettableHighUsedMark = arena->used; }
+				}
+				break;
+			}
+			Assert(token->memArena == arena);
+			AssertMsg(token->nextSectionPntr == ((u8*)prevAllocPntr) + prevAllocSize, "GrowMem token doesn't match the prevAllocPntr and prevAllocSize given");
+			AssertMsg(newAllocSize - prevAllocSize <= token->nextSectionSize, "Tried to GrowMem a Slab allocation past the end of it's slot");
+			//Nothing to do, the whole slot is already counted in used
+		} break;
+		
+		// +===================================+
+		// | MemArenaType_ThreadCached GrowMem |
+		// +===================================+
+		case MemArenaType_ThreadCached:
+		{
+			ThreadCacheBlockPrefix_t* prefix = ((ThreadCacheBlockPrefix_t*)prevAllocPntr) - 1;
+			if (prefix->sizeClass >= SLAB_NUM_SIZE_CLASSES)
+			{
+				//The GrowMemQuery was passed through to the sourceArena
+				NotNull(arena->sourceArena);
+				LockThreadCacheSource(arena, FindThreadCache(arena));
+				GrowMem(arena->sourceArena, ((const u8*)prevAllocPntr) - prefix->rawOffset, prefix->rawOffset + prevAllocSize, prefix->rawOffset + newAllocSize, token);
+				prefix->passthroughSize = newAllocSize;
+				arena->size += (newAllocSize - prevAllocSize);
+				arena->used += (newAllocSize - prevAllocSize);
+				if (IsFlagSet(arena->flags, MemArenaFlag_TelemetryEnabled))
+				{
+					if (arena->highUsedMark < arena->used) { arena->highUsedMark = arena->used; }
+					if (arena->resettableHighUsedMark < arena->used) { arena->resettableHighUsedMark = arena->used; }
+				}
+				UnlockThreadCacheSource(arena);
+				break;
+			}
+			Assert(token->memArena == arena);
+			AssertMsg(token->nextSectionPntr == ((u8*)prevAllocPntr) + prevAllocSize, "GrowMem token doesn't match the prevAllocPntr and prevAllocSize given");
+			AssertMsg(newAllocSize - prevAllocSize <= token->nextSectionSize, "Tried to GrowMem a ThreadCached allocation past the end of it's block");
+			//Nothing to do, the whole block is already counted in used
+		} break;
+		
 		// +======================================+
 		// | Unsupported Arena Type GrowMemQuery  |
 		// +======================================+
@@ -3642,6 +5489,10 @@ void GrowMem(MemArena_t* arena, const void* prevAllocPntr, u64 prevAllocSize, u6
 		} break;
 	}
 	
+	bool lockSharedStats = (arena->type == MemArenaType_ThreadCached && IsFlagSet(arena->flags, MemArenaFlag_Histograms));
+	if (lockSharedStats) { LockThreadCacheSource(arena, nullptr); }
+	if (IsFlagSet(arena->flags, MemArenaFlag_Histograms)) { RecordMemArenaHistograms(arena, MemArenaOp_Grow, &startTime, 0); }
+	if (lockSharedStats) { UnlockThreadCacheSource(arena); }
 	if (didLock) { UnlockGyMutex(&arena->mutex); }
 }
 
@@ -3669,12 +5520,19 @@ void ShrinkMem(MemArena_t* arena, const void* prevAllocPntr, u64 prevAllocSize,
 		case MemArenaType_StdHeap:
 		{
 			//We don't really need to do anything for these arenas because they are fine if you pass the incorrect size to FreeMem
+			//but allocations with their own mapping can give back any whole pages past the new size
+			#if STD_HEAP_REMAP_SUPPORTED
+			StdHeapMappedPrefix_t* mappedPrefix = GetStdHeapMappedPrefix(prevAllocPntr);
+			if (mappedPrefix != nullptr) { ResizeStdHeapMapped(mappedPrefix, newAllocSize, false); }
+			#endif
+			DecrementBy(arena->used, prevAllocSize - newAllocSize); //so FreeMem with the new size balances out
 		} break;
 		
 		// +====================================+
 		// | MemArenaType_MarkedStack ShrinkMem |
 		// +====================================+
 		case MemArenaType_MarkedStack:
+		case MemArenaType_MappedFile:
 		{
 			Assert(IsPntrInsideRange(prevAllocPntr, arena->mainPntr, arena->size));
 			u64 prevAllocOffset = (u64)(((u8*)prevAllocPntr) - ((u8*)arena->mainPntr));
@@ -3683,7 +5541,23 @@ void ShrinkMem(MemArena_t* arena, const void* prevAllocPntr, u64 prevAllocSize,
 			// This is the only scenario where we support shrinking
 			if (prevAllocOffset + prevAllocSize == arena->used)
 			{
-				arena->used -= (prevAllocSize - newAllocSize);
+				arena->used -= (prevAllocSize - newAllocSize);
+			}
+		} break;
+		
+		// +==============================+
+		// | MemArenaType_Ring ShrinkMem  |
+		// +==============================+
+		case MemArenaType_Ring:
+		{
+			NotNull(arena->headerPntr);
+			RingArenaHeader_t* ringHeader = (RingArenaHeader_t*)arena->headerPntr;
+			Assert(IsPntrInsideRange(prevAllocPntr, arena->mainPntr, arena->size));
+			// Like the stacks, we can only give back space if this is the most recent allocation in the ring
+			if (GetRingAllocPos(arena, prevAllocPntr) + prevAllocSize == ringHeader->headPos)
+			{
+				ringHeader->headPos -= (prevAllocSize - newAllocSize);
+				arena->used = ringHeader->headPos - ringHeader->tailPos;
 			}
 		} break;
 		
@@ -3782,68 +5656,37 @@ void ShrinkMem(MemArena_t* arena, const void* prevAllocPntr, u64 prevAllocSize,
 		// +==================================+
 		case MemArenaType_PagedHeap:
 		{
-			bool foundAllocation = false;
-			HeapPageHeader_t* pageHeader = (HeapPageHeader_t*)arena->headerPntr;
-			u64 pageIndex = 0;
-			while (pageHeader != nullptr)
+			DebugAssertMsg(FindHeapPageFor(arena, prevAllocPntr) != nullptr, "Tried to shrink an allocation from the incorrect arena. Maybe the arena is corrupt or the memory pntr was mishandled?");
+			HeapAllocPrefix_t* prefixPntr = GetHeapAllocPrefix(prevAllocPntr);
+			Assert(IsAllocPrefixFilled(prefixPntr->size));
+			u64 sectionSize = UnpackAllocPrefixSize(prefixPntr->size);
+			AssertMsg(((u8*)prevAllocPntr) + prevAllocSize <= ((u8*)prefixPntr) + sectionSize, "prevAllocSize passed to ShrinkMem was too large");
+			u64 newSectionSize = MaxU64(RoundUpToU64((u64)((((u8*)prevAllocPntr) + newAllocSize) - (u8*)prefixPntr), HEAP_SECTION_GRANULARITY), HEAP_MIN_SECTION_SIZE);
+			if (newSectionSize >= sectionSize) { break; }
+			u64 shrinkAmount = sectionSize - newSectionSize;
+			
+			HeapFreeIndex_t* freeIndex = (HeapFreeIndex_t*)arena->otherPntr;
+			NotNull(freeIndex);
+			HeapAllocPrefix_t* nextPrefixPntr = (HeapAllocPrefix_t*)(((u8*)prefixPntr) + sectionSize);
+			bool isNextSectionFilled = IsAllocPrefixFilled(nextPrefixPntr->size);
+			if (!isNextSectionFilled || shrinkAmount >= HEAP_MIN_SECTION_SIZE)
 			{
-				u8* allocBytePntr = (u8*)(pageHeader + 1);
-				if (!IsPntrInsideRange(prevAllocPntr, allocBytePntr, pageHeader->size))
-				{
-					pageHeader = pageHeader->next;
-					pageIndex++;
-					continue;
-				}
-				
-				u64 allocOffset = 0;
-				u64 sectionIndex = 0;
-				while (allocOffset < pageHeader->size)
+				u64 newFreeSize = shrinkAmount;
+				if (!isNextSectionFilled)
 				{
-					HeapAllocPrefix_t* allocPntr = (HeapAllocPrefix_t*)allocBytePntr;
-					u8* allocAfterPrefixPntr = (allocBytePntr + sizeof(HeapAllocPrefix_t));
-					bool isAllocFilled = IsAllocPrefixFilled(allocPntr->size);
-					u64 allocSize = UnpackAllocPrefixSize(allocPntr->size);
-					AssertMsg(allocSize >= sizeof(HeapAllocPrefix_t), "Found an allocation header that claimed to be smaller than the header itself in Fixed Heap");
-					AssertMsg(allocOffset + allocSize <= pageHeader->size, "Found an allocation header with invalid size. Would extend past the end of a page!");
-					u64 allocAfterPrefixSize = allocSize - sizeof(HeapAllocPrefix_t);
-					if (allocAfterPrefixPntr == prevAllocPntr)
-					{
-						Assert(isAllocFilled);
-						AssertMsg(allocSize >= prevAllocSize, "prevAllocSize passed to ShrinkMem was too large");
-						AssertMsg(allocSize <= prevAllocSize + AllocAlignment_Max, "prevAllocSize passed to ShrinkMem was too small (even given some slop for alignment)");
-						foundAllocation = true;
-						
-						u64 extraBytesInThisAlloc = allocAfterPrefixSize - prevAllocSize;
-						u64 shrinkAmount = (prevAllocSize - newAllocSize) + extraBytesInThisAlloc;
-						bool nextAllocExists = (allocOffset + allocSize < pageHeader->size);
-						HeapAllocPrefix_t* nextAllocPntr = (nextAllocExists ? (HeapAllocPrefix_t*)(allocBytePntr + allocSize) : nullptr);
-						bool isNextAllocFilled = (nextAllocExists ? IsAllocPrefixFilled(nextAllocPntr->size) : true);
-						u64 nextAllocSize = (nextAllocExists ? UnpackAllocPrefixSize(nextAllocPntr->size) : 0);
-						if (!isNextAllocFilled || shrinkAmount > sizeof(HeapAllocPrefix_t))
-						{
-							allocSize -= shrinkAmount;
-							allocPntr->size = PackAllocPrefixSize(isAllocFilled, allocSize);
-							HeapAllocPrefix_t* newEmptyAlloc = (HeapAllocPrefix_t*)(allocBytePntr + allocSize);
-							newEmptyAlloc->size = PackAllocPrefixSize(isNextAllocFilled, (isNextAllocFilled ? 0 : nextAllocSize) + shrinkAmount);
-							arena->used -= shrinkAmount - (isNextAllocFilled ? 0 : sizeof(HeapAllocPrefix_t));
-						}
-						else
-						{
-							//If we aren't shrinking enough to make a new section and the next section is filled, we should be safe to silently keep the allocation the same size
-						}
-						
-						break;
-					}
-					allocOffset += allocSize;
-					allocBytePntr += allocSize;
-					sectionIndex++;
+					RemoveHeapFreeSection(freeIndex, nextPrefixPntr);
+					newFreeSize += UnpackAllocPrefixSize(nextPrefixPntr->size);
 				}
-				UNUSED(sectionIndex); //used for debug purposes
-				
-				if (foundAllocation) { break; }
+				prefixPntr->size = PackAllocPrefixSize(true, newSectionSize) | (prefixPntr->size & (HEAP_ALLOC_FIRST_FLAG | HEAP_ALLOC_PREV_FREE_FLAG));
+				HeapAllocPrefix_t* newFreePrefix = (HeapAllocPrefix_t*)(((u8*)prefixPntr) + newSectionSize);
+				newFreePrefix->size = PackAllocPrefixSize(false, newFreeSize);
+				InsertHeapFreeSection(freeIndex, newFreePrefix);
+				arena->used -= shrinkAmount - (isNextSectionFilled ? sizeof(HeapAllocPrefix_t) : 0);
+			}
+			else
+			{
+				//If we aren't shrinking enough to make a new section and the next section is filled, we should be safe to silently keep the allocation the same size
 			}
-			UNUSED(pageIndex); //used for debug purposes
-			AssertMsg(foundAllocation, "Tried to shrink an allocation from the incorrect arena. Or the prevAllocPntr was misaligned. Maybe the arena is corrupt or the memory pntr was mishandled?");
 		} break;
 		
 		// +===============================+
@@ -3854,6 +5697,46 @@ void ShrinkMem(MemArena_t* arena, const void* prevAllocPntr, u64 prevAllocSize,
 			Unimplemented(); //TODO: Implement me!
 		} break;
 		
+		// +===============================+
+		// |  MemArenaType_Slab ShrinkMem  |
+		// +===============================+
+		case MemArenaType_Slab:
+		{
+			const SlabPageHeader_t* pageHeader = FindSlabPageFor(arena, prevAllocPntr);
+			if (pageHeader == nullptr)
+			{
+				NotNull(arena->sourceArena);
+				SlabPassthroughPrefix_t* prefix = ((SlabPassthroughPrefix_t*)prevAllocPntr) - 1;
+				ShrinkMem(arena->sourceArena, ((const u8*)prevAllocPntr) - prefix->rawOffset, prefix->rawOffset + prevAllocSize, prefix->rawOffset + newAllocSize);
+				prefix->size = newAllocSize;
+				DecrementBy(arena->used, prevAllocSize - newAllocSize);
+				break;
+			}
+			AssertMsg(prevAllocSize <= pageHeader->slotSize, "prevAllocSize passed to ShrinkMem was larger than the Slab slot");
+			//Nothing to do, the allocation keeps it's whole slot
+		} break;
+		
+		// +=======================================+
+		// |  MemArenaType_ThreadCached ShrinkMem  |
+		// +=======================================+
+		case MemArenaType_ThreadCached:
+		{
+			ThreadCacheBlockPrefix_t* prefix = ((ThreadCacheBlockPrefix_t*)prevAllocPntr) - 1;
+			if (prefix->sizeClass >= SLAB_NUM_SIZE_CLASSES)
+			{
+				NotNull(arena->sourceArena);
+				LockThreadCacheSource(arena, FindThreadCache(arena));
+				ShrinkMem(arena->sourceArena, ((const u8*)prevAllocPntr) - prefix->rawOffset, prefix->rawOffset + prevAllocSize, prefix->rawOffset + newAllocSize);
+				prefix->passthroughSize = newAllocSize;
+				DecrementBy(arena->size, prevAllocSize - newAllocSize);
+				DecrementBy(arena->used, prevAllocSize - newAllocSize);
+				UnlockThreadCacheSource(arena);
+				break;
+			}
+			AssertMsg(prevAllocSize <= (SLAB_MIN_SLOT_SIZE << prefix->sizeClass), "prevAllocSize passed to ShrinkMem was larger than the ThreadCached block");
+			//Nothing to do, the allocation keeps it's whole block
+		} break;
+		
 		// +==================================+
 		// | Unsupported Arena Type ShrinkMem |
 		// +==================================+
@@ -3875,6 +5758,9 @@ void FreeMemArena(MemArena_t* arena)
 	NotNull(arena);
 	
 	if (IsValidGyMutex(&arena->mutex)) { FreeGyMutex(&arena->mutex); }
+	#if GYLIB_MEM_ARENA_DEBUG_ENABLED
+	if (arena->debugArena != nullptr) { FreeAllocInfoTable(arena); }
+	#endif
 	
 	switch (arena->type)
 	{
@@ -3896,21 +5782,16 @@ void FreeMemArena(MemArena_t* arena)
 			while (pageHeader != nullptr)
 			{
 				HeapPageHeader_t* nextPageHeader = pageHeader->next;
-				if (arena->sourceArena != nullptr)
-				{
-					FreeMem(arena->sourceArena, pageHeader, sizeof(HeapPageHeader_t) + pageHeader->size);
-				}
-				else if (arena->freeFunc != nullptr)
-				{
-					arena->freeFunc(pageHeader);
-				}
-				else
-				{
-					AssertMsg(false, "This PageHeap cannot be freed because it doesn't have a sourceArena or freeFunc pointer!");
-				}
+				ReleaseHeapPage(arena, pageHeader);
 				pageHeader = nextPageHeader;
 				pageIndex++;
 			}
+			if (arena->otherPntr != nullptr)
+			{
+				if (arena->sourceArena != nullptr) { FreeMem(arena->sourceArena, arena->otherPntr, sizeof(HeapFreeIndex_t)); }
+				else if (arena->freeFunc != nullptr) { arena->freeFunc(arena->otherPntr); }
+				arena->otherPntr = nullptr;
+			}
 		} break;
 		
 		// +======================================+
@@ -3940,20 +5821,75 @@ void FreeMemArena(MemArena_t* arena)
 			}
 		} break;
 		
+		// +========================================+
+		// | MemArenaType_MappedFile FreeMemArena   |
+		// +========================================+
+		case MemArenaType_MappedFile:
+		{
+			//NOTE: We don't sync here, anything since the last SyncMappedFileArena is not part of the file's state
+			OsUnmapFile(arena->headerPntr, arena->maxSize);
+		} break;
+		
 		#if !ORCA_COMPILATION
 		// +========================================+
 		// | MemArenaType_VirtualStack FreeMemArena |
 		// +========================================+
 		case MemArenaType_VirtualStack:
 		{
-			Assert((arena->mainPntr == nullptr) == (arena->maxSize > 0));
-			if (arena->mainPntr != nullptr)
+			AssertMsg(!IsFlagSet(arena->flags, MemArenaFlag_Snapshotted), "Free the MemArenaSnapshot_t before freeing the arena it's tracking");
+			Assert((arena->headerPntr == nullptr) == (arena->maxSize == 0));
+			if (arena->headerPntr != nullptr)
 			{
-				OsFreeReservedMemory(arena->mainPntr, arena->maxSize);
+				//NOTE: The reservation starts at the header, mainPntr is offset past the header and marks
+				OsFreeReservedMemory(arena->headerPntr, arena->maxSize);
 			}
 		} break;
 		#endif //!ORCA_COMPILATION
 		
+		// +==================================+
+		// |  MemArenaType_Slab FreeMemArena  |
+		// +==================================+
+		case MemArenaType_Slab:
+		{
+			NotNull2(arena->headerPntr, arena->sourceArena);
+			SlabArenaHeader_t* slabHeader = (SlabArenaHeader_t*)arena->headerPntr;
+			//NOTE: Allocations that were passed through to the sourceArena are not freed here
+			for (u64 pIndex = 0; pIndex < arena->numPages; pIndex++)
+			{
+				FreeMem(arena->sourceArena, slabHeader->pages[pIndex], slabHeader->pages[pIndex]->pageSize);
+			}
+			if (slabHeader->pages != nullptr) { FreeMem(arena->sourceArena, slabHeader->pages, sizeof(SlabPageHeader_t*) * slabHeader->pageListSize); }
+			FreeMem(arena->sourceArena, slabHeader, sizeof(SlabArenaHeader_t));
+		} break;
+		
+		// +==========================================+
+		// |  MemArenaType_ThreadCached FreeMemArena  |
+		// +==========================================+
+		case MemArenaType_ThreadCached:
+		{
+			NotNull2(arena->headerPntr, arena->sourceArena);
+			ThreadCacheArenaHeader_t* cacheHeader = (ThreadCacheArenaHeader_t*)arena->headerPntr;
+			//NOTE: Other threads must be done using this arena. Their thread local entries are left behind but once the arenaId
+			//      is unregistered they never match anything and GetThreadCache will reuse them.
+			//      Allocations that are still out (including passthrough ones) are not freed here
+			UnregisterThreadCacheArenaId(cacheHeader->arenaId);
+			ThreadCache_t* cache = cacheHeader->firstCache;
+			while (cache != nullptr)
+			{
+				ThreadCache_t* nextCache = cache->next;
+				DrainThreadCacheRemoteFrees(cache);
+				for (u64 cIndex = 0; cIndex < SLAB_NUM_SIZE_CLASSES; cIndex++) { FlushThreadCacheClass(arena, cache, cIndex, 0); }
+				FreeMem(arena->sourceArena, cache, sizeof(ThreadCache_t));
+				cache = nextCache;
+			}
+			for (u64 eIndex = 0; eIndex < THREAD_CACHE_MAX_ARENAS_PER_THREAD; eIndex++)
+			{
+				if (ThreadCacheTlsEntries[eIndex].arena == arena) { ClearStruct(ThreadCacheTlsEntries[eIndex]); }
+			}
+			if (IsValidGyMutex(&cacheHeader->sourceMutex)) { FreeGyMutex(&cacheHeader->sourceMutex); }
+			FreeMem(arena->sourceArena, cacheHeader, sizeof(ThreadCacheArenaHeader_t));
+		} break;
+		
 		default: AssertMsg(false, "Tried to FreeMemArena on arena that doesn't know where it got it's memory from"); break;
 	}
 	
@@ -3966,6 +5902,9 @@ void ClearMemArena(MemArena_t* arena)
 	
 	bool didLock = false;
 	if (IsValidGyMutex(&arena->mutex)) { LockGyMutex(&arena->mutex); didLock = true; }
+	#if GYLIB_MEM_ARENA_DEBUG_ENABLED
+	if (arena->debugArena != nullptr) { FreeAllocInfoTable(arena); }
+	#endif
 	
 	switch (arena->type)
 	{
@@ -3982,6 +5921,8 @@ void ClearMemArena(MemArena_t* arena)
 		// +======================================+
 		case MemArenaType_PagedHeap:
 		{
+			HeapFreeIndex_t* freeIndex = (HeapFreeIndex_t*)arena->otherPntr;
+			if (freeIndex != nullptr) { ClearPointer(freeIndex); }
 			HeapPageHeader_t* pageHeader = (HeapPageHeader_t*)arena->headerPntr;
 			u64 pageIndex = 0;
 			while (pageHeader != nullptr)
@@ -3989,23 +5930,14 @@ void ClearMemArena(MemArena_t* arena)
 				HeapPageHeader_t* nextPageHeader = pageHeader->next;
 				if (IsFlagSet(arena->flags, MemArenaFlag_AutoFreePages))
 				{
-					if (arena->sourceArena != nullptr)
-					{
-						FreeMem(arena->sourceArena, pageHeader, sizeof(HeapPageHeader_t) + pageHeader->size);
-					}
-					else if (arena->freeFunc != nullptr)
-					{
-						arena->freeFunc(pageHeader);
-					}
-					else
-					{
-						AssertMsg(false, "This PageHeap cannot be freed because it doesn't have a sourceArena of freeFunc pointer!");
-					}
+					ReleaseHeapPage(arena, pageHeader);
 				}
 				else
 				{
+					NotNull(freeIndex);
 					HeapAllocPrefix_t* allocPntr = (HeapAllocPrefix_t*)(pageHeader + 1);
-					allocPntr->size = PackAllocPrefixSize(false, pageHeader->size);
+					allocPntr->size = PackAllocPrefixSize(false, pageHeader->size) | HEAP_ALLOC_FIRST_FLAG;
+					InsertHeapFreeSection(freeIndex, allocPntr); //also sets HEAP_ALLOC_PREV_FREE_FLAG on the sentinel
 				}
 				pageHeader = nextPageHeader;
 				pageIndex++;
@@ -4017,6 +5949,7 @@ void ClearMemArena(MemArena_t* arena)
 			{
 				arena->numPages = 0;
 				arena->size = 0;
+				arena->used = 0;
 				arena->headerPntr = nullptr;
 			}
 		} break;
@@ -4056,12 +5989,366 @@ void ClearMemArena(MemArena_t* arena)
 			arena->used = 0;
 		} break;
 		
+		// +==================================+
+		// | MemArenaType_Slab ClearMemArena  |
+		// +==================================+
+		case MemArenaType_Slab:
+		{
+			NotNull2(arena->headerPntr, arena->sourceArena);
+			SlabArenaHeader_t* slabHeader = (SlabArenaHeader_t*)arena->headerPntr;
+			//NOTE: Allocations that were passed through to the sourceArena are not freed here
+			for (u64 cIndex = 0; cIndex < SLAB_NUM_SIZE_CLASSES; cIndex++)
+			{
+				slabHeader->freeLists[cIndex] = nullptr;
+				slabHeader->carvePntrs[cIndex] = nullptr;
+				slabHeader->carveEnds[cIndex] = nullptr;
+			}
+			if (IsFlagSet(arena->flags, MemArenaFlag_AutoFreePages))
+			{
+				for (u64 pIndex = 0; pIndex < arena->numPages; pIndex++)
+				{
+					FreeMem(arena->sourceArena, slabHeader->pages[pIndex], slabHeader->pages[pIndex]->pageSize);
+				}
+				arena->numPages = 0;
+				arena->size = 0;
+			}
+			else
+			{
+				//Keep the pages around and put every slot back in it's size class free list
+				for (u64 pIndex = 0; pIndex < arena->numPages; pIndex++)
+				{
+					SlabPageHeader_t* pageHeader = slabHeader->pages[pIndex];
+					for (u64 sIndex = pageHeader->numSlots; sIndex > 0; sIndex--)
+					{
+						void* slotPntr = pageHeader->slotsBase + ((sIndex-1) * pageHeader->slotSize);
+						*((void**)slotPntr) = slabHeader->freeLists[pageHeader->sizeClass];
+						slabHeader->freeLists[pageHeader->sizeClass] = slotPntr;
+					}
+				}
+			}
+			arena->used = 0;
+			arena->numAllocations = 0;
+		} break;
+		
+		// +===========================================+
+		// |  MemArenaType_ThreadCached ClearMemArena  |
+		// +===========================================+
+		case MemArenaType_ThreadCached:
+		{
+			//NOTE: We don't know which allocations are still out (they're spread across every thread) so there's no way to take them back
+			AssertMsg(false, "ThreadCached arenas don't support ClearMemArena. Free the allocations individually or FreeMemArena instead");
+		} break;
+		
+		// +========================================+
+		// | MemArenaType_MappedFile ClearMemArena  |
+		// +========================================+
+		case MemArenaType_MappedFile:
+		{
+			NotNull(arena->headerPntr);
+			MarkedStackArenaHeader_t* stackHeader = (MarkedStackArenaHeader_t*)arena->headerPntr;
+			stackHeader->numMarks = 0;
+			arena->used = 0;
+			arena->numAllocations = 0;
+		} break;
+		
+		// +==================================+
+		// | MemArenaType_Ring ClearMemArena  |
+		// +==================================+
+		case MemArenaType_Ring:
+		{
+			NotNull2(arena->headerPntr, arena->otherPntr);
+			RingArenaHeader_t* ringHeader = (RingArenaHeader_t*)arena->headerPntr;
+			ringHeader->headPos = 0;
+			ringHeader->tailPos = 0;
+			ringHeader->oldestFrameId = 0;
+			ringHeader->currentFrameId = 0;
+			MyMemSet(arena->otherPntr, 0x00, ringHeader->maxNumFrames * sizeof(RingArenaFrame_t));
+			arena->used = 0;
+			arena->numAllocations = 0;
+		} break;
+		
 		default: AssertMsg(false, "Tried to ClearMemArena on arena that doesn't know how to clear itself"); break;
 	}
 	
 	if (didLock) { UnlockGyMutex(&arena->mutex); }
 }
 
+// +--------------------------------------------------------------+
+// |                    Thread Cache Functions                    |
+// +--------------------------------------------------------------+
+//Gives all the blocks in the calling thread's cache back to the sourceArena and folds it's stats into the arena
+void FlushThreadCache(MemArena_t* arena)
+{
+	NotNull(arena);
+	Assert(arena->type == MemArenaType_ThreadCached);
+	ThreadCache_t* cache = FindThreadCache(arena);
+	if (cache == nullptr) { return; }
+	DrainThreadCacheRemoteFrees(cache);
+	LockThreadCacheSource(arena, cache);
+	for (u64 cIndex = 0; cIndex < SLAB_NUM_SIZE_CLASSES; cIndex++) { FlushThreadCacheClass(arena, cache, cIndex, 0); }
+	UnlockThreadCacheSource(arena);
+}
+
+//Call this on each thread that used a ThreadCached arena before the thread exits (or when it's done with the arena).
+//The cache stays in the arena's list and gets adopted by the next thread that needs one
+void ReleaseThreadCache(MemArena_t* arena)
+{
+	NotNull(arena);
+	Assert(arena->type == MemArenaType_ThreadCached);
+	ThreadCache_t* cache = FindThreadCache(arena);
+	if (cache == nullptr) { return; }
+	FlushThreadCache(arena);
+	for (u64 eIndex = 0; eIndex < THREAD_CACHE_MAX_ARENAS_PER_THREAD; eIndex++)
+	{
+		if (ThreadCacheTlsEntries[eIndex].cache == cache) { ClearStruct(ThreadCacheTlsEntries[eIndex]); }
+	}
+	ThreadSafeStoreReleaseU32(&cache->isClaimed, 0);
+}
+
+// +--------------------------------------------------------------+
+// |                        Ring Functions                        |
+// +--------------------------------------------------------------+
+u64 GetCurrentRingFrame(const MemArena_t* arena)
+{
+	NotNull2(arena, arena->headerPntr);
+	Assert(arena->type == MemArenaType_Ring);
+	const RingArenaHeader_t* ringHeader = (const RingArenaHeader_t*)arena->headerPntr;
+	return ringHeader->currentFrameId;
+}
+
+//Closes the current frame and starts a new one at the head. Returns the id of the new frame.
+//Keep the id of the frame you just closed around (usually alongside a GPU fence) and hand it to RetireRingFrame once it's safe to reuse
+u64 AdvanceRingFrame(MemArena_t* arena)
+{
+	NotNull2(arena, arena->headerPntr);
+	Assert(arena->type == MemArenaType_Ring);
+	
+	bool didLock = false;
+	if (IsValidGyMutex(&arena->mutex)) { LockGyMutex(&arena->mutex); didLock = true; }
+	
+	RingArenaHeader_t* ringHeader = (RingArenaHeader_t*)arena->headerPntr;
+	RingArenaFrame_t* frames = (RingArenaFrame_t*)arena->otherPntr;
+	u64 numLiveFrames = (ringHeader->currentFrameId - ringHeader->oldestFrameId) + 1;
+	if (numLiveFrames >= ringHeader->maxNumFrames)
+	{
+		GyLibPrintLine_E("Tried to advance to frame %llu in Ring arena which only has support for %llu live frames", numLiveFrames+1, ringHeader->maxNumFrames);
+		AssertMsg(false, "Too many live frames in a Ring arena. Retire some frames before advancing");
+		if (didLock) { UnlockGyMutex(&arena->mutex); }
+		return ringHeader->currentFrameId;
+	}
+	
+	ringHeader->currentFrameId++;
+	RingArenaFrame_t* newFrame = &frames[ringHeader->currentFrameId % ringHeader->maxNumFrames];
+	newFrame->startPos = ringHeader->headPos;
+	newFrame->numAllocations = 0;
+	if (IsFlagSet(arena->flags, MemArenaFlag_TelemetryEnabled))
+	{
+		if (ringHeader->highFrameCount < numLiveFrames+1) { ringHeader->highFrameCount = numLiveFrames+1; }
+	}
+	
+	u64 result = ringHeader->currentFrameId;
+	if (didLock) { UnlockGyMutex(&arena->mutex); }
+	return result;
+}
+
+//Releases the space used by frameId and every frame before it. The current frame can't be retired, call AdvanceRingFrame first
+void RetireRingFrame(MemArena_t* arena, u64 frameId)
+{
+	NotNull2(arena, arena->headerPntr);
+	Assert(arena->type == MemArenaType_Ring);
+	
+	bool didLock = false;
+	if (IsValidGyMutex(&arena->mutex)) { LockGyMutex(&arena->mutex); didLock = true; }
+	
+	RingArenaHeader_t* ringHeader = (RingArenaHeader_t*)arena->headerPntr;
+	RingArenaFrame_t* frames = (RingArenaFrame_t*)arena->otherPntr;
+	AssertMsg(frameId < ringHeader->currentFrameId, "Tried to retire the current frame (or one that hasn't started yet) in a Ring arena");
+	if (frameId >= ringHeader->oldestFrameId && frameId < ringHeader->currentFrameId)
+	{
+		for (u64 retireId = ringHeader->oldestFrameId; retireId <= frameId; retireId++)
+		{
+			RingArenaFrame_t* frame = &frames[retireId % ringHeader->maxNumFrames];
+			DecrementBy(arena->numAllocations, frame->numAllocations);
+			frame->numAllocations = 0;
+		}
+		ringHeader->oldestFrameId = frameId + 1;
+		ringHeader->tailPos = frames[ringHeader->oldestFrameId % ringHeader->maxNumFrames].startPos;
+		arena->used = ringHeader->headPos - ringHeader->tailPos;
+	}
+	
+	if (didLock) { UnlockGyMutex(&arena->mutex); }
+}
+
+// +--------------------------------------------------------------+
+// |                    Mapped File Functions                     |
+// +--------------------------------------------------------------+
+//Records used, numAllocations and our current base address in the file header and flushes everything up to used to the file.
+//Reopening the file picks up from the last sync
+bool SyncMappedFileArena(MemArena_t* arena, bool waitForWrite = true)
+{
+	NotNull2(arena, arena->headerPntr);
+	Assert(arena->type == MemArenaType_MappedFile);
+	
+	bool didLock = false;
+	if (IsValidGyMutex(&arena->mutex)) { LockGyMutex(&arena->mutex); didLock = true; }
+	
+	MappedFileArenaHeader_t* fileHeader = (MappedFileArenaHeader_t*)arena->headerPntr;
+	fileHeader->used = arena->used;
+	fileHeader->numAllocations = arena->numAllocations;
+	fileHeader->baseAddress = (u64)arena->headerPntr;
+	bool result = OsSyncMappedFile(arena->headerPntr, fileHeader->headerAndMarksSize + arena->used, waitForWrite);
+	
+	if (didLock) { UnlockGyMutex(&arena->mutex); }
+	return result;
+}
+
+//Offsets are relative to the start of the file so 0 (the header) is never a valid allocation and we use it for nullptr
+u64 GetMappedFileOffset(const MemArena_t* arena, const void* pntr)
+{
+	NotNull2(arena, arena->headerPntr);
+	Assert(arena->type == MemArenaType_MappedFile);
+	if (pntr == nullptr) { return 0; }
+	AssertMsg(IsPntrInsideRange(pntr, arena->headerPntr, arena->maxSize, true), "Tried to get the offset of a pointer that isn't inside this MappedFile arena");
+	return (u64)((const u8*)pntr - (const u8*)arena->headerPntr);
+}
+void* GetMappedFilePntr(const MemArena_t* arena, u64 offset)
+{
+	NotNull2(arena, arena->headerPntr);
+	Assert(arena->type == MemArenaType_MappedFile);
+	if (offset == 0) { return nullptr; }
+	Assert(offset <= arena->maxSize);
+	return ((u8*)arena->headerPntr) + offset;
+}
+
+void SetMappedFileRoot(MemArena_t* arena, const void* rootPntr)
+{
+	NotNull2(arena, arena->headerPntr);
+	MappedFileArenaHeader_t* fileHeader = (MappedFileArenaHeader_t*)arena->headerPntr;
+	fileHeader->rootOffset = GetMappedFileOffset(arena, rootPntr);
+}
+void* GetMappedFileRoot(const MemArena_t* arena)
+{
+	NotNull2(arena, arena->headerPntr);
+	const MappedFileArenaHeader_t* fileHeader = (const MappedFileArenaHeader_t*)arena->headerPntr;
+	return GetMappedFilePntr(arena, fileHeader->rootOffset);
+}
+
+//Returns true if the file was mapped at a different address than when it was last synced, meaning raw pointers stored inside it are invalid.
+//SyncMappedFileArena records the new base address so fix up any raw pointers before syncing
+bool DidMappedFileRelocate(const MemArena_t* arena)
+{
+	NotNull2(arena, arena->headerPntr);
+	Assert(arena->type == MemArenaType_MappedFile);
+	const MappedFileArenaHeader_t* fileHeader = (const MappedFileArenaHeader_t*)arena->headerPntr;
+	return (fileHeader->baseAddress != (u64)arena->headerPntr);
+}
+
+// +--------------------------------------------------------------+
+// |                     Histogram Functions                      |
+// +--------------------------------------------------------------+
+//The arena only holds a pntr to histograms so it needs to outlive the arena (or until this is called again with nullptr to disable them)
+//NOTE: ThreadCached arenas don't have a mutex so their histograms are only reliable if a single thread is using the arena
+void EnableMemArenaHistograms(MemArena_t* arena, MemArenaHistograms_t* histograms)
+{
+	NotNull(arena);
+	bool didLock = false;
+	if (IsValidGyMutex(&arena->mutex)) { LockGyMutex(&arena->mutex); didLock = true; }
+	
+	arena->histograms = histograms;
+	if (histograms != nullptr)
+	{
+		ClearPointer(histograms);
+		FlagSet(arena->flags, MemArenaFlag_Histograms);
+	}
+	else { FlagUnset(arena->flags, MemArenaFlag_Histograms); }
+	
+	if (didLock) { UnlockGyMutex(&arena->mutex); }
+}
+
+void ResetMemArenaHistograms(MemArena_t* arena)
+{
+	NotNull2(arena, arena->histograms);
+	bool didLock = false;
+	if (IsValidGyMutex(&arena->mutex)) { LockGyMutex(&arena->mutex); didLock = true; }
+	ClearPointer(arena->histograms);
+	if (didLock) { UnlockGyMutex(&arena->mutex); }
+}
+
+void TakeMemArenaHistogramsSnapshot(MemArena_t* arena, MemArenaHistograms_t* snapshotOut)
+{
+	NotNull3(arena, arena->histograms, snapshotOut);
+	bool didLock = false;
+	if (IsValidGyMutex(&arena->mutex)) { LockGyMutex(&arena->mutex); didLock = true; }
+	MyMemCopy(snapshotOut, arena->histograms, sizeof(MemArenaHistograms_t));
+	if (didLock) { UnlockGyMutex(&arena->mutex); }
+}
+
+//Fills diffOut with everything that was recorded between the two snapshots. The min and max of the
+//window aren't known exactly so they come from the range of the first and last non-empty buckets
+void DiffMemArenaHistogram(const MemArenaHistogram_t* before, const MemArenaHistogram_t* after, MemArenaHistogram_t* diffOut)
+{
+	NotNull3(before, after, diffOut);
+	AssertMsg(after->count >= before->count, "The before and after snapshots passed to DiffMemArenaHistogram are in the wrong order (or the histograms were reset between them)");
+	diffOut->count = after->count - before->count;
+	diffOut->total = after->total - before->total;
+	diffOut->minValue = 0;
+	diffOut->maxValue = 0;
+	bool foundFirst = false;
+	for (u64 bIndex = 0; bIndex < MEM_ARENA_HISTOGRAM_NUM_BUCKETS; bIndex++)
+	{
+		diffOut->buckets[bIndex] = after->buckets[bIndex] - before->buckets[bIndex];
+		if (diffOut->buckets[bIndex] > 0)
+		{
+			if (!foundFirst) { diffOut->minValue = MaxU64(GetMemArenaHistogramBucketMin(bIndex), after->minValue); foundFirst = true; }
+			diffOut->maxValue = MinU64(GetMemArenaHistogramBucketMax(bIndex), after->maxValue);
+		}
+	}
+}
+void DiffMemArenaHistograms(const MemArenaHistograms_t* before, const MemArenaHistograms_t* after, MemArenaHistograms_t* diffOut)
+{
+	NotNull3(before, after, diffOut);
+	DiffMemArenaHistogram(&before->allocSizes, &after->allocSizes, &diffOut->allocSizes);
+	for (u64 opIndex = 0; opIndex < MemArenaOp_NumOps; opIndex++)
+	{
+		DiffMemArenaHistogram(&before->latencies[opIndex], &after->latencies[opIndex], &diffOut->latencies[opIndex]);
+	}
+}
+
+//percentile is 0.0 - 1.0. The result is the largest value that could be in the bucket the percentile lands in (so the real percentile is at most 25% smaller)
+u64 GetMemArenaHistogramPercentile(const MemArenaHistogram_t* histogram, r64 percentile)
+{
+	NotNull(histogram);
+	if (histogram->count == 0) { return 0; }
+	u64 targetCount = (u64)(percentile * (r64)histogram->count);
+	if (targetCount >= histogram->count) { targetCount = histogram->count-1; }
+	u64 countSoFar = 0;
+	for (u64 bIndex = 0; bIndex < MEM_ARENA_HISTOGRAM_NUM_BUCKETS; bIndex++)
+	{
+		countSoFar += histogram->buckets[bIndex];
+		if (countSoFar > targetCount)
+		{
+			return MaxU64(MinU64(GetMemArenaHistogramBucketMax(bIndex), histogram->maxValue), histogram->minValue);
+		}
+	}
+	return histogram->maxValue;
+}
+
+r64 GetMemArenaHistogramAverage(const MemArenaHistogram_t* histogram)
+{
+	NotNull(histogram);
+	if (histogram->count == 0) { return 0.0; }
+	return (r64)histogram->total / (r64)histogram->count;
+}
+
+//percentile is 0.0 - 1.0, result is in nanoseconds
+r64 GetMemArenaLatencyPercentile(const MemArenaHistograms_t* histograms, MemArenaOp_t arenaOp, r64 percentile)
+{
+	NotNull(histograms);
+	Assert(arenaOp < MemArenaOp_NumOps);
+	u64 perfCount = GetMemArenaHistogramPercentile(&histograms->latencies[arenaOp], percentile);
+	return (r64)perfCount * GetPerfTimeSecondsPerCount() * 1000000000.0;
+}
+
 // +--------------------------------------------------------------+
 // |                 Push And Pop Mark Functions                  |
 // +--------------------------------------------------------------+
@@ -4079,6 +6366,7 @@ u64 PushMemMark(MemArena_t* arena)
 		// | MemArenaType_MarkedStack PushMemMark |
 		// +======================================+
 		case MemArenaType_MarkedStack:
+		case MemArenaType_MappedFile:
 		{
 			NotNull(arena->headerPntr);
 			NotNull(arena->otherPntr);
@@ -4186,6 +6474,7 @@ void PopMemMark(MemArena_t* arena, u64 mark = 0xFFFFFFFFFFFFFFFFULL)
 		// | MemArenaType_MarkedStack PopMemMark  |
 		// +======================================+
 		case MemArenaType_MarkedStack:
+		case MemArenaType_MappedFile:
 		{
 			NotNull(arena->headerPntr);
 			NotNull(arena->otherPntr);
@@ -4369,32 +6658,145 @@ MemArenaType_MarkedStack
 MemArenaType_PagedStack
 MemArenaType_VirtualStack
 MemArenaType_Buffer
+MemArenaType_Slab
+MemArenaType_ThreadCached
+MemArenaType_Ring
+MemArenaType_MappedFile
+MemArenaOp_Alloc
+MemArenaOp_Free
+MemArenaOp_Realloc
+MemArenaOp_Grow
+MemArenaOp_NumOps
+MEM_ARENA_HISTOGRAM_SUB_BITS
+MEM_ARENA_HISTOGRAM_NUM_BUCKETS
+MAPPED_FILE_ARENA_MAGIC
+MAPPED_FILE_ARENA_VERSION
+SLAB_MIN_SLOT_SIZE_POWER
+SLAB_MAX_SLOT_SIZE_POWER
+SLAB_NUM_SIZE_CLASSES
+SLAB_MIN_SLOT_SIZE
+SLAB_MAX_SLOT_SIZE
+SLAB_PAGE_LIST_MIN_SIZE
+THREAD_CACHE_DEFAULT_MAGAZINE_SIZE
+THREAD_CACHE_MAX_ARENAS_PER_THREAD
+THREAD_CACHE_MAX_LIVE_ARENAS
+STD_HEAP_REMAP_SUPPORTED
+STD_HEAP_REMAP_THRESHOLD
+STD_HEAP_MAX_MAPPED_ALLOCS
+HEAP_ALLOC_PREV_FREE_FLAG
+HEAP_ALLOC_FIRST_FLAG
+HEAP_SECTION_GRANULARITY
+HEAP_MIN_SECTION_SIZE
+HEAP_FREE_INDEX_SL_LOG2
+HEAP_FREE_INDEX_SL_COUNT
+HEAP_FREE_INDEX_FL_SHIFT
+HEAP_FREE_INDEX_FL_MAX
+HEAP_FREE_INDEX_FL_COUNT
+MEM_ARENA_FAST_PATH_BLOCKING_FLAGS
 AllocAlignment_None
 AllocAlignment_4Bytes
 AllocAlignment_8Bytes
 AllocAlignment_16Bytes
 AllocAlignment_64Bytes
 AllocAlignment_Max
+AllocAlignment_4Kilobytes
+AllocAlignment_2Megabytes
 @Types
 MemArenaType_t
 AllocAlignment_t
+MemArenaOp_t
+MemArenaHistogram_t
+MemArenaHistograms_t
+StdHeapMappedPrefix_t
 HeapAllocPrefix_t
 HeapPageHeader_t
+HeapFreeSection_t
+HeapFreeIndex_t
 MarkedStackArenaHeader_t
+RingArenaFrame_t
+RingArenaHeader_t
+MappedFileArenaHeader_t
+SlabPageHeader_t
+SlabArenaHeader_t
+SlabPassthroughPrefix_t
+ThreadCache_t
+ThreadCacheBlockPrefix_t
+ThreadCacheArenaHeader_t
+ThreadCacheTlsEntry_t
 MemArena_t
 AllocationFunction_f
 ReallocFunction_f
 FreeFunction_f
 @Functions
 const char* GetMemArenaTypeStr(MemArenaType_t arenaType)
+const char* GetMemArenaOpStr(MemArenaOp_t arenaOp)
 #define PackAllocPrefixSize(used, size)
 #define IsAllocPrefixFilled(packedSize)
 #define UnpackAllocPrefixSize(packedSize)
 bool IsAlignedTo(const void* memoryPntr, AllocAlignment_t alignment)
-u8 OffsetToAlign(const void* memoryPntr, AllocAlignment_t alignment)
+u64 OffsetToAlign(const void* memoryPntr, AllocAlignment_t alignment)
 bool IsPntrInsideRange(const void* testPntr, const void* rangeBase, u64 rangeSize, bool inclusive = false)
+u64 GetMemArenaHistogramBucket(u64 value)
+u64 GetMemArenaHistogramBucketMin(u64 bucketIndex)
+u64 GetMemArenaHistogramBucketMax(u64 bucketIndex)
+void AddToMemArenaHistogram(MemArenaHistogram_t* histogram, u64 value)
+void RecordMemArenaHistograms(MemArena_t* arena, MemArenaOp_t arenaOp, const PerfTime_t* startTime, u64 allocSize)
+u64 GetSlabSizeClass(u64 numBytes, AllocAlignment_t alignment)
+u64 GetSlabPassthroughRawOffset(AllocAlignment_t alignment)
+u64 FindSlabPageUpperBound(const MemArena_t* arena, const void* pntr)
+SlabPageHeader_t* FindSlabPageFor(const MemArena_t* arena, const void* allocPntr)
+SlabPageHeader_t* AllocSlabPage(MemArena_t* arena, u64 sizeClass)
+StdHeapMappedPrefix_t* GetStdHeapMappedPrefix(const void* allocPntr)
+u8* AllocStdHeapMapped(u64 numBytes)
+void FreeStdHeapMapped(StdHeapMappedPrefix_t* prefix)
+u8* ResizeStdHeapMapped(StdHeapMappedPrefix_t* prefix, u64 newSize, bool allowMove)
+u64 GetHeapSectionSizeFor(u64 numBytes, u64 alignOffset)
+HeapAllocPrefix_t* GetHeapAllocPrefix(const void* allocPntr)
+HeapPageHeader_t* FindHeapPageFor(const MemArena_t* arena, const void* pntr)
+void GetHeapFreeIndexMapping(u64 sectionSize, u64* firstLevelOut, u64* secondLevelOut)
+void InsertHeapFreeSection(HeapFreeIndex_t* freeIndex, HeapAllocPrefix_t* prefixPntr)
+void UnlinkHeapFreeSection(HeapFreeIndex_t* freeIndex, const void* sectionPntr, u64 sectionSize, HeapFreeSection_t* nextFree, HeapFreeSection_t* prevFree)
+void RemoveHeapFreeSection(HeapFreeIndex_t* freeIndex, HeapAllocPrefix_t* prefixPntr)
+HeapAllocPrefix_t* TakeHeapFreeSection(HeapFreeIndex_t* freeIndex, u64 minSectionSize)
+HeapAllocPrefix_t* FreeHeapSection(MemArena_t* arena, HeapAllocPrefix_t* prefixPntr)
+HeapFreeIndex_t* GetHeapFreeIndex(MemArena_t* arena)
+HeapAllocPrefix_t* AllocHeapPage(MemArena_t* arena, u64 minSectionSize)
+void ReleaseHeapPage(MemArena_t* arena, HeapPageHeader_t* pageHeader)
+u64 GetThreadCacheRawOffset(AllocAlignment_t alignment)
+void RegisterThreadCacheArenaId(u64 arenaId)
+void UnregisterThreadCacheArenaId(u64 arenaId)
+bool IsThreadCacheArenaIdLive(u64 arenaId)
+void LockThreadCacheSource(MemArena_t* arena, ThreadCache_t* cache)
+void UnlockThreadCacheSource(MemArena_t* arena)
+ThreadCache_t* FindThreadCache(const MemArena_t* arena)
+ThreadCache_t* GetThreadCache(MemArena_t* arena)
+void DrainThreadCacheRemoteFrees(ThreadCache_t* cache)
+void PushThreadCacheRemoteFree(ThreadCache_t* owner, void* blockPntr)
+bool RefillThreadCache(MemArena_t* arena, ThreadCache_t* cache, u64 sizeClass)
+void FlushThreadCacheClass(MemArena_t* arena, ThreadCache_t* cache, u64 sizeClass, u64 numToKeep)
+u64 GetRingAllocPos(const MemArena_t* arena, const void* allocPntr)
+RingArenaFrame_t* FindRingFrameFor(const MemArena_t* arena, u64 allocPos)
 void FreeMemArena(MemArena_t* arena)
 void ClearMemArena(MemArena_t* arena)
+void FlushThreadCache(MemArena_t* arena)
+void ReleaseThreadCache(MemArena_t* arena)
+u64 GetCurrentRingFrame(const MemArena_t* arena)
+u64 AdvanceRingFrame(MemArena_t* arena)
+void RetireRingFrame(MemArena_t* arena, u64 frameId)
+bool SyncMappedFileArena(MemArena_t* arena, bool waitForWrite = true)
+u64 GetMappedFileOffset(const MemArena_t* arena, const void* pntr)
+void* GetMappedFilePntr(const MemArena_t* arena, u64 offset)
+void SetMappedFileRoot(MemArena_t* arena, const void* rootPntr)
+void* GetMappedFileRoot(const MemArena_t* arena)
+bool DidMappedFileRelocate(const MemArena_t* arena)
+void EnableMemArenaHistograms(MemArena_t* arena, MemArenaHistograms_t* histograms)
+void ResetMemArenaHistograms(MemArena_t* arena)
+void TakeMemArenaHistogramsSnapshot(MemArena_t* arena, MemArenaHistograms_t* snapshotOut)
+void DiffMemArenaHistogram(const MemArenaHistogram_t* before, const MemArenaHistogram_t* after, MemArenaHistogram_t* diffOut)
+void DiffMemArenaHistograms(const MemArenaHistograms_t* before, const MemArenaHistograms_t* after, MemArenaHistograms_t* diffOut)
+u64 GetMemArenaHistogramPercentile(const MemArenaHistogram_t* histogram, r64 percentile)
+r64 GetMemArenaHistogramAverage(const MemArenaHistogram_t* histogram)
+r64 GetMemArenaLatencyPercentile(const MemArenaHistograms_t* histograms, MemArenaOp_t arenaOp, r64 percentile)
 void InitMemArena_Redirect(MemArena_t* arena, AllocationFunction_f* allocFunc, FreeFunction_f* freeFunc, ReallocFunction_f* reallocFunc = nullptr)
 void InitMemArena_Alias(MemArena_t* arena, MemArena_t* sourceArena)
 void InitMemArena_StdHeap(MemArena_t* arena)
@@ -4403,6 +6805,10 @@ void InitMemArena_PagedHeapFuncs(MemArena_t* arena, u64 pageSize, AllocationFunc
 void InitMemArena_PagedHeapArena(MemArena_t* arena, u64 pageSize, MemArena_t* sourceArena, u64 maxNumPages = 0, AllocAlignment_t alignment = AllocAlignment_None)
 void InitMemArena_MarkedStack(MemArena_t* arena, u64 size, void* memoryPntr, u64 maxNumMarks, AllocAlignment_t alignment = AllocAlignment_None)
 void InitMemArena_Buffer(MemArena_t* arena, u64 bufferSize, void* bufferPntr, bool singleAlloc = false, AllocAlignment_t alignment = AllocAlignment_None)
+void InitMemArena_Slab(MemArena_t* arena, u64 pageSize, MemArena_t* sourceArena, u64 maxNumPages = 0, AllocAlignment_t alignment = AllocAlignment_None)
+void InitMemArena_ThreadCached(MemArena_t* arena, MemArena_t* sourceArena, u64 magazineSize = THREAD_CACHE_DEFAULT_MAGAZINE_SIZE, AllocAlignment_t alignment = AllocAlignment_None)
+void InitMemArena_Ring(MemArena_t* arena, u64 size, void* memoryPntr, u64 maxNumFrames, AllocAlignment_t alignment = AllocAlignment_None)
+bool InitMemArena_MappedFile(MemArena_t* arena, const char* filePath, u64 maxSize, u64 maxNumMarks, bool copyOnWrite = false, void* desiredBase = nullptr, AllocAlignment_t alignment = AllocAlignment_None)
 #define CreateStackBufferArena(arenaName, bufferName, size)
 bool IsInitialized(const MemArena_t* arena)
 bool DoesMemArenaSupportFreeing(MemArena_t* arena)
@@ -4416,6 +6822,9 @@ void* AllocMem(MemArena_t* arena, u64 numBytes, AllocAlignment_t alignOverride =
 #define AllocArray(arena, structName, numItems)
 #define AllocBytes(arena, numBytes)
 #define AllocChars(arena, numBytes)
+void* AllocMemFast(MemArena_t* arena, u64 numBytes, AllocAlignment_t alignOverride = AllocAlignment_None)
+#define AllocStructFast(arena, structName)
+#define AllocArrayFast(arena, structName, numItems)
 MemArena_t AllocBufferArena(MemArena_t* sourceArena, u64 numBytes, AllocAlignment_t alignOverride = AllocAlignment_None)
 char* AllocCharsAndFill(MemArena_t* arena, u64 numChars, const char* dataForFill, bool addNullTerm = true)
 char* AllocCharsAndFillNt(MemArena_t* arena, const char* nullTermStr, bool addNullTerm = true)
@@ -0,0 +1,307 @@
+/*
+File:   gy_memory_snapshot.h
+Author: Taylor Robbins
+Date:   10\16\2026
+Description:
+	** Holds MemArenaSnapshot_t which lets you checkpoint a VirtualStack arena and roll back to that checkpoint later.
+	** Taking a snapshot marks every committed page of the arena read-only. The first write to each page after that
+	** faults, and our fault handler copies the original page into a shadow reservation, records it as dirty, and makes
+	** the page writable again. Restoring only copies back the pages that were dirtied, so it's cheap to checkpoint
+	** every tick when a tick only touches a small part of the arena.
+	** NOTE: Writes to the arena made by the kernel (like read() straight into arena memory) don't fault like normal
+	** writes do, they fail with EFAULT on Linux. Don't hand snapshotted memory directly to syscalls
+	** NOTE: Debug alloc info (GYLIB_MEM_ARENA_DEBUG_ENABLED) lives outside the arena and is not rolled back
+*/
+
+#ifndef _GY_MEMORY_SNAPSHOT_H
+#define _GY_MEMORY_SNAPSHOT_H
+
+#if (WINDOWS_COMPILATION || LINUX_COMPILATION)
+#define MEM_ARENA_SNAPSHOTS_SUPPORTED 1
+#else
+#define MEM_ARENA_SNAPSHOTS_SUPPORTED 0
+#endif
+
+#define MEM_ARENA_MAX_NUM_SNAPSHOTS 16
+
+struct MemArenaSnapshot_t
+{
+	MemArena_t* arena;
+	u64 pageSize;
+	u8* basePntr; //the start of the arena's reservation (which is where the header and marks live)
+	u64 protectedSize; //how many bytes after basePntr were committed (and therefore protected) when the snapshot was taken
+	u64 numPages; //how many pages the arena's whole reservation covers
+	
+	u64 shadowSize;
+	u8* shadowPntr; //mirrors the arena's reservation, holds the original contents of each dirtied page
+	u32* pageClaims; //one per page, claimed by the first fault on that page (u32 rather than a bit so concurrent faults can't race)
+	u32* dirtyPageIndices;
+	volatile u64 numDirtyPages;
+	
+	u64 used;
+	u64 numAllocations;
+};
+
+struct MemArenaSnapshotGlobals_t
+{
+	bool handlerInstalled;
+	MemArenaSnapshot_t* volatile snapshots[MEM_ARENA_MAX_NUM_SNAPSHOTS];
+	#if WINDOWS_COMPILATION
+	PVOID handlerHandle;
+	#elif LINUX_COMPILATION
+	struct sigaction prevAction;
+	#endif
+};
+
+// +--------------------------------------------------------------+
+// |                         Header Only                          |
+// +--------------------------------------------------------------+
+#ifdef GYLIB_HEADER_ONLY
+	extern MemArenaSnapshotGlobals_t memArenaSnapshotGlobals;
+	#if MEM_ARENA_SNAPSHOTS_SUPPORTED
+	bool HandleMemArenaSnapshotFault(void* faultAddress);
+	void InstallMemArenaSnapshotHandler();
+	#endif
+	bool InitMemArenaSnapshot(MemArenaSnapshot_t* snapshot, MemArena_t* arena);
+	void FreeMemArenaSnapshot(MemArenaSnapshot_t* snapshot);
+	void TakeMemArenaSnapshot(MemArenaSnapshot_t* snapshot);
+	void RestoreMemArenaSnapshot(MemArenaSnapshot_t* snapshot);
+#else
+
+MemArenaSnapshotGlobals_t memArenaSnapshotGlobals = {};
+
+// +--------------------------------------------------------------+
+// |                        Fault Handling                        |
+// +--------------------------------------------------------------+
+#if MEM_ARENA_SNAPSHOTS_SUPPORTED
+//Called from the signal handler (or vectored exception handler) so this needs to stay away from locks and allocations.
+//Returns false if the address doesn't belong to any of our snapshots
+bool HandleMemArenaSnapshotFault(void* faultAddress)
+{
+	for (u64 sIndex = 0; sIndex < MEM_ARENA_MAX_NUM_SNAPSHOTS; sIndex++)
+	{
+		MemArenaSnapshot_t* snapshot = memArenaSnapshotGlobals.snapshots[sIndex];
+		if (snapshot == nullptr || !IsPntrInsideRange(faultAddress, snapshot->basePntr, snapshot->protectedSize)) { continue; }
+		
+		u64 pageIndex = (u64)((u8*)faultAddress - snapshot->basePntr) / snapshot->pageSize;
+		u8* pagePntr = snapshot->basePntr + (pageIndex * snapshot->pageSize);
+		// If another thread already claimed this page we just return and let the write fault again until that thread has made the page writable
+		if (ThreadSafeClaimByBool(&snapshot->pageClaims[pageIndex]))
+		{
+			u8* shadowPagePntr = snapshot->shadowPntr + (pageIndex * snapshot->pageSize);
+			OsCommitReservedMemory(shadowPagePntr, snapshot->pageSize);
+			MyMemCopy(shadowPagePntr, pagePntr, snapshot->pageSize);
+			u64 dirtyIndex = ThreadSafeIncrementU64(&snapshot->numDirtyPages) - 1;
+			snapshot->dirtyPageIndices[dirtyIndex] = (u32)pageIndex;
+			ThreadingWriteBarrier();
+			bool protectSuccess = OsProtectMemory(pagePntr, snapshot->pageSize, true);
+			Assert(protectSuccess);
+		}
+		return true;
+	}
+	return false;
+}
+
+#if WINDOWS_COMPILATION
+LONG WINAPI MemArenaSnapshotExceptionHandler(EXCEPTION_POINTERS* exceptionInfo)
+{
+	EXCEPTION_RECORD* record = exceptionInfo->ExceptionRecord;
+	if (record->ExceptionCode == EXCEPTION_ACCESS_VIOLATION && record->NumberParameters >= 2 && record->ExceptionInformation[0] == 1) //1 = write access
+	{
+		if (HandleMemArenaSnapshotFault((void*)record->ExceptionInformation[1])) { return EXCEPTION_CONTINUE_EXECUTION; }
+	}
+	return EXCEPTION_CONTINUE_SEARCH;
+}
+#elif LINUX_COMPILATION
+void MemArenaSnapshotSignalHandler(int signalNum, siginfo_t* signalInfo, void* context)
+{
+	if (signalInfo->si_code == SEGV_ACCERR && HandleMemArenaSnapshotFault(signalInfo->si_addr)) { return; }
+	
+	//Not one of our pages, pass it along to whatever handler was installed before us
+	struct sigaction* prevAction = &memArenaSnapshotGlobals.prevAction;
+	if (IsFlagSet(prevAction->sa_flags, SA_SIGINFO) && prevAction->sa_sigaction != nullptr) { prevAction->sa_sigaction(signalNum, signalInfo, context); }
+	else if (prevAction->sa_handler != SIG_DFL && prevAction->sa_handler != SIG_IGN) { prevAction->sa_handler(signalNum); }
+	else { sigaction(SIGSEGV, prevAction, nullptr); } //returning re-runs the faulting instruction which will now go to the default handler
+}
+#endif
+
+void InstallMemArenaSnapshotHandler()
+{
+	if (memArenaSnapshotGlobals.handlerInstalled) { return; }
+	#if WINDOWS_COMPILATION
+	memArenaSnapshotGlobals.handlerHandle = AddVectoredExceptionHandler(1, MemArenaSnapshotExceptionHandler);
+	NotNull(memArenaSnapshotGlobals.handlerHandle);
+	#elif LINUX_COMPILATION
+	struct sigaction newAction = {};
+	newAction.sa_sigaction = MemArenaSnapshotSignalHandler;
+	newAction.sa_flags = SA_SIGINFO;
+	sigemptyset(&newAction.sa_mask);
+	int actionResult = sigaction(SIGSEGV, &newAction, &memArenaSnapshotGlobals.prevAction);
+	Assert(actionResult == 0);
+	#endif
+	memArenaSnapshotGlobals.handlerInstalled = true;
+}
+#endif //MEM_ARENA_SNAPSHOTS_SUPPORTED
+
+// +--------------------------------------------------------------+
+// |                          Functions                           |
+// +--------------------------------------------------------------+
+//NOTE: The handler stays installed after the last snapshot is freed, it just won't find any snapshots to service
+void FreeMemArenaSnapshot(MemArenaSnapshot_t* snapshot)
+{
+	NotNull(snapshot);
+	#if MEM_ARENA_SNAPSHOTS_SUPPORTED
+	if (snapshot->arena != nullptr)
+	{
+		for (u64 sIndex = 0; sIndex < MEM_ARENA_MAX_NUM_SNAPSHOTS; sIndex++)
+		{
+			if (memArenaSnapshotGlobals.snapshots[sIndex] == snapshot) { memArenaSnapshotGlobals.snapshots[sIndex] = nullptr; }
+		}
+		bool protectSuccess = OsProtectMemory(snapshot->basePntr, snapshot->protectedSize, true);
+		Assert(protectSuccess);
+		FlagUnset(snapshot->arena->flags, MemArenaFlag_Snapshotted);
+		OsFreeReservedMemory(snapshot->shadowPntr, snapshot->shadowSize);
+	}
+	#endif
+	ClearPointer(snapshot);
+}
+
+//Makes the arena's current state the one that RestoreMemArenaSnapshot rolls back to.
+//Only the pages dirtied since the last take (and any newly committed pages) need to be re-protected
+void TakeMemArenaSnapshot(MemArenaSnapshot_t* snapshot)
+{
+	NotNull2(snapshot, snapshot->arena);
+	#if MEM_ARENA_SNAPSHOTS_SUPPORTED
+	MemArena_t* arena = snapshot->arena;
+	bool didLock = false;
+	if (IsValidGyMutex(&arena->mutex)) { LockGyMutex(&arena->mutex); didLock = true; }
+	
+	for (u64 dIndex = 0; dIndex < snapshot->numDirtyPages; dIndex++)
+	{
+		u64 pageIndex = snapshot->dirtyPageIndices[dIndex];
+		bool protectSuccess = OsProtectMemory(snapshot->basePntr + (pageIndex * snapshot->pageSize), snapshot->pageSize, false);
+		Assert(protectSuccess);
+		snapshot->pageClaims[pageIndex] = 0;
+	}
+	snapshot->numDirtyPages = 0;
+	
+	u64 newProtectedSize = (u64)(((u8*)arena->mainPntr + arena->size) - snapshot->basePntr);
+	Assert(newProtectedSize % snapshot->pageSize == 0);
+	if (newProtectedSize > snapshot->protectedSize)
+	{
+		bool protectSuccess = OsProtectMemory(snapshot->basePntr + snapshot->protectedSize, newProtectedSize - snapshot->protectedSize, false);
+		Assert(protectSuccess);
+		ThreadingWriteBarrier();
+		snapshot->protectedSize = newProtectedSize;
+	}
+	
+	snapshot->used = arena->used;
+	snapshot->numAllocations = arena->numAllocations;
+	
+	if (didLock) { UnlockGyMutex(&arena->mutex); }
+	#endif
+}
+
+//Copies every page that was dirtied since the snapshot was taken back into the arena. The snapshot stays active
+//so you can keep restoring to the same point (like when re-simulating several ticks in a rollback)
+//NOTE: No other thread may be writing to the arena while this runs
+void RestoreMemArenaSnapshot(MemArenaSnapshot_t* snapshot)
+{
+	NotNull2(snapshot, snapshot->arena);
+	#if MEM_ARENA_SNAPSHOTS_SUPPORTED
+	MemArena_t* arena = snapshot->arena;
+	bool didLock = false;
+	if (IsValidGyMutex(&arena->mutex)) { LockGyMutex(&arena->mutex); didLock = true; }
+	
+	for (u64 dIndex = 0; dIndex < snapshot->numDirtyPages; dIndex++)
+	{
+		u64 pageIndex = snapshot->dirtyPageIndices[dIndex];
+		u8* pagePntr = snapshot->basePntr + (pageIndex * snapshot->pageSize);
+		MyMemCopy(pagePntr, snapshot->shadowPntr + (pageIndex * snapshot->pageSize), snapshot->pageSize);
+		bool protectSuccess = OsProtectMemory(pagePntr, snapshot->pageSize, false);
+		Assert(protectSuccess);
+		snapshot->pageClaims[pageIndex] = 0;
+	}
+	snapshot->numDirtyPages = 0;
+	
+	//NOTE: The header and marks live in the protected pages so they've been rolled back above.
+	// Pages committed after the snapshot stay committed (and unprotected), they are past the restored used so their contents don't matter
+	arena->used = snapshot->used;
+	arena->numAllocations = snapshot->numAllocations;
+	
+	if (didLock) { UnlockGyMutex(&arena->mutex); }
+	#endif
+}
+
+//Returns false if the platform doesn't support snapshots or we are already tracking MEM_ARENA_MAX_NUM_SNAPSHOTS snapshots
+bool InitMemArenaSnapshot(MemArenaSnapshot_t* snapshot, MemArena_t* arena)
+{
+	NotNull2(snapshot, arena);
+	ClearPointer(snapshot);
+	#if MEM_ARENA_SNAPSHOTS_SUPPORTED
+	AssertMsg(arena->type == MemArenaType_VirtualStack, "Only VirtualStack arenas support snapshots");
+	AssertMsg(!IsFlagSet(arena->flags, MemArenaFlag_Snapshotted), "Tried to take a second snapshot of the same arena");
+	
+	u64 slotIndex = MEM_ARENA_MAX_NUM_SNAPSHOTS;
+	for (u64 sIndex = 0; sIndex < MEM_ARENA_MAX_NUM_SNAPSHOTS; sIndex++)
+	{
+		if (memArenaSnapshotGlobals.snapshots[sIndex] == nullptr) { slotIndex = sIndex; break; }
+	}
+	if (slotIndex >= MEM_ARENA_MAX_NUM_SNAPSHOTS)
+	{
+		GyLibPrintLine_E("Tried to make more than %u MemArena snapshots at once", MEM_ARENA_MAX_NUM_SNAPSHOTS);
+		return false;
+	}
+	
+	snapshot->arena = arena;
+	snapshot->pageSize = OsGetMemoryPageSize();
+	snapshot->basePntr = (u8*)arena->headerPntr;
+	snapshot->protectedSize = 0;
+	snapshot->numPages = arena->maxSize / snapshot->pageSize;
+	Assert(arena->maxSize % snapshot->pageSize == 0);
+	Assert(snapshot->numPages <= UINT32_MAX);
+	
+	u64 claimsSize = RoundUpToU64(snapshot->numPages * sizeof(u32), snapshot->pageSize);
+	u64 indicesSize = RoundUpToU64(snapshot->numPages * sizeof(u32), snapshot->pageSize);
+	snapshot->shadowSize = arena->maxSize + claimsSize + indicesSize;
+	snapshot->shadowPntr = (u8*)OsReserveMemory(snapshot->shadowSize);
+	NotNull(snapshot->shadowPntr);
+	//The shadow pages get committed by the fault handler as they are needed, but the page claims and dirty list need to be ready now
+	OsCommitReservedMemory(snapshot->shadowPntr + arena->maxSize, claimsSize + indicesSize);
+	snapshot->pageClaims = (u32*)(snapshot->shadowPntr + arena->maxSize);
+	snapshot->dirtyPageIndices = (u32*)(snapshot->shadowPntr + arena->maxSize + claimsSize);
+	
+	InstallMemArenaSnapshotHandler();
+	FlagSet(arena->flags, MemArenaFlag_Snapshotted);
+	memArenaSnapshotGlobals.snapshots[slotIndex] = snapshot;
+	TakeMemArenaSnapshot(snapshot);
+	return true;
+	#else
+	UNUSED(arena);
+	AssertMsg(false, "MemArena snapshots are not supported on this platform");
+	return false;
+	#endif
+}
+
+#endif //GYLIB_HEADER_ONLY
+
+#endif //  _GY_MEMORY_SNAPSHOT_H
+
+// +--------------------------------------------------------------+
+// |                   Autocomplete Dictionary                    |
+// +--------------------------------------------------------------+
+/*
+@Defines
+MEM_ARENA_SNAPSHOTS_SUPPORTED
+MEM_ARENA_MAX_NUM_SNAPSHOTS
+@Types
+MemArenaSnapshot_t
+MemArenaSnapshotGlobals_t
+@Functions
+bool HandleMemArenaSnapshotFault(void* faultAddress)
+void InstallMemArenaSnapshotHandler()
+void FreeMemArenaSnapshot(MemArenaSnapshot_t* snapshot)
+void TakeMemArenaSnapshot(MemArenaSnapshot_t* snapshot)
+void RestoreMemArenaSnapshot(MemArenaSnapshot_t* snapshot)
+bool InitMemArenaSnapshot(MemArenaSnapshot_t* snapshot, MemArena_t* arena)
+*/
@@ -36,6 +36,14 @@ Description:
 	void* OsReserveMemory(u64 numBytes);
 	void OsCommitReservedMemory(void* memoryPntr, u64 numBytes);
 	void OsFreeReservedMemory(void* memoryPntr, u64 reservedSize);
+	u64 OsGetHugePageSize();
+	void* OsReserveMemoryAligned(u64 numBytes, u64 alignment);
+	bool OsAdviseHugePages(void* memoryPntr, u64 numBytes);
+	bool OsProtectMemory(void* memoryPntr, u64 numBytes, bool allowWrite);
+	void* OsRemapMemory(void* memoryPntr, u64 oldSize, u64 newSize, bool allowMove);
+	void* OsMapFile(const char* filePath, u64 minFileSize, bool copyOnWrite, void* desiredBase, u64* fileSizeOut);
+	bool OsSyncMappedFile(void* memoryPntr, u64 numBytes, bool waitForWrite);
+	void OsUnmapFile(void* basePntr, u64 mappedSize);
 #else
 
 // +--------------------------------------------------------------+
@@ -54,7 +62,7 @@ MyStr_t OsGetExecutablePath(MemArena_t* memArena, OsError_t* errorOut)
 	#if WINDOWS_COMPILATION
 	{
 		MemArena_t* scratch = GetScratchArena(memArena);
-		char* tempBuffer = AllocArray(scratch, char, MAX_EXECUTABLE_PATH_LENGTH);
+		char* tempBuffer = AllocArrayFast(scratch, char, MAX_EXECUTABLE_PATH_LENGTH);
 		NotNull(tempBuffer);
 		DWORD pathLength = GetModuleFileNameA(
 			0,
@@ -342,8 +350,8 @@ void* OsReserveMemory(u64 numBytes)
 			-1, //fd,
 			0 //offset
 		);
+		if (result == MAP_FAILED) { return nullptr; } //match the Windows behavior, callers check for nullptr
 		AssertIf(result != nullptr, (u64)result % pageSize == 0);
-		Assert(result != MAP_FAILED);
 		return result;
 	}
 	// +==============================+
@@ -514,6 +522,359 @@ void OsFreeReservedMemory(void* memoryPntr, u64 reservedSize)
 	#endif
 }
 
+// +--------------------------------------------------------------+
+// |                      OsGetHugePageSize                       |
+// +--------------------------------------------------------------+
+//Returns 0 if we don't support huge pages on this platform
+u64 OsGetHugePageSize()
+{
+	// +==============================+
+	// |           Windows            |
+	// +==============================+
+	#if WINDOWS_COMPILATION
+	{
+		//TODO: Large pages on Windows need SeLockMemoryPrivilege and have to be committed all at once (MEM_LARGE_PAGES) so they don't fit reserve/commit style usage
+		return 0;
+	}
+	// +==============================+
+	// |            Linux             |
+	// +==============================+
+	#elif LINUX_COMPILATION
+	{
+		#ifdef MADV_HUGEPAGE
+		//TODO: Maybe we should read /sys/kernel/mm/transparent_hugepage/hpage_pmd_size? 2MB is the PMD size on x86_64 and most aarch64 configs
+		return Megabytes(2);
+		#else
+		return 0;
+		#endif
+	}
+	// +==============================+
+	// |   Playdate / Orca / WASM     |
+	// +==============================+
+	#elif PLAYDATE_COMPILATION || ORCA_COMPILATION || WASM_COMPILATION
+	{
+		return 0;
+	}
+	#else
+	#error OsGetHugePageSize does not support the current platform yet!
+	#endif
+}
+
+// +--------------------------------------------------------------+
+// |                    OsReserveMemoryAligned                    |
+// +--------------------------------------------------------------+
+//NOTE: numBytes must be a multiple of memory page size, alignment must be a power of two
+//      The result can be freed with OsFreeReservedMemory(result, numBytes) like any other reservation
+void* OsReserveMemoryAligned(u64 numBytes, u64 alignment)
+{
+	if (numBytes == 0) { return nullptr; }
+	u64 pageSize = OsGetMemoryPageSize();
+	Assert(numBytes % pageSize == 0);
+	Assert(alignment > 0 && (alignment & (alignment - 1)) == 0);
+	if (alignment <= pageSize) { return OsReserveMemory(numBytes); }
+	
+	// +==============================+
+	// |           Windows            |
+	// +==============================+
+	#if WINDOWS_COMPILATION
+	{
+		//VirtualFree can't release part of a reservation, so we reserve an oversized region to find an aligned address, release it, and reserve again at that address.
+		//Another thread can take the address in between so we try a few times
+		for (u64 attempt = 0; attempt < 8; attempt++)
+		{
+			u8* oversizedPntr = (u8*)VirtualAlloc(nullptr, numBytes + alignment, MEM_RESERVE, PAGE_READWRITE);
+			if (oversizedPntr == nullptr) { return nullptr; }
+			u8* alignedPntr = (u8*)RoundUpToU64((u64)oversizedPntr, alignment);
+			VirtualFree(oversizedPntr, 0, MEM_RELEASE);
+			void* result = VirtualAlloc(alignedPntr, numBytes, MEM_RESERVE, PAGE_READWRITE);
+			if (result != nullptr) { Assert(result == alignedPntr); return result; }
+		}
+		return nullptr;
+	}
+	// +==============================+
+	// |            Linux             |
+	// +==============================+
+	#elif LINUX_COMPILATION
+	{
+		//Reserve enough extra that an aligned range has to fit inside, then unmap the unaligned head and the leftover tail
+		u64 oversizedSize = numBytes + alignment - pageSize;
+		u8* oversizedPntr = (u8*)mmap(
+			nullptr, //addr
+			oversizedSize, //length
+			PROT_READ|PROT_WRITE, //prot
+			MAP_PRIVATE | MAP_ANONYMOUS,
+			-1, //fd,
+			0 //offset
+		);
+		Assert(oversizedPntr != MAP_FAILED);
+		u8* result = (u8*)RoundUpToU64((u64)oversizedPntr, alignment);
+		u64 headSize = (u64)(result - oversizedPntr);
+		u64 tailSize = oversizedSize - headSize - numBytes;
+		if (headSize > 0) { int unmapResult = munmap(oversizedPntr, headSize); Assert(unmapResult == 0); }
+		if (tailSize > 0) { int unmapResult = munmap(result + numBytes, tailSize); Assert(unmapResult == 0); }
+		return result;
+	}
+	// +==============================+
+	// |   Playdate / Orca / WASM     |
+	// +==============================+
+	#elif PLAYDATE_COMPILATION || ORCA_COMPILATION || WASM_COMPILATION
+	{
+		return nullptr;
+	}
+	#else
+	#error OsReserveMemoryAligned does not support the current platform yet!
+	#endif
+}
+
+// +--------------------------------------------------------------+
+// |                      OsAdviseHugePages                       |
+// +--------------------------------------------------------------+
+//Asks the OS to back the range with huge pages where it can. Returns false if the OS (or platform) refused.
+//NOTE: Only the huge page aligned parts of the range can actually be backed by huge pages
+bool OsAdviseHugePages(void* memoryPntr, u64 numBytes)
+{
+	NotNull(memoryPntr);
+	// +==============================+
+	// |            Linux             |
+	// +==============================+
+	#if LINUX_COMPILATION && defined(MADV_HUGEPAGE)
+	{
+		int adviseResult = madvise(memoryPntr, numBytes, MADV_HUGEPAGE);
+		return (adviseResult == 0); //fails with EINVAL if transparent huge pages are disabled in the kernel
+	}
+	#else
+	{
+		UNUSED(numBytes);
+		return false;
+	}
+	#endif
+}
+
+// +--------------------------------------------------------------+
+// |                       OsProtectMemory                        |
+// +--------------------------------------------------------------+
+//Switches committed pages between read-only and read-write. Returns false if the OS (or platform) refused.
+//NOTE: numBytes must be a multiple of memory page size, and memoryPntr must be aligned to the beginning of a page
+bool OsProtectMemory(void* memoryPntr, u64 numBytes, bool allowWrite)
+{
+	if (numBytes == 0) { return true; }
+	NotNull(memoryPntr);
+	DebugAssert((u64)memoryPntr % OsGetMemoryPageSize() == 0);
+	DebugAssert(numBytes % OsGetMemoryPageSize() == 0);
+	
+	// +==============================+
+	// |           Windows            |
+	// +==============================+
+	#if WINDOWS_COMPILATION
+	{
+		DWORD oldProtect = 0;
+		BOOL protectResult = VirtualProtect(
+			memoryPntr, //lpAddress
+			numBytes, //dwSize
+			(allowWrite ? PAGE_READWRITE : PAGE_READONLY), //flNewProtect
+			&oldProtect //lpflOldProtect
+		);
+		return (protectResult != 0);
+	}
+	// +==============================+
+	// |            Linux             |
+	// +==============================+
+	#elif LINUX_COMPILATION
+	{
+		int protectResult = mprotect(memoryPntr, numBytes, (allowWrite ? (PROT_READ|PROT_WRITE) : PROT_READ));
+		return (protectResult == 0);
+	}
+	#else
+	{
+		UNUSED(allowWrite);
+		return false;
+	}
+	#endif
+}
+
+// +--------------------------------------------------------------+
+// |                        OsRemapMemory                         |
+// +--------------------------------------------------------------+
+//Resizes memory from OsReserveMemory by moving page mappings around rather than copying. If allowMove is false the
+//mapping can only grow into the address space right after it. Returns the new address, or nullptr if it couldn't be resized
+//(always on platforms other than Linux, use a copy instead)
+//NOTE: oldSize and newSize must be multiples of memory page size
+void* OsRemapMemory(void* memoryPntr, u64 oldSize, u64 newSize, bool allowMove)
+{
+	NotNull(memoryPntr);
+	// +==============================+
+	// |            Linux             |
+	// +==============================+
+	#if LINUX_COMPILATION && defined(MREMAP_MAYMOVE)
+	{
+		void* result = mremap(memoryPntr, oldSize, newSize, (allowMove ? MREMAP_MAYMOVE : 0));
+		return (result == MAP_FAILED) ? nullptr : result;
+	}
+	#else
+	{
+		UNUSED(oldSize);
+		UNUSED(newSize);
+		UNUSED(allowMove);
+		return nullptr;
+	}
+	#endif
+}
+
+// +--------------------------------------------------------------+
+// |                          OsMapFile                           |
+// +--------------------------------------------------------------+
+//Maps the whole file into memory and returns the base address (or nullptr on failure).
+//Unless copyOnWrite is set the file is created if it doesn't exist, extended to minFileSize if it's smaller, and writes go back to the file.
+//With copyOnWrite the file must already exist and writes stay private to this process (unmodified pages are still shared through the page cache)
+//desiredBase is only a hint, if that address is taken we map wherever the OS likes
+void* OsMapFile(const char* filePath, u64 minFileSize, bool copyOnWrite, void* desiredBase, u64* fileSizeOut)
+{
+	NotNull(filePath);
+	// +==============================+
+	// |           Windows            |
+	// +==============================+
+	#if WINDOWS_COMPILATION
+	{
+		HANDLE fileHandle = CreateFileA(
+			filePath, //lpFileName
+			(copyOnWrite ? GENERIC_READ : (GENERIC_READ|GENERIC_WRITE)), //dwDesiredAccess
+			FILE_SHARE_READ|FILE_SHARE_WRITE, //dwShareMode
+			nullptr, //lpSecurityAttributes
+			(copyOnWrite ? OPEN_EXISTING : OPEN_ALWAYS), //dwCreationDisposition
+			FILE_ATTRIBUTE_NORMAL, //dwFlagsAndAttributes
+			nullptr //hTemplateFile
+		);
+		if (fileHandle == INVALID_HANDLE_VALUE) { return nullptr; }
+		LARGE_INTEGER fileSizeLarge;
+		if (!GetFileSizeEx(fileHandle, &fileSizeLarge)) { CloseHandle(fileHandle); return nullptr; }
+		u64 fileSize = (u64)fileSizeLarge.QuadPart;
+		if (!copyOnWrite && fileSize < minFileSize) { fileSize = minFileSize; } //CreateFileMapping extends the file for us
+		if (fileSize == 0) { CloseHandle(fileHandle); return nullptr; }
+		
+		HANDLE mappingHandle = CreateFileMappingA(
+			fileHandle, //hFile
+			nullptr, //lpFileMappingAttributes
+			(copyOnWrite ? PAGE_WRITECOPY : PAGE_READWRITE), //flProtect
+			(DWORD)(fileSize >> 32), //dwMaximumSizeHigh
+			(DWORD)(fileSize & 0xFFFFFFFFULL), //dwMaximumSizeLow
+			nullptr //lpName
+		);
+		if (mappingHandle == nullptr) { CloseHandle(fileHandle); return nullptr; }
+		DWORD viewAccess = (copyOnWrite ? FILE_MAP_COPY : FILE_MAP_WRITE);
+		void* result = MapViewOfFileEx(mappingHandle, viewAccess, 0, 0, (SIZE_T)fileSize, desiredBase);
+		if (result == nullptr && desiredBase != nullptr) { result = MapViewOfFileEx(mappingHandle, viewAccess, 0, 0, (SIZE_T)fileSize, nullptr); }
+		//NOTE: The view keeps the mapping (and the file) alive so we don't need to hold onto these handles
+		CloseHandle(mappingHandle);
+		CloseHandle(fileHandle);
+		if (result != nullptr) { SetOptionalOutPntr(fileSizeOut, fileSize); }
+		return result;
+	}
+	// +==============================+
+	// |            Linux             |
+	// +==============================+
+	#elif LINUX_COMPILATION
+	{
+		int fileDescriptor = open(filePath, (copyOnWrite ? O_RDONLY : (O_RDWR|O_CREAT)), 0644);
+		if (fileDescriptor < 0) { return nullptr; }
+		struct stat fileStat;
+		if (fstat(fileDescriptor, &fileStat) != 0) { close(fileDescriptor); return nullptr; }
+		u64 fileSize = (u64)fileStat.st_size;
+		if (!copyOnWrite && fileSize < minFileSize)
+		{
+			if (ftruncate(fileDescriptor, (off_t)minFileSize) != 0) { close(fileDescriptor); return nullptr; }
+			fileSize = minFileSize;
+		}
+		if (fileSize == 0) { close(fileDescriptor); return nullptr; }
+		
+		int mapFlags = (copyOnWrite ? MAP_PRIVATE : MAP_SHARED);
+		void* result = MAP_FAILED;
+		#ifdef MAP_FIXED_NOREPLACE
+		if (desiredBase != nullptr) { result = mmap(desiredBase, fileSize, PROT_READ|PROT_WRITE, mapFlags|MAP_FIXED_NOREPLACE, fileDescriptor, 0); }
+		#endif
+		if (result == MAP_FAILED) { result = mmap(desiredBase, fileSize, PROT_READ|PROT_WRITE, mapFlags, fileDescriptor, 0); }
+		//NOTE: The mapping keeps the file alive so we don't need to hold onto the descriptor
+		close(fileDescriptor);
+		if (result == MAP_FAILED) { return nullptr; }
+		SetOptionalOutPntr(fileSizeOut, fileSize);
+		return result;
+	}
+	#else
+	{
+		UNUSED(minFileSize);
+		UNUSED(copyOnWrite);
+		UNUSED(desiredBase);
+		UNUSED(fileSizeOut);
+		return nullptr;
+	}
+	#endif
+}
+
+// +--------------------------------------------------------------+
+// |                       OsSyncMappedFile                       |
+// +--------------------------------------------------------------+
+//Writes any modified pages in the range back to the file. If waitForWrite is false we only schedule the write (not supported on Windows, we always wait)
+bool OsSyncMappedFile(void* memoryPntr, u64 numBytes, bool waitForWrite)
+{
+	NotNull(memoryPntr);
+	if (numBytes == 0) { return true; }
+	// +==============================+
+	// |           Windows            |
+	// +==============================+
+	#if WINDOWS_COMPILATION
+	{
+		UNUSED(waitForWrite);
+		return (FlushViewOfFile(memoryPntr, (SIZE_T)numBytes) != 0);
+	}
+	// +==============================+
+	// |            Linux             |
+	// +==============================+
+	#elif LINUX_COMPILATION
+	{
+		//msync needs a page aligned address so round down and cover the extra bytes
+		u64 pageSize = OsGetMemoryPageSize();
+		u64 pageOffset = ((u64)memoryPntr % pageSize);
+		int syncResult = msync(((u8*)memoryPntr) - pageOffset, numBytes + pageOffset, (waitForWrite ? MS_SYNC : MS_ASYNC));
+		return (syncResult == 0);
+	}
+	#else
+	{
+		UNUSED(waitForWrite);
+		return false;
+	}
+	#endif
+}
+
+// +--------------------------------------------------------------+
+// |                         OsUnmapFile                          |
+// +--------------------------------------------------------------+
+void OsUnmapFile(void* basePntr, u64 mappedSize)
+{
+	if (basePntr == nullptr) { return; }
+	// +==============================+
+	// |           Windows            |
+	// +==============================+
+	#if WINDOWS_COMPILATION
+	{
+		UNUSED(mappedSize);
+		BOOL unmapResult = UnmapViewOfFile(basePntr);
+		Assert(unmapResult != 0); //TODO: Handle errors, call GetLastError and return an OsError_t
+	}
+	// +==============================+
+	// |            Linux             |
+	// +==============================+
+	#elif LINUX_COMPILATION
+	{
+		int unmapResult = munmap(basePntr, mappedSize);
+		Assert(unmapResult == 0); //TODO: Handle errors, check errno and return an OsError_t
+	}
+	#else
+	{
+		UNUSED(mappedSize);
+		AssertMsg(false, "OsUnmapFile is not supported on this platform");
+	}
+	#endif
+}
+
 #endif //GYLIB_HEADER_ONLY
 
 #endif //  _GY_OS_H
@@ -531,4 +892,12 @@ u64 OsGetMemoryPageSize()
 void* OsReserveMemory(u64 numBytes)
 void OsCommitReservedMemory(void* memoryPntr, u64 numBytes)
 void OsFreeReservedMemory(void* memoryPntr, u64 reservedSize)
+u64 OsGetHugePageSize()
+void* OsReserveMemoryAligned(u64 numBytes, u64 alignment)
+bool OsAdviseHugePages(void* memoryPntr, u64 numBytes)
+bool OsProtectMemory(void* memoryPntr, u64 numBytes, bool allowWrite)
+void* OsRemapMemory(void* memoryPntr, u64 oldSize, u64 newSize, bool allowMove)
+void* OsMapFile(const char* filePath, u64 minFileSize, bool copyOnWrite, void* desiredBase, u64* fileSizeOut)
+bool OsSyncMappedFile(void* memoryPntr, u64 numBytes, bool waitForWrite)
+void OsUnmapFile(void* basePntr, u64 mappedSize)
 */
\ No newline at end of file
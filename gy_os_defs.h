@@ -49,6 +49,14 @@ u64 OsGetMemoryPageSize();
 void* OsReserveMemory(u64 numBytes);
 void OsCommitReservedMemory(void* memoryPntr, u64 numBytes);
 void OsFreeReservedMemory(void* memoryPntr, u64 reservedSize);
+u64 OsGetHugePageSize();
+void* OsReserveMemoryAligned(u64 numBytes, u64 alignment);
+bool OsAdviseHugePages(void* memoryPntr, u64 numBytes);
+bool OsProtectMemory(void* memoryPntr, u64 numBytes, bool allowWrite);
+void* OsRemapMemory(void* memoryPntr, u64 oldSize, u64 newSize, bool allowMove);
+void* OsMapFile(const char* filePath, u64 minFileSize, bool copyOnWrite, void* desiredBase, u64* fileSizeOut);
+bool OsSyncMappedFile(void* memoryPntr, u64 numBytes, bool waitForWrite);
+void OsUnmapFile(void* basePntr, u64 mappedSize);
 
 #endif //  _GY_OS_DEFS_H
 
@@ -73,4 +81,12 @@ u64 OsGetMemoryPageSize()
 void* OsReserveMemory(u64 numBytes)
 void OsCommitReservedMemory(void* memoryPntr, u64 numBytes)
 void OsFreeReservedMemory(void* memoryPntr, u64 reservedSize)
+u64 OsGetHugePageSize()
+void* OsReserveMemoryAligned(u64 numBytes, u64 alignment)
+bool OsAdviseHugePages(void* memoryPntr, u64 numBytes)
+bool OsProtectMemory(void* memoryPntr, u64 numBytes, bool allowWrite)
+void* OsRemapMemory(void* memoryPntr, u64 oldSize, u64 newSize, bool allowMove)
+void* OsMapFile(const char* filePath, u64 minFileSize, bool copyOnWrite, void* desiredBase, u64* fileSizeOut)
+bool OsSyncMappedFile(void* memoryPntr, u64 numBytes, bool waitForWrite)
+void OsUnmapFile(void* basePntr, u64 mappedSize)
 */
\ No newline at end of file
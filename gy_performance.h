@@ -4,20 +4,35 @@ Author: Taylor Robbins
 Date:   04\09\2024
 Description:
 	** Holds functions PerfTime_t type and GetPerfTime and GetPerfTimeDiff functions
+	** PerfTime works without any setup. The counter frequency is queried once on first use (QueryPerformanceFrequency on Windows, a fixed 1GHz on Linux/Orca)
+	** On Linux we use clock_gettime(CLOCK_MONOTONIC_RAW). If GYLIB_PERF_TIME_TSC_ENABLED is defined and the
+	** cpu reports an invariant TSC, calling InitPerfTime switches us to rdtsc instead, calibrated against CLOCK_MONOTONIC_RAW.
+	** InitPerfTime is optional. If you do call it, call it once at startup before taking any PerfTime_t or starting other threads
+	** (it can spin for PERF_TIME_TSC_CALIBRATION_NANOSECONDS and is not thread safe)
 */
 
 #ifndef _GY_PERFORMANCE_H
 #define _GY_PERFORMANCE_H
 
+#if LINUX_COMPILATION && GYLIB_PERF_TIME_TSC_ENABLED && (defined(__x86_64__) || defined(__i386__))
+#define PERF_TIME_TSC_SUPPORTED 1
+#else
+#define PERF_TIME_TSC_SUPPORTED 0
+#endif
+
+#define PERF_TIME_TSC_CALIBRATION_NANOSECONDS 10000000ULL //10ms
+
 struct PerfTime_t
 {
 	#if WINDOWS_COMPILATION
 	LARGE_INTEGER perfCount;
 	u64 cycleCount;
+	#elif LINUX_COMPILATION
+	u64 perfCount; //nanoseconds from CLOCK_MONOTONIC_RAW, or TSC cycles if perfTimeGlobals.usingTsc
 	#elif ORCA_COMPILATION
-	u64 value;
+	u64 value; //nanoseconds from oc_clock_time(OC_CLOCK_MONOTONIC)
 	#else
-	//TODO: Implement linux/OSX/wasm variants of PerfTime!
+	//TODO: Implement OSX/wasm variants of PerfTime!
 	#error Unsupported platform in gy_performance.h PerfTime_t
 	#endif
 };
@@ -27,19 +42,114 @@ struct PerfTimeTotal_t
 	u64 totalCounterAmount;
 };
 
+struct PerfTimeGlobals_t
+{
+	bool initialized; //only set by InitPerfTime, otherwise we use GetPerfTimeDefaultFrequency
+	bool usingTsc;
+	u64 countsPerSecond;
+	r64 secondsPerCount;
+};
+
 // +--------------------------------------------------------------+
 // |                         Header Only                          |
 // +--------------------------------------------------------------+
 #ifdef GYLIB_HEADER_ONLY
+	extern PerfTimeGlobals_t perfTimeGlobals;
+	u64 GetPerfTimeDefaultFrequency();
+	r64 GetPerfTimeSecondsPerCount();
+	void InitPerfTime();
 	PerfTime_t GetPerfTime();
 	r64 GetPerfTimeDiff(const PerfTime_t* tStart, const PerfTime_t* tEnd);
 	void AddToPerfTimeTotal(const PerfTime_t* tStart, const PerfTime_t* tEnd, PerfTimeTotal_t* totalOut);
 	r64 GetPerfTimeTotal(const PerfTimeTotal_t* total);
 #else
 
+PerfTimeGlobals_t perfTimeGlobals = {};
+
+// +--------------------------------------------------------------+
+// |                       Helper Functions                       |
+// +--------------------------------------------------------------+
+#if LINUX_COMPILATION
+u64 GetMonotonicRawNanoseconds()
+{
+	struct timespec timeSpec;
+	int getTimeResult = clock_gettime(CLOCK_MONOTONIC_RAW, &timeSpec);
+	Assert_(getTimeResult == 0);
+	return ((u64)timeSpec.tv_sec * 1000000000ULL) + (u64)timeSpec.tv_nsec;
+}
+#endif //LINUX_COMPILATION
+
+#if PERF_TIME_TSC_SUPPORTED
+bool IsInvariantTscAvailable()
+{
+	unsigned int eax = 0, ebx = 0, ecx = 0, edx = 0;
+	if (__get_cpuid(0x80000000, &eax, &ebx, &ecx, &edx) == 0 || eax < 0x80000007) { return false; }
+	if (__get_cpuid(0x80000007, &eax, &ebx, &ecx, &edx) == 0) { return false; }
+	return ((edx & (1 << 8)) != 0); //Invariant TSC bit
+}
+#endif //PERF_TIME_TSC_SUPPORTED
+
+#if WINDOWS_COMPILATION
+u64 QueryPerfTimeFrequency()
+{
+	LARGE_INTEGER perfCountFrequencyLarge;
+	BOOL queryResult = QueryPerformanceFrequency(&perfCountFrequencyLarge);
+	Assert_(queryResult != 0 && perfCountFrequencyLarge.QuadPart > 0);
+	return (u64)perfCountFrequencyLarge.QuadPart;
+}
+#endif //WINDOWS_COMPILATION
+
+//The frequency of the default (non-TSC) counter, used whenever InitPerfTime hasn't been called
+u64 GetPerfTimeDefaultFrequency()
+{
+	#if WINDOWS_COMPILATION
+	//Function local statics are initialized exactly once, even if multiple threads race on the first call
+	static const u64 frequency = QueryPerfTimeFrequency();
+	return frequency;
+	#elif LINUX_COMPILATION || ORCA_COMPILATION
+	return 1000000000ULL; //nanoseconds
+	#else
+	//TODO: Implement OSX/wasm variants of PerfTime!
+	#error Unsupported platform in gy_performance.h GetPerfTimeDefaultFrequency
+	#endif
+}
+
+r64 GetPerfTimeSecondsPerCount()
+{
+	if (perfTimeGlobals.initialized) { return perfTimeGlobals.secondsPerCount; }
+	return 1.0 / (r64)GetPerfTimeDefaultFrequency();
+}
+
 // +--------------------------------------------------------------+
 // |                          Functions                           |
 // +--------------------------------------------------------------+
+void InitPerfTime()
+{
+	perfTimeGlobals.usingTsc = false;
+	perfTimeGlobals.countsPerSecond = GetPerfTimeDefaultFrequency();
+	#if LINUX_COMPILATION
+	#if PERF_TIME_TSC_SUPPORTED
+	if (IsInvariantTscAvailable())
+	{
+		//Spin for a short time and compare the TSC against the raw monotonic clock to find the TSC frequency
+		u64 startNanoseconds = GetMonotonicRawNanoseconds();
+		u64 startCycles = __rdtsc();
+		u64 endNanoseconds = startNanoseconds;
+		while (endNanoseconds - startNanoseconds < PERF_TIME_TSC_CALIBRATION_NANOSECONDS) { endNanoseconds = GetMonotonicRawNanoseconds(); }
+		u64 endCycles = __rdtsc();
+		if (endCycles > startCycles)
+		{
+			perfTimeGlobals.usingTsc = true;
+			perfTimeGlobals.countsPerSecond = (u64)(((r64)(endCycles - startCycles) * 1000000000.0) / (r64)(endNanoseconds - startNanoseconds));
+		}
+	}
+	#endif //PERF_TIME_TSC_SUPPORTED
+	#endif //LINUX_COMPILATION
+	Assert_(perfTimeGlobals.countsPerSecond > 0);
+	perfTimeGlobals.secondsPerCount = 1.0 / (r64)perfTimeGlobals.countsPerSecond;
+	perfTimeGlobals.initialized = true;
+}
+
 PerfTime_t GetPerfTime()
 {
 	PerfTime_t result = {};
@@ -47,10 +157,17 @@ PerfTime_t GetPerfTime()
 	BOOL queryResult = QueryPerformanceCounter(&result.perfCount);
 	Assert_(queryResult != 0);
 	result.cycleCount = __rdtsc();
+	#elif LINUX_COMPILATION
+	#if PERF_TIME_TSC_SUPPORTED
+	if (perfTimeGlobals.usingTsc) { result.perfCount = __rdtsc(); }
+	else { result.perfCount = GetMonotonicRawNanoseconds(); }
+	#else
+	result.perfCount = GetMonotonicRawNanoseconds();
+	#endif
 	#elif ORCA_COMPILATION
-	Unimplemented(); //TODO: Implement me!
+	result.value = (u64)(oc_clock_time(OC_CLOCK_MONOTONIC) * 1000000000.0);
 	#else
-	//TODO: Implement linux/OSX/wasm variants of PerfTime!
+	//TODO: Implement OSX/wasm variants of PerfTime!
 	#error Unsupported platform in gy_performance.h GetPerfTime
 	#endif
 	return result;
@@ -60,15 +177,16 @@ r64 GetPerfTimeDiff(const PerfTime_t* tStart, const PerfTime_t* tEnd)
 {
 	NotNull_(tStart);
 	NotNull_(tEnd);
+	r64 secondsPerCount = GetPerfTimeSecondsPerCount();
 	r64 resultSecs;
 	#if WINDOWS_COMPILATION
-	LARGE_INTEGER perfCountFrequencyLarge;
-	QueryPerformanceFrequency(&perfCountFrequencyLarge);
-	resultSecs = ((r64)(tEnd->perfCount.QuadPart - tStart->perfCount.QuadPart) / (r64)perfCountFrequencyLarge.QuadPart);
+	resultSecs = (r64)(tEnd->perfCount.QuadPart - tStart->perfCount.QuadPart) * secondsPerCount;
+	#elif LINUX_COMPILATION
+	resultSecs = (r64)(i64)(tEnd->perfCount - tStart->perfCount) * secondsPerCount;
 	#elif ORCA_COMPILATION
-	Unimplemented(); //TODO: Implement me!
+	resultSecs = (r64)(i64)(tEnd->value - tStart->value) * secondsPerCount;
 	#else
-	//TODO: Implement linux/OSX/wasm variants of PerfTime!
+	//TODO: Implement OSX/wasm variants of PerfTime!
 	#error Unsupported platform in gy_performance.h GetPerfTimeDiff
 	#endif
 	return resultSecs * 1000.0;
@@ -81,10 +199,12 @@ void AddToPerfTimeTotal(const PerfTime_t* tStart, const PerfTime_t* tEnd, PerfTi
 	NotNull_(totalOut);
 	#if WINDOWS_COMPILATION
 	totalOut->totalCounterAmount += (u64)(tEnd->perfCount.QuadPart - tStart->perfCount.QuadPart);
+	#elif LINUX_COMPILATION
+	totalOut->totalCounterAmount += (tEnd->perfCount - tStart->perfCount);
 	#elif ORCA_COMPILATION
-	Unimplemented(); //TODO: Implement me!
+	totalOut->totalCounterAmount += (tEnd->value - tStart->value);
 	#else
-	//TODO: Implement linux/OSX/wasm variants of PerfTime!
+	//TODO: Implement OSX/wasm variants of PerfTime!
 	#error Unsupported platform in gy_performance.h AddToPerfTimeTotal
 	#endif
 }
@@ -92,15 +212,12 @@ void AddToPerfTimeTotal(const PerfTime_t* tStart, const PerfTime_t* tEnd, PerfTi
 r64 GetPerfTimeTotal(const PerfTimeTotal_t* total)
 {
 	NotNull_(total);
+	r64 secondsPerCount = GetPerfTimeSecondsPerCount();
 	r64 resultSecs;
-	#if WINDOWS_COMPILATION
-	LARGE_INTEGER perfCountFrequencyLarge;
-	QueryPerformanceFrequency(&perfCountFrequencyLarge);
-	resultSecs = ((r64)total->totalCounterAmount / (r64)perfCountFrequencyLarge.QuadPart);
-	#elif ORCA_COMPILATION
-	Unimplemented(); //TODO: Implement me!
+	#if WINDOWS_COMPILATION || LINUX_COMPILATION || ORCA_COMPILATION
+	resultSecs = (r64)total->totalCounterAmount * secondsPerCount;
 	#else
-	//TODO: Implement linux/OSX/wasm variants of PerfTime!
+	//TODO: Implement OSX/wasm variants of PerfTime!
 	#error Unsupported platform in gy_performance.h GetPerfTimeTotal
 	#endif
 	return resultSecs * 1000.0;
@@ -115,13 +232,19 @@ r64 GetPerfTimeTotal(const PerfTimeTotal_t* total)
 // |                   Autocomplete Dictionary                    |
 // +--------------------------------------------------------------+
 /*
+@Defines
+PERF_TIME_TSC_SUPPORTED
+PERF_TIME_TSC_CALIBRATION_NANOSECONDS
 @Types
 PerfTime_t
 PerfTimeTotal_t
+PerfTimeGlobals_t
 @Functions
+u64 GetPerfTimeDefaultFrequency()
+r64 GetPerfTimeSecondsPerCount()
+void InitPerfTime()
 PerfTime_t GetPerfTime()
 r64 GetPerfTimeDiff(const PerfTime_t* tStart, const PerfTime_t* tEnd)
 void AddToPerfTimeTotal(const PerfTime_t* tStart, const PerfTime_t* tEnd, PerfTimeTotal_t* totalOut)
 r64 GetPerfTimeTotal(const PerfTimeTotal_t* total)
 */
-
@@ -83,6 +83,8 @@ struct ProcessLog_t
 	bool hadWarnings;
 	bool debugBreakOnWarningsAndErrors;
 	u32 errorCode;
+	u64 numWarnings; //lines output at DbgLevel_Warning
+	u64 numErrors; //lines output at DbgLevel_Error
 	TryParseFailureReason_t parseFailureReason;
 	XmlParsingError_t xmlParsingError;
 	
@@ -239,6 +241,8 @@ void LogOutput_(ProcessLog_t* log, u8 flags, const char* filePath, u32 lineNumbe
 	UNUSED(addNewLine); //TODO: We should probably take this into account
 	
 	if (log->debugBreakOnWarningsAndErrors && (dbgLevel == DbgLevel_Warning || dbgLevel == DbgLevel_Error)) { MyDebugBreak(); }
+	if (dbgLevel == DbgLevel_Warning) { log->numWarnings++; }
+	if (dbgLevel == DbgLevel_Error) { log->numErrors++; }
 	
 	if (log->immediateOutputFuncPntr != nullptr)
 	{
@@ -280,7 +284,7 @@ void LogPrint_(ProcessLog_t* log, u8 flags, const char* filePath, u32 lineNumber
 		va_end(args);
 		if (formattedStrLength >= 0)
 		{
-			char* formattedStr = AllocArray(scratch, char, formattedStrLength+1); //Allocate
+			char* formattedStr = AllocArrayFast(scratch, char, formattedStrLength+1); //Allocate
 			if (formattedStr != nullptr)
 			{
 				va_start(args, formatString);
@@ -0,0 +1,334 @@
+/*
+File:   gy_slot_map.h
+Author: Taylor Robbins
+Date:   10\16\2026
+Description:
+	** A SlotMap_t is an object pool that hands out u64 handles instead of indices.
+	** Items live in a BktArray_t so their addresses never change, and removed slots
+	** go on a free list to be reused by the next add instead of shifting anything down.
+	** Each slot has a generation counter that goes up every time the slot is removed,
+	** and the handle holds both the slot index (low 32 bits) and the generation (high 32 bits),
+	** so a handle to a removed item fails to resolve even after its slot gets reused.
+	** An occupancy bitmap lets SlotMapIter skip over empty slots 64 at a time.
+	** NOTE: SLOT_MAP_INVALID_HANDLE (0) is never handed out since generations start at 1
+*/
+
+#ifndef _GY_SLOT_MAP_H
+#define _GY_SLOT_MAP_H
+
+#include "gy_defines_check.h"
+#include "gy_std.h"
+#include "gy_types.h"
+#include "gy_intrinsics.h"
+#include "gy_memory.h"
+#include "gy_bucket_array.h"
+
+#define SLOT_MAP_INVALID_HANDLE      0
+#define SLOT_MAP_DEFAULT_BUCKET_SIZE 64
+#define SLOT_MAP_NO_FREE_INDEX       0xFFFFFFFF //also the max number of slots
+
+// +--------------------------------------------------------------+
+// |                  Structure/Type Definitions                  |
+// +--------------------------------------------------------------+
+//Sits in front of each item in the BktArray_t
+struct SlotMapSlot_t
+{
+	u32 generation;
+	u32 nextFreeIndex; //only meaningful while the slot is on the free list
+};
+
+struct SlotMap_t
+{
+	MemArena_t* allocArena;
+	u64 itemSize;
+	u64 slotStride; //sizeof(SlotMapSlot_t) + itemSize, rounded up to 8 bytes
+	u64 bucketSize; //always a power of two. Every bucket in slots is exactly this size so we can find a slot without searching
+	u8 bucketSizePower;
+	
+	u64 count;
+	u64 firstFreeIndex;
+	BktArray_t slots;
+	
+	u64 numOccupiedWords;
+	u64* occupiedBits; //bit n is set when slot n holds an item
+};
+
+// +--------------------------------------------------------------+
+// |                            Macros                            |
+// +--------------------------------------------------------------+
+#define MakeSlotMapHandle(index, generation)  ((((u64)(generation)) << 32) | (u64)(index))
+#define GetSlotMapHandleIndex(handle)         ((u32)((handle) & 0xFFFFFFFFULL))
+#define GetSlotMapHandleGeneration(handle)    ((u32)((handle) >> 32))
+
+#define SlotMapAdd(map, type, handleOut)     ((type*)SlotMapAdd_((map), sizeof(type), (handleOut)))
+
+#define SlotMapGetHard(map, type, handle)    ((type*)SlotMapGet_((map), sizeof(type), (handle), true))
+#define SlotMapGetSoft(map, type, handle)    ((type*)SlotMapGet_((map), sizeof(type), (handle), false))
+#define SlotMapGet(map, type, handle)        SlotMapGetHard((map), type, (handle))
+#define SlotMapContains(map, handle)         (SlotMapGet_((map), (map)->itemSize, (handle), false) != nullptr)
+
+#define SlotMapRemoveHard(map, handle)       SlotMapRemove_((map), (handle), true)
+#define SlotMapRemoveSoft(map, handle)       SlotMapRemove_((map), (handle), false)
+#define SlotMapRemove(map, handle)           SlotMapRemoveHard((map), (handle))
+
+// +--------------------------------------------------------------+
+// |                         Header Only                          |
+// +--------------------------------------------------------------+
+#ifdef GYLIB_HEADER_ONLY
+	void FreeSlotMap(SlotMap_t* map);
+	void CreateSlotMap(SlotMap_t* map, MemArena_t* memArena, u64 itemSize, u64 bucketSize = SLOT_MAP_DEFAULT_BUCKET_SIZE);
+	SlotMapSlot_t* GetSlotMapSlot(const SlotMap_t* map, u64 slotIndex);
+	bool IsSlotMapSlotOccupied(const SlotMap_t* map, u64 slotIndex);
+	void SetSlotMapSlotOccupied(SlotMap_t* map, u64 slotIndex, bool occupied);
+	void ClearSlotMap(SlotMap_t* map);
+	void* SlotMapAdd_(SlotMap_t* map, u64 itemSize, u64* handleOut);
+	void* SlotMapGet_(SlotMap_t* map, u64 itemSize, u64 handle, bool assertOnFailure);
+	const void* SlotMapGet_(const SlotMap_t* map, u64 itemSize, u64 handle, bool assertOnFailure);
+	bool SlotMapRemove_(SlotMap_t* map, u64 handle, bool assertOnFailure);
+	bool SlotMapIter(const SlotMap_t* map, u64* slotIndexPntr, u64* handleOut = nullptr, void** itemOut = nullptr);
+#else
+
+// +--------------------------------------------------------------+
+// |                       Create and Free                        |
+// +--------------------------------------------------------------+
+void FreeSlotMap(SlotMap_t* map)
+{
+	NotNull(map);
+	if (map->allocArena != nullptr)
+	{
+		FreeBktArray(&map->slots);
+		if (map->occupiedBits != nullptr)
+		{
+			FreeMem(map->allocArena, map->occupiedBits, sizeof(u64) * map->numOccupiedWords);
+		}
+	}
+	ClearPointer(map);
+}
+
+void CreateSlotMap(SlotMap_t* map, MemArena_t* memArena, u64 itemSize, u64 bucketSize = SLOT_MAP_DEFAULT_BUCKET_SIZE)
+{
+	NotNull2(map, memArena);
+	Assert(itemSize > 0);
+	Assert(bucketSize > 0);
+	ClearPointer(map);
+	map->allocArena = memArena;
+	map->itemSize = itemSize;
+	map->slotStride = ((sizeof(SlotMapSlot_t) + itemSize + 7) & ~(u64)7);
+	map->bucketSize = PowerOfTwoGreaterThanOrEqualTo(bucketSize, &map->bucketSizePower);
+	map->count = 0;
+	map->firstFreeIndex = SLOT_MAP_NO_FREE_INDEX;
+	CreateBktArray(&map->slots, memArena, map->slotStride, map->bucketSize);
+	map->numOccupiedWords = 0;
+	map->occupiedBits = nullptr;
+}
+
+// +--------------------------------------------------------------+
+// |                       Helper Functions                       |
+// +--------------------------------------------------------------+
+SlotMapSlot_t* GetSlotMapSlot(const SlotMap_t* map, u64 slotIndex)
+{
+	NotNull(map);
+	Assert(slotIndex < map->slots.length);
+	//We only ever add to slots one at a time and never remove from it, so every bucket is exactly bucketSize items
+	BktArrayBucket_t* bucket = map->slots.buckets[slotIndex >> map->bucketSizePower];
+	DebugAssert(bucket->numItemsAlloc == map->bucketSize);
+	return (SlotMapSlot_t*)(((u8*)bucket->items) + (map->slotStride * (slotIndex & (map->bucketSize - 1))));
+}
+
+bool IsSlotMapSlotOccupied(const SlotMap_t* map, u64 slotIndex)
+{
+	NotNull(map);
+	if ((slotIndex / 64) >= map->numOccupiedWords) { return false; }
+	return IsFlagSet(map->occupiedBits[slotIndex / 64], (1ULL << (slotIndex % 64)));
+}
+
+void SetSlotMapSlotOccupied(SlotMap_t* map, u64 slotIndex, bool occupied)
+{
+	NotNull(map);
+	u64 wordIndex = (slotIndex / 64);
+	if (wordIndex >= map->numOccupiedWords)
+	{
+		u64 newNumWords = (map->numOccupiedWords > 0) ? map->numOccupiedWords : 1;
+		while (newNumWords <= wordIndex) { newNumWords *= 2; }
+		u64* newBits = AllocArray(map->allocArena, u64, newNumWords);
+		NotNull(newBits);
+		MyMemSet(newBits, 0x00, sizeof(u64) * newNumWords);
+		if (map->occupiedBits != nullptr)
+		{
+			MyMemCopy(newBits, map->occupiedBits, sizeof(u64) * map->numOccupiedWords);
+			FreeMem(map->allocArena, map->occupiedBits, sizeof(u64) * map->numOccupiedWords);
+		}
+		map->occupiedBits = newBits;
+		map->numOccupiedWords = newNumWords;
+	}
+	FlagSetTo(map->occupiedBits[wordIndex], (1ULL << (slotIndex % 64)), occupied);
+}
+
+// +--------------------------------------------------------------+
+// |                            Clear                             |
+// +--------------------------------------------------------------+
+//Invalidates every outstanding handle. Memory is kept and all the slots go back on the free list
+void ClearSlotMap(SlotMap_t* map)
+{
+	NotNull(map);
+	map->firstFreeIndex = SLOT_MAP_NO_FREE_INDEX;
+	//Walk backwards so the free list hands out low indices first
+	for (u64 sIndex = map->slots.length; sIndex > 0; sIndex--)
+	{
+		SlotMapSlot_t* slot = GetSlotMapSlot(map, sIndex-1);
+		if (IsSlotMapSlotOccupied(map, sIndex-1))
+		{
+			slot->generation++;
+			if (slot->generation == 0) { slot->generation = 1; }
+		}
+		slot->nextFreeIndex = (u32)map->firstFreeIndex;
+		map->firstFreeIndex = sIndex-1;
+	}
+	if (map->occupiedBits != nullptr) { MyMemSet(map->occupiedBits, 0x00, sizeof(u64) * map->numOccupiedWords); }
+	map->count = 0;
+}
+
+// +--------------------------------------------------------------+
+// |                             Add                              |
+// +--------------------------------------------------------------+
+//The returned item is zeroed
+void* SlotMapAdd_(SlotMap_t* map, u64 itemSize, u64* handleOut)
+{
+	NotNull(map);
+	NotNull(map->allocArena);
+	AssertMsg(map->itemSize == itemSize, "Invalid itemSize passed to SlotMapAdd. Make sure you're accessing the SlotMap with the correct type!");
+	
+	u64 slotIndex = 0;
+	SlotMapSlot_t* slot = nullptr;
+	if (map->firstFreeIndex != SLOT_MAP_NO_FREE_INDEX)
+	{
+		slotIndex = map->firstFreeIndex;
+		slot = GetSlotMapSlot(map, slotIndex);
+		map->firstFreeIndex = slot->nextFreeIndex;
+	}
+	else
+	{
+		AssertMsg(map->slots.length < SLOT_MAP_NO_FREE_INDEX, "SlotMap ran out of slot indices!");
+		slotIndex = map->slots.length;
+		slot = (SlotMapSlot_t*)BktArrayAdd_(&map->slots, map->slotStride);
+		NotNull(slot);
+		slot->generation = 1;
+	}
+	
+	slot->nextFreeIndex = SLOT_MAP_NO_FREE_INDEX;
+	SetSlotMapSlotOccupied(map, slotIndex, true);
+	map->count++;
+	void* result = (void*)(slot + 1);
+	MyMemSet(result, 0x00, map->itemSize);
+	SetOptionalOutPntr(handleOut, MakeSlotMapHandle(slotIndex, slot->generation));
+	return result;
+}
+
+// +--------------------------------------------------------------+
+// |                             Get                              |
+// +--------------------------------------------------------------+
+void* SlotMapGet_(SlotMap_t* map, u64 itemSize, u64 handle, bool assertOnFailure)
+{
+	NotNull(map);
+	AssertMsg(map->itemSize == itemSize, "Invalid itemSize passed to SlotMapGet. Make sure you're accessing the SlotMap with the correct type!");
+	u64 slotIndex = GetSlotMapHandleIndex(handle);
+	if (slotIndex < map->slots.length && IsSlotMapSlotOccupied(map, slotIndex))
+	{
+		SlotMapSlot_t* slot = GetSlotMapSlot(map, slotIndex);
+		if (slot->generation == GetSlotMapHandleGeneration(handle)) { return (void*)(slot + 1); }
+	}
+	AssertIfMsg(assertOnFailure, false, "Stale or invalid handle passed to SlotMapGet!");
+	return nullptr;
+}
+const void* SlotMapGet_(const SlotMap_t* map, u64 itemSize, u64 handle, bool assertOnFailure) //const version
+{
+	return (const void*)SlotMapGet_((SlotMap_t*)map, itemSize, handle, assertOnFailure);
+}
+
+// +--------------------------------------------------------------+
+// |                            Remove                            |
+// +--------------------------------------------------------------+
+bool SlotMapRemove_(SlotMap_t* map, u64 handle, bool assertOnFailure)
+{
+	NotNull(map);
+	if (SlotMapGet_(map, map->itemSize, handle, false) == nullptr)
+	{
+		AssertIfMsg(assertOnFailure, false, "Stale or invalid handle passed to SlotMapRemove!");
+		return false;
+	}
+	u64 slotIndex = GetSlotMapHandleIndex(handle);
+	SlotMapSlot_t* slot = GetSlotMapSlot(map, slotIndex);
+	slot->generation++;
+	if (slot->generation == 0) { slot->generation = 1; } //never hand out SLOT_MAP_INVALID_HANDLE
+	slot->nextFreeIndex = (u32)map->firstFreeIndex;
+	map->firstFreeIndex = slotIndex;
+	SetSlotMapSlotOccupied(map, slotIndex, false);
+	Assert(map->count > 0);
+	map->count--;
+	return true;
+}
+
+// +--------------------------------------------------------------+
+// |                           Iterate                            |
+// +--------------------------------------------------------------+
+//Start slotIndexPntr at 0 and call this until it returns false. Items come out in slot order.
+//Removing the item you were just handed is fine, adding while iterating may or may not visit the new item
+bool SlotMapIter(const SlotMap_t* map, u64* slotIndexPntr, u64* handleOut = nullptr, void** itemOut = nullptr)
+{
+	NotNull2(map, slotIndexPntr);
+	u64 wordIndex = (*slotIndexPntr / 64);
+	if (wordIndex >= map->numOccupiedWords) { return false; }
+	u64 bits = map->occupiedBits[wordIndex] & (~0ULL << (*slotIndexPntr % 64));
+	while (bits == 0)
+	{
+		wordIndex++;
+		if (wordIndex >= map->numOccupiedWords) { *slotIndexPntr = wordIndex * 64; return false; }
+		bits = map->occupiedBits[wordIndex];
+	}
+	u64 slotIndex = (wordIndex * 64) + FindLsbIndexU64(bits);
+	*slotIndexPntr = slotIndex + 1;
+	SlotMapSlot_t* slot = GetSlotMapSlot(map, slotIndex);
+	SetOptionalOutPntr(handleOut, MakeSlotMapHandle(slotIndex, slot->generation));
+	SetOptionalOutPntr(itemOut, (void*)(slot + 1));
+	return true;
+}
+
+#endif //GYLIB_HEADER_ONLY
+
+#endif //  _GY_SLOT_MAP_H
+
+// +--------------------------------------------------------------+
+// |                   Autocomplete Dictionary                    |
+// +--------------------------------------------------------------+
+/*
+@Defines
+SLOT_MAP_INVALID_HANDLE
+SLOT_MAP_DEFAULT_BUCKET_SIZE
+SLOT_MAP_NO_FREE_INDEX
+@Types
+SlotMapSlot_t
+SlotMap_t
+@Functions
+#define MakeSlotMapHandle(index, generation)
+#define GetSlotMapHandleIndex(handle)
+#define GetSlotMapHandleGeneration(handle)
+#define SlotMapAdd(map, type, handleOut)
+#define SlotMapGetHard(map, type, handle)
+#define SlotMapGetSoft(map, type, handle)
+#define SlotMapGet(map, type, handle)
+#define SlotMapContains(map, handle)
+#define SlotMapRemoveHard(map, handle)
+#define SlotMapRemoveSoft(map, handle)
+#define SlotMapRemove(map, handle)
+void FreeSlotMap(SlotMap_t* map)
+void CreateSlotMap(SlotMap_t* map, MemArena_t* memArena, u64 itemSize, u64 bucketSize = SLOT_MAP_DEFAULT_BUCKET_SIZE)
+SlotMapSlot_t* GetSlotMapSlot(const SlotMap_t* map, u64 slotIndex)
+bool IsSlotMapSlotOccupied(const SlotMap_t* map, u64 slotIndex)
+void SetSlotMapSlotOccupied(SlotMap_t* map, u64 slotIndex, bool occupied)
+void ClearSlotMap(SlotMap_t* map)
+void* SlotMapAdd_(SlotMap_t* map, u64 itemSize, u64* handleOut)
+void* SlotMapGet_(SlotMap_t* map, u64 itemSize, u64 handle, bool assertOnFailure)
+const void* SlotMapGet_(const SlotMap_t* map, u64 itemSize, u64 handle, bool assertOnFailure)
+bool SlotMapRemove_(SlotMap_t* map, u64 handle, bool assertOnFailure)
+bool SlotMapIter(const SlotMap_t* map, u64* slotIndexPntr, u64* handleOut = nullptr, void** itemOut = nullptr)
+*/
@@ -0,0 +1,345 @@
+/*
+File:   gy_soa_array.h
+Author: Taylor Robbins
+Date:   10\16\2026
+Description:
+	** A SoaArray_t is a "structure of arrays" version of VarArray_t. Instead of one array of fat structs
+	** you declare a set of columns (like v3 position, v3 velocity, r32 mass) and each column gets its own contiguous array.
+	** Rows are added and removed across all columns at once, and a loop that only touches a couple columns only pulls
+	** those columns through the cache, which also lets the compiler vectorize it.
+	** Every column starts on a SOA_ARRAY_COLUMN_ALIGNMENT (64 byte) boundary and allocLength is always a multiple of
+	** SOA_ARRAY_MIN_ALLOC_LENGTH, so a SIMD loop can safely read/write up to allocLength without special handling for the tail.
+	** NOTE: All columns live in a single allocation, so any add can move every column. Don't hold column pointers across adds
+*/
+
+#ifndef _GY_SOA_ARRAY_H
+#define _GY_SOA_ARRAY_H
+
+#include "gy_defines_check.h"
+#include "gy_std.h"
+#include "gy_types.h"
+#include "gy_assert.h"
+#include "gy_memory.h"
+
+#define SOA_ARRAY_MAX_NUM_COLUMNS   16
+#define SOA_ARRAY_COLUMN_ALIGNMENT  64 //bytes, a full cache line
+#define SOA_ARRAY_MIN_ALLOC_LENGTH  16 //also what allocLength is always a multiple of (16 r32s is one 512-bit register)
+
+// +--------------------------------------------------------------+
+// |                  Structure/Type Definitions                  |
+// +--------------------------------------------------------------+
+struct SoaArrayColumn_t
+{
+	u64 itemSize;
+	void* items; //always SOA_ARRAY_COLUMN_ALIGNMENT aligned
+};
+
+struct SoaArray_t
+{
+	MemArena_t* allocArena;
+	u64 numColumns;
+	SoaArrayColumn_t columns[SOA_ARRAY_MAX_NUM_COLUMNS];
+	
+	u64 length;
+	u64 allocLength;
+	
+	//Not every arena supports alignment so we over-allocate by SOA_ARRAY_COLUMN_ALIGNMENT-1 bytes and align the first column ourselves
+	void* allocPntr;
+	u64 allocSize;
+	
+	bool wasExpanded;
+	u64 numExpansions;
+};
+
+// +--------------------------------------------------------------+
+// |                            Macros                            |
+// +--------------------------------------------------------------+
+#define SoaArrayColumn(array, columnIndex, type) ((type*)SoaArrayGetColumn_((array), (columnIndex), sizeof(type)))
+
+#define SoaArrayGetHard(array, columnIndex, rowIndex, type) ((type*)SoaArrayGet_((array), (columnIndex), (rowIndex), sizeof(type), true))
+#define SoaArrayGetSoft(array, columnIndex, rowIndex, type) ((type*)SoaArrayGet_((array), (columnIndex), (rowIndex), sizeof(type), false))
+#define SoaArrayGet(array, columnIndex, rowIndex, type) SoaArrayGetHard((array), (columnIndex), (rowIndex), type)
+
+#define SoaArrayLoop(arrayPntr, rowIndexName) for (u64 rowIndexName = 0; rowIndexName < (arrayPntr)->length; rowIndexName++)
+
+// +--------------------------------------------------------------+
+// |                         Header Only                          |
+// +--------------------------------------------------------------+
+#ifdef GYLIB_HEADER_ONLY
+	void FreeSoaArray(SoaArray_t* array);
+	void CreateSoaArray(SoaArray_t* array, MemArena_t* memArena, u64 numColumns, const u64* columnSizes, u64 initialRequiredCapacity = 0);
+	u64 GetSoaArrayColumnOffset(const SoaArray_t* array, u64 columnIndex, u64 allocLength);
+	bool SoaArrayExpand(SoaArray_t* array, u64 capacityRequired);
+	void SoaArrayClear(SoaArray_t* array, bool deallocate = false);
+	void* SoaArrayGetColumn_(SoaArray_t* array, u64 columnIndex, u64 itemSize);
+	const void* SoaArrayGetColumn_(const SoaArray_t* array, u64 columnIndex, u64 itemSize);
+	void* SoaArrayGet_(SoaArray_t* array, u64 columnIndex, u64 rowIndex, u64 itemSize, bool assertOnFailure);
+	const void* SoaArrayGet_(const SoaArray_t* array, u64 columnIndex, u64 rowIndex, u64 itemSize, bool assertOnFailure);
+	u64 SoaArrayAddRows(SoaArray_t* array, u64 numRows);
+	u64 SoaArrayAdd(SoaArray_t* array);
+	void SoaArrayRemove(SoaArray_t* array, u64 rowIndex);
+	void SoaArrayRemoveSwap(SoaArray_t* array, u64 rowIndex);
+#else
+
+// +--------------------------------------------------------------+
+// |                       Helper Functions                       |
+// +--------------------------------------------------------------+
+//Where a column starts (relative to the aligned start of the allocation) when the array holds allocLength rows
+//Passing columnIndex == numColumns gives you the total number of bytes all the columns need
+u64 GetSoaArrayColumnOffset(const SoaArray_t* array, u64 columnIndex, u64 allocLength)
+{
+	NotNull(array);
+	Assert(columnIndex <= array->numColumns);
+	u64 result = 0;
+	for (u64 cIndex = 0; cIndex < columnIndex; cIndex++)
+	{
+		result += RoundUpToU64(array->columns[cIndex].itemSize * allocLength, SOA_ARRAY_COLUMN_ALIGNMENT);
+	}
+	return result;
+}
+
+//Returns if the array actually expanded
+bool SoaArrayExpand(SoaArray_t* array, u64 capacityRequired)
+{
+	NotNull(array);
+	NotNull(array->allocArena);
+	Assert(array->numColumns > 0);
+	if (array->allocLength >= capacityRequired) { return false; }
+	
+	u64 newLength = (array->allocLength > 0) ? array->allocLength : SOA_ARRAY_MIN_ALLOC_LENGTH;
+	while (newLength < capacityRequired)
+	{
+		DebugAssert(newLength <= UINT64_MAX/2);
+		newLength *= 2;
+	}
+	DebugAssert((newLength % SOA_ARRAY_MIN_ALLOC_LENGTH) == 0);
+	
+	u64 newAllocSize = GetSoaArrayColumnOffset(array, array->numColumns, newLength) + (SOA_ARRAY_COLUMN_ALIGNMENT-1);
+	void* newAllocPntr = AllocMem(array->allocArena, newAllocSize);
+	if (newAllocPntr == nullptr)
+	{
+		GyLibPrintLine_E("Failed to expand SoaArray to %llu rows (%llu bytes)", newLength, newAllocSize);
+		AssertMsg(false, "Failed to expand SoaArray");
+		return false;
+	}
+	u8* newBase = ((u8*)newAllocPntr) + OffsetToAlign(newAllocPntr, (AllocAlignment_t)SOA_ARRAY_COLUMN_ALIGNMENT);
+	
+	for (u64 cIndex = 0; cIndex < array->numColumns; cIndex++)
+	{
+		SoaArrayColumn_t* column = &array->columns[cIndex];
+		void* newItems = (void*)(newBase + GetSoaArrayColumnOffset(array, cIndex, newLength));
+		if (array->length > 0) { MyMemCopy(newItems, column->items, column->itemSize * array->length); }
+		column->items = newItems;
+	}
+	if (array->allocPntr != nullptr)
+	{
+		FreeMem(array->allocArena, array->allocPntr, array->allocSize);
+	}
+	
+	array->allocPntr = newAllocPntr;
+	array->allocSize = newAllocSize;
+	array->allocLength = newLength;
+	array->wasExpanded = true;
+	IncrementU64(array->numExpansions);
+	return true;
+}
+
+// +--------------------------------------------------------------+
+// |                       Create and Free                        |
+// +--------------------------------------------------------------+
+void FreeSoaArray(SoaArray_t* array)
+{
+	NotNull(array);
+	if (array->allocPntr != nullptr)
+	{
+		NotNull(array->allocArena);
+		FreeMem(array->allocArena, array->allocPntr, array->allocSize);
+	}
+	ClearPointer(array);
+}
+
+//columnSizes holds the itemSize of each column, in the order you want to refer to them by index. Something like:
+//  u64 columnSizes[] = { sizeof(v3), sizeof(v3), sizeof(r32) };
+//  CreateSoaArray(&particles, memArena, ArrayCount(columnSizes), columnSizes);
+void CreateSoaArray(SoaArray_t* array, MemArena_t* memArena, u64 numColumns, const u64* columnSizes, u64 initialRequiredCapacity = 0)
+{
+	NotNull3(array, memArena, columnSizes);
+	AssertMsg(numColumns > 0 && numColumns <= SOA_ARRAY_MAX_NUM_COLUMNS, "Invalid number of columns passed to CreateSoaArray. Bump SOA_ARRAY_MAX_NUM_COLUMNS if you need more");
+	ClearPointer(array);
+	array->allocArena = memArena;
+	array->numColumns = numColumns;
+	for (u64 cIndex = 0; cIndex < numColumns; cIndex++)
+	{
+		Assert(columnSizes[cIndex] > 0);
+		array->columns[cIndex].itemSize = columnSizes[cIndex];
+		array->columns[cIndex].items = nullptr;
+	}
+	array->length = 0;
+	array->allocLength = 0;
+	array->allocPntr = nullptr;
+	array->allocSize = 0;
+	if (initialRequiredCapacity > 0)
+	{
+		SoaArrayExpand(array, initialRequiredCapacity);
+		array->wasExpanded = false;
+		array->numExpansions = 0;
+	}
+}
+
+// +--------------------------------------------------------------+
+// |                            Clear                             |
+// +--------------------------------------------------------------+
+void SoaArrayClear(SoaArray_t* array, bool deallocate = false)
+{
+	NotNull(array);
+	if (deallocate && array->allocPntr != nullptr)
+	{
+		NotNull(array->allocArena);
+		FreeMem(array->allocArena, array->allocPntr, array->allocSize);
+		array->allocPntr = nullptr;
+		array->allocSize = 0;
+		array->allocLength = 0;
+		for (u64 cIndex = 0; cIndex < array->numColumns; cIndex++) { array->columns[cIndex].items = nullptr; }
+	}
+	array->length = 0;
+}
+
+// +--------------------------------------------------------------+
+// |                             Get                              |
+// +--------------------------------------------------------------+
+//Returns the start of the whole column (length items long). This pointer is invalidated by the next add that expands the array
+void* SoaArrayGetColumn_(SoaArray_t* array, u64 columnIndex, u64 itemSize)
+{
+	NotNull(array);
+	Assert(columnIndex < array->numColumns);
+	AssertMsg(array->columns[columnIndex].itemSize == itemSize, "Invalid itemSize passed to SoaArrayColumn. Make sure you're accessing the column with the correct type!");
+	return array->columns[columnIndex].items;
+}
+const void* SoaArrayGetColumn_(const SoaArray_t* array, u64 columnIndex, u64 itemSize) //const version
+{
+	return (const void*)SoaArrayGetColumn_((SoaArray_t*)array, columnIndex, itemSize);
+}
+
+void* SoaArrayGet_(SoaArray_t* array, u64 columnIndex, u64 rowIndex, u64 itemSize, bool assertOnFailure)
+{
+	NotNull(array);
+	Assert(columnIndex < array->numColumns);
+	AssertMsg(array->columns[columnIndex].itemSize == itemSize, "Invalid itemSize passed to SoaArrayGet. Make sure you're accessing the column with the correct type!");
+	if (rowIndex >= array->length)
+	{
+		AssertIfMsg(assertOnFailure, false, "SoaArrayGet out of bounds!");
+		return nullptr;
+	}
+	return (void*)(((u8*)array->columns[columnIndex].items) + (itemSize * rowIndex));
+}
+const void* SoaArrayGet_(const SoaArray_t* array, u64 columnIndex, u64 rowIndex, u64 itemSize, bool assertOnFailure) //const version
+{
+	return (const void*)SoaArrayGet_((SoaArray_t*)array, columnIndex, rowIndex, itemSize, assertOnFailure);
+}
+
+// +--------------------------------------------------------------+
+// |                             Add                              |
+// +--------------------------------------------------------------+
+//Returns the index of the first new row. The new rows are zeroed in every column
+u64 SoaArrayAddRows(SoaArray_t* array, u64 numRows)
+{
+	NotNull(array);
+	NotNull(array->allocArena);
+	u64 result = array->length;
+	if (numRows == 0) { return result; }
+	SoaArrayExpand(array, array->length + numRows);
+	Assert(array->allocLength >= array->length + numRows);
+	for (u64 cIndex = 0; cIndex < array->numColumns; cIndex++)
+	{
+		SoaArrayColumn_t* column = &array->columns[cIndex];
+		MyMemSet(((u8*)column->items) + (column->itemSize * array->length), 0x00, column->itemSize * numRows);
+	}
+	array->length += numRows;
+	return result;
+}
+
+u64 SoaArrayAdd(SoaArray_t* array)
+{
+	return SoaArrayAddRows(array, 1);
+}
+
+// +--------------------------------------------------------------+
+// |                            Remove                            |
+// +--------------------------------------------------------------+
+//Keeps the rows in order by shifting everything above rowIndex down, O(length)
+void SoaArrayRemove(SoaArray_t* array, u64 rowIndex)
+{
+	NotNull(array);
+	if (rowIndex >= array->length)
+	{
+		GyLibPrintLine_E("Tried to remove row [%llu]/%llu in SoaArray", rowIndex, array->length);
+		AssertMsg(false, "SoaArrayRemove out of bounds!");
+		return;
+	}
+	for (u64 cIndex = 0; cIndex < array->numColumns; cIndex++)
+	{
+		SoaArrayColumn_t* column = &array->columns[cIndex];
+		u8* rowPntr = ((u8*)column->items) + (column->itemSize * rowIndex);
+		MyMemMove(rowPntr, rowPntr + column->itemSize, column->itemSize * (array->length - (rowIndex+1)));
+	}
+	array->length--;
+}
+
+//Moves the last row into rowIndex, O(numColumns). This is usually what you want for simulation style data where order doesn't matter
+void SoaArrayRemoveSwap(SoaArray_t* array, u64 rowIndex)
+{
+	NotNull(array);
+	if (rowIndex >= array->length)
+	{
+		GyLibPrintLine_E("Tried to remove row [%llu]/%llu in SoaArray", rowIndex, array->length);
+		AssertMsg(false, "SoaArrayRemoveSwap out of bounds!");
+		return;
+	}
+	u64 lastIndex = array->length-1;
+	if (rowIndex != lastIndex)
+	{
+		for (u64 cIndex = 0; cIndex < array->numColumns; cIndex++)
+		{
+			SoaArrayColumn_t* column = &array->columns[cIndex];
+			u8* items = (u8*)column->items;
+			MyMemCopy(items + (column->itemSize * rowIndex), items + (column->itemSize * lastIndex), column->itemSize);
+		}
+	}
+	array->length--;
+}
+
+#endif //GYLIB_HEADER_ONLY
+
+#endif //  _GY_SOA_ARRAY_H
+
+// +--------------------------------------------------------------+
+// |                   Autocomplete Dictionary                    |
+// +--------------------------------------------------------------+
+/*
+@Defines
+SOA_ARRAY_MAX_NUM_COLUMNS
+SOA_ARRAY_COLUMN_ALIGNMENT
+SOA_ARRAY_MIN_ALLOC_LENGTH
+@Types
+SoaArrayColumn_t
+SoaArray_t
+@Functions
+#define SoaArrayColumn(array, columnIndex, type)
+#define SoaArrayGetHard(array, columnIndex, rowIndex, type)
+#define SoaArrayGetSoft(array, columnIndex, rowIndex, type)
+#define SoaArrayGet(array, columnIndex, rowIndex, type)
+#define SoaArrayLoop(arrayPntr, rowIndexName)
+void FreeSoaArray(SoaArray_t* array)
+void CreateSoaArray(SoaArray_t* array, MemArena_t* memArena, u64 numColumns, const u64* columnSizes, u64 initialRequiredCapacity = 0)
+u64 GetSoaArrayColumnOffset(const SoaArray_t* array, u64 columnIndex, u64 allocLength)
+bool SoaArrayExpand(SoaArray_t* array, u64 capacityRequired)
+void SoaArrayClear(SoaArray_t* array, bool deallocate = false)
+void* SoaArrayGetColumn_(SoaArray_t* array, u64 columnIndex, u64 itemSize)
+const void* SoaArrayGetColumn_(const SoaArray_t* array, u64 columnIndex, u64 itemSize)
+void* SoaArrayGet_(SoaArray_t* array, u64 columnIndex, u64 rowIndex, u64 itemSize, bool assertOnFailure)
+const void* SoaArrayGet_(const SoaArray_t* array, u64 columnIndex, u64 rowIndex, u64 itemSize, bool assertOnFailure)
+u64 SoaArrayAddRows(SoaArray_t* array, u64 numRows)
+u64 SoaArrayAdd(SoaArray_t* array)
+void SoaArrayRemove(SoaArray_t* array, u64 rowIndex)
+void SoaArrayRemoveSwap(SoaArray_t* array, u64 rowIndex)
+*/
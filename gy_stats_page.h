@@ -0,0 +1,416 @@
+/*
+File:   gy_stats_page.h
+Author: Taylor Robbins
+Date:   10\16\2026
+Description:
+	** Holds StatsPage_t which publishes arena counters, PerfSection timings and ProcessLog warning/error counts (see SetStatsPageProcessLog)
+	** into a named shared memory segment (shm_open on Linux, a named file mapping on Windows) so another process can
+	** watch a running program without attaching a debugger or parsing logs.
+	** The writer calls CreateStatsPage once, AddStatsPageArena for each arena it wants to expose, and then
+	** PublishStatsPage whenever it has new numbers (once per frame is fine, publishing is just a few hundred bytes of copying).
+	** A reader calls OpenStatsPage with the same name and then ReadStatsPage to get a consistent copy of the StatsPageLayout_t.
+	** The layout is guarded by a sequence lock: the writer makes sequence odd while it's writing and even when it's done,
+	** the reader retries if sequence was odd or changed while it was copying. The writer never waits on readers.
+	** NOTE: The layout is versioned with STATS_PAGE_VERSION, bump it whenever StatsPageLayout_t changes
+*/
+
+#ifndef _GY_STATS_PAGE_H
+#define _GY_STATS_PAGE_H
+
+#if (WINDOWS_COMPILATION || LINUX_COMPILATION)
+#define STATS_PAGE_SUPPORTED 1
+#else
+#define STATS_PAGE_SUPPORTED 0
+#endif
+
+#define STATS_PAGE_MAGIC               0x53504753 //"SGPS" in little-endian
+#define STATS_PAGE_VERSION             1
+#define STATS_PAGE_MAX_ARENAS          32
+#define STATS_PAGE_MAX_PERF_SECTIONS   32
+#define STATS_PAGE_NAME_MAX_LENGTH     32 //including the null-terminator
+#define STATS_PAGE_SEGMENT_NAME_LENGTH 64
+#define STATS_PAGE_DEFAULT_MAX_RETRIES 100
+
+struct StatsPageArena_t
+{
+	char name[STATS_PAGE_NAME_MAX_LENGTH];
+	u32 type; //MemArenaType_t
+	u32 flags; //MemArenaFlag_t
+	u64 size;
+	u64 used;
+	u64 numPages;
+	u64 numAllocations;
+	u64 highUsedMark;
+	u64 resettableHighUsedMark;
+	u64 highAllocMark;
+};
+
+struct StatsPagePerfSection_t
+{
+	char name[STATS_PAGE_NAME_MAX_LENGTH];
+	r64 timeMs;
+};
+
+//This is exactly what lives in the shared memory, so it can only hold fixed size things (no pntrs)
+struct StatsPageLayout_t
+{
+	u32 magic;
+	u32 version;
+	u64 layoutSize; //sizeof(StatsPageLayout_t) in the writer
+	u64 processId;
+	volatile u64 sequence; //odd while the writer is in the middle of publishing
+	
+	u64 publishCount;
+	u64 numLogWarnings;
+	u64 numLogErrors;
+	u64 numArenas;
+	StatsPageArena_t arenas[STATS_PAGE_MAX_ARENAS];
+	u64 numPerfSections;
+	r64 totalPerfSectionsTimeMs;
+	StatsPagePerfSection_t perfSections[STATS_PAGE_MAX_PERF_SECTIONS];
+};
+
+struct StatsPage_t
+{
+	bool isOpen;
+	bool isWriter;
+	char segmentName[STATS_PAGE_SEGMENT_NAME_LENGTH];
+	StatsPageLayout_t* layout;
+	#if WINDOWS_COMPILATION
+	HANDLE mappingHandle;
+	#elif LINUX_COMPILATION
+	int fileDescriptor;
+	#endif
+	
+	//Only used by the writer
+	u64 numArenas;
+	MemArena_t* arenas[STATS_PAGE_MAX_ARENAS];
+	char arenaNames[STATS_PAGE_MAX_ARENAS][STATS_PAGE_NAME_MAX_LENGTH];
+	#if GYLIB_SCRATCH_ARENA_AVAILABLE
+	const ProcessLog_t* log;
+	#endif
+};
+
+// +--------------------------------------------------------------+
+// |                         Header Only                          |
+// +--------------------------------------------------------------+
+#ifdef GYLIB_HEADER_ONLY
+	void CopyStatsPageName(char* destBuffer, const char* name);
+	bool MapStatsPage(StatsPage_t* page, const char* name, bool create);
+	void FreeStatsPage(StatsPage_t* page);
+	bool CreateStatsPage(StatsPage_t* pageOut, const char* name);
+	bool OpenStatsPage(StatsPage_t* pageOut, const char* name);
+	bool AddStatsPageArena(StatsPage_t* page, MemArena_t* arena, const char* name);
+	#if GYLIB_SCRATCH_ARENA_AVAILABLE
+	void SetStatsPageProcessLog(StatsPage_t* page, const ProcessLog_t* log);
+	#endif
+	void PublishStatsPage(StatsPage_t* page, const PerfSectionBundle_t* perfSections = nullptr);
+	bool ReadStatsPage(const StatsPage_t* page, StatsPageLayout_t* layoutOut, u64 maxRetries = STATS_PAGE_DEFAULT_MAX_RETRIES);
+	void PrintStatsPageLayout(const StatsPageLayout_t* layout);
+#else
+
+// +--------------------------------------------------------------+
+// |                       Helper Functions                       |
+// +--------------------------------------------------------------+
+//Truncates to STATS_PAGE_NAME_MAX_LENGTH-1 characters
+void CopyStatsPageName(char* destBuffer, const char* name)
+{
+	NotNull(destBuffer);
+	MyMemSet(destBuffer, 0x00, STATS_PAGE_NAME_MAX_LENGTH);
+	if (name == nullptr) { return; }
+	u64 nameLength = MinU64(MyStrLength64(name), STATS_PAGE_NAME_MAX_LENGTH-1);
+	MyMemCopy(destBuffer, name, nameLength);
+}
+
+bool MapStatsPage(StatsPage_t* page, const char* name, bool create)
+{
+	NotNull2(page, name);
+	ClearPointer(page);
+	page->isWriter = create;
+	
+	// +==============================+
+	// |            Linux             |
+	// +==============================+
+	#if LINUX_COMPILATION
+	{
+		MyBufferPrintf(page->segmentName, STATS_PAGE_SEGMENT_NAME_LENGTH, "/gylib_stats_%s", name);
+		page->fileDescriptor = shm_open(page->segmentName, (create ? (O_RDWR | O_CREAT) : O_RDONLY), 0644);
+		if (page->fileDescriptor < 0) { return false; }
+		if (create && ftruncate(page->fileDescriptor, (off_t)sizeof(StatsPageLayout_t)) != 0)
+		{
+			close(page->fileDescriptor);
+			shm_unlink(page->segmentName);
+			return false;
+		}
+		if (!create)
+		{
+			struct stat fileStat;
+			if (fstat(page->fileDescriptor, &fileStat) != 0 || (u64)fileStat.st_size < sizeof(StatsPageLayout_t)) { close(page->fileDescriptor); return false; }
+		}
+		void* mappedPntr = mmap(nullptr, sizeof(StatsPageLayout_t), (create ? (PROT_READ | PROT_WRITE) : PROT_READ), MAP_SHARED, page->fileDescriptor, 0);
+		if (mappedPntr == MAP_FAILED)
+		{
+			close(page->fileDescriptor);
+			if (create) { shm_unlink(page->segmentName); }
+			return false;
+		}
+		page->layout = (StatsPageLayout_t*)mappedPntr;
+	}
+	// +==============================+
+	// |           Windows            |
+	// +==============================+
+	#elif WINDOWS_COMPILATION
+	{
+		MyBufferPrintf(page->segmentName, STATS_PAGE_SEGMENT_NAME_LENGTH, "Local\\gylib_stats_%s", name);
+		if (create)
+		{
+			page->mappingHandle = CreateFileMappingA(
+				INVALID_HANDLE_VALUE, //hFile (backed by the page file)
+				NULL, //lpFileMappingAttributes
+				PAGE_READWRITE, //flProtect
+				0, //dwMaximumSizeHigh
+				(DWORD)sizeof(StatsPageLayout_t), //dwMaximumSizeLow
+				page->segmentName //lpName
+			);
+		}
+		else { page->mappingHandle = OpenFileMappingA(FILE_MAP_READ, FALSE, page->segmentName); }
+		if (page->mappingHandle == NULL) { return false; }
+		void* mappedPntr = MapViewOfFile(page->mappingHandle, (create ? FILE_MAP_WRITE : FILE_MAP_READ), 0, 0, sizeof(StatsPageLayout_t));
+		if (mappedPntr == nullptr) { CloseHandle(page->mappingHandle); return false; }
+		page->layout = (StatsPageLayout_t*)mappedPntr;
+	}
+	#else
+	UNUSED(create);
+	return false;
+	#endif
+	
+	page->isOpen = true;
+	return true;
+}
+
+// +--------------------------------------------------------------+
+// |                        Create and Free                       |
+// +--------------------------------------------------------------+
+//The writer removes the shared memory name when it frees the page. Readers that still have it open keep seeing the last published numbers
+void FreeStatsPage(StatsPage_t* page)
+{
+	NotNull(page);
+	if (page->isOpen)
+	{
+		#if LINUX_COMPILATION
+		munmap(page->layout, sizeof(StatsPageLayout_t));
+		close(page->fileDescriptor);
+		if (page->isWriter) { shm_unlink(page->segmentName); }
+		#elif WINDOWS_COMPILATION
+		UnmapViewOfFile(page->layout);
+		CloseHandle(page->mappingHandle);
+		#endif
+	}
+	ClearPointer(page);
+}
+
+//name should be short and only contain characters that are valid in a file name
+bool CreateStatsPage(StatsPage_t* pageOut, const char* name)
+{
+	NotNull2(pageOut, name);
+	if (!MapStatsPage(pageOut, name, true)) { return false; }
+	
+	StatsPageLayout_t* layout = pageOut->layout;
+	MyMemSet(layout, 0x00, sizeof(StatsPageLayout_t));
+	layout->version = STATS_PAGE_VERSION;
+	layout->layoutSize = sizeof(StatsPageLayout_t);
+	#if LINUX_COMPILATION
+	layout->processId = (u64)getpid();
+	#elif WINDOWS_COMPILATION
+	layout->processId = (u64)GetCurrentProcessId();
+	#endif
+	ThreadingWriteBarrier();
+	layout->magic = STATS_PAGE_MAGIC; //written last so a reader never sees the magic before the rest of the header
+	return true;
+}
+
+//Opens a page created by another process for reading. Fails if the page doesn't exist or was written by a different STATS_PAGE_VERSION
+bool OpenStatsPage(StatsPage_t* pageOut, const char* name)
+{
+	NotNull2(pageOut, name);
+	if (!MapStatsPage(pageOut, name, false)) { return false; }
+	const StatsPageLayout_t* layout = pageOut->layout;
+	if (layout->magic != STATS_PAGE_MAGIC || layout->version != STATS_PAGE_VERSION || layout->layoutSize != sizeof(StatsPageLayout_t))
+	{
+		FreeStatsPage(pageOut);
+		return false;
+	}
+	return true;
+}
+
+// +--------------------------------------------------------------+
+// |                            Writer                            |
+// +--------------------------------------------------------------+
+//The arena needs to stay valid until the page is freed
+bool AddStatsPageArena(StatsPage_t* page, MemArena_t* arena, const char* name)
+{
+	NotNull2(page, arena);
+	Assert(page->isOpen && page->isWriter);
+	if (page->numArenas >= STATS_PAGE_MAX_ARENAS) { return false; }
+	page->arenas[page->numArenas] = arena;
+	CopyStatsPageName(&page->arenaNames[page->numArenas][0], name);
+	page->numArenas++;
+	return true;
+}
+
+#if GYLIB_SCRATCH_ARENA_AVAILABLE
+//The log's warning and error counts get published along with everything else. The log needs to stay valid until the page is freed (or this is called with nullptr)
+void SetStatsPageProcessLog(StatsPage_t* page, const ProcessLog_t* log)
+{
+	NotNull(page);
+	Assert(page->isOpen && page->isWriter);
+	page->log = log;
+}
+#endif
+
+//perfSections is optional. Only the first STATS_PAGE_MAX_PERF_SECTIONS sections are published
+void PublishStatsPage(StatsPage_t* page, const PerfSectionBundle_t* perfSections = nullptr)
+{
+	NotNull(page);
+	Assert(page->isOpen && page->isWriter);
+	StatsPageLayout_t* layout = page->layout;
+	
+	//Take everything we need from the arenas before we start writing so the sequence stays odd for as short as possible
+	StatsPageArena_t arenaStats[STATS_PAGE_MAX_ARENAS];
+	for (u64 aIndex = 0; aIndex < page->numArenas; aIndex++)
+	{
+		MemArena_t* arena = page->arenas[aIndex];
+		StatsPageArena_t* stats = &arenaStats[aIndex];
+		bool didLock = false;
+		if (IsValidGyMutex(&arena->mutex)) { LockGyMutex(&arena->mutex); didLock = true; }
+		MyMemCopy(&stats->name[0], &page->arenaNames[aIndex][0], STATS_PAGE_NAME_MAX_LENGTH);
+		stats->type = (u32)arena->type;
+		stats->flags = (u32)arena->flags;
+		stats->size = arena->size;
+		stats->used = arena->used;
+		stats->numPages = arena->numPages;
+		stats->numAllocations = arena->numAllocations;
+		stats->highUsedMark = arena->highUsedMark;
+		stats->resettableHighUsedMark = arena->resettableHighUsedMark;
+		stats->highAllocMark = arena->highAllocMark;
+		if (didLock) { UnlockGyMutex(&arena->mutex); }
+	}
+	
+	layout->sequence++; //odd, readers will retry until we are done
+	ThreadingWriteBarrier();
+	
+	layout->publishCount++;
+	layout->numArenas = page->numArenas;
+	MyMemCopy(&layout->arenas[0], &arenaStats[0], sizeof(StatsPageArena_t) * page->numArenas);
+	#if GYLIB_SCRATCH_ARENA_AVAILABLE
+	if (page->log != nullptr)
+	{
+		layout->numLogWarnings = page->log->numWarnings;
+		layout->numLogErrors = page->log->numErrors;
+	}
+	#endif
+	layout->numPerfSections = 0;
+	layout->totalPerfSectionsTimeMs = 0.0;
+	if (perfSections != nullptr && perfSections->sections.length > 0)
+	{
+		//The last section in a bundle only marks the end time of the one before it
+		for (u64 sIndex = 0; sIndex+1 < perfSections->sections.length && layout->numPerfSections < STATS_PAGE_MAX_PERF_SECTIONS; sIndex++)
+		{
+			const PerfSection_t* section = VarArrayGet(&perfSections->sections, sIndex, PerfSection_t);
+			const PerfSection_t* nextSection = VarArrayGet(&perfSections->sections, sIndex+1, PerfSection_t);
+			StatsPagePerfSection_t* sectionStats = &layout->perfSections[layout->numPerfSections];
+			CopyStatsPageName(&sectionStats->name[0], section->name);
+			sectionStats->timeMs = GetPerfTimeDiff(&section->time, &nextSection->time);
+			layout->totalPerfSectionsTimeMs += sectionStats->timeMs;
+			layout->numPerfSections++;
+		}
+	}
+	
+	ThreadingWriteBarrier();
+	layout->sequence++; //even again
+}
+
+// +--------------------------------------------------------------+
+// |                            Reader                            |
+// +--------------------------------------------------------------+
+//Returns false if we couldn't get a copy that wasn't being written to after maxRetries tries (the writer is publishing constantly or has crashed mid-publish)
+bool ReadStatsPage(const StatsPage_t* page, StatsPageLayout_t* layoutOut, u64 maxRetries = STATS_PAGE_DEFAULT_MAX_RETRIES)
+{
+	NotNull2(page, layoutOut);
+	Assert(page->isOpen);
+	const StatsPageLayout_t* layout = page->layout;
+	for (u64 attempt = 0; attempt <= maxRetries; attempt++)
+	{
+		u64 sequenceBefore = layout->sequence;
+		ThreadingReadBarrier();
+		if ((sequenceBefore % 2) != 0) { continue; }
+		MyMemCopy(layoutOut, (const void*)layout, sizeof(StatsPageLayout_t));
+		ThreadingReadBarrier();
+		if (layout->sequence == sequenceBefore)
+		{
+			if (layoutOut->numArenas > STATS_PAGE_MAX_ARENAS) { layoutOut->numArenas = STATS_PAGE_MAX_ARENAS; }
+			if (layoutOut->numPerfSections > STATS_PAGE_MAX_PERF_SECTIONS) { layoutOut->numPerfSections = STATS_PAGE_MAX_PERF_SECTIONS; }
+			return true;
+		}
+	}
+	return false;
+}
+
+void PrintStatsPageLayout(const StatsPageLayout_t* layout)
+{
+	NotNull(layout);
+	GyLibPrintLine_I("Process %llu (publish %llu): %llu warning%s, %llu error%s", layout->processId, layout->publishCount, layout->numLogWarnings, Plural(layout->numLogWarnings, "s"), layout->numLogErrors, Plural(layout->numLogErrors, "s"));
+	for (u64 aIndex = 0; aIndex < layout->numArenas && aIndex < STATS_PAGE_MAX_ARENAS; aIndex++)
+	{
+		const StatsPageArena_t* arena = &layout->arenas[aIndex];
+		GyLibPrintLine_I("\t%s (%s): %llu/%llu used (high %llu), %llu allocation%s, %llu page%s",
+			arena->name, GetMemArenaTypeStr((MemArenaType_t)arena->type),
+			arena->used, arena->size, arena->highUsedMark,
+			arena->numAllocations, Plural(arena->numAllocations, "s"),
+			arena->numPages, Plural(arena->numPages, "s")
+		);
+	}
+	if (layout->numPerfSections > 0)
+	{
+		GyLibPrintLine_I("\tPerf sections took %.1lfms total:", layout->totalPerfSectionsTimeMs);
+		for (u64 sIndex = 0; sIndex < layout->numPerfSections && sIndex < STATS_PAGE_MAX_PERF_SECTIONS; sIndex++)
+		{
+			GyLibPrintLine_I("\t\t%s: %.1lfms", layout->perfSections[sIndex].name, layout->perfSections[sIndex].timeMs);
+		}
+	}
+}
+
+#endif //GYLIB_HEADER_ONLY
+
+#endif //  _GY_STATS_PAGE_H
+
+// +--------------------------------------------------------------+
+// |                   Autocomplete Dictionary                    |
+// +--------------------------------------------------------------+
+/*
+@Defines
+STATS_PAGE_SUPPORTED
+STATS_PAGE_MAGIC
+STATS_PAGE_VERSION
+STATS_PAGE_MAX_ARENAS
+STATS_PAGE_MAX_PERF_SECTIONS
+STATS_PAGE_NAME_MAX_LENGTH
+STATS_PAGE_SEGMENT_NAME_LENGTH
+STATS_PAGE_DEFAULT_MAX_RETRIES
+@Types
+StatsPageArena_t
+StatsPagePerfSection_t
+StatsPageLayout_t
+StatsPage_t
+@Functions
+void CopyStatsPageName(char* destBuffer, const char* name)
+bool MapStatsPage(StatsPage_t* page, const char* name, bool create)
+void FreeStatsPage(StatsPage_t* page)
+bool CreateStatsPage(StatsPage_t* pageOut, const char* name)
+bool OpenStatsPage(StatsPage_t* pageOut, const char* name)
+bool AddStatsPageArena(StatsPage_t* page, MemArena_t* arena, const char* name)
+void SetStatsPageProcessLog(StatsPage_t* page, const ProcessLog_t* log)
+void PublishStatsPage(StatsPage_t* page, const PerfSectionBundle_t* perfSections = nullptr)
+bool ReadStatsPage(const StatsPage_t* page, StatsPageLayout_t* layoutOut, u64 maxRetries = STATS_PAGE_DEFAULT_MAX_RETRIES)
+void PrintStatsPageLayout(const StatsPageLayout_t* layout)
+*/
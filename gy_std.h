@@ -40,6 +40,13 @@ Date:   09\14\2021
 #include <signal.h>
 #include <unistd.h> //needed for getpagesize
 #include <sys/mman.h> //needed for mmap
+#include <sys/stat.h> //needed for fstat
+#include <fcntl.h> //needed for open
+#include <time.h> //needed for clock_gettime
+#if GYLIB_PERF_TIME_TSC_ENABLED && (defined(__x86_64__) || defined(__i386__))
+#include <x86intrin.h> //needed for __rdtsc
+#include <cpuid.h> //needed for __get_cpuid
+#endif
 #elif WASM_COMPILATION
 #include <intrin.h>
 #elif PLAYDATE_COMPILATION
@@ -51,6 +58,18 @@ Date:   09\14\2021
 #error Unsupported platform in gy_std.h
 #endif
 
+//NOTE: Define GYLIB_SSE2_AVAILABLE to 0 before including to force the scalar paths
+#ifndef GYLIB_SSE2_AVAILABLE
+#if (WINDOWS_COMPILATION || LINUX_COMPILATION || OSX_COMPILATION) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define GYLIB_SSE2_AVAILABLE 1
+#else
+#define GYLIB_SSE2_AVAILABLE 0
+#endif
+#endif
+#if GYLIB_SSE2_AVAILABLE
+#include <emmintrin.h> //needed for _mm_cmpeq_epi8 and _mm_movemask_epi8
+#endif
+
 // +--------------------------------------------------------------+
 // |                      Playdate Reroutes                       |
 // +--------------------------------------------------------------+
@@ -263,6 +282,7 @@ float ratof(char* arr)
 // +--------------------------------------------------------------+
 /*
 @Defines
+GYLIB_SSE2_AVAILABLE
 @Types
 @Functions
 #define MyMalloc(numBytes)
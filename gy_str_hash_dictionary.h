@@ -4,18 +4,37 @@ Author: Taylor Robbins
 Date:   07\29\2022
 Description:
 	** Holds the StrHashDict_t type and all the related functions for it
+	** The table is laid out like a SwissTable: a separate array of control bytes (one per slot)
+	** sits in front of a dense array of slots (u64 hash header + item). Each control byte is either
+	** EMPTY, DELETED, or the low 7 bits of the hash (H2) for a full slot. Lookups start at
+	** the slot chosen by the upper bits of the hash (H1) and check a whole group of 16 control bytes
+	** at a time (one SSE2 compare when available) so we rarely touch a slot that doesn't match.
+	** NOTE: Like before, items are identified only by the FNV hash of their key. The key itself is not stored
+	** With SetStrHashDictIncrementalResize a resize doesn't move every item at once. The old table stays
+	** alive next to the new one and each Add/Remove migrates a few slots (StrHashDictMigrate can be called
+	** to move more, like once a frame). Lookups and iteration check both tables until the migration is done.
 */
 
 #ifndef _GY_STR_HASH_DICTIONARY_H
 #define _GY_STR_HASH_DICTIONARY_H
 
-#define GY_STR_HASH_DICTIONARY_DEFEAULT_INITIAL_SIZE    32
+#define GY_STR_HASH_DICTIONARY_DEFEAULT_INITIAL_SIZE    32 //must be a power of two
+#define GY_STR_HASH_DICTIONARY_GROUP_WIDTH              16
+#define GY_STR_HASH_DICTIONARY_MAX_LOAD_NUM             7 //grow when the table would be more than 7/8 full (counting DELETED slots)
+#define GY_STR_HASH_DICTIONARY_MAX_LOAD_DENOM           8
+#define GY_STR_HASH_DICTIONARY_DEFAULT_MIGRATE_SLOTS    64 //how many old slots each Add/Remove migrates during an incremental resize
+#define GY_STR_HASH_DICTIONARY_BATCH_SIZE               16 //how many keys StrHashDictGetBatch hashes and prefetches before resolving them
+
+#define GY_STR_HASH_DICTIONARY_CTRL_EMPTY      0x80 //0b10000000
+#define GY_STR_HASH_DICTIONARY_CTRL_DELETED    0xFE //0b11111110
+//full slots have a control byte of 0b0xxxxxxx where x is the H2 of the hash
 
 #include "gy_defines_check.h"
 #include "gy_std.h"
 #include "gy_basic_macros.h"
 #include "gy_types.h"
 #include "gy_assert.h"
+#include "gy_intrinsics.h"
 #include "gy_memory.h"
 #include "gy_hash.h"
 #include "gy_string.h"
@@ -32,10 +51,22 @@ struct StrHashDict_t
 {
 	MemArena_t* allocArena;
 	u64 numItems;
+	u64 numDeleted;
 	u64 itemSize;
 	
-	u64 numItemsAlloc;
-	void* base;
+	u64 numItemsAlloc; //always a power of two
+	u8* ctrl; //numItemsAlloc + GROUP_WIDTH bytes, the last GROUP_WIDTH bytes mirror the first ones so groups can be loaded past the end
+	void* base; //numItemsAlloc slots, each is a StrHashDictItem_t followed by itemSize bytes
+	
+	bool incrementalResize;
+	u64 migrateSlotsPerOp;
+	//When oldCtrl is not nullptr we are in the middle of an incremental resize.
+	//numItems counts the items in both tables, oldNumItems is how many are still in the old table
+	u64 migrateIndex;
+	u64 oldNumItems;
+	u64 oldNumItemsAlloc;
+	u8* oldCtrl;
+	void* oldBase;
 };
 
 struct StrHashDictIter_t
@@ -75,14 +106,37 @@ struct StrHashDictIter_t
 #define StrHashDictGet(dict, key, type)      StrHashDictGetHard(dict, key, type)
 #define StrHashDictContains(dict, key, type) (StrHashDictGet_((dict), (key), sizeof(type), false) != nullptr)
 #define StrHashDictContainsEmpty(dict, key)  (StrHashDictGet_((dict), (key), 0, false) != nullptr)
+#define StrHashDictGetBatch(dict, numKeys, keys, resultsOut, type) StrHashDictGetBatch_((dict), (numKeys), (keys), sizeof(type), (void**)(resultsOut))
+
+#define StrHashDictH1(hash) ((hash) >> 7)
+#define StrHashDictH2(hash) ((u8)((hash) & 0x7F))
+#define IsStrHashDictCtrlFull(ctrlByte) (((ctrlByte) & 0x80) == 0)
+#define IsStrHashDictResizing(dict) ((dict)->oldCtrl != nullptr)
 
 // +--------------------------------------------------------------+
 // |                         Header Only                          |
 // +--------------------------------------------------------------+
 #ifdef GYLIB_HEADER_ONLY
+	u64 GetStrHashDictCtrlSize(u64 numItemsAlloc);
+	u64 GetStrHashDictAllocSize(u64 numItemsAlloc, u64 itemSize);
+	u64 GetStrHashDictNumItemsAllocFor(u64 numItems);
 	void FreeStrHashDict(StrHashDict_t* dict);
 	void CreateStrHashDict(StrHashDict_t* dict, MemArena_t* memArena, u64 itemSize, u64 initialRequiredCapacity = 0);
+	u32 StrHashDictGroupMatch(const u8* groupCtrl, u8 value);
+	u32 StrHashDictGroupMatchEmpty(const u8* groupCtrl);
+	u32 StrHashDictGroupMatchEmptyOrDeleted(const u8* groupCtrl);
+	StrHashDictItem_t* GetStrHashDictSlot(const StrHashDict_t* dict, u64 slotIndex);
+	void SetStrHashDictCtrl(StrHashDict_t* dict, u64 slotIndex, u8 value);
+	u64 FindStrHashDictSlot(const StrHashDict_t* dict, u64 hash);
+	u64 FindStrHashDictFreeSlot(const StrHashDict_t* dict, u64 hash);
+	void StrHashDictRehash(StrHashDict_t* dict, u64 newNumItemsAlloc);
+	StrHashDict_t GetStrHashDictOldTable(const StrHashDict_t* dict);
+	void StrHashDictFreeOldTable(StrHashDict_t* dict);
+	bool StrHashDictMigrate(StrHashDict_t* dict, u64 numSlots);
+	void StrHashDictBeginResize(StrHashDict_t* dict, u64 newNumItemsAlloc);
+	void SetStrHashDictIncrementalResize(StrHashDict_t* dict, bool enabled, u64 migrateSlotsPerOp = GY_STR_HASH_DICTIONARY_DEFAULT_MIGRATE_SLOTS);
 	bool StrHashExpand(StrHashDict_t* dict, u64 numItemsRequired);
+	StrHashDictItem_t* FindStrHashDictItem(const StrHashDict_t* dict, u64 hash);
 	StrHashDictIter_t StrHashDictGetIter_(const StrHashDict_t* dict, u64 itemSize);
 	bool StrHashDictIter_(StrHashDictIter_t* iter, u64 itemSize, void** itemPntrOut);
 	void* StrHashDictAdd_(StrHashDict_t* dict, MyStr_t key, u64 itemSize, bool assertOnDuplicate, bool* isNewEntryOut = nullptr);
@@ -93,19 +147,42 @@ struct StrHashDictIter_t
 	void* StrHashDictGet_(StrHashDict_t* dict, const char* nullTermStr, u64 itemSize, bool assertOnFailure);
 	const void* StrHashDictGet_(const StrHashDict_t* dict, MyStr_t key, u64 itemSize, bool assertOnFailure);
 	const void* StrHashDictGet_(const StrHashDict_t* dict, const char* nullTermStr, u64 itemSize, bool assertOnFailure);
+	u64 StrHashDictGetBatch_(const StrHashDict_t* dict, u64 numKeys, const MyStr_t* keys, u64 itemSize, void** resultsOut);
 #else
 
 // +--------------------------------------------------------------+
 // |                       Create and Free                        |
 // +--------------------------------------------------------------+
+//The control bytes and slots live in one allocation. We round the control bytes up so the slots stay 8 byte aligned
+u64 GetStrHashDictCtrlSize(u64 numItemsAlloc)
+{
+	return ((numItemsAlloc + GY_STR_HASH_DICTIONARY_GROUP_WIDTH + 7) & ~(u64)7);
+}
+u64 GetStrHashDictAllocSize(u64 numItemsAlloc, u64 itemSize)
+{
+	return GetStrHashDictCtrlSize(numItemsAlloc) + (numItemsAlloc * (sizeof(StrHashDictItem_t) + itemSize));
+}
+
+//The smallest power of two number of slots that can hold numItems without going over the max load
+u64 GetStrHashDictNumItemsAllocFor(u64 numItems)
+{
+	u64 result = GY_STR_HASH_DICTIONARY_GROUP_WIDTH;
+	while (numItems * GY_STR_HASH_DICTIONARY_MAX_LOAD_DENOM > result * GY_STR_HASH_DICTIONARY_MAX_LOAD_NUM) { result *= 2; }
+	return result;
+}
+
 void FreeStrHashDict(StrHashDict_t* dict)
 {
 	NotNull(dict);
-	if (dict->base != nullptr)
+	if (dict->ctrl != nullptr)
+	{
+		NotNull(dict->allocArena);
+		FreeMem(dict->allocArena, dict->ctrl, GetStrHashDictAllocSize(dict->numItemsAlloc, dict->itemSize));
+	}
+	if (dict->oldCtrl != nullptr)
 	{
 		NotNull(dict->allocArena);
-		u64 itemAndHeaderSize = sizeof(StrHashDictItem_t) + dict->itemSize;
-		FreeMem(dict->allocArena, dict->base, dict->numItemsAlloc * itemAndHeaderSize);
+		FreeMem(dict->allocArena, dict->oldCtrl, GetStrHashDictAllocSize(dict->oldNumItemsAlloc, dict->itemSize));
 	}
 	ClearPointer(dict);
 }
@@ -119,69 +196,270 @@ void CreateStrHashDict(StrHashDict_t* dict, MemArena_t* memArena, u64 itemSize,
 	dict->allocArena = memArena;
 	dict->itemSize = itemSize;
 	dict->numItems = 0;
-	u64 itemAndHeaderSize = sizeof(StrHashDictItem_t) + itemSize;
+	dict->numDeleted = 0;
 	
-	dict->numItemsAlloc = initialRequiredCapacity*2;
-	if (dict->numItemsAlloc == 0) { dict->numItemsAlloc = GY_STR_HASH_DICTIONARY_DEFEAULT_INITIAL_SIZE; }
+	dict->numItemsAlloc = GetStrHashDictNumItemsAllocFor(initialRequiredCapacity);
+	if (dict->numItemsAlloc < GY_STR_HASH_DICTIONARY_DEFEAULT_INITIAL_SIZE) { dict->numItemsAlloc = GY_STR_HASH_DICTIONARY_DEFEAULT_INITIAL_SIZE; }
 	
-	if (dict->numItemsAlloc > 0)
-	{
-		dict->base = AllocMem(memArena, dict->numItemsAlloc * itemAndHeaderSize);
-		Assert(dict->base != nullptr);
-		MyMemSet(dict->base, 0x00, dict->numItemsAlloc * itemAndHeaderSize);
-	}
-	else { dict->base = nullptr; }
+	u64 allocSize = GetStrHashDictAllocSize(dict->numItemsAlloc, itemSize);
+	dict->ctrl = (u8*)AllocMem(memArena, allocSize);
+	Assert(dict->ctrl != nullptr);
+	MyMemSet(dict->ctrl, GY_STR_HASH_DICTIONARY_CTRL_EMPTY, GetStrHashDictCtrlSize(dict->numItemsAlloc));
+	dict->base = (void*)(dict->ctrl + GetStrHashDictCtrlSize(dict->numItemsAlloc));
+	//NOTE: The slots don't need to be cleared, only slots marked full in ctrl are ever read and Add clears each slot before handing it out
 }
 
 // +--------------------------------------------------------------+
 // |                       Helper Functions                       |
 // +--------------------------------------------------------------+
+//Returns a bitmask where bit i is set if groupCtrl[i] == value
+u32 StrHashDictGroupMatch(const u8* groupCtrl, u8 value)
+{
+	#if GYLIB_SSE2_AVAILABLE
+	__m128i group = _mm_loadu_si128((const __m128i*)groupCtrl);
+	return (u32)_mm_movemask_epi8(_mm_cmpeq_epi8(group, _mm_set1_epi8((char)value)));
+	#else
+	u32 result = 0;
+	for (u32 bIndex = 0; bIndex < GY_STR_HASH_DICTIONARY_GROUP_WIDTH; bIndex++)
+	{
+		if (groupCtrl[bIndex] == value) { result |= (1UL << bIndex); }
+	}
+	return result;
+	#endif
+}
+u32 StrHashDictGroupMatchEmpty(const u8* groupCtrl)
+{
+	return StrHashDictGroupMatch(groupCtrl, GY_STR_HASH_DICTIONARY_CTRL_EMPTY);
+}
+//EMPTY and DELETED are the only control bytes with the high bit set
+u32 StrHashDictGroupMatchEmptyOrDeleted(const u8* groupCtrl)
+{
+	#if GYLIB_SSE2_AVAILABLE
+	return (u32)_mm_movemask_epi8(_mm_loadu_si128((const __m128i*)groupCtrl));
+	#else
+	u32 result = 0;
+	for (u32 bIndex = 0; bIndex < GY_STR_HASH_DICTIONARY_GROUP_WIDTH; bIndex++)
+	{
+		if (!IsStrHashDictCtrlFull(groupCtrl[bIndex])) { result |= (1UL << bIndex); }
+	}
+	return result;
+	#endif
+}
+
+StrHashDictItem_t* GetStrHashDictSlot(const StrHashDict_t* dict, u64 slotIndex)
+{
+	DebugAssert(slotIndex < dict->numItemsAlloc);
+	return (StrHashDictItem_t*)((u8*)dict->base + (slotIndex * (sizeof(StrHashDictItem_t) + dict->itemSize)));
+}
+
+//Also writes the mirrored copy at the end of the control bytes
+void SetStrHashDictCtrl(StrHashDict_t* dict, u64 slotIndex, u8 value)
+{
+	DebugAssert(slotIndex < dict->numItemsAlloc);
+	dict->ctrl[slotIndex] = value;
+	if (slotIndex < GY_STR_HASH_DICTIONARY_GROUP_WIDTH) { dict->ctrl[dict->numItemsAlloc + slotIndex] = value; }
+}
+
+//Probes group by group (triangular steps, which visit every group when numItemsAlloc is a power of two)
+//Returns numItemsAlloc if the hash is not in the table
+u64 FindStrHashDictSlot(const StrHashDict_t* dict, u64 hash)
+{
+	if (dict->ctrl == nullptr || dict->numItems == 0) { return dict->numItemsAlloc; }
+	u64 mask = dict->numItemsAlloc - 1;
+	u8 h2 = StrHashDictH2(hash);
+	u64 groupIndex = (StrHashDictH1(hash) & mask);
+	for (u64 step = GY_STR_HASH_DICTIONARY_GROUP_WIDTH; step <= dict->numItemsAlloc; step += GY_STR_HASH_DICTIONARY_GROUP_WIDTH)
+	{
+		const u8* groupCtrl = &dict->ctrl[groupIndex];
+		u32 matches = StrHashDictGroupMatch(groupCtrl, h2);
+		while (matches != 0)
+		{
+			u64 slotIndex = ((groupIndex + FindLsbIndexU32(matches)) & mask);
+			if (GetStrHashDictSlot(dict, slotIndex)->hash == hash) { return slotIndex; }
+			matches &= (matches - 1);
+		}
+		if (StrHashDictGroupMatchEmpty(groupCtrl) != 0) { break; }
+		groupIndex = ((groupIndex + step) & mask);
+	}
+	return dict->numItemsAlloc;
+}
+
+//Returns the first EMPTY or DELETED slot along the probe sequence for this hash. Doesn't check if the hash is already in the table
+u64 FindStrHashDictFreeSlot(const StrHashDict_t* dict, u64 hash)
+{
+	NotNull(dict->ctrl);
+	u64 mask = dict->numItemsAlloc - 1;
+	u64 groupIndex = (StrHashDictH1(hash) & mask);
+	for (u64 step = GY_STR_HASH_DICTIONARY_GROUP_WIDTH; step <= dict->numItemsAlloc; step += GY_STR_HASH_DICTIONARY_GROUP_WIDTH)
+	{
+		u32 freeSlots = StrHashDictGroupMatchEmptyOrDeleted(&dict->ctrl[groupIndex]);
+		if (freeSlots != 0) { return ((groupIndex + FindLsbIndexU32(freeSlots)) & mask); }
+		groupIndex = ((groupIndex + step) & mask);
+	}
+	AssertMsg(false, "StrHashDict has no free slots! This shouldn't happen because of the max load");
+	return dict->numItemsAlloc;
+}
+
+//Moves every item into a freshly allocated table with newNumItemsAlloc slots. This also clears out all DELETED slots
+void StrHashDictRehash(StrHashDict_t* dict, u64 newNumItemsAlloc)
+{
+	NotNull2(dict, dict->allocArena);
+	Assert(!IsStrHashDictResizing(dict));
+	Assert(newNumItemsAlloc >= GY_STR_HASH_DICTIONARY_GROUP_WIDTH && (newNumItemsAlloc & (newNumItemsAlloc - 1)) == 0);
+	Assert(dict->numItems * GY_STR_HASH_DICTIONARY_MAX_LOAD_DENOM <= newNumItemsAlloc * GY_STR_HASH_DICTIONARY_MAX_LOAD_NUM);
+	
+	StrHashDict_t oldDict = *dict;
+	u64 itemAndHeaderSize = sizeof(StrHashDictItem_t) + dict->itemSize;
+	u64 newCtrlSize = GetStrHashDictCtrlSize(newNumItemsAlloc);
+	u64 newAllocSize = GetStrHashDictAllocSize(newNumItemsAlloc, dict->itemSize);
+	dict->ctrl = (u8*)AllocMem(dict->allocArena, newAllocSize);
+	NotNull(dict->ctrl);
+	MyMemSet(dict->ctrl, GY_STR_HASH_DICTIONARY_CTRL_EMPTY, newCtrlSize);
+	dict->base = (void*)(dict->ctrl + newCtrlSize);
+	dict->numItemsAlloc = newNumItemsAlloc;
+	dict->numDeleted = 0;
+	
+	for (u64 sIndex = 0; sIndex < oldDict.numItemsAlloc; sIndex++)
+	{
+		if (IsStrHashDictCtrlFull(oldDict.ctrl[sIndex]))
+		{
+			StrHashDictItem_t* oldSlot = GetStrHashDictSlot(&oldDict, sIndex);
+			u64 newSlotIndex = FindStrHashDictFreeSlot(dict, oldSlot->hash);
+			SetStrHashDictCtrl(dict, newSlotIndex, oldDict.ctrl[sIndex]);
+			MyMemCopy(GetStrHashDictSlot(dict, newSlotIndex), oldSlot, itemAndHeaderSize);
+		}
+	}
+	
+	if (oldDict.ctrl != nullptr) { FreeMem(dict->allocArena, oldDict.ctrl, GetStrHashDictAllocSize(oldDict.numItemsAlloc, oldDict.itemSize)); }
+}
+
+//Returns a copy of dict that points at the old table so the normal helpers can be used on it.
+//Writes to the control bytes or slots through this copy still land in the old table
+StrHashDict_t GetStrHashDictOldTable(const StrHashDict_t* dict)
+{
+	NotNull(dict);
+	StrHashDict_t result = {};
+	result.allocArena = dict->allocArena;
+	result.itemSize = dict->itemSize;
+	result.numItems = dict->oldNumItems;
+	result.numItemsAlloc = dict->oldNumItemsAlloc;
+	result.ctrl = dict->oldCtrl;
+	result.base = dict->oldBase;
+	return result;
+}
+
+void StrHashDictFreeOldTable(StrHashDict_t* dict)
+{
+	NotNull2(dict, dict->allocArena);
+	if (dict->oldCtrl == nullptr) { return; }
+	Assert(dict->oldNumItems == 0);
+	FreeMem(dict->allocArena, dict->oldCtrl, GetStrHashDictAllocSize(dict->oldNumItemsAlloc, dict->itemSize));
+	dict->migrateIndex = 0;
+	dict->oldNumItems = 0;
+	dict->oldNumItemsAlloc = 0;
+	dict->oldCtrl = nullptr;
+	dict->oldBase = nullptr;
+}
+
+//Moves up to numSlots slots of the old table into the new one. Returns true if there is still more to migrate
+bool StrHashDictMigrate(StrHashDict_t* dict, u64 numSlots)
+{
+	NotNull(dict);
+	if (!IsStrHashDictResizing(dict)) { return false; }
+	
+	StrHashDict_t oldTable = GetStrHashDictOldTable(dict);
+	u64 itemAndHeaderSize = sizeof(StrHashDictItem_t) + dict->itemSize;
+	u64 endIndex = dict->migrateIndex + numSlots;
+	if (endIndex > dict->oldNumItemsAlloc || endIndex < dict->migrateIndex) { endIndex = dict->oldNumItemsAlloc; }
+	for (; dict->migrateIndex < endIndex && dict->oldNumItems > 0; dict->migrateIndex++)
+	{
+		u8 ctrlByte = oldTable.ctrl[dict->migrateIndex];
+		if (IsStrHashDictCtrlFull(ctrlByte))
+		{
+			StrHashDictItem_t* oldSlot = GetStrHashDictSlot(&oldTable, dict->migrateIndex);
+			u64 newSlotIndex = FindStrHashDictFreeSlot(dict, oldSlot->hash);
+			if (dict->ctrl[newSlotIndex] == GY_STR_HASH_DICTIONARY_CTRL_DELETED) { Assert(dict->numDeleted > 0); dict->numDeleted--; }
+			SetStrHashDictCtrl(dict, newSlotIndex, ctrlByte);
+			MyMemCopy(GetStrHashDictSlot(dict, newSlotIndex), oldSlot, itemAndHeaderSize);
+			//Leave a DELETED marker so lookups in the old table still probe past this slot
+			SetStrHashDictCtrl(&oldTable, dict->migrateIndex, GY_STR_HASH_DICTIONARY_CTRL_DELETED);
+			dict->oldNumItems--;
+		}
+	}
+	
+	if (dict->migrateIndex >= dict->oldNumItemsAlloc || dict->oldNumItems == 0) { StrHashDictFreeOldTable(dict); }
+	return IsStrHashDictResizing(dict);
+}
+
+//Allocates a new table and keeps the current one around as the old table. Items get moved over by StrHashDictMigrate
+void StrHashDictBeginResize(StrHashDict_t* dict, u64 newNumItemsAlloc)
+{
+	NotNull2(dict, dict->allocArena);
+	Assert(!IsStrHashDictResizing(dict));
+	Assert(newNumItemsAlloc >= GY_STR_HASH_DICTIONARY_GROUP_WIDTH && (newNumItemsAlloc & (newNumItemsAlloc - 1)) == 0);
+	Assert(dict->numItems * GY_STR_HASH_DICTIONARY_MAX_LOAD_DENOM <= newNumItemsAlloc * GY_STR_HASH_DICTIONARY_MAX_LOAD_NUM);
+	
+	dict->migrateIndex = 0;
+	dict->oldNumItems = dict->numItems;
+	dict->oldNumItemsAlloc = dict->numItemsAlloc;
+	dict->oldCtrl = dict->ctrl;
+	dict->oldBase = dict->base;
+	
+	u64 newCtrlSize = GetStrHashDictCtrlSize(newNumItemsAlloc);
+	u64 newAllocSize = GetStrHashDictAllocSize(newNumItemsAlloc, dict->itemSize);
+	dict->ctrl = (u8*)AllocMem(dict->allocArena, newAllocSize);
+	NotNull(dict->ctrl);
+	MyMemSet(dict->ctrl, GY_STR_HASH_DICTIONARY_CTRL_EMPTY, newCtrlSize);
+	dict->base = (void*)(dict->ctrl + newCtrlSize);
+	dict->numItemsAlloc = newNumItemsAlloc;
+	dict->numDeleted = 0;
+	
+	if (dict->oldNumItems == 0) { StrHashDictFreeOldTable(dict); }
+}
+
+//Turning incremental resizing off finishes any migration that is in progress
+void SetStrHashDictIncrementalResize(StrHashDict_t* dict, bool enabled, u64 migrateSlotsPerOp = GY_STR_HASH_DICTIONARY_DEFAULT_MIGRATE_SLOTS)
+{
+	NotNull(dict);
+	Assert(!enabled || migrateSlotsPerOp > 0);
+	dict->incrementalResize = enabled;
+	dict->migrateSlotsPerOp = migrateSlotsPerOp;
+	if (!enabled) { StrHashDictMigrate(dict, dict->oldNumItemsAlloc); }
+}
+
+//Returns true if the table was reallocated. This always does the whole resize right away (finishing any incremental resize first)
 bool StrHashExpand(StrHashDict_t* dict, u64 numItemsRequired)
 {
 	NotNull(dict);
 	NotNull(dict->allocArena);
+	StrHashDictMigrate(dict, dict->oldNumItemsAlloc);
 	
-	if (dict->numItemsAlloc < numItemsRequired*2)
+	u64 requiredNumItemsAlloc = GetStrHashDictNumItemsAllocFor(numItemsRequired);
+	if (dict->numItemsAlloc < requiredNumItemsAlloc)
 	{
-		u8* baseBytePntr = (u8*)dict->base;
-		u64 itemAndHeaderSize = sizeof(StrHashDictItem_t) + dict->itemSize;
 		u64 newNumItemsAlloc = dict->numItemsAlloc*2;
-		if (newNumItemsAlloc < numItemsRequired*2) { newNumItemsAlloc = numItemsRequired*2; }
-		
-		u8* newBase = (u8*)AllocMem(dict->allocArena, newNumItemsAlloc * itemAndHeaderSize);
-		NotNull(newBase);
-		MyMemSet(newBase, 0x00, newNumItemsAlloc * itemAndHeaderSize);
-		
-		for (u64 iIndex = 0; iIndex < dict->numItemsAlloc; iIndex++)
-		{
-			StrHashDictItem_t* item = (StrHashDictItem_t*)(baseBytePntr + (iIndex * itemAndHeaderSize));
-			if (item->hash != 0)
-			{
-				u64 newExpectedIndex = (item->hash % newNumItemsAlloc);
-				u64 offset = 0;
-				while (offset < newNumItemsAlloc)
-				{
-					StrHashDictItem_t* newSlot = (StrHashDictItem_t*)(newBase + (((newExpectedIndex + offset) % newNumItemsAlloc) * itemAndHeaderSize));
-					if (newSlot->hash == 0)
-					{
-						MyMemCopy(newSlot, item, itemAndHeaderSize);
-						break;
-					}
-					offset++;
-				}
-				Assert(offset < newNumItemsAlloc);
-			}
-		}
-		
-		if (dict->base != nullptr) { FreeMem(dict->allocArena, dict->base, dict->numItemsAlloc * itemAndHeaderSize); }
-		dict->base = (void*)newBase;
-		dict->numItemsAlloc = newNumItemsAlloc;
-		
+		if (newNumItemsAlloc < requiredNumItemsAlloc) { newNumItemsAlloc = requiredNumItemsAlloc; }
+		StrHashDictRehash(dict, newNumItemsAlloc);
 		return true;
 	}
 	else { return false; }
 }
 
+//Searches the new table and then the old one if we are in the middle of a resize. Returns nullptr if the hash isn't found
+StrHashDictItem_t* FindStrHashDictItem(const StrHashDict_t* dict, u64 hash)
+{
+	NotNull(dict);
+	u64 slotIndex = FindStrHashDictSlot(dict, hash);
+	if (slotIndex < dict->numItemsAlloc) { return GetStrHashDictSlot(dict, slotIndex); }
+	if (IsStrHashDictResizing(dict))
+	{
+		StrHashDict_t oldTable = GetStrHashDictOldTable(dict);
+		slotIndex = FindStrHashDictSlot(&oldTable, hash);
+		if (slotIndex < oldTable.numItemsAlloc) { return GetStrHashDictSlot(&oldTable, slotIndex); }
+	}
+	return nullptr;
+}
+
 StrHashDictIter_t StrHashDictGetIter_(const StrHashDict_t* dict, u64 itemSize)
 {
 	NotNull(dict);
@@ -204,27 +482,20 @@ bool StrHashDictIter_(StrHashDictIter_t* iter, u64 itemSize, void** itemPntrOut)
 	if (iter->dict->itemSize == 0) { return false; }
 	Assert(iter->dict->itemSize == itemSize);
 	
+	//slotIndex walks the new table and then the old table (if we are resizing). Migrated slots in the old table are DELETED so nothing is visited twice
 	iter->index = iter->foundIndex;
-	while (iter->slotIndex+1 < iter->dict->numItemsAlloc)
+	StrHashDict_t oldTable = GetStrHashDictOldTable(iter->dict);
+	while (iter->slotIndex < iter->dict->numItemsAlloc + oldTable.numItemsAlloc)
 	{
-		if (iter->pntr == nullptr)
-		{
-			if (iter->dict->numItemsAlloc == 0) { return false; }
-			NotNull(iter->dict->base);
-			iter->pntr = (u8*)iter->dict->base;
-			iter->slotIndex = 0;
-		}
-		else
-		{
-			iter->pntr += iter->itemAndHeaderSize;
-			iter->slotIndex++;
-		}
-		
-		StrHashDictItem_t* slotHeader = (StrHashDictItem_t*)iter->pntr;
-		if (slotHeader->hash != 0)
+		u64 slotIndex = iter->slotIndex;
+		iter->slotIndex++;
+		StrHashDict_t* table = iter->dict;
+		if (slotIndex >= iter->dict->numItemsAlloc) { table = &oldTable; slotIndex -= iter->dict->numItemsAlloc; }
+		if (IsStrHashDictCtrlFull(table->ctrl[slotIndex]))
 		{
+			iter->pntr = (u8*)GetStrHashDictSlot(table, slotIndex);
 			iter->foundIndex++;
-			*itemPntrOut = (void*)(slotHeader + 1);
+			*itemPntrOut = (void*)(((StrHashDictItem_t*)iter->pntr) + 1);
 			return true;
 		}
 	}
@@ -241,40 +512,43 @@ void* StrHashDictAdd_(StrHashDict_t* dict, MyStr_t key, u64 itemSize, bool asser
 	NotNull(dict->allocArena);
 	SetOptionalOutPntr(isNewEntryOut, false);
 	
-	StrHashExpand(dict, dict->numItems+1);
+	StrHashDictMigrate(dict, dict->migrateSlotsPerOp);
 	
 	u64 keyHash = FnvHashStr(key);
-	Assert(keyHash != 0);
-	u64 expectedIndex = (keyHash % dict->numItemsAlloc);
-	u64 itemAndHeaderSize = sizeof(StrHashDictItem_t) + dict->itemSize;
-	u8* baseBytePntr = (u8*)dict->base;
+	StrHashDictItem_t* existingItem = FindStrHashDictItem(dict, keyHash);
+	if (existingItem != nullptr)
+	{
+		AssertIfMsg(assertOnDuplicate, false, "Duplicate key added to StrHashDict!");
+		return (void*)(existingItem + 1);
+	}
 	
-	void* result = nullptr;
-	u64 offset = 0;
-	while (offset < dict->numItemsAlloc)
+	u64 numNewTableItems = dict->numItems - dict->oldNumItems;
+	bool needsToGrow = ((dict->numItems + 1) * GY_STR_HASH_DICTIONARY_MAX_LOAD_DENOM > dict->numItemsAlloc * GY_STR_HASH_DICTIONARY_MAX_LOAD_NUM);
+	bool tooManyDeleted = ((numNewTableItems + dict->numDeleted + 1) * GY_STR_HASH_DICTIONARY_MAX_LOAD_DENOM > dict->numItemsAlloc * GY_STR_HASH_DICTIONARY_MAX_LOAD_NUM);
+	if (needsToGrow || tooManyDeleted)
 	{
-		StrHashDictItem_t* newSlot = (StrHashDictItem_t*)(baseBytePntr + (((expectedIndex + offset) % dict->numItemsAlloc) * itemAndHeaderSize));
-		if (newSlot->hash == keyHash)
-		{
-			AssertIfMsg(assertOnDuplicate, false, "Duplicate key added to StrHashDict!");
-			newSlot->hash = keyHash;
-			result = (void*)(newSlot + 1);
-			SetOptionalOutPntr(isNewEntryOut, false);
-			break;
-		}
-		else if (newSlot->hash == 0)
+		StrHashDictMigrate(dict, dict->oldNumItemsAlloc); //finish any resize that is still in progress
+		if (dict->incrementalResize)
 		{
-			newSlot->hash = keyHash;
-			result = (void*)(newSlot + 1);
-			SetOptionalOutPntr(isNewEntryOut, true);
-			dict->numItems++;
-			break;
+			u64 newNumItemsAlloc = dict->numItemsAlloc;
+			if (needsToGrow) { newNumItemsAlloc = MaxU64(dict->numItemsAlloc*2, GetStrHashDictNumItemsAllocFor(dict->numItems+1)); }
+			StrHashDictBeginResize(dict, newNumItemsAlloc);
 		}
-		offset++;
+		else if (needsToGrow) { StrHashExpand(dict, dict->numItems+1); }
+		else { StrHashDictRehash(dict, dict->numItemsAlloc); } //Too many DELETED slots, rehash at the same size to get rid of them
 	}
-	Assert(result != nullptr);
 	
-	return result;
+	u64 slotIndex = FindStrHashDictFreeSlot(dict, keyHash);
+	Assert(slotIndex < dict->numItemsAlloc);
+	if (dict->ctrl[slotIndex] == GY_STR_HASH_DICTIONARY_CTRL_DELETED) { Assert(dict->numDeleted > 0); dict->numDeleted--; }
+	SetStrHashDictCtrl(dict, slotIndex, StrHashDictH2(keyHash));
+	StrHashDictItem_t* newSlot = GetStrHashDictSlot(dict, slotIndex);
+	MyMemSet(newSlot, 0x00, sizeof(StrHashDictItem_t) + dict->itemSize);
+	newSlot->hash = keyHash;
+	SetOptionalOutPntr(isNewEntryOut, true);
+	dict->numItems++;
+	
+	return (void*)(newSlot + 1);
 }
 void* StrHashDictAdd_(StrHashDict_t* dict, const char* nullTermStr, u64 itemSize, bool assertOnFailure, bool* isNewEntryOut = nullptr)
 {
@@ -290,25 +564,40 @@ bool StrHashDictRemove_(StrHashDict_t* dict, MyStr_t key, u64 itemSize, bool ass
 	Assert(dict->itemSize == itemSize);
 	NotNull(dict->allocArena);
 	
-	u64 keyHash = FnvHashStr(key);
-	Assert(keyHash != 0);
-	u64 expectedIndex = (keyHash % dict->numItemsAlloc);
-	u64 itemAndHeaderSize = sizeof(StrHashDictItem_t) + dict->itemSize;
-	u8* baseBytePntr = (u8*)dict->base;
+	StrHashDictMigrate(dict, dict->migrateSlotsPerOp);
 	
-	bool result = false;
-	u64 offset = 0;
-	while (offset < dict->numItemsAlloc)
+	u64 keyHash = FnvHashStr(key);
+	u64 slotIndex = FindStrHashDictSlot(dict, keyHash);
+	bool result = (slotIndex < dict->numItemsAlloc);
+	if (!result && IsStrHashDictResizing(dict))
 	{
-		StrHashDictItem_t* newSlot = (StrHashDictItem_t*)(baseBytePntr + (((expectedIndex + offset) % dict->numItemsAlloc) * itemAndHeaderSize));
-		if (newSlot->hash == keyHash)
+		//The old table is going away so we don't bother checking for EMPTY neighbors, just mark it DELETED
+		StrHashDict_t oldTable = GetStrHashDictOldTable(dict);
+		u64 oldSlotIndex = FindStrHashDictSlot(&oldTable, keyHash);
+		if (oldSlotIndex < oldTable.numItemsAlloc)
 		{
-			newSlot->hash = 0;
+			SetStrHashDictCtrl(&oldTable, oldSlotIndex, GY_STR_HASH_DICTIONARY_CTRL_DELETED);
+			GetStrHashDictSlot(&oldTable, oldSlotIndex)->hash = 0;
+			dict->oldNumItems--;
 			dict->numItems--;
+			if (dict->oldNumItems == 0) { StrHashDictFreeOldTable(dict); }
 			result = true;
-			break;
 		}
-		offset++;
+	}
+	else if (result)
+	{
+		//If there is an EMPTY slot within one group width on both sides then no probe sequence
+		//could have passed over this slot while looking at a full group, so we can mark it EMPTY instead of DELETED
+		u64 mask = dict->numItemsAlloc - 1;
+		u32 emptyBefore = StrHashDictGroupMatchEmpty(&dict->ctrl[(slotIndex - GY_STR_HASH_DICTIONARY_GROUP_WIDTH) & mask]);
+		u32 emptyAfter = StrHashDictGroupMatchEmpty(&dict->ctrl[slotIndex]);
+		bool wasNeverFull = (emptyBefore != 0 && emptyAfter != 0 &&
+			((GY_STR_HASH_DICTIONARY_GROUP_WIDTH-1 - FindMsbIndexU32(emptyBefore)) + FindLsbIndexU32(emptyAfter)) < GY_STR_HASH_DICTIONARY_GROUP_WIDTH
+		);
+		if (wasNeverFull) { SetStrHashDictCtrl(dict, slotIndex, GY_STR_HASH_DICTIONARY_CTRL_EMPTY); }
+		else { SetStrHashDictCtrl(dict, slotIndex, GY_STR_HASH_DICTIONARY_CTRL_DELETED); dict->numDeleted++; }
+		GetStrHashDictSlot(dict, slotIndex)->hash = 0;
+		dict->numItems--;
 	}
 	
 	AssertIf(assertOnFailure, result);
@@ -329,23 +618,8 @@ void* StrHashDictGet_(StrHashDict_t* dict, MyStr_t key, u64 itemSize, bool asser
 	NotNull(dict->allocArena);
 	
 	u64 keyHash = FnvHashStr(key);
-	Assert(keyHash != 0);
-	u64 expectedIndex = (keyHash % dict->numItemsAlloc);
-	u64 itemAndHeaderSize = sizeof(StrHashDictItem_t) + dict->itemSize;
-	u8* baseBytePntr = (u8*)dict->base;
-	
-	void* result = nullptr;
-	u64 offset = 0;
-	while (offset < dict->numItemsAlloc)
-	{
-		StrHashDictItem_t* itemPntr = (StrHashDictItem_t*)(baseBytePntr + (((expectedIndex + offset) % dict->numItemsAlloc) * itemAndHeaderSize));
-		if (itemPntr->hash == keyHash)
-		{
-			result = (void*)(itemPntr + 1);
-			break;
-		}
-		offset++;
-	}
+	StrHashDictItem_t* item = FindStrHashDictItem(dict, keyHash);
+	void* result = (item != nullptr) ? (void*)(item + 1) : nullptr;
 	AssertIfMsg(assertOnFailure, result != nullptr, "Key not found in StrHashDict!");
 	
 	return result;
@@ -363,6 +637,41 @@ const void* StrHashDictGet_(const StrHashDict_t* dict, const char* nullTermStr,
 	return (const void*)StrHashDictGet_((StrHashDict_t*)dict, nullTermStr, itemSize, assertOnFailure);
 }
 
+//Looks up numKeys keys at once, filling resultsOut[i] with the item for keys[i] (or nullptr). Returns how many were found.
+//Keys are handled in groups of GY_STR_HASH_DICTIONARY_BATCH_SIZE: we hash the whole group and prefetch each key's home group
+//and slot first, then resolve the probes once those cache lines are (hopefully) on their way, instead of stalling on one miss at a time
+u64 StrHashDictGetBatch_(const StrHashDict_t* dict, u64 numKeys, const MyStr_t* keys, u64 itemSize, void** resultsOut)
+{
+	NotNull(dict);
+	Assert(dict->itemSize == itemSize);
+	Assert(numKeys == 0 || (keys != nullptr && resultsOut != nullptr));
+	
+	u64 numFound = 0;
+	u64 keyHashes[GY_STR_HASH_DICTIONARY_BATCH_SIZE];
+	for (u64 batchStart = 0; batchStart < numKeys; batchStart += GY_STR_HASH_DICTIONARY_BATCH_SIZE)
+	{
+		u64 batchSize = MinU64(GY_STR_HASH_DICTIONARY_BATCH_SIZE, numKeys - batchStart);
+		for (u64 kIndex = 0; kIndex < batchSize; kIndex++)
+		{
+			keyHashes[kIndex] = FnvHashStr(keys[batchStart + kIndex]);
+			if (dict->ctrl != nullptr)
+			{
+				u64 homeIndex = (StrHashDictH1(keyHashes[kIndex]) & (dict->numItemsAlloc - 1));
+				PrefetchForRead(&dict->ctrl[homeIndex]);
+				PrefetchForRead(GetStrHashDictSlot(dict, homeIndex));
+			}
+		}
+		for (u64 kIndex = 0; kIndex < batchSize; kIndex++)
+		{
+			StrHashDictItem_t* item = FindStrHashDictItem(dict, keyHashes[kIndex]);
+			resultsOut[batchStart + kIndex] = (item != nullptr) ? (void*)(item + 1) : nullptr;
+			if (item != nullptr) { numFound++; }
+		}
+	}
+	
+	return numFound;
+}
+
 #endif //GYLIB_HEADER_ONLY
 
 #endif //  _GY_STR_HASH_DICTIONARY_H
@@ -372,14 +681,43 @@ const void* StrHashDictGet_(const StrHashDict_t* dict, const char* nullTermStr,
 // +--------------------------------------------------------------+
 /*
 @Defines
+GY_STR_HASH_DICTIONARY_DEFEAULT_INITIAL_SIZE
+GY_STR_HASH_DICTIONARY_GROUP_WIDTH
+GY_STR_HASH_DICTIONARY_MAX_LOAD_NUM
+GY_STR_HASH_DICTIONARY_MAX_LOAD_DENOM
+GY_STR_HASH_DICTIONARY_DEFAULT_MIGRATE_SLOTS
+GY_STR_HASH_DICTIONARY_BATCH_SIZE
+GY_STR_HASH_DICTIONARY_CTRL_EMPTY
+GY_STR_HASH_DICTIONARY_CTRL_DELETED
 @Types
 StrHashDictItem_t
 StrHashDict_t
 StrHashDictIter_t
 @Functions
+#define StrHashDictH1(hash)
+#define StrHashDictH2(hash)
+#define IsStrHashDictCtrlFull(ctrlByte)
+#define IsStrHashDictResizing(dict)
+u64 GetStrHashDictCtrlSize(u64 numItemsAlloc)
+u64 GetStrHashDictAllocSize(u64 numItemsAlloc, u64 itemSize)
+u64 GetStrHashDictNumItemsAllocFor(u64 numItems)
 void FreeStrHashDict(StrHashDict_t* dict)
 void CreateStrHashDict(StrHashDict_t* dict, MemArena_t* memArena, u64 itemSize, u64 initialRequiredCapacity = 0)
+u32 StrHashDictGroupMatch(const u8* groupCtrl, u8 value)
+u32 StrHashDictGroupMatchEmpty(const u8* groupCtrl)
+u32 StrHashDictGroupMatchEmptyOrDeleted(const u8* groupCtrl)
+StrHashDictItem_t* GetStrHashDictSlot(const StrHashDict_t* dict, u64 slotIndex)
+void SetStrHashDictCtrl(StrHashDict_t* dict, u64 slotIndex, u8 value)
+u64 FindStrHashDictSlot(const StrHashDict_t* dict, u64 hash)
+u64 FindStrHashDictFreeSlot(const StrHashDict_t* dict, u64 hash)
+void StrHashDictRehash(StrHashDict_t* dict, u64 newNumItemsAlloc)
+StrHashDict_t GetStrHashDictOldTable(const StrHashDict_t* dict)
+void StrHashDictFreeOldTable(StrHashDict_t* dict)
+bool StrHashDictMigrate(StrHashDict_t* dict, u64 numSlots)
+void StrHashDictBeginResize(StrHashDict_t* dict, u64 newNumItemsAlloc)
+void SetStrHashDictIncrementalResize(StrHashDict_t* dict, bool enabled, u64 migrateSlotsPerOp = GY_STR_HASH_DICTIONARY_DEFAULT_MIGRATE_SLOTS)
 bool StrHashExpand(StrHashDict_t* dict, u64 numItemsRequired)
+StrHashDictItem_t* FindStrHashDictItem(const StrHashDict_t* dict, u64 hash)
 #define StrHashDictGetIter(dict, type)
 #define StrHashDictIter(iter, type, itemPntrOut)
 #define StrHashDictAddHard(dict, key, type)
@@ -400,4 +738,6 @@ bool StrHashExpand(StrHashDict_t* dict, u64 numItemsRequired)
 #define StrHashDictGet(dict, key, type)
 #define StrHashDictContains(dict, key, type)
 #define StrHashDictContainsEmpty(dict, key)
-*/
\ No newline at end of file
+#define StrHashDictGetBatch(dict, numKeys, keys, resultsOut, type)
+u64 StrHashDictGetBatch_(const StrHashDict_t* dict, u64 numKeys, const MyStr_t* keys, u64 itemSize, void** resultsOut)
+*/
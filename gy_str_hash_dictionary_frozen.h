@@ -0,0 +1,317 @@
+/*
+File:   gy_str_hash_dictionary_frozen.h
+Author: Taylor Robbins
+Date:   10\16\2026
+Description:
+	** Holds FrozenStrHashDict_t, a read-only version of a StrHashDict_t that lives in one contiguous "image".
+	** FreezeStrHashDict builds the image: a header, one u32 seed per bucket, the u64 hash of every item, and the items packed together.
+	** The seeds make a minimal perfect hash (hash and displace): the key's hash picks a bucket, the bucket's seed
+	** is mixed into the hash to pick a slot, and every item gets its own slot with no empty slots in between.
+	** A lookup is always one seed read plus one hash compare, no probing.
+	** The image only uses offsets (no pointers) so it can be written to disk as is and used straight out of
+	** a buffer or an mmap'd file (OpenFrozenStrHashDict just validates the header and points into the buffer)
+	** NOTE: Like StrHashDict_t we identify items by the full 64-bit FNV hash of their key, that's what gets stored to verify lookups
+	** NOTE: The image is stored in native byte order. An image from a machine with the other byte order fails the magic check
+*/
+
+#ifndef _GY_STR_HASH_DICTIONARY_FROZEN_H
+#define _GY_STR_HASH_DICTIONARY_FROZEN_H
+
+#define FROZEN_STR_HASH_DICT_MAGIC             0x44485346 //"FSHD"
+#define FROZEN_STR_HASH_DICT_VERSION           1
+#define FROZEN_STR_HASH_DICT_ITEMS_PER_BUCKET  4 //average, more items per bucket is smaller but takes longer to freeze
+#define FROZEN_STR_HASH_DICT_MAX_SEED          0x7FFFFFFF
+
+struct FrozenStrHashDictHeader_t
+{
+	u32 magic;
+	u32 version;
+	u64 imageSize;
+	u64 numItems;
+	u64 itemSize;
+	u64 itemStride; //itemSize rounded up to 8 bytes
+	u64 numBuckets;
+	u64 seedsOffset; //u32 * numBuckets
+	u64 hashesOffset; //u64 * numItems
+	u64 itemsOffset; //itemStride * numItems
+};
+
+struct FrozenStrHashDict_t
+{
+	const FrozenStrHashDictHeader_t* header;
+	u64 numItems;
+	u64 itemSize;
+	u64 itemStride;
+	u64 numBuckets;
+	const u32* seeds;
+	const u64* hashes;
+	const u8* items;
+};
+
+// +--------------------------------------------------------------+
+// |                            Macros                            |
+// +--------------------------------------------------------------+
+#define FrozenStrHashDictGetHard(dict, key, type)  (const type*)FrozenStrHashDictGet_((dict), (key), sizeof(type), true)
+#define FrozenStrHashDictGetSoft(dict, key, type)  (const type*)FrozenStrHashDictGet_((dict), (key), sizeof(type), false)
+#define FrozenStrHashDictGet(dict, key, type)      FrozenStrHashDictGetHard(dict, key, type)
+#define FrozenStrHashDictContains(dict, key, type) (FrozenStrHashDictGet_((dict), (key), sizeof(type), false) != nullptr)
+#define FrozenStrHashDictContainsEmpty(dict, key)  (FrozenStrHashDictGet_((dict), (key), 0, false) != nullptr)
+
+// +--------------------------------------------------------------+
+// |                         Header Only                          |
+// +--------------------------------------------------------------+
+#ifdef GYLIB_HEADER_ONLY
+	u64 GetFrozenStrHashDictNumBuckets(u64 numItems);
+	u64 GetFrozenStrHashDictBucketIndex(u64 hash, u64 numBuckets);
+	u64 GetFrozenStrHashDictSlotIndex(u64 hash, u32 seed, u64 numItems);
+	MyStr_t FreezeStrHashDict(const StrHashDict_t* dict, MemArena_t* memArena);
+	bool OpenFrozenStrHashDict(FrozenStrHashDict_t* dictOut, const void* imageData, u64 imageSize);
+	const void* FrozenStrHashDictGet_(const FrozenStrHashDict_t* dict, MyStr_t key, u64 itemSize, bool assertOnFailure);
+	const void* FrozenStrHashDictGet_(const FrozenStrHashDict_t* dict, const char* nullTermStr, u64 itemSize, bool assertOnFailure);
+#else
+
+// +--------------------------------------------------------------+
+// |                       Helper Functions                       |
+// +--------------------------------------------------------------+
+u64 GetFrozenStrHashDictNumBuckets(u64 numItems)
+{
+	if (numItems == 0) { return 0; }
+	return (numItems + FROZEN_STR_HASH_DICT_ITEMS_PER_BUCKET-1) / FROZEN_STR_HASH_DICT_ITEMS_PER_BUCKET;
+}
+
+//These map a 32-bit value onto [0, range) with a multiply and shift instead of a modulo (range must fit in 32 bits)
+//NOTE: FNV's upper bits barely change between keys that only differ in their last few characters, so we multiply before taking them
+u64 GetFrozenStrHashDictBucketIndex(u64 hash, u64 numBuckets)
+{
+	u64 mixed = hash * 0x9E3779B97F4A7C15ULL;
+	return (((mixed >> 32) * numBuckets) >> 32);
+}
+u64 GetFrozenStrHashDictSlotIndex(u64 hash, u32 seed, u64 numItems)
+{
+	u64 mixed = hash ^ ((u64)seed * 0x9E3779B97F4A7C15ULL);
+	mixed ^= (mixed >> 31);
+	mixed *= 0xBF58476D1CE4E5B9ULL;
+	mixed ^= (mixed >> 29);
+	return (((mixed >> 32) * numItems) >> 32);
+}
+
+// +--------------------------------------------------------------+
+// |                            Freeze                            |
+// +--------------------------------------------------------------+
+//Returns the image allocated from memArena (which must hand out 8 byte aligned memory). Temporary arrays are also allocated from memArena and freed before returning.
+//This works on dicts that are in the middle of an incremental resize
+MyStr_t FreezeStrHashDict(const StrHashDict_t* dict, MemArena_t* memArena)
+{
+	NotNull2(dict, memArena);
+	AssertMsg(dict->numItems <= 0xFFFFFFFF, "FrozenStrHashDict only supports up to 2^32 items");
+	u64 numItems = dict->numItems;
+	u64 numBuckets = GetFrozenStrHashDictNumBuckets(numItems);
+	u64 itemStride = ((dict->itemSize + 7) & ~(u64)7);
+	
+	FrozenStrHashDictHeader_t header = {};
+	header.magic = FROZEN_STR_HASH_DICT_MAGIC;
+	header.version = FROZEN_STR_HASH_DICT_VERSION;
+	header.numItems = numItems;
+	header.itemSize = dict->itemSize;
+	header.itemStride = itemStride;
+	header.numBuckets = numBuckets;
+	header.seedsOffset = sizeof(FrozenStrHashDictHeader_t);
+	header.hashesOffset = header.seedsOffset + (((sizeof(u32) * numBuckets) + 7) & ~(u64)7);
+	header.itemsOffset = header.hashesOffset + (sizeof(u64) * numItems);
+	header.imageSize = header.itemsOffset + (itemStride * numItems);
+	
+	u8* image = (u8*)AllocMem(memArena, header.imageSize);
+	NotNull(image);
+	AssertMsg((((size_t)image) & 7) == 0, "FreezeStrHashDict needs an arena that hands out 8 byte aligned memory");
+	MyMemSet(image, 0x00, header.imageSize);
+	MyMemCopy(image, &header, sizeof(header));
+	u32* seeds = (u32*)(image + header.seedsOffset);
+	u64* hashes = (u64*)(image + header.hashesOffset);
+	u8* items = image + header.itemsOffset;
+	if (numItems == 0) { return NewStr(header.imageSize, (char*)image); }
+	
+	// +==============================+
+	// |     Gather Items by Bucket   |
+	// +==============================+
+	const StrHashDictItem_t** sourceItems = AllocArray(memArena, const StrHashDictItem_t*, numItems);
+	u32* bucketStarts = AllocArray(memArena, u32, numBuckets+1);
+	u32* bucketOrder = AllocArray(memArena, u32, numBuckets);
+	u8* slotTaken = AllocArray(memArena, u8, numItems);
+	u64* bucketSlots = AllocArray(memArena, u64, numItems); //big enough for the largest bucket
+	NotNull3(sourceItems, bucketStarts, bucketOrder);
+	NotNull2(slotTaken, bucketSlots);
+	MyMemSet(bucketStarts, 0x00, sizeof(u32) * (numBuckets+1));
+	MyMemSet(slotTaken, 0x00, sizeof(u8) * numItems);
+	
+	//Counting sort the items by bucket (bucketStarts[b] ends up as the index of bucket b's first item)
+	StrHashDict_t oldTable = GetStrHashDictOldTable(dict);
+	const StrHashDict_t* tables[2] = { dict, &oldTable };
+	for (u8 pass = 0; pass < 2; pass++)
+	{
+		u64 foundIndex = 0;
+		for (u8 tIndex = 0; tIndex < 2; tIndex++)
+		{
+			const StrHashDict_t* table = tables[tIndex];
+			for (u64 sIndex = 0; sIndex < table->numItemsAlloc; sIndex++)
+			{
+				if (!IsStrHashDictCtrlFull(table->ctrl[sIndex])) { continue; }
+				const StrHashDictItem_t* item = GetStrHashDictSlot(table, sIndex);
+				u64 bucketIndex = GetFrozenStrHashDictBucketIndex(item->hash, numBuckets);
+				if (pass == 0) { bucketStarts[bucketIndex+1]++; }
+				else { sourceItems[bucketStarts[bucketIndex]++] = item; }
+				foundIndex++;
+			}
+		}
+		Assert(foundIndex == numItems);
+		if (pass == 0) { for (u64 bIndex = 0; bIndex < numBuckets; bIndex++) { bucketStarts[bIndex+1] += bucketStarts[bIndex]; } }
+		else { for (u64 bIndex = numBuckets; bIndex > 0; bIndex--) { bucketStarts[bIndex] = bucketStarts[bIndex-1]; } bucketStarts[0] = 0; }
+	}
+	
+	//Place the biggest buckets first while there are still lots of free slots (buckets are small so one pass over the buckets per size is cheap)
+	u64 maxBucketSize = 0;
+	for (u64 bIndex = 0; bIndex < numBuckets; bIndex++)
+	{
+		u32 bucketSize = bucketStarts[bIndex+1] - bucketStarts[bIndex];
+		if (bucketSize > maxBucketSize) { maxBucketSize = bucketSize; }
+	}
+	u64 orderIndex = 0;
+	for (u64 size = maxBucketSize; size > 0; size--)
+	{
+		for (u64 bIndex = 0; bIndex < numBuckets; bIndex++)
+		{
+			if (bucketStarts[bIndex+1] - bucketStarts[bIndex] == size) { bucketOrder[orderIndex++] = (u32)bIndex; }
+		}
+	}
+	
+	// +==============================+
+	// |     Find a Seed per Bucket   |
+	// +==============================+
+	for (u64 oIndex = 0; oIndex < orderIndex; oIndex++)
+	{
+		u32 bucketIndex = bucketOrder[oIndex];
+		u32 bucketSize = bucketStarts[bucketIndex+1] - bucketStarts[bucketIndex];
+		const StrHashDictItem_t** bucketItems = &sourceItems[bucketStarts[bucketIndex]];
+		bool foundSeed = false;
+		for (u32 seed = 0; seed <= FROZEN_STR_HASH_DICT_MAX_SEED; seed++)
+		{
+			bool seedWorks = true;
+			for (u32 iIndex = 0; iIndex < bucketSize; iIndex++)
+			{
+				u64 slotIndex = GetFrozenStrHashDictSlotIndex(bucketItems[iIndex]->hash, seed, numItems);
+				if (slotTaken[slotIndex]) { seedWorks = false; }
+				for (u32 prevIndex = 0; prevIndex < iIndex && seedWorks; prevIndex++) { if (bucketSlots[prevIndex] == slotIndex) { seedWorks = false; } }
+				if (!seedWorks) { break; }
+				bucketSlots[iIndex] = slotIndex;
+			}
+			if (seedWorks)
+			{
+				seeds[bucketIndex] = seed;
+				for (u32 iIndex = 0; iIndex < bucketSize; iIndex++)
+				{
+					slotTaken[bucketSlots[iIndex]] = 1;
+					hashes[bucketSlots[iIndex]] = bucketItems[iIndex]->hash;
+					if (dict->itemSize > 0) { MyMemCopy(items + (bucketSlots[iIndex] * itemStride), bucketItems[iIndex] + 1, dict->itemSize); }
+				}
+				foundSeed = true;
+				break;
+			}
+		}
+		AssertMsg(foundSeed, "Failed to find a perfect hash seed for a FrozenStrHashDict bucket!");
+	}
+	
+	FreeMem(memArena, bucketSlots, sizeof(u64) * numItems);
+	FreeMem(memArena, slotTaken, sizeof(u8) * numItems);
+	FreeMem(memArena, bucketOrder, sizeof(u32) * numBuckets);
+	FreeMem(memArena, bucketStarts, sizeof(u32) * (numBuckets+1));
+	FreeMem(memArena, sourceItems, sizeof(const StrHashDictItem_t*) * numItems);
+	return NewStr(header.imageSize, (char*)image);
+}
+
+// +--------------------------------------------------------------+
+// |                             Open                             |
+// +--------------------------------------------------------------+
+//imageData must stay alive (and 8 byte aligned) for as long as the FrozenStrHashDict_t is used. Nothing is copied
+bool OpenFrozenStrHashDict(FrozenStrHashDict_t* dictOut, const void* imageData, u64 imageSize)
+{
+	NotNull(dictOut);
+	ClearPointer(dictOut);
+	if (imageData == nullptr || imageSize < sizeof(FrozenStrHashDictHeader_t)) { return false; }
+	if ((((size_t)imageData) & 7) != 0) { return false; }
+	const FrozenStrHashDictHeader_t* header = (const FrozenStrHashDictHeader_t*)imageData;
+	if (header->magic != FROZEN_STR_HASH_DICT_MAGIC) { return false; }
+	if (header->version != FROZEN_STR_HASH_DICT_VERSION) { return false; }
+	if (header->imageSize > imageSize) { return false; }
+	if (header->numItems > 0xFFFFFFFF || header->numBuckets != GetFrozenStrHashDictNumBuckets(header->numItems)) { return false; }
+	if (header->itemStride != ((header->itemSize + 7) & ~(u64)7)) { return false; }
+	if (header->seedsOffset < sizeof(FrozenStrHashDictHeader_t) || header->seedsOffset + (sizeof(u32) * header->numBuckets) > header->hashesOffset) { return false; }
+	if ((header->hashesOffset & 7) != 0 || header->hashesOffset + (sizeof(u64) * header->numItems) > header->itemsOffset) { return false; }
+	if (header->itemsOffset > header->imageSize) { return false; }
+	if (header->itemStride > 0 && header->numItems > (header->imageSize - header->itemsOffset) / header->itemStride) { return false; }
+	
+	const u8* imageBytes = (const u8*)imageData;
+	dictOut->header = header;
+	dictOut->numItems = header->numItems;
+	dictOut->itemSize = header->itemSize;
+	dictOut->itemStride = header->itemStride;
+	dictOut->numBuckets = header->numBuckets;
+	dictOut->seeds = (const u32*)(imageBytes + header->seedsOffset);
+	dictOut->hashes = (const u64*)(imageBytes + header->hashesOffset);
+	dictOut->items = imageBytes + header->itemsOffset;
+	return true;
+}
+
+// +--------------------------------------------------------------+
+// |                             Get                              |
+// +--------------------------------------------------------------+
+const void* FrozenStrHashDictGet_(const FrozenStrHashDict_t* dict, MyStr_t key, u64 itemSize, bool assertOnFailure)
+{
+	NotNull(dict);
+	Assert(dict->itemSize == itemSize);
+	
+	const void* result = nullptr;
+	if (dict->numItems > 0)
+	{
+		u64 keyHash = FnvHashStr(key);
+		u32 seed = dict->seeds[GetFrozenStrHashDictBucketIndex(keyHash, dict->numBuckets)];
+		u64 slotIndex = GetFrozenStrHashDictSlotIndex(keyHash, seed, dict->numItems);
+		if (dict->hashes[slotIndex] == keyHash) { result = (const void*)(dict->items + (slotIndex * dict->itemStride)); }
+	}
+	AssertIfMsg(assertOnFailure, result != nullptr, "Key not found in FrozenStrHashDict!");
+	
+	return result;
+}
+const void* FrozenStrHashDictGet_(const FrozenStrHashDict_t* dict, const char* nullTermStr, u64 itemSize, bool assertOnFailure)
+{
+	return FrozenStrHashDictGet_(dict, NewStr(nullTermStr), itemSize, assertOnFailure);
+}
+
+#endif //GYLIB_HEADER_ONLY
+
+#endif //  _GY_STR_HASH_DICTIONARY_FROZEN_H
+
+// +--------------------------------------------------------------+
+// |                   Autocomplete Dictionary                    |
+// +--------------------------------------------------------------+
+/*
+@Defines
+FROZEN_STR_HASH_DICT_MAGIC
+FROZEN_STR_HASH_DICT_VERSION
+FROZEN_STR_HASH_DICT_ITEMS_PER_BUCKET
+FROZEN_STR_HASH_DICT_MAX_SEED
+@Types
+FrozenStrHashDictHeader_t
+FrozenStrHashDict_t
+@Functions
+#define FrozenStrHashDictGetHard(dict, key, type)
+#define FrozenStrHashDictGetSoft(dict, key, type)
+#define FrozenStrHashDictGet(dict, key, type)
+#define FrozenStrHashDictContains(dict, key, type)
+#define FrozenStrHashDictContainsEmpty(dict, key)
+u64 GetFrozenStrHashDictNumBuckets(u64 numItems)
+u64 GetFrozenStrHashDictBucketIndex(u64 hash, u64 numBuckets)
+u64 GetFrozenStrHashDictSlotIndex(u64 hash, u32 seed, u64 numItems)
+MyStr_t FreezeStrHashDict(const StrHashDict_t* dict, MemArena_t* memArena)
+bool OpenFrozenStrHashDict(FrozenStrHashDict_t* dictOut, const void* imageData, u64 imageSize)
+const void* FrozenStrHashDictGet_(const FrozenStrHashDict_t* dict, MyStr_t key, u64 itemSize, bool assertOnFailure)
+const void* FrozenStrHashDictGet_(const FrozenStrHashDict_t* dict, const char* nullTermStr, u64 itemSize, bool assertOnFailure)
+*/
@@ -693,7 +693,7 @@ void StringFifoInsertLinesFromFifo(StringFifo_t* fifo, const StringFifo_t* srcFi
 	// | Move lines already in Fifo into Temporary Storage  |
 	// +====================================================+
 	MemArena_t* scratchArena = GetScratchArena();
-	u8* tempSpace = AllocArray(scratchArena, u8, totalTempSpaceNeeded);
+	u8* tempSpace = AllocArrayFast(scratchArena, u8, totalTempSpaceNeeded);
 	NotNull(tempSpace);
 	
 	//walk back to the first line we want to store in temporary buffer
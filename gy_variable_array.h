@@ -4,6 +4,10 @@ Author: Taylor Robbins
 Date:   10\12\2021
 Description:
 	** The VarArray_t structure acts like a stretchy buffer, resizing as needed to hold as many fixed size elements as needed
+	** Arrays made with CreateVarArrayVirtual reserve address space for maxLength items up front and commit pages as
+	** they grow, so they never copy their items and pointers into them stay valid until the array is freed
+	** Arrays made with CreateVarArrayInline start out using a buffer the caller owns (usually a small fixed array
+	** sitting right next to the VarArray_t) and only allocate from the arena once they grow past it
 */
 
 #ifndef _GY_VARIABLE_ARRAY_H
@@ -37,6 +41,12 @@ struct VarArray_t
 	void* items;
 	bool wasExpanded; //feel free to clear this in usage code
 	u64 numExpansions;
+	
+	u64 reservedLength; //0 unless made with CreateVarArrayVirtual, in which case items points to OS reserved memory that can hold this many items
+	u64 committedSize; //how many bytes (a multiple of page size) at the start of the reserved range are committed
+	
+	void* inlineItems; //nullptr unless made with CreateVarArrayInline. items == inlineItems until we outgrow it (we never free this)
+	u64 inlineLength;
 };
 
 // +--------------------------------------------------------------+
@@ -44,10 +54,17 @@ struct VarArray_t
 // +--------------------------------------------------------------+
 #if GYLIB_SCRATCH_ARENA_AVAILABLE
 #define CreateVarArray(array, memArena, itemSize, ...) CreateVarArray_(__FILE__, __LINE__, __func__, (array), (memArena), (itemSize), ##__VA_ARGS__)
+#define CreateVarArrayVirtual(array, memArena, itemSize, maxLength, ...) CreateVarArrayVirtual_(__FILE__, __LINE__, __func__, (array), (memArena), (itemSize), (maxLength), ##__VA_ARGS__)
+#define CreateVarArrayInline(array, memArena, itemSize, inlineBuffer, inlineBufferLength, ...) CreateVarArrayInline_(__FILE__, __LINE__, __func__, (array), (memArena), (itemSize), (inlineBuffer), (inlineBufferLength), ##__VA_ARGS__)
 #else
 #define CreateVarArray(array, memArena, itemSize, ...) CreateVarArray_((array), (memArena), (itemSize), ##__VA_ARGS__)
+#define CreateVarArrayVirtual(array, memArena, itemSize, maxLength, ...) CreateVarArrayVirtual_((array), (memArena), (itemSize), (maxLength), ##__VA_ARGS__)
+#define CreateVarArrayInline(array, memArena, itemSize, inlineBuffer, inlineBufferLength, ...) CreateVarArrayInline_((array), (memArena), (itemSize), (inlineBuffer), (inlineBufferLength), ##__VA_ARGS__)
 #endif
 
+#define IsVarArrayVirtual(array) ((array)->reservedLength > 0)
+#define IsVarArrayUsingInlineItems(array) ((array)->inlineItems != nullptr && (array)->items == (array)->inlineItems)
+
 #define VarArrayContains(array, itemPntr) VarArrayContains_((array), (itemPntr), sizeof(*(itemPntr)))
 #define VarArrayContainsTyped(array, itemPntr, type) VarArrayContains_((array), (itemPntr), sizeof(type))
 
@@ -97,6 +114,16 @@ struct VarArray_t
 	#else
 	void CreateVarArray_(VarArray_t* array, MemArena_t* memArena, u64 itemSize, u64 initialRequiredCapacity = 0, bool exponentialChunkSize = true, u64 allocChunkSize = 8);
 	#endif
+	#if GYLIB_SCRATCH_ARENA_AVAILABLE
+	void CreateVarArrayVirtual_(const char* filePath, u64 lineNumber, const char* funcName, VarArray_t* array, MemArena_t* memArena, u64 itemSize, u64 maxLength, u64 initialRequiredCapacity = 0);
+	#else
+	void CreateVarArrayVirtual_(VarArray_t* array, MemArena_t* memArena, u64 itemSize, u64 maxLength, u64 initialRequiredCapacity = 0);
+	#endif
+	#if GYLIB_SCRATCH_ARENA_AVAILABLE
+	void CreateVarArrayInline_(const char* filePath, u64 lineNumber, const char* funcName, VarArray_t* array, MemArena_t* memArena, u64 itemSize, void* inlineBuffer, u64 inlineBufferLength, bool exponentialChunkSize = true, u64 allocChunkSize = 8);
+	#else
+	void CreateVarArrayInline_(VarArray_t* array, MemArena_t* memArena, u64 itemSize, void* inlineBuffer, u64 inlineBufferLength, bool exponentialChunkSize = true, u64 allocChunkSize = 8);
+	#endif
 	bool VarArrayIsCreated(VarArray_t* array);
 	void VarArrayName(VarArray_t* array, MyStr_t newName);
 	bool VarArrayExpand(VarArray_t* array, u64 capacityRequired);
@@ -128,7 +155,13 @@ struct VarArray_t
 void FreeVarArray(VarArray_t* array)
 {
 	NotNull(array);
-	if (array->items != nullptr)
+	if (IsVarArrayVirtual(array))
+	{
+		#if !ORCA_COMPILATION
+		OsFreeReservedMemory(array->items, RoundUpToU64(array->reservedLength * array->itemSize, OsGetMemoryPageSize()));
+		#endif
+	}
+	else if (array->items != nullptr && !IsVarArrayUsingInlineItems(array))
 	{
 		NotNull(array->allocArena);
 		FreeMem(array->allocArena, array->items, array->itemSize * array->allocLength);
@@ -160,6 +193,10 @@ void CreateVarArray_(VarArray_t* array, MemArena_t* memArena, u64 itemSize, u64
 	array->length = 0;
 	array->wasExpanded = false;
 	array->numExpansions = 0;
+	array->reservedLength = 0;
+	array->committedSize = 0;
+	array->inlineItems = nullptr;
+	array->inlineLength = 0;
 	#if GYLIB_SCRATCH_ARENA_AVAILABLE
 		#if GYLIB_MEM_ARENA_DEBUG_ENABLED
 		array->creationFilePath = filePath;
@@ -209,6 +246,66 @@ void CreateVarArray_(VarArray_t* array, MemArena_t* memArena, u64 itemSize, u64
 	else { array->items = nullptr; }
 }
 
+//memArena is still used for the name (and marks the array as created) but the items come straight from the OS
+//NOTE: Nothing gets decommitted until the array is freed. VarArrayClear(array, true) only resets the length
+#if GYLIB_SCRATCH_ARENA_AVAILABLE
+void CreateVarArrayVirtual_(const char* filePath, u64 lineNumber, const char* funcName, VarArray_t* array, MemArena_t* memArena, u64 itemSize, u64 maxLength, u64 initialRequiredCapacity = 0)
+#else
+void CreateVarArrayVirtual_(VarArray_t* array, MemArena_t* memArena, u64 itemSize, u64 maxLength, u64 initialRequiredCapacity = 0)
+#endif
+{
+	#if !ORCA_COMPILATION
+	NotNull(array);
+	NotNull(memArena);
+	Assert(itemSize > 0);
+	Assert(maxLength > 0);
+	Assert(initialRequiredCapacity <= maxLength);
+	Assert(maxLength <= (UINT64_MAX / itemSize));
+	#if GYLIB_SCRATCH_ARENA_AVAILABLE
+	CreateVarArray_(filePath, lineNumber, funcName, array, memArena, itemSize, 0, true, 1);
+	#else
+	CreateVarArray_(array, memArena, itemSize, 0, true, 1);
+	#endif
+	
+	u64 pageSize = OsGetMemoryPageSize();
+	array->items = OsReserveMemory(RoundUpToU64(maxLength * itemSize, pageSize));
+	if (array->items == nullptr)
+	{
+		AssertMsg(false, "Failed to reserve memory in CreateVarArrayVirtual!");
+		ClearPointer(array);
+		return;
+	}
+	array->reservedLength = maxLength;
+	array->committedSize = RoundUpToU64(initialRequiredCapacity * itemSize, pageSize);
+	OsCommitReservedMemory(array->items, array->committedSize);
+	array->allocLength = MinU64(array->committedSize / itemSize, maxLength);
+	#else
+	AssertMsg_(false, "CreateVarArrayVirtual is not supported without the standard library being present!");
+	#endif //!ORCA_COMPILATION
+}
+
+//inlineBuffer has to hold inlineBufferLength items and must outlive the array without moving, so if it's a member of the
+//same struct as the VarArray_t that struct can't be copied or moved (keep it in a BktArray_t, SlotMap_t, on the stack, etc.)
+//NOTE: Once we outgrow the inline buffer we copy into arena memory and stay there (even after VarArrayClear) until VarArrayClear(array, true)
+#if GYLIB_SCRATCH_ARENA_AVAILABLE
+void CreateVarArrayInline_(const char* filePath, u64 lineNumber, const char* funcName, VarArray_t* array, MemArena_t* memArena, u64 itemSize, void* inlineBuffer, u64 inlineBufferLength, bool exponentialChunkSize = true, u64 allocChunkSize = 8)
+#else
+void CreateVarArrayInline_(VarArray_t* array, MemArena_t* memArena, u64 itemSize, void* inlineBuffer, u64 inlineBufferLength, bool exponentialChunkSize = true, u64 allocChunkSize = 8)
+#endif
+{
+	NotNull3(array, memArena, inlineBuffer);
+	Assert(inlineBufferLength > 0);
+	#if GYLIB_SCRATCH_ARENA_AVAILABLE
+	CreateVarArray_(filePath, lineNumber, funcName, array, memArena, itemSize, 0, exponentialChunkSize, allocChunkSize);
+	#else
+	CreateVarArray_(array, memArena, itemSize, 0, exponentialChunkSize, allocChunkSize);
+	#endif
+	array->inlineItems = inlineBuffer;
+	array->inlineLength = inlineBufferLength;
+	array->items = inlineBuffer;
+	array->allocLength = inlineBufferLength;
+}
+
 bool VarArrayIsCreated(VarArray_t* array)
 {
 	NotNull(array);
@@ -237,6 +334,31 @@ bool VarArrayExpand(VarArray_t* array, u64 capacityRequired)
 	Assert(array->itemSize > 0);
 	if (array->allocLength >= capacityRequired) { return false; }
 	
+	#if !ORCA_COMPILATION
+	if (IsVarArrayVirtual(array))
+	{
+		if (capacityRequired > array->reservedLength)
+		{
+			GyLibPrintLine_E("Virtual variable array %s can't grow to %llu items, it only reserved space for %llu", (array->name.pntr != nullptr) ? array->name.pntr : "[unnamed]", capacityRequired, array->reservedLength);
+			AssertMsg(false, "Virtual variable array ran out of reserved space");
+			return false;
+		}
+		//Nothing moves so this never copies. We commit at least double what we had so big arrays aren't making a syscall every few pages
+		u64 pageSize = OsGetMemoryPageSize();
+		u64 reservedSize = RoundUpToU64(array->reservedLength * array->itemSize, pageSize);
+		u64 newCommittedSize = RoundUpToU64(capacityRequired * array->itemSize, pageSize);
+		if (newCommittedSize < array->committedSize * 2) { newCommittedSize = MinU64(array->committedSize * 2, reservedSize); }
+		Assert(newCommittedSize > array->committedSize && newCommittedSize <= reservedSize);
+		OsCommitReservedMemory(((u8*)array->items) + array->committedSize, newCommittedSize - array->committedSize);
+		array->committedSize = newCommittedSize;
+		array->allocLength = MinU64(newCommittedSize / array->itemSize, array->reservedLength);
+		Assert(array->allocLength >= capacityRequired);
+		array->wasExpanded = true;
+		IncrementU64(array->numExpansions);
+		return true;
+	}
+	#endif //!ORCA_COMPILATION
+	
 	u64 newLength = 0;
 	if (array->exponentialChunkSize)
 	{
@@ -278,7 +400,7 @@ bool VarArrayExpand(VarArray_t* array, u64 capacityRequired)
 	{
 		MyMemCopy(newSpace, array->items, array->length * array->itemSize);
 	}
-	if (array->items != nullptr)
+	if (array->items != nullptr && !IsVarArrayUsingInlineItems(array))
 	{
 		FreeMem(array->allocArena, array->items, array->allocLength * array->itemSize);
 	}
@@ -320,12 +442,12 @@ bool VarArrayGetIndexOf_(VarArray_t* array, const void* itemInQuestion, u64* ind
 void VarArrayClear(VarArray_t* array, bool deallocate = false)
 {
 	NotNull(array);
-	if (deallocate && array->allocLength > 0)
+	if (deallocate && array->allocLength > 0 && !IsVarArrayVirtual(array) && !IsVarArrayUsingInlineItems(array))
 	{
 		NotNull(array->allocArena);
 		FreeMem(array->allocArena, array->items, array->allocLength * array->itemSize);
-		array->items = nullptr;
-		array->allocLength = 0;
+		array->items = array->inlineItems;
+		array->allocLength = array->inlineLength;
 	}
 	array->length = 0;
 }
@@ -680,6 +802,10 @@ VarArray_t
 @Functions
 void FreeVarArray(VarArray_t* array)
 void CreateVarArray(VarArray_t* array, MemArena_t* memArena, u64 itemSize, u64 initialRequiredCapacity = 0, bool exponentialChunkSize = true, u64 allocChunkSize = 8)
+void CreateVarArrayVirtual(VarArray_t* array, MemArena_t* memArena, u64 itemSize, u64 maxLength, u64 initialRequiredCapacity = 0)
+#define IsVarArrayVirtual(array)
+void CreateVarArrayInline(VarArray_t* array, MemArena_t* memArena, u64 itemSize, void* inlineBuffer, u64 inlineBufferLength, bool exponentialChunkSize = true, u64 allocChunkSize = 8)
+#define IsVarArrayUsingInlineItems(array)
 void VarArrayName(VarArray_t* array, MyStr_t newName)
 bool VarArrayExpand(VarArray_t* array, u64 capacityRequired)
 #define VarArrayContains(array, itemPntr)
@@ -0,0 +1,267 @@
+/*
+File:   gy_test_atom_table.h
+Author: Taylor Robbins
+Date:   10\16\2026
+Description:
+	** GyTestCase_AtomTable runs a random mix of interns, finds, and GetAtomStr lookups against an AtomTable_t and checks every result
+	** against a plain array of the id each key was given. Interning goes through a copy of the key's characters so the table has to
+	** compare the strings themselves, and every atom has to round trip back to the exact characters it was made from.
+	** The threaded test is split in three parts since gylib doesn't create threads for you: call StartAtomTableThreadTest,
+	** then RunAtomTableThreadTestWorker(test, threadIndex) on numThreads threads at the same time, then FinishAtomTableThreadTest once they are all done.
+	** Each worker interns every key in it's own random order (so all the threads race to add the same strings) and checks it's own
+	** atoms with lock-free finds as it goes. Finish makes sure every thread got the same id for each key and that the ids are dense and unique.
+*/
+
+#ifndef _GY_TEST_ATOM_TABLE_H
+#define _GY_TEST_ATOM_TABLE_H
+
+#include "gy_test_helpers.h"
+
+#define GY_TEST_ATOM_TABLE_MAX_KEY_LENGTH 48
+
+struct AtomTableThreadTest_t
+{
+	MemArena_t* memArena;
+	u64 seed;
+	u64 numKeys;
+	u64 numThreads;
+	char* keyChars;
+	MyStr_t* keys;
+	u32* threadOrders; //numThreads rows of numKeys, each worker shuffles it's own row
+	u32* threadIds; //numThreads rows of numKeys, the id each worker got back for each key
+	AtomTable_t table;
+};
+
+//Key 0 is always the empty string. The rest share long prefixes so StrEquals has to look past the first few characters
+//charsOut needs room for numKeys * GY_TEST_ATOM_TABLE_MAX_KEY_LENGTH chars
+void GyTestMakeAtomTableKeys(u64 numKeys, char* charsOut, MyStr_t* keysOut)
+{
+	for (u64 kIndex = 0; kIndex < numKeys; kIndex++)
+	{
+		char* keyChars = &charsOut[kIndex * GY_TEST_ATOM_TABLE_MAX_KEY_LENGTH];
+		int keyLength = 0;
+		if (kIndex == 0) { keyChars[0] = '\0'; }
+		else if ((kIndex % 3) == 0) { keyLength = MyBufferPrintf(keyChars, GY_TEST_ATOM_TABLE_MAX_KEY_LENGTH, "resources/textures/entities/%llu.png", (unsigned long long)kIndex); }
+		else { keyLength = MyBufferPrintf(keyChars, GY_TEST_ATOM_TABLE_MAX_KEY_LENGTH, "tag_%llu", (unsigned long long)kIndex); }
+		Assert(keyLength >= 0 && keyLength < GY_TEST_ATOM_TABLE_MAX_KEY_LENGTH);
+		keysOut[kIndex] = NewStr((uxx)keyLength, keyChars);
+	}
+}
+
+struct AtomTableShadowTest_t
+{
+	AtomTable_t table;
+	u64 numKeys;
+	MyStr_t* keys;
+	u32* expectedIds;
+	u32 numInterned;
+	char keyCopy[GY_TEST_ATOM_TABLE_MAX_KEY_LENGTH];
+};
+
+GY_TEST_SHADOW_WEIGHTS_DEF(AtomTableShadowTest_GetWeights)
+{
+	AtomTableShadowTest_t* test = (AtomTableShadowTest_t*)context;
+	weightsOut[0] = 5; //intern
+	weightsOut[1] = 3; //find
+	weightsOut[2] = (test->numInterned > 0) ? 2 : 0; //round trip an atom back to it's string
+	weightsOut[3] = (stepIndex % 64 == 0) ? 1 : 0; //check every key
+}
+
+GY_TEST_SHADOW_ACTION_DEF(AtomTableShadowTest_DoAction)
+{
+	AtomTableShadowTest_t* test = (AtomTableShadowTest_t*)context;
+	u64 keyIndex = GetRandU64(random, 0, test->numKeys);
+	MyStr_t key = test->keys[keyIndex];
+	if (action == 0)
+	{
+		MyMemCopy(test->keyCopy, key.chars, key.length);
+		Atom_t atom = AtomTableIntern(&test->table, NewStr(key.length, &test->keyCopy[0]));
+		Assert(IsValidAtom(atom));
+		Assert(atom.hash == (u32)(FnvHashStr(key) & 0xFFFFFFFF));
+		if (test->expectedIds[keyIndex] == ATOM_INVALID_ID)
+		{
+			test->numInterned++;
+			Assert(atom.id == test->numInterned); //ids are handed out in order with no gaps
+			test->expectedIds[keyIndex] = atom.id;
+		}
+		else { Assert(atom.id == test->expectedIds[keyIndex]); }
+		Assert(AtomsEqual(AtomTableIntern(&test->table, key), atom));
+	}
+	else if (action == 1)
+	{
+		Atom_t atom = AtomTableFind(&test->table, key);
+		Assert(atom.id == test->expectedIds[keyIndex]);
+	}
+	else if (action == 2)
+	{
+		Atom_t atom = NewAtom((u32)GetRandU64(random, 1, (u64)test->numInterned + 1), 0);
+		MyStr_t atomStr = GetAtomStr(&test->table, atom);
+		NotNull(atomStr.chars);
+		Assert(atomStr.chars[atomStr.length] == '\0');
+		Atom_t foundAtom = AtomTableFind(&test->table, atomStr);
+		Assert(foundAtom.id == atom.id);
+		Assert(foundAtom.hash == (u32)(FnvHashStr(atomStr) & 0xFFFFFFFF));
+	}
+	else
+	{
+		for (u64 kIndex = 0; kIndex < test->numKeys; kIndex++)
+		{
+			Atom_t atom = AtomTableFind(&test->table, test->keys[kIndex]);
+			Assert(atom.id == test->expectedIds[kIndex]);
+			if (IsValidAtom(atom))
+			{
+				MyStr_t atomStr = GetAtomStr(&test->table, atom);
+				Assert(StrEquals(atomStr, test->keys[kIndex]));
+				Assert(atomStr.length == 0 || atomStr.chars != test->keys[kIndex].chars); //the table keeps it's own copy
+			}
+		}
+	}
+}
+
+GY_TEST_SHADOW_CHECK_DEF(AtomTableShadowTest_Check)
+{
+	AtomTableShadowTest_t* test = (AtomTableShadowTest_t*)context;
+	Assert(test->table.numAtoms == test->numInterned);
+}
+
+void GyTestCase_AtomTable(MemArena_t* memArena, u64 seed, u64 numActions, u64 numKeys)
+{
+	NotNull(memArena);
+	Assert(numKeys > 0);
+	RandomSeries_t random;
+	InitGyTestRandom(&random, seed);
+	
+	AtomTableShadowTest_t test = {};
+	test.numKeys = numKeys;
+	char* keyChars = AllocArray(memArena, char, numKeys * GY_TEST_ATOM_TABLE_MAX_KEY_LENGTH);
+	test.keys = AllocArray(memArena, MyStr_t, numKeys);
+	test.expectedIds = AllocArray(memArena, u32, numKeys);
+	NotNull3(keyChars, test.keys, test.expectedIds);
+	GyTestMakeAtomTableKeys(numKeys, keyChars, test.keys);
+	MyMemSet(test.expectedIds, 0x00, sizeof(u32) * numKeys);
+	
+	CreateAtomTable(&test.table, memArena);
+	Assert(!IsValidAtom(AtomTableFind(&test.table, test.keys[0])));
+	Assert(GetAtomStr(&test.table, Atom_Invalid).length == 0);
+	
+	GyTestShadowModel_t model;
+	InitGyTestShadowModel(&model, &test, 4, AtomTableShadowTest_GetWeights, AtomTableShadowTest_DoAction, AtomTableShadowTest_Check);
+	RunGyTestShadowModel(&model, &random, numActions);
+	
+	Assert(GetAtomStr(&test.table, NewAtom(test.numInterned + 1, 0)).length == 0);
+	FreeAtomTable(&test.table);
+	FreeMem(memArena, test.expectedIds, sizeof(u32) * numKeys);
+	FreeMem(memArena, test.keys, sizeof(MyStr_t) * numKeys);
+	FreeMem(memArena, keyChars, sizeof(char) * numKeys * GY_TEST_ATOM_TABLE_MAX_KEY_LENGTH);
+}
+
+// +--------------------------------------------------------------+
+// |                        Threaded Test                         |
+// +--------------------------------------------------------------+
+//Needs GYLIB_THREADING_ENABLED. memArena only gets used here, in FinishAtomTableThreadTest, and by the table while it holds it's mutex
+void StartAtomTableThreadTest(AtomTableThreadTest_t* test, MemArena_t* memArena, u64 seed, u64 numKeys, u64 numThreads)
+{
+	NotNull2(test, memArena);
+	Assert(numKeys > 0 && numKeys < 0xFFFFFFFF);
+	Assert(numThreads > 0);
+	ClearPointer(test);
+	test->memArena = memArena;
+	test->seed = seed;
+	test->numKeys = numKeys;
+	test->numThreads = numThreads;
+	test->keyChars = AllocArray(memArena, char, numKeys * GY_TEST_ATOM_TABLE_MAX_KEY_LENGTH);
+	test->keys = AllocArray(memArena, MyStr_t, numKeys);
+	test->threadOrders = AllocArray(memArena, u32, numThreads * numKeys);
+	test->threadIds = AllocArray(memArena, u32, numThreads * numKeys);
+	NotNull2(test->keyChars, test->keys);
+	NotNull2(test->threadOrders, test->threadIds);
+	GyTestMakeAtomTableKeys(numKeys, test->keyChars, test->keys);
+	for (u64 tIndex = 0; tIndex < numThreads; tIndex++)
+	{
+		for (u64 kIndex = 0; kIndex < numKeys; kIndex++) { test->threadOrders[(tIndex * numKeys) + kIndex] = (u32)kIndex; }
+	}
+	MyMemSet(test->threadIds, 0x00, sizeof(u32) * numThreads * numKeys);
+	CreateAtomTable(&test->table, memArena);
+	AssertMsg(IsValidGyMutex(&test->table.mutex), "The threaded AtomTable test needs GYLIB_THREADING_ENABLED");
+}
+
+void RunAtomTableThreadTestWorker(AtomTableThreadTest_t* test, u64 threadIndex)
+{
+	NotNull(test);
+	Assert(threadIndex < test->numThreads);
+	RandomSeries_t random;
+	InitGyTestRandom(&random, test->seed + threadIndex);
+	u32* order = &test->threadOrders[threadIndex * test->numKeys];
+	u32* ids = &test->threadIds[threadIndex * test->numKeys];
+	for (u64 oIndex = test->numKeys - 1; oIndex > 0; oIndex--)
+	{
+		u64 swapIndex = GetRandU64(&random, 0, oIndex + 1);
+		u32 temp = order[oIndex];
+		order[oIndex] = order[swapIndex];
+		order[swapIndex] = temp;
+	}
+	
+	for (u64 oIndex = 0; oIndex < test->numKeys; oIndex++)
+	{
+		u32 keyIndex = order[oIndex];
+		MyStr_t key = test->keys[keyIndex];
+		Atom_t atom = AtomTableIntern(&test->table, key);
+		Assert(IsValidAtom(atom));
+		Assert(atom.hash == (u32)(FnvHashStr(key) & 0xFFFFFFFF));
+		ids[keyIndex] = atom.id;
+		
+		//Anything we interned ourselves has to be visible to our own lock-free reads, even while other threads are growing the index
+		Assert(AtomsEqual(AtomTableFind(&test->table, key), atom));
+		Assert(StrEquals(GetAtomStr(&test->table, atom), key));
+		u32 prevKeyIndex = order[GetRandU64(&random, 0, oIndex + 1)];
+		Assert(AtomTableFind(&test->table, test->keys[prevKeyIndex]).id == ids[prevKeyIndex]);
+	}
+}
+
+void FinishAtomTableThreadTest(AtomTableThreadTest_t* test)
+{
+	NotNull(test);
+	u64 numKeys = test->numKeys;
+	Assert(test->table.numAtoms == numKeys);
+	
+	bool* idUsed = AllocArray(test->memArena, bool, numKeys + 1);
+	NotNull(idUsed);
+	MyMemSet(idUsed, 0x00, sizeof(bool) * (numKeys + 1));
+	for (u64 kIndex = 0; kIndex < numKeys; kIndex++)
+	{
+		u32 id = test->threadIds[kIndex];
+		Assert(id != ATOM_INVALID_ID && id <= numKeys);
+		Assert(!idUsed[id]);
+		idUsed[id] = true;
+		for (u64 tIndex = 1; tIndex < test->numThreads; tIndex++) { Assert(test->threadIds[(tIndex * numKeys) + kIndex] == id); }
+		Assert(StrEquals(GetAtomStr(&test->table, NewAtom(id, 0)), test->keys[kIndex]));
+		Assert(AtomTableFind(&test->table, test->keys[kIndex]).id == id);
+	}
+	
+	FreeMem(test->memArena, idUsed, sizeof(bool) * (numKeys + 1));
+	FreeAtomTable(&test->table);
+	FreeMem(test->memArena, test->threadIds, sizeof(u32) * test->numThreads * numKeys);
+	FreeMem(test->memArena, test->threadOrders, sizeof(u32) * test->numThreads * numKeys);
+	FreeMem(test->memArena, test->keys, sizeof(MyStr_t) * numKeys);
+	FreeMem(test->memArena, test->keyChars, sizeof(char) * numKeys * GY_TEST_ATOM_TABLE_MAX_KEY_LENGTH);
+	ClearPointer(test);
+}
+
+#endif //  _GY_TEST_ATOM_TABLE_H
+
+// +--------------------------------------------------------------+
+// |                   Autocomplete Dictionary                    |
+// +--------------------------------------------------------------+
+/*
+@Defines
+GY_TEST_ATOM_TABLE_MAX_KEY_LENGTH
+@Types
+AtomTableThreadTest_t
+AtomTableShadowTest_t
+@Functions
+void GyTestMakeAtomTableKeys(u64 numKeys, char* charsOut, MyStr_t* keysOut)
+void GyTestCase_AtomTable(MemArena_t* memArena, u64 seed, u64 numActions, u64 numKeys)
+void StartAtomTableThreadTest(AtomTableThreadTest_t* test, MemArena_t* memArena, u64 seed, u64 numKeys, u64 numThreads)
+void RunAtomTableThreadTestWorker(AtomTableThreadTest_t* test, u64 threadIndex)
+void FinishAtomTableThreadTest(AtomTableThreadTest_t* test)
+*/
@@ -0,0 +1,184 @@
+/*
+File:   gy_test_bucket_array.h
+Author: Taylor Robbins
+Date:   10\16\2026
+Description:
+	** GyTestCase_BktArray runs a random mix of adds, bulk adds, removes, clears, and solidifies against a BktArray_t and checks
+	** every item against a plain array of the values it should hold (in order). After every step the bucket directory has to
+	** mirror the linked list, bucketEnds has to hold the running item count through lastUsedBucket, and numUselessSpaces has
+	** to match the free space left behind in the buckets before lastUsedBucket. Use a small minBucketSize to get lots of buckets.
+*/
+
+#ifndef _GY_TEST_BUCKET_ARRAY_H
+#define _GY_TEST_BUCKET_ARRAY_H
+
+#include "gy_test_helpers.h"
+
+struct BktArrayShadowTest_t
+{
+	BktArray_t array;
+	u64 maxNumItems;
+	u64 numItems;
+	u64* values;
+	u64 nextValue;
+};
+
+GY_TEST_SHADOW_WEIGHTS_DEF(BktArrayShadowTest_GetWeights)
+{
+	BktArrayShadowTest_t* test = (BktArrayShadowTest_t*)context;
+	weightsOut[0] = (test->numItems < test->maxNumItems) ? 30 : 0; //add
+	weightsOut[1] = (test->numItems < test->maxNumItems) ? 10 : 0; //add bulk
+	weightsOut[2] = (test->numItems > 0) ? 30 : 0; //remove at
+	weightsOut[3] = (test->numItems > 0) ? 10 : 0; //remove last
+	weightsOut[4] = 1; //clear
+	weightsOut[5] = 3; //solidify
+	weightsOut[6] = (test->numItems > 0) ? 16 : 0; //get
+}
+
+GY_TEST_SHADOW_ACTION_DEF(BktArrayShadowTest_DoAction)
+{
+	BktArrayShadowTest_t* test = (BktArrayShadowTest_t*)context;
+	BktArray_t* array = &test->array;
+	if (action == 0)
+	{
+		u64* newItem = BktArrayAdd(array, u64);
+		NotNull(newItem);
+		*newItem = test->nextValue;
+		test->values[test->numItems++] = test->nextValue++;
+	}
+	else if (action == 1)
+	{
+		u64 numNewItems = GetRandU64(random, 1, MinU64(array->minBucketSize * 3, test->maxNumItems - test->numItems) + 1);
+		bool mustBeConsecutive = (GetRandU64(random, 0, 2) == 0);
+		u64 baseIndex = test->numItems;
+		u64* firstItem = BktArrayAddBulk(array, u64, numNewItems, mustBeConsecutive);
+		NotNull(firstItem);
+		Assert(BktArrayGetHard(array, u64, baseIndex) == firstItem);
+		for (u64 iIndex = 0; iIndex < numNewItems; iIndex++)
+		{
+			u64* newItem = BktArrayGetHard(array, u64, baseIndex + iIndex);
+			if (mustBeConsecutive) { Assert(newItem == firstItem + iIndex); }
+			*newItem = test->nextValue;
+			test->values[test->numItems++] = test->nextValue++;
+		}
+	}
+	else if (action == 2)
+	{
+		u64 removeIndex = GetRandU64(random, 0, test->numItems);
+		BktArrayRemoveAt(array, removeIndex);
+		for (u64 iIndex = removeIndex; iIndex+1 < test->numItems; iIndex++) { test->values[iIndex] = test->values[iIndex+1]; }
+		test->numItems--;
+	}
+	else if (action == 3)
+	{
+		BktArrayRemoveLast(array);
+		test->numItems--;
+	}
+	else if (action == 4)
+	{
+		bool reduceToSingleBucket = (GetRandU64(random, 0, 2) == 0);
+		BktArrayClear(array, reduceToSingleBucket);
+		if (reduceToSingleBucket) { Assert(array->numBuckets == 1); }
+		test->numItems = 0;
+	}
+	else if (action == 5)
+	{
+		bool deallocateEmptyBuckets = (GetRandU64(random, 0, 2) == 0);
+		bool singleBucket = (GetRandU64(random, 0, 2) == 0);
+		BktArraySolidify(array, deallocateEmptyBuckets, singleBucket);
+		if (array->numBuckets > 0)
+		{
+			Assert(array->numUselessSpaces == 0);
+			if (singleBucket) { Assert(array->numBuckets == 1); }
+			else if (deallocateEmptyBuckets) { Assert(array->lastUsedBucket == array->numBuckets-1); }
+		}
+	}
+	else
+	{
+		u64 getIndex = GetRandU64(random, 0, test->numItems);
+		u64* item = BktArrayGetSoft(array, u64, getIndex);
+		NotNull(item);
+		Assert(*item == test->values[getIndex]);
+		u64 foundIndex = test->numItems;
+		Assert(IsPntrInBktArray(array, item, &foundIndex));
+		Assert(foundIndex == getIndex);
+	}
+}
+
+GY_TEST_SHADOW_CHECK_DEF(BktArrayShadowTest_Check)
+{
+	BktArrayShadowTest_t* test = (BktArrayShadowTest_t*)context;
+	BktArray_t* array = &test->array;
+	Assert(array->length == test->numItems);
+	Assert(BktArrayGetSoft(array, u64, test->numItems) == nullptr);
+	if (array->numBuckets == 0) { Assert(test->numItems == 0); return; }
+	
+	Assert(array->lastUsedBucket < array->numBuckets);
+	Assert(array->numDirectoryAlloc >= array->numBuckets);
+	u64 itemCount = 0;
+	u64 numUselessSpaces = 0;
+	BktArrayBucket_t* bucket = array->firstBucket;
+	for (u64 bIndex = 0; bIndex < array->numBuckets; bIndex++)
+	{
+		NotNull(bucket);
+		Assert(array->buckets[bIndex] == bucket);
+		Assert(bucket->numItems <= bucket->numItemsAlloc);
+		itemCount += bucket->numItems;
+		if (bIndex <= array->lastUsedBucket) { Assert(array->bucketEnds[bIndex] == itemCount); }
+		else { Assert(bucket->numItems == 0); }
+		if (bIndex < array->lastUsedBucket) { numUselessSpaces += bucket->numItemsAlloc - bucket->numItems; }
+		bucket = bucket->next;
+	}
+	Assert(bucket == nullptr);
+	Assert(itemCount == test->numItems);
+	Assert(array->numUselessSpaces == numUselessSpaces);
+	
+	for (u64 iIndex = 0; iIndex < test->numItems; iIndex++)
+	{
+		u64 bIndex = BktArrayFindBucketIndex(array, iIndex);
+		Assert(bIndex <= array->lastUsedBucket);
+		Assert(array->bucketEnds[bIndex] > iIndex && array->bucketEnds[bIndex] - array->buckets[bIndex]->numItems <= iIndex);
+		Assert(*BktArrayGetHard(array, u64, iIndex) == test->values[iIndex]);
+	}
+}
+
+void GyTestCase_BktArray(MemArena_t* memArena, u64 seed, u64 numActions, u64 maxNumItems, u64 minBucketSize)
+{
+	NotNull(memArena);
+	Assert(maxNumItems > 0 && minBucketSize > 0);
+	RandomSeries_t random;
+	InitGyTestRandom(&random, seed);
+	
+	BktArrayShadowTest_t test = {};
+	CreateBktArray(&test.array, memArena, sizeof(u64), minBucketSize, GetRandU64(&random, 0, minBucketSize * 2));
+	test.maxNumItems = maxNumItems;
+	test.values = AllocArray(memArena, u64, maxNumItems);
+	NotNull(test.values);
+	test.nextValue = 1;
+	
+	GyTestShadowModel_t model;
+	InitGyTestShadowModel(&model, &test, 7, BktArrayShadowTest_GetWeights, BktArrayShadowTest_DoAction, BktArrayShadowTest_Check);
+	RunGyTestShadowModel(&model, &random, numActions);
+	
+	//Solidifying can't change the order of the items, only which buckets they live in
+	BktArraySolidify(&test.array, true, false);
+	BktArrayShadowTest_Check(&test, numActions);
+	BktArraySolidify(&test.array, false, true);
+	BktArrayShadowTest_Check(&test, numActions);
+	if (test.numItems > 0) { Assert(test.array.numBuckets == 1 && test.array.firstBucket->numItems == test.numItems); }
+	
+	FreeMem(memArena, test.values, sizeof(u64) * maxNumItems);
+	FreeBktArray(&test.array);
+}
+
+#endif //  _GY_TEST_BUCKET_ARRAY_H
+
+// +--------------------------------------------------------------+
+// |                   Autocomplete Dictionary                    |
+// +--------------------------------------------------------------+
+/*
+@Types
+BktArrayShadowTest_t
+@Functions
+void GyTestCase_BktArray(MemArena_t* memArena, u64 seed, u64 numActions, u64 maxNumItems, u64 minBucketSize)
+*/
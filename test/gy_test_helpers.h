@@ -0,0 +1,193 @@
+/*
+File:   gy_test_helpers.h
+Author: Taylor Robbins
+Date:   10\16\2026
+Description:
+	** Scaffolding shared by the randomized container tests and their benchmarks so each test file only has to hold the container specific checks.
+	** InitGyTestRandom seeds the RandomSeries_t a test case draws from and GyTestPickAction picks each step from a table of weights
+	** (set a weight to 0 to rule an action out for that step, like removing from an empty container).
+	** RunGyTestShadowModel owns the loop those tests share: each step it asks the test for the action weights, picks one, has the test do it
+	** to both the container and a plain "shadow" model of what the container should hold, then runs the test's check callback.
+	** A GyTestBenchmark_t times a few named variants of the same work, makes sure they all agree on a checksum, and prints the time per op for each
+*/
+
+#ifndef _GY_TEST_HELPERS_H
+#define _GY_TEST_HELPERS_H
+
+#define GY_TEST_BENCHMARK_MAX_VARIANTS 4
+#define GY_TEST_SHADOW_MAX_ACTIONS     8
+
+//Fill weightsOut[0..numActionTypes) for this step, they all start at 0
+#define GY_TEST_SHADOW_WEIGHTS_DEF(functionName) void functionName(void* context, u64 stepIndex, u64* weightsOut)
+typedef GY_TEST_SHADOW_WEIGHTS_DEF(GyTestShadowWeights_f);
+//Do the action to the container and the shadow model, asserting on anything the container hands back
+#define GY_TEST_SHADOW_ACTION_DEF(functionName) void functionName(void* context, RandomSeries_t* random, u64 stepIndex, u64 action)
+typedef GY_TEST_SHADOW_ACTION_DEF(GyTestShadowAction_f);
+//Called after every step to make sure the container and the shadow model still agree
+#define GY_TEST_SHADOW_CHECK_DEF(functionName) void functionName(void* context, u64 stepIndex)
+typedef GY_TEST_SHADOW_CHECK_DEF(GyTestShadowCheck_f);
+
+struct GyTestShadowModel_t
+{
+	void* context;
+	u64 numActionTypes;
+	GyTestShadowWeights_f* getWeights;
+	GyTestShadowAction_f* doAction;
+	GyTestShadowCheck_f* check; //optional
+};
+
+struct GyTestBenchmarkVariant_t
+{
+	const char* name;
+	u64 checksum;
+	r64 timeMs;
+	r64 nsPerOp;
+};
+
+struct GyTestBenchmark_t
+{
+	const char* itemName;
+	u64 numItems;
+	const char* opName;
+	u64 numOps;
+	bool isTiming;
+	PerfTime_t startTime;
+	u64 numVariants;
+	GyTestBenchmarkVariant_t variants[GY_TEST_BENCHMARK_MAX_VARIANTS];
+};
+
+// +--------------------------------------------------------------+
+// |                      Randomized Testing                      |
+// +--------------------------------------------------------------+
+void InitGyTestRandom(RandomSeries_t* random, u64 seed)
+{
+	NotNull(random);
+	CreateRandomSeries(random);
+	SeedRandomSeriesU64(random, seed);
+}
+
+//Returns an index into weights, each with odds proportional to it's weight. At least one weight has to be non-zero
+u64 GyTestPickAction(RandomSeries_t* random, u64 numWeights, const u64* weights)
+{
+	NotNull2(random, weights);
+	u64 totalWeight = 0;
+	for (u64 wIndex = 0; wIndex < numWeights; wIndex++) { totalWeight += weights[wIndex]; }
+	Assert(totalWeight > 0);
+	u64 pick = GetRandU64(random, 0, totalWeight);
+	for (u64 wIndex = 0; wIndex < numWeights; wIndex++)
+	{
+		if (pick < weights[wIndex]) { return wIndex; }
+		pick -= weights[wIndex];
+	}
+	Assert(false);
+	return 0;
+}
+#define GyTestPickActionFrom(random, weightsArray) GyTestPickAction((random), ArrayCount(weightsArray), (weightsArray))
+
+void InitGyTestShadowModel(GyTestShadowModel_t* model, void* context, u64 numActionTypes, GyTestShadowWeights_f* getWeights, GyTestShadowAction_f* doAction, GyTestShadowCheck_f* check = nullptr)
+{
+	NotNull3(model, getWeights, doAction);
+	Assert(numActionTypes > 0 && numActionTypes <= GY_TEST_SHADOW_MAX_ACTIONS);
+	ClearPointer(model);
+	model->context = context;
+	model->numActionTypes = numActionTypes;
+	model->getWeights = getWeights;
+	model->doAction = doAction;
+	model->check = check;
+}
+
+void RunGyTestShadowModel(const GyTestShadowModel_t* model, RandomSeries_t* random, u64 numSteps)
+{
+	NotNull2(model, random);
+	for (u64 sIndex = 0; sIndex < numSteps; sIndex++)
+	{
+		u64 weights[GY_TEST_SHADOW_MAX_ACTIONS] = {};
+		model->getWeights(model->context, sIndex, &weights[0]);
+		u64 action = GyTestPickAction(random, model->numActionTypes, &weights[0]);
+		model->doAction(model->context, random, sIndex, action);
+		if (model->check != nullptr) { model->check(model->context, sIndex); }
+	}
+}
+
+// +--------------------------------------------------------------+
+// |                         Benchmarking                         |
+// +--------------------------------------------------------------+
+void InitGyTestBenchmark(GyTestBenchmark_t* benchmark, const char* itemName, u64 numItems, const char* opName, u64 numOps)
+{
+	NotNull3(benchmark, itemName, opName);
+	ClearPointer(benchmark);
+	benchmark->itemName = itemName;
+	benchmark->numItems = numItems;
+	benchmark->opName = opName;
+	benchmark->numOps = numOps;
+}
+
+void GyTestBenchmarkStart(GyTestBenchmark_t* benchmark, const char* variantName)
+{
+	NotNull2(benchmark, variantName);
+	Assert(!benchmark->isTiming);
+	Assert(benchmark->numVariants < GY_TEST_BENCHMARK_MAX_VARIANTS);
+	GyTestBenchmarkVariant_t* variant = &benchmark->variants[benchmark->numVariants];
+	ClearPointer(variant);
+	variant->name = variantName;
+	benchmark->isTiming = true;
+	benchmark->startTime = GetPerfTime(); //last so none of the setup above gets timed
+}
+
+//Every variant is doing the same work so they all have to come up with the same checksum (pass 0 if there's nothing to compare)
+void GyTestBenchmarkEnd(GyTestBenchmark_t* benchmark, u64 checksum)
+{
+	PerfTime_t endTime = GetPerfTime();
+	NotNull(benchmark);
+	Assert(benchmark->isTiming);
+	GyTestBenchmarkVariant_t* variant = &benchmark->variants[benchmark->numVariants];
+	variant->checksum = checksum;
+	variant->timeMs = GetPerfTimeDiff(&benchmark->startTime, &endTime);
+	if (benchmark->numOps > 0) { variant->nsPerOp = (variant->timeMs * 1000000.0) / (r64)benchmark->numOps; }
+	AssertMsg(variant->checksum == benchmark->variants[0].checksum, "Benchmark variants disagreed on the result of the same work!");
+	benchmark->isTiming = false;
+	benchmark->numVariants++;
+}
+
+void PrintGyTestBenchmark(const GyTestBenchmark_t* benchmark)
+{
+	NotNull(benchmark);
+	Assert(!benchmark->isTiming);
+	GyLibPrintLine_I("%llu %ss, %llu %ss:", benchmark->numItems, benchmark->itemName, benchmark->numOps, benchmark->opName);
+	for (u64 vIndex = 0; vIndex < benchmark->numVariants; vIndex++)
+	{
+		const GyTestBenchmarkVariant_t* variant = &benchmark->variants[vIndex];
+		GyLibPrintLine_I("    %-24s %10.2lfms (%.1lfns/%s)", variant->name, variant->timeMs, variant->nsPerOp, benchmark->opName);
+	}
+}
+
+#endif //  _GY_TEST_HELPERS_H
+
+// +--------------------------------------------------------------+
+// |                   Autocomplete Dictionary                    |
+// +--------------------------------------------------------------+
+/*
+@Defines
+GY_TEST_BENCHMARK_MAX_VARIANTS
+GY_TEST_SHADOW_MAX_ACTIONS
+@Types
+GyTestShadowWeights_f
+GyTestShadowAction_f
+GyTestShadowCheck_f
+GyTestShadowModel_t
+GyTestBenchmarkVariant_t
+GyTestBenchmark_t
+@Functions
+#define GY_TEST_SHADOW_WEIGHTS_DEF(functionName)
+#define GY_TEST_SHADOW_ACTION_DEF(functionName)
+#define GY_TEST_SHADOW_CHECK_DEF(functionName)
+void InitGyTestRandom(RandomSeries_t* random, u64 seed)
+u64 GyTestPickAction(RandomSeries_t* random, u64 numWeights, const u64* weights)
+#define GyTestPickActionFrom(random, weightsArray)
+void InitGyTestShadowModel(GyTestShadowModel_t* model, void* context, u64 numActionTypes, GyTestShadowWeights_f* getWeights, GyTestShadowAction_f* doAction, GyTestShadowCheck_f* check = nullptr)
+void RunGyTestShadowModel(const GyTestShadowModel_t* model, RandomSeries_t* random, u64 numSteps)
+void InitGyTestBenchmark(GyTestBenchmark_t* benchmark, const char* itemName, u64 numItems, const char* opName, u64 numOps)
+void GyTestBenchmarkStart(GyTestBenchmark_t* benchmark, const char* variantName)
+void GyTestBenchmarkEnd(GyTestBenchmark_t* benchmark, u64 checksum)
+void PrintGyTestBenchmark(const GyTestBenchmark_t* benchmark)
+*/
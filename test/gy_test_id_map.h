@@ -0,0 +1,192 @@
+/*
+File:   gy_test_id_map.h
+Author: Taylor Robbins
+Date:   10\16\2026
+Description:
+	** GyTestCase_IdMap runs a random mix of adds, removes, and lookups against an IdMap_t and checks every
+	** result against a plain array of the same items (this exercises the backward-shift removal pretty heavily)
+	** RunIdMapBenchmark times IdMap_t lookups (one at a time and with IdMapGetBatch) against a linear search through a VarArray_t holding the same items
+*/
+
+#ifndef _GY_TEST_ID_MAP_H
+#define _GY_TEST_ID_MAP_H
+
+#include "gy_test_helpers.h"
+
+struct IdMapTestItem_t
+{
+	u64 id;
+	void* pntr;
+};
+
+struct IdMapShadowTest_t
+{
+	IdMap_t map;
+	IdMapTestItem_t* items;
+	u64 numItems;
+	u64 maxNumItems;
+};
+
+GY_TEST_SHADOW_WEIGHTS_DEF(IdMapShadowTest_GetWeights)
+{
+	IdMapShadowTest_t* test = (IdMapShadowTest_t*)context;
+	bool canAdd = (test->numItems < test->maxNumItems);
+	weightsOut[0] = canAdd ? 4 : 0; //add with IdMapAddNew
+	weightsOut[1] = canAdd ? 1 : 0; //add with an id we picked ourselves
+	weightsOut[2] = (test->numItems > 0) ? 3 : 0; //remove
+	weightsOut[3] = 1; //shrink
+	weightsOut[4] = 1; //check every item
+}
+
+GY_TEST_SHADOW_ACTION_DEF(IdMapShadowTest_DoAction)
+{
+	IdMapShadowTest_t* test = (IdMapShadowTest_t*)context;
+	switch (action)
+	{
+		case 0:
+		case 1:
+		{
+			IdMapTestItem_t* newItem = &test->items[test->numItems];
+			newItem->pntr = (void*)(u64)GetRandU64(random, 1, 0xFFFFFFFF);
+			if (action == 1)
+			{
+				newItem->id = GetRandU64(random, 1, test->map.nextId + 1000);
+				for (u64 iIndex = 0; iIndex < test->numItems; iIndex++) { if (test->items[iIndex].id == newItem->id) { return; } }
+				Assert(IdMapAdd(&test->map, newItem->id, newItem->pntr));
+			}
+			else { newItem->id = IdMapAddNew(&test->map, newItem->pntr); }
+			test->numItems++;
+		} break;
+		
+		case 2:
+		{
+			u64 itemIndex = GetRandU64(random, 0, test->numItems);
+			Assert(IdMapRemove(&test->map, test->items[itemIndex].id));
+			Assert(!IdMapContains(&test->map, test->items[itemIndex].id));
+			test->items[itemIndex] = test->items[test->numItems-1];
+			test->numItems--;
+		} break;
+		
+		case 3:
+		{
+			IdMapShrink(&test->map);
+		} break;
+		
+		case 4:
+		{
+			for (u64 iIndex = 0; iIndex < test->numItems; iIndex++)
+			{
+				Assert(IdMapGetSoft(&test->map, test->items[iIndex].id, void) == test->items[iIndex].pntr);
+			}
+			Assert(!IdMapContains(&test->map, test->map.nextId));
+		} break;
+	}
+}
+
+GY_TEST_SHADOW_CHECK_DEF(IdMapShadowTest_Check)
+{
+	IdMapShadowTest_t* test = (IdMapShadowTest_t*)context;
+	Assert(test->map.count == test->numItems);
+}
+
+void GyTestCase_IdMap(MemArena_t* memArena, u64 seed, u64 numActions, u64 maxNumItems)
+{
+	NotNull(memArena);
+	Assert(maxNumItems > 0);
+	RandomSeries_t random;
+	InitGyTestRandom(&random, seed);
+	
+	IdMapShadowTest_t test = {};
+	CreateIdMap(&test.map, memArena);
+	test.items = AllocArray(memArena, IdMapTestItem_t, maxNumItems);
+	NotNull(test.items);
+	test.maxNumItems = maxNumItems;
+	
+	GyTestShadowModel_t model;
+	InitGyTestShadowModel(&model, &test, 5, IdMapShadowTest_GetWeights, IdMapShadowTest_DoAction, IdMapShadowTest_Check);
+	RunGyTestShadowModel(&model, &random, numActions);
+	
+	u64 numIterated = 0;
+	u64 slotIndex = 0;
+	u64 iterId = 0;
+	void* iterPntr = nullptr;
+	while (IdMapIter(&test.map, &slotIndex, &iterId, &iterPntr))
+	{
+		Assert(IdMapGetSoft(&test.map, iterId, void) == iterPntr);
+		numIterated++;
+	}
+	Assert(numIterated == test.numItems);
+	
+	FreeMem(memArena, test.items, sizeof(IdMapTestItem_t) * maxNumItems);
+	FreeIdMap(&test.map);
+}
+
+void RunIdMapBenchmark(MemArena_t* memArena, u64 numItems, u64 numLookups, GyTestBenchmark_t* benchmarkOut)
+{
+	NotNull2(memArena, benchmarkOut);
+	Assert(numItems > 0);
+	InitGyTestBenchmark(benchmarkOut, "item", numItems, "lookup", numLookups);
+	RandomSeries_t random;
+	InitGyTestRandom(&random, numItems);
+	
+	IdMap_t map;
+	CreateIdMap(&map, memArena, numItems);
+	VarArray_t array;
+	CreateVarArray(&array, memArena, sizeof(IdMapTestItem_t), numItems);
+	for (u64 iIndex = 0; iIndex < numItems; iIndex++)
+	{
+		IdMapTestItem_t* newItem = VarArrayAdd(&array, IdMapTestItem_t);
+		NotNull(newItem);
+		newItem->pntr = (void*)newItem;
+		newItem->id = IdMapAddNew(&map, newItem->pntr);
+	}
+	u64* lookupIds = AllocArray(memArena, u64, numLookups);
+	void** batchResults = AllocArray(memArena, void*, numLookups);
+	NotNull2(lookupIds, batchResults);
+	for (u64 lIndex = 0; lIndex < numLookups; lIndex++) { lookupIds[lIndex] = GetRandU64(&random, 1, numItems+1); }
+	
+	u64 idMapChecksum = 0;
+	GyTestBenchmarkStart(benchmarkOut, "IdMap");
+	for (u64 lIndex = 0; lIndex < numLookups; lIndex++)
+	{
+		idMapChecksum += (u64)IdMapGetSoft(&map, lookupIds[lIndex], void);
+	}
+	GyTestBenchmarkEnd(benchmarkOut, idMapChecksum);
+	
+	u64 idMapBatchChecksum = 0;
+	GyTestBenchmarkStart(benchmarkOut, "IdMap batched");
+	IdMapGetBatch(&map, numLookups, lookupIds, batchResults);
+	for (u64 lIndex = 0; lIndex < numLookups; lIndex++) { idMapBatchChecksum += (u64)batchResults[lIndex]; }
+	GyTestBenchmarkEnd(benchmarkOut, idMapBatchChecksum);
+	
+	u64 varArrayChecksum = 0;
+	GyTestBenchmarkStart(benchmarkOut, "VarArray");
+	for (u64 lIndex = 0; lIndex < numLookups; lIndex++)
+	{
+		VarArrayLoop(&array, iIndex)
+		{
+			VarArrayLoopGet(IdMapTestItem_t, item, &array, iIndex);
+			if (item->id == lookupIds[lIndex]) { varArrayChecksum += (u64)item->pntr; break; }
+		}
+	}
+	GyTestBenchmarkEnd(benchmarkOut, varArrayChecksum);
+	
+	FreeMem(memArena, batchResults, sizeof(void*) * numLookups);
+	FreeMem(memArena, lookupIds, sizeof(u64) * numLookups);
+	FreeVarArray(&array);
+	FreeIdMap(&map);
+}
+
+#endif //  _GY_TEST_ID_MAP_H
+
+// +--------------------------------------------------------------+
+// |                   Autocomplete Dictionary                    |
+// +--------------------------------------------------------------+
+/*
+@Types
+IdMapTestItem_t
+IdMapShadowTest_t
+@Functions
+void GyTestCase_IdMap(MemArena_t* memArena, u64 seed, u64 numActions, u64 maxNumItems)
+void RunIdMapBenchmark(MemArena_t* memArena, u64 numItems, u64 numLookups, GyTestBenchmark_t* benchmarkOut)
+*/
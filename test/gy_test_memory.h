@@ -2,6 +2,23 @@
 File:   gy_test_memory.h
 Author: Taylor Robbins
 Date:   04\15\2024
+Description:
+	** Set arena->testSetOut to a MemArenaTestSet_t (allocated from a different arena!) to record every AllocMem, ReallocMem, and FreeMem
+	** that happens on that arena. The set can then be serialized to a compact binary trace (SerializeMemArenaTestSet), saved from a
+	** live process, loaded back later (DeserializeMemArenaTestSet), and replayed against any MemArenaType_t.
+	** MemArenaTestSetRunBenchmark replays a set against an arena and measures throughput, per-action latency percentiles,
+	** peak used vs size (fragmentation), and page counts so different arena types can be compared on the same workload
+	** MemArenaTestSetRunVerified replays a set while checking the arena after every action (fill patterns, ReallocMem contents, and MemArenaVerify).
+	** The GyTestCase_ arena functions replay a random set (that has been through the binary trace format) against each of the newer arena types.
+	** GyTestCase_RingArena covers frame retirement and wrapping around the buffer instead, since a trace can't express those.
+	** GyTestCase_MappedFileArena checks that everything (including marks and the root) survives closing and reopening the file.
+	** GyTestCase_VirtualStackArena checks page and huge page alignment and that a huge page arena commits in whole huge pages.
+	** GyTestCase_MemArenaAllocInfo (only with GYLIB_MEM_ARENA_DEBUG_ENABLED) checks the table of debug alloc infos that every arena keeps.
+	** GyTestCase_MemArenaSnapshot checks that restoring a MemArenaSnapshot_t rolls back contents, used, and marks, and that re-taking it moves the restore point.
+	** GyTestCase_MemArenaHistograms checks the histogram buckets, the counts and percentiles an arena records, and diffing two histogram snapshots.
+	** GyTestCase_StatsPage publishes arena counters to a StatsPage_t and reads them back through a second mapping, including a reader running into an odd sequence.
+	** The threaded ThreadCached test is split in three parts since gylib doesn't create threads for you: call StartThreadCachedArenaThreadTest,
+	** then RunThreadCachedArenaThreadTestWorker(test, threadIndex) on numThreads threads at the same time, then FinishThreadCachedArenaThreadTest once they are all done
 */
 
 // +--------------------------------------------------------------+
@@ -13,7 +30,7 @@ Date:   04\15\2024
 #define _GY_TEST_MEMORY_PREDECLARED
 
 struct MemArenaTestSet_t;
-enum AllocAlignment_t;
+enum AllocAlignment_t : uint32_t;
 uint64_t MemArenaTestSetGetActionIndex(const MemArenaTestSet_t* set);
 void MemArenaTestSetRecordAllocMemAction(MemArenaTestSet_t* set, uint64_t size, AllocAlignment_t alignment, void* resultPntr);
 void MemArenaTestSetRecordReallocMemAction(MemArenaTestSet_t* set, void* allocPntr, uint64_t newSize, uint64_t oldSize, AllocAlignment_t alignment, void* resultPntr);
@@ -77,6 +94,56 @@ struct MemArenaTestSet_t
 	VarArray_t actions; //MemArenaTestAction_t
 };
 
+// Trace Format:
+//   u32 magic, u32 version, u64 numTotalAllocations, u64 numActions
+//   Then each action starts with a u8: bits 0-1 are the type, bit 2 is set if a Realloc moved to a new allocIndex, bits 3-7 are log2(alignment) (0 for None)
+//   All the following numbers are LEB128 varints. Alloc indices are stored as a distance back from the next new allocIndex since most frees are recent allocations
+//     Alloc:   size (the allocIndex is always the next new one)
+//     Free:    allocIndex distance, size
+//     Realloc: oldAllocIndex distance (0 if there was no old allocation), size, oldSize
+#define MEM_ARENA_TEST_TRACE_MAGIC   0x544D5947 //"GYMT"
+#define MEM_ARENA_TEST_TRACE_VERSION 1
+#define MEM_ARENA_TEST_TRACE_HEADER_SIZE (sizeof(u32) + sizeof(u32) + sizeof(u64) + sizeof(u64))
+#define MEM_ARENA_TEST_TRACE_MOVED_FLAG   0x04
+#define MEM_ARENA_TEST_TRACE_ALIGN_SHIFT  3
+
+//Latencies are tracked in a log-linear histogram so we don't have to store and sort a time for every action.
+//Values below 2^MEM_ARENA_TEST_LATENCY_SUB_BITS get their own bucket, above that each power of two is split into 2^MEM_ARENA_TEST_LATENCY_SUB_BITS buckets (~6% precision)
+#define MEM_ARENA_TEST_LATENCY_SUB_BITS    4
+#define MEM_ARENA_TEST_LATENCY_NUM_BUCKETS ((64 - MEM_ARENA_TEST_LATENCY_SUB_BITS + 1) << MEM_ARENA_TEST_LATENCY_SUB_BITS)
+
+#define MEM_ARENA_TEST_THREAD_MAX_LIVE     64 //blocks each worker in the threaded ThreadCached test holds at once
+#define MEM_ARENA_TEST_THREAD_NUM_HANDOFFS 32 //blocks that get passed between workers so they are freed on a thread that didn't allocate them
+
+struct ThreadCachedArenaThreadTest_t
+{
+	MemArena_t* sourceArena;
+	u64 seed;
+	u64 numThreads;
+	u64 numActionsPerThread;
+	MemArena_t heap; //PagedHeap between the ThreadCached arena and sourceArena
+	MemArena_t arena;
+	u8** liveBlocks; //numThreads rows of MEM_ARENA_TEST_THREAD_MAX_LIVE
+	u8* volatile handoffs[MEM_ARENA_TEST_THREAD_NUM_HANDOFFS];
+};
+
+struct MemArenaTestBenchmarkResult_t
+{
+	MemArenaType_t arenaType;
+	u64 numActions;
+	r64 totalTimeMs; //only counts time spent inside the actions
+	r64 actionsPerSecond;
+	r64 p50ActionTimeNs;
+	r64 p99ActionTimeNs;
+	r64 maxActionTimeNs;
+	u64 peakUsed;
+	u64 peakSize;
+	u64 sizeAtPeakUsed; //peakUsed / sizeAtPeakUsed is a decent measure of how well the arena packs allocations
+	u64 peakNumPages;
+	u64 finalNumPages;
+	u64 latencyBuckets[MEM_ARENA_TEST_LATENCY_NUM_BUCKETS]; //in perf time counts, see GetMemArenaTestLatencyBucket
+};
+
 // +--------------------------------------------------------------+
 // |                         Header Only                          |
 // +--------------------------------------------------------------+
@@ -91,6 +158,40 @@ struct MemArenaTestSet_t
 	void MemArenaTestSetPrepare(MemArenaTestSet_t* set);
 	void MemArenaTestPerformAction(MemArena_t* memArena, MemArenaTestAllocation_t* allocations, u64 numAllocations, MemArenaTestAction_t* action);
 	void MemArenaTestSetPerformAllActions(MemArena_t* memArena, MemArenaTestSet_t* set);
+	void MemArenaTestTraceWriteVarU64(u8* result, u64 resultSize, u64* byteIndexPntr, u64 value);
+	bool MemArenaTestTraceReadVarU64(const u8* dataPntr, u64 dataSize, u64* byteIndexPntr, u64* valueOut);
+	MyStr_t SerializeMemArenaTestSet(const MemArenaTestSet_t* set, MemArena_t* memArena);
+	bool DeserializeMemArenaTestSet(MyStr_t traceData, MemArena_t* memArena, MemArenaTestSet_t* setOut);
+	u64 GetMemArenaTestLatencyBucket(u64 value);
+	u64 GetMemArenaTestLatencyBucketValue(u64 bucketIndex);
+	r64 GetMemArenaTestLatencyPercentile(const MemArenaTestBenchmarkResult_t* result, r64 percentile);
+	void MemArenaTestSetRunBenchmark(MemArena_t* memArena, const MemArenaTestSet_t* set, MemArena_t* scratchArena, MemArenaTestBenchmarkResult_t* resultOut);
+	void PrintMemArenaTestBenchmarkResult(const MemArenaTestBenchmarkResult_t* result, const char* arenaName = nullptr);
+	void GenerateMemArenaTestSet(MemArena_t* memArena, MemArenaTestSet_t* setOut, u64 seed, u64 numActions, u64 minAllocSize, u64 maxAllocSize, u64 maxNumLive, AllocAlignment_t maxAlignment = AllocAlignment_None);
+	u8 GetMemArenaTestFillValue(u64 allocIndex);
+	bool IsMemArenaTestFillIntact(const void* allocPntr, u64 size, u8 fillValue);
+	void MemArenaTestSetRunVerified(MemArena_t* memArena, const MemArenaTestSet_t* set, MemArena_t* scratchArena, bool resizeInPlace = false);
+	void GyTestCase_MemArenaReplay(MemArena_t* memArena, MemArena_t* scratchArena, u64 seed, u64 numActions, u64 minAllocSize, u64 maxAllocSize, u64 maxNumLive, AllocAlignment_t maxAlignment, bool resizeInPlace);
+	void GyTestCase_SlabArena(MemArena_t* sourceArena, MemArena_t* scratchArena, u64 seed, u64 numActions);
+	void GyTestCase_PagedHeapArena(MemArena_t* sourceArena, MemArena_t* scratchArena, u64 seed, u64 numActions);
+	void GyTestCase_ThreadCachedArena(MemArena_t* sourceArena, MemArena_t* scratchArena, u64 seed, u64 numActions);
+	void GyTestCase_StdHeapRemap(MemArena_t* scratchArena, u64 seed, u64 numActions);
+	void GyTestCase_RingArena(MemArena_t* sourceArena, u64 seed, u64 numFrames, u64 ringSize, u64 maxNumFrames);
+	void GyTestCase_MappedFileArena(const char* filePath, u64 seed, u64 numAllocations);
+	void GyTestCase_VirtualStackArena(MemArena_t* scratchArena, u64 seed, u64 numAllocations, bool useHugePages);
+	#if GYLIB_MEM_ARENA_DEBUG_ENABLED
+	void GyTestCase_MemArenaAllocInfo(MemArena_t* sourceArena, MemArena_t* scratchArena, u64 seed, u64 numAllocations);
+	#endif
+	#if MEM_ARENA_SNAPSHOTS_SUPPORTED
+	void GyTestCase_MemArenaSnapshot(MemArena_t* scratchArena, u64 seed, u64 numTicks);
+	#endif
+	void GyTestCase_MemArenaHistograms(MemArena_t* sourceArena, MemArena_t* scratchArena, u64 seed, u64 numActions);
+	#if STATS_PAGE_SUPPORTED
+	void GyTestCase_StatsPage(MemArena_t* sourceArena, u64 seed, u64 numPublishes);
+	#endif
+	void StartThreadCachedArenaThreadTest(ThreadCachedArenaThreadTest_t* test, MemArena_t* sourceArena, u64 seed, u64 numThreads, u64 numActionsPerThread);
+	void RunThreadCachedArenaThreadTestWorker(ThreadCachedArenaThreadTest_t* test, u64 threadIndex);
+	void FinishThreadCachedArenaThreadTest(ThreadCachedArenaThreadTest_t* test);
 #else
 
 // +--------------------------------------------------------------+
@@ -118,10 +219,11 @@ void NewMemArenaTestSet(MemArena_t* memArena, MemArenaTestSet_t* set, u64 numAll
 u64 FindMemArenaTestSetAllocIndex(MemArenaTestSet_t* set, void* allocPntr)
 {
 	if (allocPntr == nullptr) { return UINT64_MAX; }
-	VarArrayLoop(&set->allocations, aIndex)
+	//NOTE: We search backwards because most frees are for recent allocations. This keeps recording a long running process from grinding to a halt
+	for (u64 aIndex = set->allocations.length; aIndex > 0; aIndex--)
 	{
-		VarArrayLoopGet(MemArenaTestAllocation_t, allocation, &set->allocations, aIndex);
-		if (allocation->pntr == allocPntr) { return aIndex; }
+		MemArenaTestAllocation_t* allocation = VarArrayGet(&set->allocations, aIndex-1, MemArenaTestAllocation_t);
+		if (allocation->pntr == allocPntr) { return aIndex-1; }
 	}
 	return UINT64_MAX;
 }
@@ -253,6 +355,1265 @@ void MemArenaTestSetPerformAllActions(MemArena_t* memArena, MemArenaTestSet_t* s
 	}
 }
 
+// +--------------------------------------------------------------+
+// |                         Binary Trace                         |
+// +--------------------------------------------------------------+
+void MemArenaTestTraceWriteVarU64(u8* result, u64 resultSize, u64* byteIndexPntr, u64 value)
+{
+	do
+	{
+		u8 byteValue = (u8)(value & 0x7F);
+		value >>= 7;
+		if (value != 0) { byteValue |= 0x80; }
+		BinSer_WriteU8(result, resultSize, byteIndexPntr, byteValue);
+	} while (value != 0);
+}
+bool MemArenaTestTraceReadVarU64(const u8* dataPntr, u64 dataSize, u64* byteIndexPntr, u64* valueOut)
+{
+	u64 value = 0;
+	for (u8 shift = 0; shift < 64; shift += 7)
+	{
+		u8 byteValue = 0;
+		if (!BinDeser_ReadU8(dataPntr, dataSize, byteIndexPntr, &byteValue)) { return false; }
+		value |= ((u64)(byteValue & 0x7F) << shift);
+		if ((byteValue & 0x80) == 0) { *valueOut = value; return true; }
+	}
+	return false;
+}
+
+//Works on a set that was recorded (before MemArenaTestSetPrepare) or one that came from DeserializeMemArenaTestSet
+//Pass memArena = nullptr to just measure the size of the trace
+MyStr_t SerializeMemArenaTestSet(const MemArenaTestSet_t* set, MemArena_t* memArena)
+{
+	NotNull(set);
+	u8* result = nullptr;
+	u64 resultSize = 0;
+	for (u8 pass = 0; pass < 2; pass++)
+	{
+		u64 byteIndex = 0;
+		BinSer_WriteU32(result, resultSize, &byteIndex, MEM_ARENA_TEST_TRACE_MAGIC);
+		BinSer_WriteU32(result, resultSize, &byteIndex, MEM_ARENA_TEST_TRACE_VERSION);
+		BinSer_WriteU64(result, resultSize, &byteIndex, MaxU64(set->numTotalAllocations, set->allocations.length));
+		BinSer_WriteU64(result, resultSize, &byteIndex, set->actions.length);
+		
+		u64 nextAllocIndex = 0;
+		VarArrayLoop(&set->actions, aIndex)
+		{
+			VarArrayLoopGet(MemArenaTestAction_t, action, &set->actions, aIndex);
+			u8 alignmentLog2 = (action->alignment != AllocAlignment_None) ? FindMsbIndexU64((u64)action->alignment) : 0;
+			u8 typeByte = (u8)action->type | (u8)(alignmentLog2 << MEM_ARENA_TEST_TRACE_ALIGN_SHIFT);
+			switch (action->type)
+			{
+				case MemArenaTestActionType_Alloc:
+				{
+					Assert(action->allocIndex == nextAllocIndex);
+					BinSer_WriteU8(result, resultSize, &byteIndex, typeByte);
+					MemArenaTestTraceWriteVarU64(result, resultSize, &byteIndex, action->size);
+					nextAllocIndex++;
+				} break;
+				case MemArenaTestActionType_Free:
+				{
+					Assert(action->allocIndex < nextAllocIndex);
+					BinSer_WriteU8(result, resultSize, &byteIndex, typeByte);
+					MemArenaTestTraceWriteVarU64(result, resultSize, &byteIndex, nextAllocIndex - action->allocIndex);
+					MemArenaTestTraceWriteVarU64(result, resultSize, &byteIndex, action->size);
+				} break;
+				case MemArenaTestActionType_Realloc:
+				{
+					bool moved = (action->allocIndex != action->oldAllocIndex);
+					Assert(!moved || action->allocIndex == nextAllocIndex);
+					Assert(action->oldAllocIndex == UINT64_MAX || action->oldAllocIndex < nextAllocIndex);
+					if (moved) { typeByte |= MEM_ARENA_TEST_TRACE_MOVED_FLAG; }
+					BinSer_WriteU8(result, resultSize, &byteIndex, typeByte);
+					MemArenaTestTraceWriteVarU64(result, resultSize, &byteIndex, (action->oldAllocIndex != UINT64_MAX) ? (nextAllocIndex - action->oldAllocIndex) : 0);
+					MemArenaTestTraceWriteVarU64(result, resultSize, &byteIndex, action->size);
+					MemArenaTestTraceWriteVarU64(result, resultSize, &byteIndex, action->oldSize);
+					if (moved) { nextAllocIndex++; }
+				} break;
+				default: AssertMsg(false, "Unknown action type in MemArenaTestSet"); break;
+			}
+		}
+		
+		if (pass == 0)
+		{
+			if (memArena == nullptr) { return NewStrLengthOnly(byteIndex); }
+			resultSize = byteIndex;
+			result = AllocArray(memArena, u8, resultSize);
+			if (result == nullptr) { return MyStr_Empty; }
+		}
+		else { Assert(byteIndex == resultSize); }
+	}
+	return NewStr(resultSize, (char*)result);
+}
+
+//The resulting set is ready for MemArenaTestSetPerformAllActions (no need to call MemArenaTestSetPrepare)
+bool DeserializeMemArenaTestSet(MyStr_t traceData, MemArena_t* memArena, MemArenaTestSet_t* setOut)
+{
+	NotNull2(memArena, setOut);
+	const u8* dataPntr = (const u8*)traceData.chars;
+	u64 dataSize = traceData.length;
+	if (dataSize < MEM_ARENA_TEST_TRACE_HEADER_SIZE) { return false; }
+	u64 byteIndex = 0;
+	u32 magic = 0, version = 0;
+	u64 numTotalAllocations = 0, numActions = 0;
+	BinDeser_ReadU32(dataPntr, dataSize, &byteIndex, &magic);
+	BinDeser_ReadU32(dataPntr, dataSize, &byteIndex, &version);
+	BinDeser_ReadU64(dataPntr, dataSize, &byteIndex, &numTotalAllocations);
+	BinDeser_ReadU64(dataPntr, dataSize, &byteIndex, &numActions);
+	if (magic != MEM_ARENA_TEST_TRACE_MAGIC || version != MEM_ARENA_TEST_TRACE_VERSION) { return false; }
+	if (numActions > dataSize - byteIndex) { return false; } //every action takes at least 2 bytes, this just protects the allocation below from garbage
+	
+	NewMemArenaTestSet(memArena, setOut, 0, numActions);
+	setOut->numTotalAllocations = numTotalAllocations;
+	u64 nextAllocIndex = 0;
+	for (u64 aIndex = 0; aIndex < numActions; aIndex++)
+	{
+		u8 typeByte = 0;
+		bool readSuccess = BinDeser_ReadU8(dataPntr, dataSize, &byteIndex, &typeByte);
+		MemArenaTestAction_t* action = VarArrayAdd(&setOut->actions, MemArenaTestAction_t);
+		NotNull(action);
+		ClearPointer(action);
+		action->type = (MemArenaTestActionType_t)(typeByte & 0x03);
+		u8 alignmentLog2 = (typeByte >> MEM_ARENA_TEST_TRACE_ALIGN_SHIFT);
+		action->alignment = (alignmentLog2 != 0 && alignmentLog2 < 64) ? (AllocAlignment_t)(1ULL << alignmentLog2) : AllocAlignment_None;
+		u64 indexDistance = 0;
+		switch (action->type)
+		{
+			case MemArenaTestActionType_Alloc:
+			{
+				readSuccess = readSuccess && MemArenaTestTraceReadVarU64(dataPntr, dataSize, &byteIndex, &action->size);
+				action->allocIndex = nextAllocIndex;
+				nextAllocIndex++;
+			} break;
+			case MemArenaTestActionType_Free:
+			{
+				readSuccess = readSuccess && MemArenaTestTraceReadVarU64(dataPntr, dataSize, &byteIndex, &indexDistance);
+				readSuccess = readSuccess && MemArenaTestTraceReadVarU64(dataPntr, dataSize, &byteIndex, &action->size);
+				readSuccess = readSuccess && (indexDistance > 0 && indexDistance <= nextAllocIndex);
+				action->allocIndex = nextAllocIndex - indexDistance;
+			} break;
+			case MemArenaTestActionType_Realloc:
+			{
+				readSuccess = readSuccess && MemArenaTestTraceReadVarU64(dataPntr, dataSize, &byteIndex, &indexDistance);
+				readSuccess = readSuccess && MemArenaTestTraceReadVarU64(dataPntr, dataSize, &byteIndex, &action->size);
+				readSuccess = readSuccess && MemArenaTestTraceReadVarU64(dataPntr, dataSize, &byteIndex, &action->oldSize);
+				readSuccess = readSuccess && (indexDistance <= nextAllocIndex);
+				action->oldAllocIndex = (indexDistance > 0) ? (nextAllocIndex - indexDistance) : UINT64_MAX;
+				if (IsFlagSet(typeByte, MEM_ARENA_TEST_TRACE_MOVED_FLAG)) { action->allocIndex = nextAllocIndex; nextAllocIndex++; }
+				else { action->allocIndex = action->oldAllocIndex; }
+			} break;
+			default: readSuccess = false; break;
+		}
+		if (!readSuccess || nextAllocIndex > numTotalAllocations)
+		{
+			FreeMemArenaTestSet(setOut);
+			return false;
+		}
+	}
+	return true;
+}
+
+// +--------------------------------------------------------------+
+// |                          Benchmark                           |
+// +--------------------------------------------------------------+
+u64 GetMemArenaTestLatencyBucket(u64 value)
+{
+	if (value < (1ULL << MEM_ARENA_TEST_LATENCY_SUB_BITS)) { return value; }
+	u8 msbIndex = FindMsbIndexU64(value);
+	u64 subIndex = (value >> (msbIndex - MEM_ARENA_TEST_LATENCY_SUB_BITS)) & ((1ULL << MEM_ARENA_TEST_LATENCY_SUB_BITS) - 1);
+	return ((u64)(msbIndex - MEM_ARENA_TEST_LATENCY_SUB_BITS + 1) << MEM_ARENA_TEST_LATENCY_SUB_BITS) + subIndex;
+}
+//Returns the middle of the range of values that land in the bucket
+u64 GetMemArenaTestLatencyBucketValue(u64 bucketIndex)
+{
+	if (bucketIndex < (1ULL << MEM_ARENA_TEST_LATENCY_SUB_BITS)) { return bucketIndex; }
+	u64 shift = (bucketIndex >> MEM_ARENA_TEST_LATENCY_SUB_BITS) - 1;
+	u64 subIndex = bucketIndex & ((1ULL << MEM_ARENA_TEST_LATENCY_SUB_BITS) - 1);
+	u64 lowValue = (((1ULL << MEM_ARENA_TEST_LATENCY_SUB_BITS) + subIndex) << shift);
+	return lowValue + ((1ULL << shift) / 2);
+}
+
+//percentile is 0.0 - 1.0, result is in nanoseconds
+r64 GetMemArenaTestLatencyPercentile(const MemArenaTestBenchmarkResult_t* result, r64 percentile)
+{
+	NotNull(result);
+	if (result->numActions == 0) { return 0.0; }
+	u64 targetCount = (u64)(percentile * (r64)result->numActions);
+	if (targetCount >= result->numActions) { targetCount = result->numActions-1; }
+	u64 countSoFar = 0;
+	for (u64 bIndex = 0; bIndex < MEM_ARENA_TEST_LATENCY_NUM_BUCKETS; bIndex++)
+	{
+		countSoFar += result->latencyBuckets[bIndex];
+		if (countSoFar > targetCount)
+		{
+			return (r64)GetMemArenaTestLatencyBucketValue(bIndex) * GetPerfTimeSecondsPerCount() * 1000000000.0;
+		}
+	}
+	return result->maxActionTimeNs;
+}
+
+//Replays all the actions in the set against memArena, timing each one. Any allocations left over at the end of the set are freed (not timed)
+//The set itself is not modified so it can be run against many arenas. scratchArena is used for the table of live allocations
+void MemArenaTestSetRunBenchmark(MemArena_t* memArena, const MemArenaTestSet_t* set, MemArena_t* scratchArena, MemArenaTestBenchmarkResult_t* resultOut)
+{
+	NotNull4(memArena, set, scratchArena, resultOut);
+	ClearPointer(resultOut);
+	resultOut->arenaType = memArena->type;
+	resultOut->numActions = set->actions.length;
+	
+	u64 numAllocations = MaxU64(set->numTotalAllocations, set->allocations.length);
+	MemArenaTestAllocation_t* allocations = nullptr;
+	if (numAllocations > 0)
+	{
+		allocations = AllocArray(scratchArena, MemArenaTestAllocation_t, numAllocations);
+		NotNull(allocations);
+		MyMemSet(allocations, 0x00, sizeof(MemArenaTestAllocation_t) * numAllocations);
+	}
+	
+	u64 totalCount = 0;
+	u64 maxCount = 0;
+	VarArrayLoop(&set->actions, aIndex)
+	{
+		VarArrayLoopGet(MemArenaTestAction_t, action, &set->actions, aIndex);
+		PerfTime_t startTime = GetPerfTime();
+		MemArenaTestPerformAction(memArena, allocations, numAllocations, action);
+		PerfTime_t endTime = GetPerfTime();
+		PerfTimeTotal_t actionTime = {};
+		AddToPerfTimeTotal(&startTime, &endTime, &actionTime);
+		totalCount += actionTime.totalCounterAmount;
+		if (maxCount < actionTime.totalCounterAmount) { maxCount = actionTime.totalCounterAmount; }
+		resultOut->latencyBuckets[GetMemArenaTestLatencyBucket(actionTime.totalCounterAmount)]++;
+		
+		//MemArenaTestPerformAction doesn't forget freed pntrs, we need to so we can clean up at the end
+		if (action->type == MemArenaTestActionType_Free) { allocations[action->allocIndex].pntr = nullptr; }
+		else if (action->type == MemArenaTestActionType_Realloc && action->oldAllocIndex < numAllocations && action->oldAllocIndex != action->allocIndex) { allocations[action->oldAllocIndex].pntr = nullptr; }
+		
+		if (resultOut->peakUsed < memArena->used) { resultOut->peakUsed = memArena->used; resultOut->sizeAtPeakUsed = memArena->size; }
+		if (resultOut->peakSize < memArena->size) { resultOut->peakSize = memArena->size; }
+		if (resultOut->peakNumPages < memArena->numPages) { resultOut->peakNumPages = memArena->numPages; }
+	}
+	resultOut->finalNumPages = memArena->numPages;
+	
+	PerfTimeTotal_t totalTime = {};
+	totalTime.totalCounterAmount = totalCount;
+	resultOut->totalTimeMs = GetPerfTimeTotal(&totalTime);
+	resultOut->actionsPerSecond = (resultOut->totalTimeMs > 0) ? ((r64)resultOut->numActions / (resultOut->totalTimeMs / 1000.0)) : 0.0;
+	resultOut->maxActionTimeNs = (r64)maxCount * GetPerfTimeSecondsPerCount() * 1000000000.0;
+	resultOut->p50ActionTimeNs = GetMemArenaTestLatencyPercentile(resultOut, 0.50);
+	resultOut->p99ActionTimeNs = GetMemArenaTestLatencyPercentile(resultOut, 0.99);
+	
+	for (u64 aIndex = 0; aIndex < numAllocations; aIndex++)
+	{
+		if (allocations[aIndex].pntr != nullptr) { FreeMem(memArena, allocations[aIndex].pntr); }
+	}
+	if (allocations != nullptr) { FreeMem(scratchArena, allocations, sizeof(MemArenaTestAllocation_t) * numAllocations); }
+}
+
+void PrintMemArenaTestBenchmarkResult(const MemArenaTestBenchmarkResult_t* result, const char* arenaName = nullptr)
+{
+	NotNull(result);
+	GyLibPrintLine_I("%s (%s): %llu actions in %.2lfms (%.0lf/sec) p50 %.0lfns p99 %.0lfns max %.0lfns",
+		(arenaName != nullptr) ? arenaName : "Arena", GetMemArenaTypeStr(result->arenaType),
+		result->numActions, result->totalTimeMs, result->actionsPerSecond,
+		result->p50ActionTimeNs, result->p99ActionTimeNs, result->maxActionTimeNs
+	);
+	GyLibPrintLine_I("    peak used %llu / size %llu (%.1lf%% packed), peak size %llu, pages %llu peak %llu final",
+		result->peakUsed, result->sizeAtPeakUsed, (result->sizeAtPeakUsed > 0) ? (100.0 * (r64)result->peakUsed / (r64)result->sizeAtPeakUsed) : 0.0,
+		result->peakSize, result->peakNumPages, result->finalNumPages
+	);
+}
+
+// +--------------------------------------------------------------+
+// |                         Random Sets                          |
+// +--------------------------------------------------------------+
+//Fills setOut with a random mix of AllocMem, ReallocMem and FreeMem actions as if they had been recorded from a program (it's ready for
+//MemArenaTestSetPerformAllActions, no need to call MemArenaTestSetPrepare). Every ReallocMem moves to a new allocIndex so the set can be
+//replayed against any arena type. Pass AllocAlignment_None for maxAlignment if the arena can't align (like StdHeap)
+void GenerateMemArenaTestSet(MemArena_t* memArena, MemArenaTestSet_t* setOut, u64 seed, u64 numActions, u64 minAllocSize, u64 maxAllocSize, u64 maxNumLive, AllocAlignment_t maxAlignment = AllocAlignment_None)
+{
+	NotNull2(memArena, setOut);
+	Assert(minAllocSize > 0 && minAllocSize <= maxAllocSize);
+	Assert(maxNumLive > 0);
+	RandomSeries_t random;
+	CreateRandomSeries(&random);
+	SeedRandomSeriesU64(&random, seed);
+	NewMemArenaTestSet(memArena, setOut, 0, numActions);
+	
+	const AllocAlignment_t alignments[] = { AllocAlignment_4Bytes, AllocAlignment_8Bytes, AllocAlignment_16Bytes, AllocAlignment_64Bytes };
+	u64 numAlignments = 0;
+	while (numAlignments < ArrayCount(alignments) && alignments[numAlignments] <= maxAlignment) { numAlignments++; }
+	
+	u64* liveIndices = AllocArray(memArena, u64, maxNumLive);
+	u64* liveSizes = AllocArray(memArena, u64, maxNumLive);
+	NotNull2(liveIndices, liveSizes);
+	u64 numLive = 0;
+	
+	for (u64 aIndex = 0; aIndex < numActions; aIndex++)
+	{
+		MemArenaTestAction_t* action = VarArrayAdd(&setOut->actions, MemArenaTestAction_t);
+		NotNull(action);
+		ClearPointer(action);
+		u64 roll = GetRandU64(&random, 0, 100);
+		if (numLive == 0 || (roll < 45 && numLive < maxNumLive))
+		{
+			action->type = MemArenaTestActionType_Alloc;
+			action->size = GetRandU64(&random, minAllocSize, maxAllocSize+1);
+			if (numAlignments > 0 && GetRandU64(&random, 0, 4) == 0) { action->alignment = alignments[GetRandU64(&random, 0, numAlignments)]; }
+			action->allocIndex = setOut->numTotalAllocations++;
+			liveIndices[numLive] = action->allocIndex;
+			liveSizes[numLive] = action->size;
+			numLive++;
+		}
+		else if (roll < 75)
+		{
+			u64 liveIndex = GetRandU64(&random, 0, numLive);
+			action->type = MemArenaTestActionType_Free;
+			action->allocIndex = liveIndices[liveIndex];
+			action->size = liveSizes[liveIndex];
+			liveIndices[liveIndex] = liveIndices[numLive-1];
+			liveSizes[liveIndex] = liveSizes[numLive-1];
+			numLive--;
+		}
+		else
+		{
+			u64 liveIndex = GetRandU64(&random, 0, numLive);
+			action->type = MemArenaTestActionType_Realloc;
+			action->oldAllocIndex = liveIndices[liveIndex];
+			action->oldSize = liveSizes[liveIndex];
+			action->size = GetRandU64(&random, minAllocSize, maxAllocSize+1);
+			action->allocIndex = setOut->numTotalAllocations++;
+			liveIndices[liveIndex] = action->allocIndex;
+			liveSizes[liveIndex] = action->size;
+		}
+	}
+	
+	FreeMem(memArena, liveSizes, sizeof(u64) * maxNumLive);
+	FreeMem(memArena, liveIndices, sizeof(u64) * maxNumLive);
+}
+
+// +--------------------------------------------------------------+
+// |                       Verified Replay                        |
+// +--------------------------------------------------------------+
+//Never 0 so a zeroed allocation doesn't pass for a filled one
+u8 GetMemArenaTestFillValue(u64 allocIndex)
+{
+	return (u8)((allocIndex % 251) + 1);
+}
+bool IsMemArenaTestFillIntact(const void* allocPntr, u64 size, u8 fillValue)
+{
+	const u8* bytePntr = (const u8*)allocPntr;
+	for (u64 bIndex = 0; bIndex < size; bIndex++) { if (bytePntr[bIndex] != fillValue) { return false; } }
+	return true;
+}
+
+//Replays the set like MemArenaTestSetRunBenchmark but checks the arena after every action instead of timing it. Each allocation is filled
+//with a value unique to it and checked before it's freed or resized (so overlapping allocations get caught), ReallocMem has to keep the
+//contents, and MemArenaVerify has to pass (StdHeap and Redirect arenas have nothing to verify). Pass resizeInPlace to do shrinking
+//reallocs with ShrinkMem and growing ones with GrowMem whenever GrowMemQuery says there is room (falling back to ReallocMem otherwise)
+void MemArenaTestSetRunVerified(MemArena_t* memArena, const MemArenaTestSet_t* set, MemArena_t* scratchArena, bool resizeInPlace = false)
+{
+	NotNull3(memArena, set, scratchArena);
+	bool canVerify = (memArena->type != MemArenaType_StdHeap && memArena->type != MemArenaType_Redirect);
+	u64 numAllocations = MaxU64(set->numTotalAllocations, set->allocations.length);
+	MemArenaTestAllocation_t* allocations = nullptr;
+	if (numAllocations > 0)
+	{
+		allocations = AllocArray(scratchArena, MemArenaTestAllocation_t, numAllocations);
+		NotNull(allocations);
+		MyMemSet(allocations, 0x00, sizeof(MemArenaTestAllocation_t) * numAllocations);
+	}
+	
+	VarArrayLoop(&set->actions, aIndex)
+	{
+		VarArrayLoopGet(MemArenaTestAction_t, action, &set->actions, aIndex);
+		Assert(action->allocIndex < numAllocations);
+		MemArenaTestAllocation_t* allocation = &allocations[action->allocIndex];
+		switch (action->type)
+		{
+			case MemArenaTestActionType_Alloc:
+			{
+				allocation->pntr = AllocMem(memArena, action->size, action->alignment);
+				NotNull(allocation->pntr);
+				Assert(action->alignment == AllocAlignment_None || IsAlignedTo(allocation->pntr, action->alignment));
+				allocation->originalSize = action->size;
+				MyMemSet(allocation->pntr, GetMemArenaTestFillValue(action->allocIndex), action->size);
+			} break;
+			
+			case MemArenaTestActionType_Free:
+			{
+				NotNull(allocation->pntr);
+				AssertMsg(IsMemArenaTestFillIntact(allocation->pntr, action->size, GetMemArenaTestFillValue(action->allocIndex)), "An allocation was overwritten before it was freed");
+				FreeMem(memArena, allocation->pntr, action->size);
+				allocation->pntr = nullptr;
+			} break;
+			
+			case MemArenaTestActionType_Realloc:
+			{
+				void* oldPntr = nullptr;
+				u8 oldFillValue = 0;
+				if (action->oldAllocIndex < numAllocations)
+				{
+					oldPntr = allocations[action->oldAllocIndex].pntr;
+					oldFillValue = GetMemArenaTestFillValue(action->oldAllocIndex);
+					NotNull(oldPntr);
+					AssertMsg(IsMemArenaTestFillIntact(oldPntr, action->oldSize, oldFillValue), "An allocation was overwritten before it was reallocated");
+				}
+				
+				void* newPntr = nullptr;
+				if (resizeInPlace && oldPntr != nullptr && action->size <= action->oldSize)
+				{
+					if (action->size < action->oldSize) { ShrinkMem(memArena, oldPntr, action->oldSize, action->size); }
+					newPntr = oldPntr;
+				}
+				else if (resizeInPlace && oldPntr != nullptr)
+				{
+					GrowMemToken_t growToken = {};
+					u64 growRoom = GrowMemQuery(memArena, oldPntr, action->oldSize, &growToken);
+					if (action->size - action->oldSize <= growRoom)
+					{
+						GrowMem(memArena, oldPntr, action->oldSize, action->size, &growToken);
+						newPntr = oldPntr;
+					}
+				}
+				if (newPntr == nullptr) { newPntr = ReallocMem(memArena, oldPntr, action->size, action->oldSize, action->alignment, (oldPntr == nullptr)); }
+				NotNull(newPntr);
+				
+				if (oldPntr != nullptr)
+				{
+					AssertMsg(IsMemArenaTestFillIntact(newPntr, MinU64(action->size, action->oldSize), oldFillValue), "ReallocMem didn't keep the contents of the allocation");
+					allocations[action->oldAllocIndex].pntr = nullptr;
+				}
+				allocation->pntr = newPntr;
+				allocation->originalSize = action->size;
+				MyMemSet(allocation->pntr, GetMemArenaTestFillValue(action->allocIndex), action->size);
+			} break;
+			
+			default: AssertMsg(false, "Unknown action type in MemArenaTestSet"); break;
+		}
+		if (canVerify) { MemArenaVerify(memArena, true); }
+	}
+	
+	for (u64 aIndex = 0; aIndex < numAllocations; aIndex++)
+	{
+		if (allocations[aIndex].pntr != nullptr)
+		{
+			Assert(IsMemArenaTestFillIntact(allocations[aIndex].pntr, allocations[aIndex].originalSize, GetMemArenaTestFillValue(aIndex)));
+			FreeMem(memArena, allocations[aIndex].pntr, allocations[aIndex].originalSize);
+		}
+	}
+	if (canVerify) { MemArenaVerify(memArena, true); }
+	if (allocations != nullptr) { FreeMem(scratchArena, allocations, sizeof(MemArenaTestAllocation_t) * numAllocations); }
+}
+
+// +--------------------------------------------------------------+
+// |                         Arena Cases                          |
+// +--------------------------------------------------------------+
+//Generates a random set, saves it to the binary trace format and loads it back (like a trace recorded from a live process)
+//then replays it against memArena with MemArenaTestSetRunVerified. The set and trace come out of scratchArena
+void GyTestCase_MemArenaReplay(MemArena_t* memArena, MemArena_t* scratchArena, u64 seed, u64 numActions, u64 minAllocSize, u64 maxAllocSize, u64 maxNumLive, AllocAlignment_t maxAlignment, bool resizeInPlace)
+{
+	NotNull2(memArena, scratchArena);
+	MemArenaTestSet_t recordedSet;
+	GenerateMemArenaTestSet(scratchArena, &recordedSet, seed, numActions, minAllocSize, maxAllocSize, maxNumLive, maxAlignment);
+	MyStr_t trace = SerializeMemArenaTestSet(&recordedSet, scratchArena);
+	NotNull(trace.chars);
+	MemArenaTestSet_t replaySet;
+	Assert(DeserializeMemArenaTestSet(trace, scratchArena, &replaySet));
+	Assert(replaySet.actions.length == recordedSet.actions.length);
+	Assert(replaySet.numTotalAllocations == recordedSet.numTotalAllocations);
+	
+	MemArenaTestSetRunVerified(memArena, &replaySet, scratchArena, resizeInPlace);
+	
+	FreeMemArenaTestSet(&replaySet);
+	FreeMem(scratchArena, trace.chars, trace.length);
+	FreeMemArenaTestSet(&recordedSet);
+}
+
+//Sizes go a little past SLAB_MAX_SLOT_SIZE so some allocations get passed through to a PagedHeap (which, unlike StdHeap, can keep their alignment)
+void GyTestCase_SlabArena(MemArena_t* sourceArena, MemArena_t* scratchArena, u64 seed, u64 numActions)
+{
+	NotNull2(sourceArena, scratchArena);
+	MemArena_t heap;
+	InitMemArena_PagedHeapArena(&heap, Kilobytes(64), sourceArena);
+	MemArena_t slab;
+	InitMemArena_Slab(&slab, Kilobytes(16), &heap);
+	GyTestCase_MemArenaReplay(&slab, scratchArena, seed, numActions, 1, SLAB_MAX_SLOT_SIZE + 512, 256, AllocAlignment_Max, false);
+	GyTestCase_MemArenaReplay(&slab, scratchArena, seed+1, numActions, 1, SLAB_MAX_SLOT_SIZE + 512, 256, AllocAlignment_Max, true);
+	Assert(slab.used == 0 && slab.numAllocations == 0);
+	FreeMemArena(&slab);
+	Assert(heap.numAllocations == 0);
+	FreeMemArena(&heap);
+}
+
+//Allocations go up to a quarter of a page so pages fill up, get added, and empty out again. The second pass resizes with GrowMem and ShrinkMem
+void GyTestCase_PagedHeapArena(MemArena_t* sourceArena, MemArena_t* scratchArena, u64 seed, u64 numActions)
+{
+	NotNull2(sourceArena, scratchArena);
+	MemArena_t heap;
+	InitMemArena_PagedHeapArena(&heap, Kilobytes(64), sourceArena);
+	GyTestCase_MemArenaReplay(&heap, scratchArena, seed, numActions, 1, Kilobytes(16), 128, AllocAlignment_Max, false);
+	GyTestCase_MemArenaReplay(&heap, scratchArena, seed+1, numActions, 1, Kilobytes(16), 128, AllocAlignment_Max, true);
+	Assert(heap.numAllocations == 0); //used doesn't go back to 0, it keeps counting the sentinel at the end of each page
+	FreeMemArena(&heap);
+}
+
+//Single threaded, see StartThreadCachedArenaThreadTest for the threaded version
+void GyTestCase_ThreadCachedArena(MemArena_t* sourceArena, MemArena_t* scratchArena, u64 seed, u64 numActions)
+{
+	NotNull2(sourceArena, scratchArena);
+	MemArena_t heap;
+	InitMemArena_PagedHeapArena(&heap, Kilobytes(64), sourceArena);
+	MemArena_t arena;
+	InitMemArena_ThreadCached(&arena, &heap, 16);
+	GyTestCase_MemArenaReplay(&arena, scratchArena, seed, numActions, 1, SLAB_MAX_SLOT_SIZE + 512, 256, AllocAlignment_Max, false);
+	GyTestCase_MemArenaReplay(&arena, scratchArena, seed+1, numActions, 1, SLAB_MAX_SLOT_SIZE + 512, 256, AllocAlignment_Max, true);
+	ReleaseThreadCache(&arena);
+	Assert(arena.used == 0 && arena.numAllocations == 0);
+	MemArenaVerify(&arena, true);
+	FreeMemArena(&arena);
+	Assert(heap.numAllocations == 0);
+	FreeMemArena(&heap);
+}
+
+//Sizes straddle STD_HEAP_REMAP_THRESHOLD so ReallocMem moves allocations in and out of their own mappings and mremaps the ones that stay mapped
+void GyTestCase_StdHeapRemap(MemArena_t* scratchArena, u64 seed, u64 numActions)
+{
+	NotNull(scratchArena);
+	MemArena_t stdHeap;
+	InitMemArena_StdHeap(&stdHeap);
+	GyTestCase_MemArenaReplay(&stdHeap, scratchArena, seed, numActions, STD_HEAP_REMAP_THRESHOLD/2, STD_HEAP_REMAP_THRESHOLD*4, 8, AllocAlignment_None, false);
+	GyTestCase_MemArenaReplay(&stdHeap, scratchArena, seed+1, numActions, STD_HEAP_REMAP_THRESHOLD/2, STD_HEAP_REMAP_THRESHOLD*4, 8, AllocAlignment_None, true);
+	Assert(stdHeap.numAllocations == 0);
+	
+	#if STD_HEAP_REMAP_SUPPORTED
+	u64 pageSize = OsGetMemoryPageSize();
+	u64 allocSize = STD_HEAP_REMAP_THRESHOLD + 100;
+	u8* allocPntr = (u8*)AllocMem(&stdHeap, allocSize);
+	NotNull(allocPntr);
+	Assert(GetStdHeapMappedPrefix(allocPntr) != nullptr);
+	MyMemSet(allocPntr, 0xAB, allocSize);
+	u64 growRoom = GrowMemQuery(&stdHeap, allocPntr, allocSize);
+	Assert(((u64)sizeof(StdHeapMappedPrefix_t) + allocSize + growRoom) % pageSize == 0); //the rest of the last page
+	Assert(GrowMemQuery(&stdHeap, allocPntr, allocSize) == growRoom); //asking doesn't change anything
+	u8* bigPntr = (u8*)ReallocMem(&stdHeap, allocPntr, allocSize * 4, allocSize);
+	NotNull(bigPntr);
+	Assert(GetStdHeapMappedPrefix(bigPntr) != nullptr);
+	Assert(IsMemArenaTestFillIntact(bigPntr, allocSize, 0xAB));
+	u8* smallPntr = (u8*)ReallocMem(&stdHeap, bigPntr, STD_HEAP_REMAP_THRESHOLD/4, allocSize * 4);
+	NotNull(smallPntr);
+	Assert(GetStdHeapMappedPrefix(smallPntr) == nullptr); //went back to malloc
+	Assert(IsMemArenaTestFillIntact(smallPntr, STD_HEAP_REMAP_THRESHOLD/4, 0xAB));
+	FreeMem(&stdHeap, smallPntr, STD_HEAP_REMAP_THRESHOLD/4);
+	#endif
+}
+
+//Each frame makes a random number of allocations and every frame that's still live gets checked before the oldest one is retired.
+//The ring is small compared to the total so it wraps around many times
+void GyTestCase_RingArena(MemArena_t* sourceArena, u64 seed, u64 numFrames, u64 ringSize, u64 maxNumFrames)
+{
+	NotNull(sourceArena);
+	Assert(maxNumFrames >= 2);
+	RandomSeries_t random;
+	CreateRandomSeries(&random);
+	SeedRandomSeriesU64(&random, seed);
+	
+	u8* ringMemory = AllocArray(sourceArena, u8, ringSize);
+	NotNull(ringMemory);
+	MemArena_t ring;
+	InitMemArena_Ring(&ring, ringSize, ringMemory, maxNumFrames);
+	//Keep the frames that are live at once to half the ring so wasted space at the wrap point never runs us out of room
+	u64 frameBudget = ring.size / (2 * maxNumFrames);
+	u64 maxAllocSize = MaxU64(frameBudget / 4, 1);
+	u64 maxAllocsPerFrame = frameBudget;
+	Assert(frameBudget > 0);
+	
+	MemArenaTestAllocation_t* allocations = AllocArray(sourceArena, MemArenaTestAllocation_t, maxNumFrames * maxAllocsPerFrame);
+	u64* frameNumAllocs = AllocArray(sourceArena, u64, maxNumFrames);
+	NotNull2(allocations, frameNumAllocs);
+	MyMemSet(frameNumAllocs, 0x00, sizeof(u64) * maxNumFrames);
+	
+	u64 numWraps = 0;
+	u8* prevAllocPntr = nullptr;
+	for (u64 fIndex = 0; fIndex < numFrames; fIndex++)
+	{
+		u64 frameId = GetCurrentRingFrame(&ring);
+		u64 frameSlot = frameId % maxNumFrames;
+		MemArenaTestAllocation_t* frameAllocs = &allocations[frameSlot * maxAllocsPerFrame];
+		u64 numAllocs = 0;
+		u64 bytesLeft = frameBudget;
+		while (bytesLeft > 0 && numAllocs < maxAllocsPerFrame)
+		{
+			u64 allocSize = GetRandU64(&random, 1, MinU64(maxAllocSize, bytesLeft) + 1);
+			u8* allocPntr = (u8*)AllocMem(&ring, allocSize);
+			NotNull(allocPntr);
+			Assert(IsPntrInsideRange(allocPntr, ring.mainPntr, ring.size) && IsPntrInsideRange(allocPntr + allocSize, ring.mainPntr, ring.size, true));
+			if (prevAllocPntr != nullptr && allocPntr < prevAllocPntr) { numWraps++; }
+			prevAllocPntr = allocPntr;
+			MyMemSet(allocPntr, GetMemArenaTestFillValue(frameId), allocSize);
+			frameAllocs[numAllocs].pntr = allocPntr;
+			frameAllocs[numAllocs].originalSize = allocSize;
+			numAllocs++;
+			bytesLeft -= allocSize;
+			if (GetRandU64(&random, 0, 8) == 0)
+			{
+				//Freeing the most recent allocation gives the space back right away
+				numAllocs--;
+				u64 usedBefore = ring.used;
+				FreeMem(&ring, frameAllocs[numAllocs].pntr, frameAllocs[numAllocs].originalSize);
+				Assert(ring.used <= usedBefore - frameAllocs[numAllocs].originalSize);
+				prevAllocPntr = (numAllocs > 0) ? (u8*)frameAllocs[numAllocs-1].pntr : nullptr;
+			}
+		}
+		frameNumAllocs[frameSlot] = numAllocs;
+		MemArenaVerify(&ring, true);
+		
+		u64 oldestLiveId = (frameId + 2 >= maxNumFrames) ? (frameId + 2 - maxNumFrames) : 0;
+		for (u64 liveId = oldestLiveId; liveId <= frameId; liveId++)
+		{
+			u64 liveSlot = liveId % maxNumFrames;
+			for (u64 aIndex = 0; aIndex < frameNumAllocs[liveSlot]; aIndex++)
+			{
+				const MemArenaTestAllocation_t* allocation = &allocations[(liveSlot * maxAllocsPerFrame) + aIndex];
+				AssertMsg(IsMemArenaTestFillIntact(allocation->pntr, allocation->originalSize, GetMemArenaTestFillValue(liveId)), "A Ring arena allocation was overwritten while it's frame was still live");
+			}
+		}
+		
+		AdvanceRingFrame(&ring);
+		if (frameId + 2 >= maxNumFrames)
+		{
+			u64 retireId = frameId + 2 - maxNumFrames;
+			RetireRingFrame(&ring, retireId);
+			frameNumAllocs[retireId % maxNumFrames] = 0;
+			MemArenaVerify(&ring, true);
+		}
+	}
+	Assert(numFrames < maxNumFrames * 4 || numWraps > 0);
+	
+	RetireRingFrame(&ring, GetCurrentRingFrame(&ring) - 1);
+	Assert(ring.used == 0 && ring.numAllocations == 0);
+	FreeMem(sourceArena, frameNumAllocs, sizeof(u64) * maxNumFrames);
+	FreeMem(sourceArena, allocations, sizeof(MemArenaTestAllocation_t) * maxNumFrames * maxAllocsPerFrame);
+	FreeMem(sourceArena, ringMemory, ringSize);
+}
+
+//Leaves the file the way it found it (everything happens inside a mark that gets popped at the end) so it's fine to point this at the same path every run
+void GyTestCase_MappedFileArena(const char* filePath, u64 seed, u64 numAllocations)
+{
+	NotNull(filePath);
+	Assert(numAllocations > 0);
+	RandomSeries_t random;
+	CreateRandomSeries(&random);
+	SeedRandomSeriesU64(&random, seed);
+	const u64 maxSize = Megabytes(4);
+	const u64 maxAllocSize = maxSize / (numAllocations * 2);
+	Assert(maxAllocSize > sizeof(u64) * 2);
+	
+	MemArena_t fileArena;
+	Assert(InitMemArena_MappedFile(&fileArena, filePath, maxSize, 8));
+	u64 startUsed = fileArena.used;
+	u64 startNumMarks = GetNumMarks(&fileArena);
+	PushMemMark(&fileArena);
+	
+	//The root is a table of offsets (not pntrs) to each allocation, each allocation starts with it's own size
+	u64* offsets = AllocArray(&fileArena, u64, numAllocations);
+	NotNull(offsets);
+	SetMappedFileRoot(&fileArena, offsets);
+	for (u64 aIndex = 0; aIndex < numAllocations; aIndex++)
+	{
+		u64 allocSize = GetRandU64(&random, sizeof(u64) * 2, maxAllocSize + 1);
+		u8* allocPntr = (u8*)AllocMem(&fileArena, allocSize);
+		NotNull(allocPntr);
+		*((u64*)allocPntr) = allocSize;
+		MyMemSet(allocPntr + sizeof(u64), GetMemArenaTestFillValue(aIndex), allocSize - sizeof(u64));
+		offsets[aIndex] = GetMappedFileOffset(&fileArena, allocPntr);
+		Assert(GetMappedFilePntr(&fileArena, offsets[aIndex]) == allocPntr);
+		if (GetRandU64(&random, 0, 4) == 0)
+		{
+			//Anything allocated inside a mark that gets popped right away shouldn't show up after reopening
+			PushMemMark(&fileArena);
+			u64 usedBeforeTemp = fileArena.used;
+			u8* tempPntr = (u8*)AllocMem(&fileArena, allocSize);
+			NotNull(tempPntr);
+			MyMemSet(tempPntr, 0xFF, allocSize);
+			PopMemMark(&fileArena);
+			Assert(fileArena.used == usedBeforeTemp);
+		}
+	}
+	MemArenaVerify(&fileArena, true);
+	u64 syncedUsed = fileArena.used;
+	u64 syncedNumAllocations = fileArena.numAllocations;
+	Assert(SyncMappedFileArena(&fileArena));
+	FreeMemArena(&fileArena);
+	
+	Assert(InitMemArena_MappedFile(&fileArena, filePath, maxSize, 8));
+	Assert(fileArena.used == syncedUsed);
+	Assert(fileArena.numAllocations == syncedNumAllocations);
+	Assert(GetNumMarks(&fileArena) == startNumMarks + 1);
+	MemArenaVerify(&fileArena, true);
+	offsets = (u64*)GetMappedFileRoot(&fileArena);
+	NotNull(offsets);
+	for (u64 aIndex = 0; aIndex < numAllocations; aIndex++)
+	{
+		u8* allocPntr = (u8*)GetMappedFilePntr(&fileArena, offsets[aIndex]);
+		NotNull(allocPntr);
+		u64 allocSize = *((u64*)allocPntr);
+		Assert(allocSize >= sizeof(u64) * 2 && allocSize <= maxAllocSize);
+		AssertMsg(IsMemArenaTestFillIntact(allocPntr + sizeof(u64), allocSize - sizeof(u64), GetMemArenaTestFillValue(aIndex)), "MappedFile arena contents didn't survive reopening the file");
+	}
+	
+	PopMemMark(&fileArena);
+	Assert(fileArena.used == startUsed);
+	Assert(GetNumMarks(&fileArena) == startNumMarks);
+	SetMappedFileRoot(&fileArena, nullptr);
+	Assert(SyncMappedFileArena(&fileArena));
+	FreeMemArena(&fileArena);
+}
+
+//Allocations are sometimes page or huge page aligned and marks get pushed and popped along the way. Everything still live is checked after every pop.
+//With useHugePages the arena should be reserved on a huge page boundary and commit in huge page sized chunks (whether or not the OS takes the advice)
+void GyTestCase_VirtualStackArena(MemArena_t* scratchArena, u64 seed, u64 numAllocations, bool useHugePages)
+{
+	NotNull(scratchArena);
+	Assert(numAllocations > 0);
+	RandomSeries_t random;
+	CreateRandomSeries(&random);
+	SeedRandomSeriesU64(&random, seed);
+	const u64 maxNumMarks = 16;
+	const AllocAlignment_t alignments[] = { AllocAlignment_None, AllocAlignment_16Bytes, AllocAlignment_Max, AllocAlignment_4Kilobytes, AllocAlignment_2Megabytes };
+	
+	MemArena_t stack;
+	InitMemArena_VirtualStack(&stack, Gigabytes(1), maxNumMarks, AllocAlignment_None, useHugePages);
+	u64 hugePageSize = OsGetHugePageSize();
+	if (useHugePages && hugePageSize > OsGetMemoryPageSize())
+	{
+		Assert(stack.pageSize == hugePageSize);
+		Assert(((u64)stack.headerPntr % hugePageSize) == 0);
+	}
+	else
+	{
+		Assert(stack.pageSize == OsGetMemoryPageSize());
+		Assert(IsFlagSet(stack.flags, MemArenaFlag_HugePages) == false);
+	}
+	u64 headerAndMarksSize = (u64)((u8*)stack.mainPntr - (u8*)stack.headerPntr);
+	
+	MemArenaTestAllocation_t* allocations = AllocArray(scratchArena, MemArenaTestAllocation_t, numAllocations);
+	NotNull(allocations);
+	u64 markNumLive[maxNumMarks];
+	u64 markUsed[maxNumMarks];
+	u64 numMarks = 0;
+	u64 numLive = 0;
+	for (u64 aIndex = 0; aIndex < numAllocations; aIndex++)
+	{
+		//Huge page alignment is rare so a long run doesn't spend most of the reservation on padding
+		u64 alignmentIndex = GetRandU64(&random, 0, ArrayCount(alignments) - 1);
+		if (GetRandU64(&random, 0, 16) == 0) { alignmentIndex = ArrayCount(alignments) - 1; }
+		AllocAlignment_t alignment = alignments[alignmentIndex];
+		u64 allocSize = GetRandU64(&random, 1, Kilobytes(64) + 1);
+		u8* allocPntr = (u8*)AllocMem(&stack, allocSize, alignment);
+		NotNull(allocPntr);
+		Assert(IsAlignedTo(allocPntr, alignment));
+		Assert(stack.used <= stack.size && ((headerAndMarksSize + stack.size) % stack.pageSize) == 0);
+		MyMemSet(allocPntr, GetMemArenaTestFillValue(numLive), allocSize); //filled by slot so the value is still right after a pop reuses slots
+		allocations[numLive].pntr = allocPntr;
+		allocations[numLive].originalSize = allocSize;
+		numLive++;
+		
+		u64 markRoll = GetRandU64(&random, 0, 8);
+		if (markRoll == 0 && numMarks < maxNumMarks)
+		{
+			markNumLive[numMarks] = numLive;
+			markUsed[numMarks] = stack.used;
+			PushMemMark(&stack);
+			numMarks++;
+		}
+		else if (markRoll == 1 && numMarks > 0)
+		{
+			numMarks--;
+			PopMemMark(&stack);
+			Assert(stack.used == markUsed[numMarks]);
+			numLive = markNumLive[numMarks];
+			for (u64 lIndex = 0; lIndex < numLive; lIndex++)
+			{
+				const MemArenaTestAllocation_t* allocation = &allocations[lIndex];
+				AssertMsg(IsMemArenaTestFillIntact(allocation->pntr, allocation->originalSize, GetMemArenaTestFillValue(lIndex)), "A VirtualStack allocation below the popped mark was overwritten");
+			}
+			MemArenaVerify(&stack, true);
+		}
+	}
+	Assert(GetNumMarks(&stack) == numMarks);
+	
+	FreeMem(scratchArena, allocations, sizeof(MemArenaTestAllocation_t) * numAllocations);
+	FreeMemArena(&stack);
+}
+
+#if GYLIB_MEM_ARENA_DEBUG_ENABLED
+//The replay has MemArenaVerify check that every live allocation has an alloc info after each step. Then we check the table directly:
+//every entry has to be found with the right size and callsite, and removing entries (backward shift deletion) can't lose any of the others
+void GyTestCase_MemArenaAllocInfo(MemArena_t* sourceArena, MemArena_t* scratchArena, u64 seed, u64 numAllocations)
+{
+	NotNull2(sourceArena, scratchArena);
+	Assert(numAllocations > 0);
+	RandomSeries_t random;
+	CreateRandomSeries(&random);
+	SeedRandomSeriesU64(&random, seed);
+	const char* testFilePath = "gy_test_memory.h";
+	
+	MemArena_t heap;
+	InitMemArena_PagedHeapArena(&heap, Kilobytes(64), sourceArena);
+	heap.debugArena = scratchArena;
+	GyTestCase_MemArenaReplay(&heap, scratchArena, seed, numAllocations * 4, 1, Kilobytes(4), numAllocations, AllocAlignment_Max, false);
+	Assert(heap.numAllocations == 0 && heap.allocInfoTable.count == 0);
+	
+	MemArenaTestAllocation_t* allocations = AllocArray(scratchArena, MemArenaTestAllocation_t, numAllocations);
+	NotNull(allocations);
+	for (u64 aIndex = 0; aIndex < numAllocations; aIndex++)
+	{
+		allocations[aIndex].originalSize = GetRandU64(&random, 1, 256 + 1);
+		allocations[aIndex].pntr = AllocMem_(testFilePath, aIndex + 1, __func__, &heap, allocations[aIndex].originalSize);
+		NotNull(allocations[aIndex].pntr);
+	}
+	const MemArenaAllocInfoTable_t* table = &heap.allocInfoTable;
+	Assert(table->count == numAllocations);
+	Assert((table->capacity & (table->capacity - 1)) == 0);
+	Assert(table->count * MEM_ARENA_ALLOC_INFO_TABLE_MAX_LOAD_DENOM <= table->capacity * MEM_ARENA_ALLOC_INFO_TABLE_MAX_LOAD_NUM);
+	
+	//Free about half of them (in a random order, so entries get shifted back over each other) and make sure the rest can all still be found
+	u64 numFreed = 0;
+	for (u64 aIndex = 0; aIndex < numAllocations; aIndex++)
+	{
+		u64 freeIndex = GetRandU64(&random, 0, numAllocations);
+		if (allocations[freeIndex].originalSize == 0) { continue; }
+		FreeMem(&heap, allocations[freeIndex].pntr, allocations[freeIndex].originalSize);
+		Assert(FindAllocInfoFor(&heap, allocations[freeIndex].pntr) == nullptr);
+		allocations[freeIndex].originalSize = 0; //freed, but we keep the pntr to check it stays out of the table
+		numFreed++;
+	}
+	Assert(table->count == numAllocations - numFreed && table->count == heap.numAllocations);
+	for (u64 aIndex = 0; aIndex < numAllocations; aIndex++)
+	{
+		MemArenaAllocInfo_t* allocInfo = FindAllocInfoFor(&heap, allocations[aIndex].pntr);
+		if (allocations[aIndex].originalSize == 0) { Assert(allocInfo == nullptr); continue; }
+		NotNull(allocInfo);
+		Assert(allocInfo->allocPntr == allocations[aIndex].pntr);
+		Assert(allocInfo->allocSize == allocations[aIndex].originalSize);
+		Assert(allocInfo->filePath == testFilePath && allocInfo->lineNumber == aIndex + 1);
+	}
+	MemArenaVerify(&heap, true);
+	
+	//ReallocMem moves the entry (if the allocation moved) and updates the size and callsite
+	for (u64 aIndex = 0; aIndex < numAllocations; aIndex++)
+	{
+		if (allocations[aIndex].originalSize == 0) { continue; }
+		u64 newSize = allocations[aIndex].originalSize * 8;
+		void* newPntr = ReallocMem_(testFilePath, numAllocations + aIndex + 1, __func__, &heap, allocations[aIndex].pntr, newSize, allocations[aIndex].originalSize);
+		NotNull(newPntr);
+		if (newPntr != allocations[aIndex].pntr) { Assert(FindAllocInfoFor(&heap, allocations[aIndex].pntr) == nullptr); }
+		MemArenaAllocInfo_t* allocInfo = FindAllocInfoFor(&heap, newPntr);
+		NotNull(allocInfo);
+		Assert(allocInfo->allocSize == newSize && allocInfo->lineNumber == numAllocations + aIndex + 1);
+		allocations[aIndex].pntr = newPntr;
+		allocations[aIndex].originalSize = newSize;
+	}
+	Assert(table->count == heap.numAllocations);
+	MemArenaVerify(&heap, true);
+	
+	for (u64 aIndex = 0; aIndex < numAllocations; aIndex++)
+	{
+		if (allocations[aIndex].originalSize > 0) { FreeMem(&heap, allocations[aIndex].pntr, allocations[aIndex].originalSize); }
+	}
+	Assert(heap.numAllocations == 0 && table->count == 0);
+	FreeMem(scratchArena, allocations, sizeof(MemArenaTestAllocation_t) * numAllocations);
+	FreeMemArena(&heap);
+}
+#endif //GYLIB_MEM_ARENA_DEBUG_ENABLED
+
+#if MEM_ARENA_SNAPSHOTS_SUPPORTED
+//Each tick scribbles over live allocations, makes new ones (committing pages past what the snapshot protected) and maybe pushes a mark, then restores.
+//Every few ticks it keeps the tick's work and re-takes the snapshot instead, so the next restore has to come back to that new state
+void GyTestCase_MemArenaSnapshot(MemArena_t* scratchArena, u64 seed, u64 numTicks)
+{
+	NotNull(scratchArena);
+	RandomSeries_t random;
+	CreateRandomSeries(&random);
+	SeedRandomSeriesU64(&random, seed);
+	const u64 maxNumMarks = 8;
+	const u64 maxNumLive = 256;
+	const u64 maxAllocSize = Kilobytes(16);
+	
+	MemArena_t stack;
+	InitMemArena_VirtualStack(&stack, Megabytes(64), maxNumMarks);
+	MemArenaTestAllocation_t* allocations = AllocArray(scratchArena, MemArenaTestAllocation_t, maxNumLive);
+	NotNull(allocations);
+	u64 numLive = 0;
+	while (numLive < maxNumLive/4)
+	{
+		allocations[numLive].originalSize = GetRandU64(&random, 1, maxAllocSize + 1);
+		allocations[numLive].pntr = AllocMem(&stack, allocations[numLive].originalSize);
+		NotNull(allocations[numLive].pntr);
+		MyMemSet(allocations[numLive].pntr, GetMemArenaTestFillValue(numLive), allocations[numLive].originalSize);
+		numLive++;
+	}
+	
+	MemArenaSnapshot_t snapshot;
+	Assert(InitMemArenaSnapshot(&snapshot, &stack));
+	Assert(IsFlagSet(stack.flags, MemArenaFlag_Snapshotted));
+	Assert(snapshot.numDirtyPages == 0);
+	u64 snapshotNumLive = numLive;
+	u64 snapshotUsed = stack.used;
+	u64 snapshotNumAllocations = stack.numAllocations;
+	u64 snapshotNumMarks = GetNumMarks(&stack);
+	
+	u64 numRetakes = 0;
+	for (u64 tIndex = 0; tIndex < numTicks; tIndex++)
+	{
+		//Fill values are never 0 so any scribble that survives a restore gets caught below
+		u64 numScribbles = GetRandU64(&random, 1, 8);
+		for (u64 sIndex = 0; sIndex < numScribbles; sIndex++)
+		{
+			const MemArenaTestAllocation_t* allocation = &allocations[GetRandU64(&random, 0, numLive)];
+			MyMemSet(allocation->pntr, 0x00, allocation->originalSize);
+		}
+		Assert(snapshot.numDirtyPages > 0);
+		if (GetNumMarks(&stack) < maxNumMarks && GetRandU64(&random, 0, 2) == 0) { PushMemMark(&stack); }
+		u64 numNewAllocs = GetRandU64(&random, 1, 8);
+		for (u64 nIndex = 0; nIndex < numNewAllocs && numLive < maxNumLive; nIndex++)
+		{
+			allocations[numLive].originalSize = GetRandU64(&random, 1, maxAllocSize + 1);
+			allocations[numLive].pntr = AllocMem(&stack, allocations[numLive].originalSize);
+			NotNull(allocations[numLive].pntr);
+			MyMemSet(allocations[numLive].pntr, GetMemArenaTestFillValue(numLive), allocations[numLive].originalSize);
+			numLive++;
+		}
+		
+		if (GetRandU64(&random, 0, 4) == 0)
+		{
+			//Put back everything we scribbled over and make this the new point to restore to
+			for (u64 lIndex = 0; lIndex < numLive; lIndex++) { MyMemSet(allocations[lIndex].pntr, GetMemArenaTestFillValue(lIndex), allocations[lIndex].originalSize); }
+			TakeMemArenaSnapshot(&snapshot);
+			snapshotNumLive = numLive;
+			snapshotUsed = stack.used;
+			snapshotNumAllocations = stack.numAllocations;
+			snapshotNumMarks = GetNumMarks(&stack);
+			numRetakes++;
+		}
+		else
+		{
+			RestoreMemArenaSnapshot(&snapshot);
+			numLive = snapshotNumLive;
+		}
+		Assert(snapshot.numDirtyPages == 0);
+		
+		Assert(stack.used == snapshotUsed);
+		Assert(stack.numAllocations == snapshotNumAllocations);
+		Assert(GetNumMarks(&stack) == snapshotNumMarks); //the marks live in the protected pages too
+		for (u64 lIndex = 0; lIndex < numLive; lIndex++)
+		{
+			AssertMsg(IsMemArenaTestFillIntact(allocations[lIndex].pntr, allocations[lIndex].originalSize, GetMemArenaTestFillValue(lIndex)), "A MemArena snapshot didn't restore the contents of an allocation");
+		}
+		MemArenaVerify(&stack, true);
+	}
+	Assert(numTicks < 16 || numRetakes > 0);
+	
+	FreeMemArenaSnapshot(&snapshot);
+	Assert(!IsFlagSet(stack.flags, MemArenaFlag_Snapshotted));
+	MyMemSet(allocations[0].pntr, 0x00, allocations[0].originalSize); //the pages are writable again without going through the fault handler
+	FreeMem(scratchArena, allocations, sizeof(MemArenaTestAllocation_t) * maxNumLive);
+	FreeMemArena(&stack);
+}
+#endif //MEM_ARENA_SNAPSHOTS_SUPPORTED
+
+//Checks the bucket math on it's own, then that an arena with histograms enabled counts every call exactly once (ReallocMem's sub-calls included)
+//and that size percentiles land within a bucket of the exact answer. The second half checks that a diff of two snapshots only holds what happened between them
+void GyTestCase_MemArenaHistograms(MemArena_t* sourceArena, MemArena_t* scratchArena, u64 seed, u64 numActions)
+{
+	NotNull2(sourceArena, scratchArena);
+	Assert(numActions > 0);
+	RandomSeries_t random;
+	CreateRandomSeries(&random);
+	SeedRandomSeriesU64(&random, seed);
+	
+	//Buckets are contiguous and (past the first few single value buckets) never wider than a quarter of their smallest value
+	for (u64 bIndex = 0; bIndex + 1 < MEM_ARENA_HISTOGRAM_NUM_BUCKETS; bIndex++)
+	{
+		u64 bucketMin = GetMemArenaHistogramBucketMin(bIndex);
+		u64 bucketMax = GetMemArenaHistogramBucketMax(bIndex);
+		Assert(bucketMin <= bucketMax && bucketMax + 1 == GetMemArenaHistogramBucketMin(bIndex + 1));
+		Assert(bucketMin < 4 || (bucketMax - bucketMin) <= bucketMin / 4);
+		Assert(GetMemArenaHistogramBucket(bucketMin) == bIndex && GetMemArenaHistogramBucket(bucketMax) == bIndex);
+	}
+	Assert(GetMemArenaHistogramBucket(UINT64_MAX) == MEM_ARENA_HISTOGRAM_NUM_BUCKETS - 1);
+	
+	MemArena_t heap;
+	InitMemArena_PagedHeapArena(&heap, Kilobytes(64), sourceArena);
+	MemArenaHistograms_t histograms;
+	EnableMemArenaHistograms(&heap, &histograms);
+	Assert(IsFlagSet(heap.flags, MemArenaFlag_Histograms));
+	
+	MemArenaTestAllocation_t* allocations = AllocArray(scratchArena, MemArenaTestAllocation_t, numActions);
+	u64* recordedSizes = AllocArray(scratchArena, u64, numActions * 2);
+	NotNull2(allocations, recordedSizes);
+	u64 numLive = 0;
+	u64 numRecordedSizes = 0;
+	u64 sizesTotal = 0;
+	u64 opCounts[MemArenaOp_NumOps] = {};
+	for (u64 aIndex = 0; aIndex < numActions; aIndex++)
+	{
+		u64 roll = GetRandU64(&random, 0, 100);
+		if (numLive == 0 || roll < 50)
+		{
+			u64 allocSize = GetRandU64(&random, 1, Kilobytes(4) + 1);
+			allocations[numLive].pntr = AllocMem(&heap, allocSize);
+			NotNull(allocations[numLive].pntr);
+			allocations[numLive].originalSize = allocSize;
+			numLive++;
+			recordedSizes[numRecordedSizes++] = allocSize;
+			sizesTotal += allocSize;
+			opCounts[MemArenaOp_Alloc]++;
+		}
+		else if (roll < 75)
+		{
+			u64 liveIndex = GetRandU64(&random, 0, numLive);
+			u64 newSize = GetRandU64(&random, 1, Kilobytes(8) + 1);
+			allocations[liveIndex].pntr = ReallocMem(&heap, allocations[liveIndex].pntr, newSize, allocations[liveIndex].originalSize);
+			NotNull(allocations[liveIndex].pntr);
+			allocations[liveIndex].originalSize = newSize;
+			recordedSizes[numRecordedSizes++] = newSize;
+			sizesTotal += newSize;
+			opCounts[MemArenaOp_Realloc]++;
+		}
+		else
+		{
+			u64 liveIndex = GetRandU64(&random, 0, numLive);
+			FreeMem(&heap, allocations[liveIndex].pntr, allocations[liveIndex].originalSize);
+			allocations[liveIndex] = allocations[numLive-1];
+			numLive--;
+			opCounts[MemArenaOp_Free]++;
+		}
+	}
+	for (u64 opIndex = 0; opIndex < MemArenaOp_NumOps; opIndex++)
+	{
+		Assert(histograms.latencies[opIndex].count == opCounts[opIndex]);
+	}
+	Assert(histograms.allocSizes.count == numRecordedSizes);
+	Assert(histograms.allocSizes.total == sizesTotal);
+	
+	QuickSortAlloc(recordedSizes, numRecordedSizes, sizeof(u64), scratchArena, CompareFuncU64);
+	Assert(histograms.allocSizes.minValue == recordedSizes[0]);
+	Assert(histograms.allocSizes.maxValue == recordedSizes[numRecordedSizes-1]);
+	const r64 percentiles[] = { 0.0, 0.5, 0.9, 0.99, 1.0 };
+	for (u64 pIndex = 0; pIndex < ArrayCount(percentiles); pIndex++)
+	{
+		u64 exactIndex = MinU64((u64)(percentiles[pIndex] * (r64)numRecordedSizes), numRecordedSizes-1);
+		u64 exactValue = recordedSizes[exactIndex];
+		u64 reportedValue = GetMemArenaHistogramPercentile(&histograms.allocSizes, percentiles[pIndex]);
+		Assert(GetMemArenaHistogramBucket(reportedValue) == GetMemArenaHistogramBucket(exactValue));
+		Assert(reportedValue >= exactValue);
+	}
+	
+	//A window where every allocation is the same size should only contain those allocations
+	const u64 windowAllocSize = 100;
+	const u64 windowNumAllocs = 10;
+	MemArenaHistograms_t before;
+	TakeMemArenaHistogramsSnapshot(&heap, &before);
+	void* windowAllocs[windowNumAllocs];
+	for (u64 wIndex = 0; wIndex < windowNumAllocs; wIndex++)
+	{
+		windowAllocs[wIndex] = AllocMem(&heap, windowAllocSize);
+		NotNull(windowAllocs[wIndex]);
+	}
+	MemArenaHistograms_t after;
+	TakeMemArenaHistogramsSnapshot(&heap, &after);
+	MemArenaHistograms_t window;
+	DiffMemArenaHistograms(&before, &after, &window);
+	Assert(window.allocSizes.count == windowNumAllocs && window.allocSizes.total == windowNumAllocs * windowAllocSize);
+	Assert(window.latencies[MemArenaOp_Alloc].count == windowNumAllocs);
+	Assert(window.latencies[MemArenaOp_Free].count == 0 && window.latencies[MemArenaOp_Realloc].count == 0);
+	Assert(window.allocSizes.minValue <= windowAllocSize && window.allocSizes.maxValue >= windowAllocSize);
+	Assert(GetMemArenaHistogramBucket(GetMemArenaHistogramPercentile(&window.allocSizes, 0.5)) == GetMemArenaHistogramBucket(windowAllocSize));
+	
+	//Once they are disabled nothing else gets recorded
+	EnableMemArenaHistograms(&heap, nullptr);
+	Assert(!IsFlagSet(heap.flags, MemArenaFlag_Histograms));
+	for (u64 wIndex = 0; wIndex < windowNumAllocs; wIndex++) { FreeMem(&heap, windowAllocs[wIndex], windowAllocSize); }
+	for (u64 lIndex = 0; lIndex < numLive; lIndex++) { FreeMem(&heap, allocations[lIndex].pntr, allocations[lIndex].originalSize); }
+	Assert(histograms.latencies[MemArenaOp_Free].count == opCounts[MemArenaOp_Free]);
+	Assert(heap.numAllocations == 0);
+	FreeMemArena(&heap);
+	
+	//GrowMem gets it's own latency histogram (and isn't counted as an alloc)
+	MemArena_t stack;
+	InitMemArena_VirtualStack(&stack, Megabytes(1), 4);
+	EnableMemArenaHistograms(&stack, &histograms);
+	void* growPntr = AllocMem(&stack, windowAllocSize);
+	NotNull(growPntr);
+	GrowMemToken_t growToken = {};
+	Assert(GrowMemQuery(&stack, growPntr, windowAllocSize, &growToken) >= windowAllocSize);
+	GrowMem(&stack, growPntr, windowAllocSize, windowAllocSize * 2, &growToken);
+	Assert(histograms.latencies[MemArenaOp_Grow].count == 1);
+	Assert(histograms.latencies[MemArenaOp_Alloc].count == 1 && histograms.allocSizes.count == 1);
+	EnableMemArenaHistograms(&stack, nullptr);
+	FreeMemArena(&stack);
+	
+	FreeMem(scratchArena, recordedSizes, sizeof(u64) * numActions * 2);
+	FreeMem(scratchArena, allocations, sizeof(MemArenaTestAllocation_t) * numActions);
+}
+
+#if STATS_PAGE_SUPPORTED
+//Publishes the counters of two arenas while they change and reads them back through a second mapping of the page (like another process would).
+//Also checks the reader's side of the sequence lock by leaving the sequence odd (like a writer that's in the middle of publishing)
+void GyTestCase_StatsPage(MemArena_t* sourceArena, u64 seed, u64 numPublishes)
+{
+	NotNull(sourceArena);
+	RandomSeries_t random;
+	CreateRandomSeries(&random);
+	SeedRandomSeriesU64(&random, seed);
+	char pageName[STATS_PAGE_NAME_MAX_LENGTH];
+	MyBufferPrintf(pageName, sizeof(pageName), "gy_test_%llu", seed);
+	
+	StatsPage_t reader;
+	Assert(!OpenStatsPage(&reader, pageName)); //nobody has created it yet
+	StatsPage_t writer;
+	Assert(CreateStatsPage(&writer, pageName));
+	Assert(OpenStatsPage(&reader, pageName));
+	
+	MemArena_t heap;
+	InitMemArena_PagedHeapArena(&heap, Kilobytes(64), sourceArena);
+	MemArena_t stack;
+	InitMemArena_VirtualStack(&stack, Megabytes(16), 4);
+	Assert(AddStatsPageArena(&writer, &heap, "heap"));
+	Assert(AddStatsPageArena(&writer, &stack, "a_stack_with_a_name_that_is_too_long_to_fit"));
+	
+	StatsPageLayout_t layout;
+	for (u64 pIndex = 0; pIndex < numPublishes; pIndex++)
+	{
+		u64 numAllocs = GetRandU64(&random, 1, 8);
+		for (u64 aIndex = 0; aIndex < numAllocs; aIndex++)
+		{
+			NotNull(AllocMem(&heap, GetRandU64(&random, 1, Kilobytes(1) + 1)));
+			NotNull(AllocMem(&stack, GetRandU64(&random, 1, Kilobytes(1) + 1)));
+		}
+		PublishStatsPage(&writer);
+		Assert((writer.layout->sequence % 2) == 0 && writer.layout->sequence == (pIndex + 1) * 2);
+		
+		Assert(ReadStatsPage(&reader, &layout, 0));
+		Assert(layout.magic == STATS_PAGE_MAGIC && layout.version == STATS_PAGE_VERSION && layout.layoutSize == sizeof(StatsPageLayout_t));
+		Assert(layout.publishCount == pIndex + 1);
+		Assert(layout.numArenas == 2);
+		Assert(MyStrCompareNt(layout.arenas[0].name, "heap") == 0);
+		Assert(MyStrLength64(layout.arenas[1].name) == STATS_PAGE_NAME_MAX_LENGTH-1);
+		Assert(layout.arenas[0].type == MemArenaType_PagedHeap && layout.arenas[1].type == MemArenaType_VirtualStack);
+		Assert(layout.arenas[0].used == heap.used && layout.arenas[0].numAllocations == heap.numAllocations && layout.arenas[0].numPages == heap.numPages);
+		Assert(layout.arenas[1].used == stack.used && layout.arenas[1].size == stack.size && layout.arenas[1].highUsedMark == stack.highUsedMark);
+	}
+	
+	//A reader has to give up (instead of returning a half written copy) while the sequence is odd, and succeed again once it's even
+	writer.layout->sequence++;
+	Assert(!ReadStatsPage(&reader, &layout, 3));
+	writer.layout->sequence++;
+	Assert(ReadStatsPage(&reader, &layout, 0));
+	Assert(layout.publishCount == numPublishes);
+	
+	//Readers that still have the page open keep seeing the last published numbers, but nobody new can open it
+	FreeStatsPage(&writer);
+	Assert(ReadStatsPage(&reader, &layout, 0) && layout.publishCount == numPublishes);
+	FreeStatsPage(&reader);
+	Assert(!OpenStatsPage(&reader, pageName));
+	
+	FreeMemArena(&stack);
+	FreeMemArena(&heap);
+}
+#endif //STATS_PAGE_SUPPORTED
+
+// +--------------------------------------------------------------+
+// |                   ThreadCached Thread Test                   |
+// +--------------------------------------------------------------+
+//Needs GYLIB_THREADING_ENABLED. sourceArena only gets used here, in FinishThreadCachedArenaThreadTest, and by the ThreadCached arena while it holds it's sourceMutex
+void StartThreadCachedArenaThreadTest(ThreadCachedArenaThreadTest_t* test, MemArena_t* sourceArena, u64 seed, u64 numThreads, u64 numActionsPerThread)
+{
+	NotNull2(test, sourceArena);
+	Assert(numThreads > 0);
+	ClearPointer(test);
+	test->sourceArena = sourceArena;
+	test->seed = seed;
+	test->numThreads = numThreads;
+	test->numActionsPerThread = numActionsPerThread;
+	test->liveBlocks = AllocArray(sourceArena, u8*, numThreads * MEM_ARENA_TEST_THREAD_MAX_LIVE);
+	NotNull(test->liveBlocks);
+	InitMemArena_PagedHeapArena(&test->heap, Kilobytes(64), sourceArena);
+	InitMemArena_ThreadCached(&test->arena, &test->heap, 16);
+	ThreadCacheArenaHeader_t* cacheHeader = (ThreadCacheArenaHeader_t*)test->arena.headerPntr;
+	AssertMsg(IsValidGyMutex(&cacheHeader->sourceMutex), "The threaded ThreadCached test needs GYLIB_THREADING_ENABLED");
+}
+
+//Blocks start with their size followed by a fill value that the rest of the block is filled with
+void RunThreadCachedArenaThreadTestWorker(ThreadCachedArenaThreadTest_t* test, u64 threadIndex)
+{
+	NotNull(test);
+	Assert(threadIndex < test->numThreads);
+	RandomSeries_t random;
+	CreateRandomSeries(&random);
+	SeedRandomSeriesU64(&random, test->seed + threadIndex);
+	u8** liveBlocks = &test->liveBlocks[threadIndex * MEM_ARENA_TEST_THREAD_MAX_LIVE];
+	u64 numLive = 0;
+	
+	for (u64 aIndex = 0; aIndex < test->numActionsPerThread; aIndex++)
+	{
+		u64 roll = GetRandU64(&random, 0, 100);
+		if (numLive == 0 || (roll < 50 && numLive < MEM_ARENA_TEST_THREAD_MAX_LIVE))
+		{
+			u64 blockSize = GetRandU64(&random, sizeof(u64) + 1, SLAB_MAX_SLOT_SIZE + 256);
+			u8* blockPntr = (u8*)AllocMem(&test->arena, blockSize);
+			NotNull(blockPntr);
+			u8 fillValue = GetMemArenaTestFillValue((threadIndex << 32) | aIndex);
+			*((u64*)blockPntr) = blockSize;
+			MyMemSet(blockPntr + sizeof(u64), fillValue, blockSize - sizeof(u64));
+			liveBlocks[numLive++] = blockPntr;
+		}
+		else
+		{
+			u64 liveIndex = GetRandU64(&random, 0, numLive);
+			u8* blockPntr = liveBlocks[liveIndex];
+			liveBlocks[liveIndex] = liveBlocks[numLive-1];
+			numLive--;
+			if (roll >= 80)
+			{
+				//Swap it with whatever block is waiting in a random handoff slot (usually from another thread) and free that one instead
+				blockPntr = (u8*)ThreadSafeExchangePntr((void* volatile*)&test->handoffs[GetRandU64(&random, 0, MEM_ARENA_TEST_THREAD_NUM_HANDOFFS)], (void*)blockPntr);
+				if (blockPntr == nullptr) { continue; }
+			}
+			u64 blockSize = *((u64*)blockPntr);
+			AssertMsg(IsMemArenaTestFillIntact(blockPntr + sizeof(u64) + 1, blockSize - sizeof(u64) - 1, blockPntr[sizeof(u64)]), "A ThreadCached block was overwritten while it was live");
+			FreeMem(&test->arena, blockPntr, blockSize);
+		}
+	}
+	
+	for (u64 lIndex = 0; lIndex < numLive; lIndex++) { FreeMem(&test->arena, liveBlocks[lIndex], *((u64*)liveBlocks[lIndex])); }
+	ReleaseThreadCache(&test->arena);
+}
+
+void FinishThreadCachedArenaThreadTest(ThreadCachedArenaThreadTest_t* test)
+{
+	NotNull(test);
+	for (u64 hIndex = 0; hIndex < MEM_ARENA_TEST_THREAD_NUM_HANDOFFS; hIndex++)
+	{
+		u8* blockPntr = test->handoffs[hIndex];
+		if (blockPntr == nullptr) { continue; }
+		u64 blockSize = *((u64*)blockPntr);
+		Assert(IsMemArenaTestFillIntact(blockPntr + sizeof(u64) + 1, blockSize - sizeof(u64) - 1, blockPntr[sizeof(u64)]));
+		FreeMem(&test->arena, blockPntr, blockSize);
+		test->handoffs[hIndex] = nullptr;
+	}
+	ReleaseThreadCache(&test->arena);
+	Assert(test->arena.used == 0 && test->arena.numAllocations == 0);
+	MemArenaVerify(&test->arena, true);
+	FreeMemArena(&test->arena);
+	Assert(test->heap.numAllocations == 0);
+	MemArenaVerify(&test->heap, true);
+	FreeMemArena(&test->heap);
+	FreeMem(test->sourceArena, test->liveBlocks, sizeof(u8*) * test->numThreads * MEM_ARENA_TEST_THREAD_MAX_LIVE);
+	ClearPointer(test);
+}
+
 #endif // GYLIB_HEADER_ONLY
 
 #endif //  _GY_TEST_MEMORY_H
@@ -269,11 +1630,22 @@ MemArenaTestActionType_Free
 MemArenaTestActionType_Alloc
 MemArenaTestActionType_Realloc
 MemArenaTestActionType_NumTypes
+MEM_ARENA_TEST_TRACE_MAGIC
+MEM_ARENA_TEST_TRACE_VERSION
+MEM_ARENA_TEST_TRACE_HEADER_SIZE
+MEM_ARENA_TEST_TRACE_MOVED_FLAG
+MEM_ARENA_TEST_TRACE_ALIGN_SHIFT
+MEM_ARENA_TEST_LATENCY_SUB_BITS
+MEM_ARENA_TEST_LATENCY_NUM_BUCKETS
+MEM_ARENA_TEST_THREAD_MAX_LIVE
+MEM_ARENA_TEST_THREAD_NUM_HANDOFFS
 @Types
 MemArenaTestActionType_t
 MemArenaTestAction_t
 MemArenaTestAllocation_t
 MemArenaTestSet_t
+ThreadCachedArenaThreadTest_t
+MemArenaTestBenchmarkResult_t
 @Functions
 const char* GetMemArenaTestActionTypeStr(MemArenaTestActionType_t enumValue)
 void FreeMemArenaTestSet(MemArenaTestSet_t* set)
@@ -286,4 +1658,32 @@ void MemArenaTestSetRecordFreeMemAction(MemArenaTestSet_t* set, void* allocPntr,
 void MemArenaTestSetPrepare(MemArenaTestSet_t* set)
 void MemArenaTestPerformAction(MemArena_t* memArena, MemArenaTestAllocation_t* allocations, u64 numAllocations, MemArenaTestAction_t* action)
 void MemArenaTestSetPerformAllActions(MemArena_t* memArena, MemArenaTestSet_t* set)
+void MemArenaTestTraceWriteVarU64(u8* result, u64 resultSize, u64* byteIndexPntr, u64 value)
+bool MemArenaTestTraceReadVarU64(const u8* dataPntr, u64 dataSize, u64* byteIndexPntr, u64* valueOut)
+MyStr_t SerializeMemArenaTestSet(const MemArenaTestSet_t* set, MemArena_t* memArena)
+bool DeserializeMemArenaTestSet(MyStr_t traceData, MemArena_t* memArena, MemArenaTestSet_t* setOut)
+u64 GetMemArenaTestLatencyBucket(u64 value)
+u64 GetMemArenaTestLatencyBucketValue(u64 bucketIndex)
+r64 GetMemArenaTestLatencyPercentile(const MemArenaTestBenchmarkResult_t* result, r64 percentile)
+void MemArenaTestSetRunBenchmark(MemArena_t* memArena, const MemArenaTestSet_t* set, MemArena_t* scratchArena, MemArenaTestBenchmarkResult_t* resultOut)
+void PrintMemArenaTestBenchmarkResult(const MemArenaTestBenchmarkResult_t* result, const char* arenaName = nullptr)
+void GenerateMemArenaTestSet(MemArena_t* memArena, MemArenaTestSet_t* setOut, u64 seed, u64 numActions, u64 minAllocSize, u64 maxAllocSize, u64 maxNumLive, AllocAlignment_t maxAlignment = AllocAlignment_None)
+u8 GetMemArenaTestFillValue(u64 allocIndex)
+bool IsMemArenaTestFillIntact(const void* allocPntr, u64 size, u8 fillValue)
+void MemArenaTestSetRunVerified(MemArena_t* memArena, const MemArenaTestSet_t* set, MemArena_t* scratchArena, bool resizeInPlace = false)
+void GyTestCase_MemArenaReplay(MemArena_t* memArena, MemArena_t* scratchArena, u64 seed, u64 numActions, u64 minAllocSize, u64 maxAllocSize, u64 maxNumLive, AllocAlignment_t maxAlignment, bool resizeInPlace)
+void GyTestCase_SlabArena(MemArena_t* sourceArena, MemArena_t* scratchArena, u64 seed, u64 numActions)
+void GyTestCase_PagedHeapArena(MemArena_t* sourceArena, MemArena_t* scratchArena, u64 seed, u64 numActions)
+void GyTestCase_ThreadCachedArena(MemArena_t* sourceArena, MemArena_t* scratchArena, u64 seed, u64 numActions)
+void GyTestCase_StdHeapRemap(MemArena_t* scratchArena, u64 seed, u64 numActions)
+void GyTestCase_RingArena(MemArena_t* sourceArena, u64 seed, u64 numFrames, u64 ringSize, u64 maxNumFrames)
+void GyTestCase_MappedFileArena(const char* filePath, u64 seed, u64 numAllocations)
+void GyTestCase_VirtualStackArena(MemArena_t* scratchArena, u64 seed, u64 numAllocations, bool useHugePages)
+void GyTestCase_MemArenaAllocInfo(MemArena_t* sourceArena, MemArena_t* scratchArena, u64 seed, u64 numAllocations)
+void GyTestCase_MemArenaSnapshot(MemArena_t* scratchArena, u64 seed, u64 numTicks)
+void GyTestCase_MemArenaHistograms(MemArena_t* sourceArena, MemArena_t* scratchArena, u64 seed, u64 numActions)
+void GyTestCase_StatsPage(MemArena_t* sourceArena, u64 seed, u64 numPublishes)
+void StartThreadCachedArenaThreadTest(ThreadCachedArenaThreadTest_t* test, MemArena_t* sourceArena, u64 seed, u64 numThreads, u64 numActionsPerThread)
+void RunThreadCachedArenaThreadTestWorker(ThreadCachedArenaThreadTest_t* test, u64 threadIndex)
+void FinishThreadCachedArenaThreadTest(ThreadCachedArenaThreadTest_t* test)
 */
@@ -0,0 +1,144 @@
+/*
+File:   gy_test_slot_map.h
+Author: Taylor Robbins
+Date:   10\16\2026
+Description:
+	** GyTestCase_SlotMap runs a random mix of adds, removes, lookups, and clears against a SlotMap_t and checks every
+	** result against a plain array of live handles. Every removed handle is kept around and checked to make sure it stays stale
+	** (even after its slot gets reused). At the end SlotMapIter has to visit exactly the live items, in slot order.
+*/
+
+#ifndef _GY_TEST_SLOT_MAP_H
+#define _GY_TEST_SLOT_MAP_H
+
+#include "gy_test_helpers.h"
+
+struct SlotMapTestItem_t
+{
+	u64 handle;
+	u64 value;
+};
+
+struct SlotMapShadowTest_t
+{
+	SlotMap_t map;
+	u64 maxNumItems;
+	u64 numLive;
+	u64* liveHandles;
+	u64 numStale;
+	u64* staleHandles;
+};
+
+GY_TEST_SHADOW_WEIGHTS_DEF(SlotMapShadowTest_GetWeights)
+{
+	SlotMapShadowTest_t* test = (SlotMapShadowTest_t*)context;
+	weightsOut[0] = (test->numLive < test->maxNumItems) ? 45 : 0; //add
+	weightsOut[1] = (test->numLive > 0) ? 35 : 0; //remove
+	weightsOut[2] = 1; //clear
+	weightsOut[3] = (test->numLive > 0) ? 19 : 0; //lookup
+}
+
+GY_TEST_SHADOW_ACTION_DEF(SlotMapShadowTest_DoAction)
+{
+	SlotMapShadowTest_t* test = (SlotMapShadowTest_t*)context;
+	if (action == 0)
+	{
+		u64 handle = SLOT_MAP_INVALID_HANDLE;
+		SlotMapTestItem_t* item = SlotMapAdd(&test->map, SlotMapTestItem_t, &handle);
+		NotNull(item);
+		Assert(handle != SLOT_MAP_INVALID_HANDLE);
+		Assert(item->handle == 0 && item->value == 0);
+		item->handle = handle;
+		item->value = stepIndex;
+		test->liveHandles[test->numLive++] = handle;
+	}
+	else if (action == 1)
+	{
+		u64 liveIndex = GetRandU64(random, 0, test->numLive);
+		u64 handle = test->liveHandles[liveIndex];
+		Assert(SlotMapRemoveSoft(&test->map, handle));
+		Assert(!SlotMapRemoveSoft(&test->map, handle));
+		test->liveHandles[liveIndex] = test->liveHandles[test->numLive-1];
+		test->numLive--;
+		test->staleHandles[test->numStale++] = handle;
+	}
+	else if (action == 2)
+	{
+		ClearSlotMap(&test->map);
+		for (u64 lIndex = 0; lIndex < test->numLive; lIndex++) { test->staleHandles[test->numStale++] = test->liveHandles[lIndex]; }
+		test->numLive = 0;
+	}
+	else
+	{
+		u64 handle = test->liveHandles[GetRandU64(random, 0, test->numLive)];
+		SlotMapTestItem_t* item = SlotMapGetSoft(&test->map, SlotMapTestItem_t, handle);
+		NotNull(item);
+		Assert(item->handle == handle);
+	}
+	//Spot check one old handle every step, they all get checked at the end
+	if (test->numStale > 0) { Assert(!SlotMapContains(&test->map, test->staleHandles[GetRandU64(random, 0, test->numStale)])); }
+}
+
+GY_TEST_SHADOW_CHECK_DEF(SlotMapShadowTest_Check)
+{
+	SlotMapShadowTest_t* test = (SlotMapShadowTest_t*)context;
+	Assert(test->map.count == test->numLive);
+}
+
+void GyTestCase_SlotMap(MemArena_t* memArena, u64 seed, u64 numActions, u64 maxNumItems)
+{
+	NotNull(memArena);
+	Assert(maxNumItems > 0);
+	RandomSeries_t random;
+	InitGyTestRandom(&random, seed);
+	
+	SlotMapShadowTest_t test = {};
+	CreateSlotMap(&test.map, memArena, sizeof(SlotMapTestItem_t), GetRandU64(&random, 1, 100));
+	test.maxNumItems = maxNumItems;
+	test.liveHandles = AllocArray(memArena, u64, maxNumItems);
+	test.staleHandles = AllocArray(memArena, u64, numActions);
+	NotNull2(test.liveHandles, test.staleHandles);
+	
+	GyTestShadowModel_t model;
+	InitGyTestShadowModel(&model, &test, 4, SlotMapShadowTest_GetWeights, SlotMapShadowTest_DoAction, SlotMapShadowTest_Check);
+	RunGyTestShadowModel(&model, &random, numActions);
+	
+	for (u64 lIndex = 0; lIndex < test.numLive; lIndex++)
+	{
+		SlotMapTestItem_t* item = SlotMapGetSoft(&test.map, SlotMapTestItem_t, test.liveHandles[lIndex]);
+		NotNull(item);
+		Assert(item->handle == test.liveHandles[lIndex]);
+	}
+	for (u64 sIndex = 0; sIndex < test.numStale; sIndex++) { Assert(!SlotMapContains(&test.map, test.staleHandles[sIndex])); }
+	
+	u64 numIterated = 0;
+	u64 prevSlotIndex = 0;
+	u64 slotIndex = 0;
+	u64 iterHandle = SLOT_MAP_INVALID_HANDLE;
+	SlotMapTestItem_t* iterItem = nullptr;
+	while (SlotMapIter(&test.map, &slotIndex, &iterHandle, (void**)&iterItem))
+	{
+		Assert(iterItem->handle == iterHandle);
+		Assert(numIterated == 0 || GetSlotMapHandleIndex(iterHandle) > prevSlotIndex);
+		prevSlotIndex = GetSlotMapHandleIndex(iterHandle);
+		numIterated++;
+	}
+	Assert(numIterated == test.numLive);
+	
+	FreeMem(memArena, test.staleHandles, sizeof(u64) * numActions);
+	FreeMem(memArena, test.liveHandles, sizeof(u64) * maxNumItems);
+	FreeSlotMap(&test.map);
+}
+
+#endif //  _GY_TEST_SLOT_MAP_H
+
+// +--------------------------------------------------------------+
+// |                   Autocomplete Dictionary                    |
+// +--------------------------------------------------------------+
+/*
+@Types
+SlotMapTestItem_t
+SlotMapShadowTest_t
+@Functions
+void GyTestCase_SlotMap(MemArena_t* memArena, u64 seed, u64 numActions, u64 maxNumItems)
+*/
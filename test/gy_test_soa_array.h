@@ -0,0 +1,218 @@
+/*
+File:   gy_test_soa_array.h
+Author: Taylor Robbins
+Date:   10\16\2026
+Description:
+	** GyTestCase_SoaArray runs a random mix of adds, removes (ordered and swap), and clears against a SoaArray_t
+	** and checks every column against a plain array of structs after each action, along with the column alignment.
+	** RunSoaArrayBenchmark times the same particle update (position += velocity * dt) over a VarArray_t of fat structs
+	** and over a SoaArray_t holding the same data in separate columns
+*/
+
+#ifndef _GY_TEST_SOA_ARRAY_H
+#define _GY_TEST_SOA_ARRAY_H
+
+#include "gy_test_helpers.h"
+
+struct SoaArrayTestRow_t
+{
+	u64 id;
+	v3 position;
+	u8 flags;
+};
+
+//This is what a typical simulation entity looks like. The update loop only touches position and velocity
+struct SoaArrayBenchmarkParticle_t
+{
+	v3 position;
+	v3 velocity;
+	r32 mass;
+	r32 lifetime;
+	v4 color;
+	u64 ownerId;
+	u8 padding[16];
+};
+
+struct SoaArrayShadowTest_t
+{
+	SoaArray_t array;
+	u64 maxNumRows;
+	u64 numExpected;
+	SoaArrayTestRow_t* expected;
+};
+
+GY_TEST_SHADOW_WEIGHTS_DEF(SoaArrayShadowTest_GetWeights)
+{
+	SoaArrayShadowTest_t* test = (SoaArrayShadowTest_t*)context;
+	weightsOut[0] = (test->numExpected < test->maxNumRows) ? 50 : 0; //add some rows
+	weightsOut[1] = (test->numExpected > 0) ? 20 : 0; //ordered remove
+	weightsOut[2] = (test->numExpected > 0) ? 25 : 0; //swap remove
+	weightsOut[3] = 1; //clear
+	weightsOut[4] = 1; //clear and free the columns
+	weightsOut[5] = 3; //just check
+}
+
+GY_TEST_SHADOW_ACTION_DEF(SoaArrayShadowTest_DoAction)
+{
+	SoaArrayShadowTest_t* test = (SoaArrayShadowTest_t*)context;
+	SoaArray_t* array = &test->array;
+	if (action == 0)
+	{
+		u64 numNewRows = MinU64(GetRandU64(random, 1, 5), test->maxNumRows - test->numExpected);
+		u64 firstRow = (numNewRows == 1) ? SoaArrayAdd(array) : SoaArrayAddRows(array, numNewRows);
+		Assert(firstRow == test->numExpected);
+		for (u64 rIndex = firstRow; rIndex < firstRow + numNewRows; rIndex++)
+		{
+			Assert(*SoaArrayGet(array, 0, rIndex, u64) == 0 && *SoaArrayGet(array, 2, rIndex, u8) == 0);
+			SoaArrayTestRow_t* row = &test->expected[test->numExpected++];
+			row->id = stepIndex * 8 + (rIndex - firstRow);
+			row->position = NewVec3((r32)stepIndex, (r32)rIndex, -(r32)stepIndex);
+			row->flags = (u8)(row->id & 0xFF);
+			*SoaArrayGet(array, 0, rIndex, u64) = row->id;
+			*SoaArrayGet(array, 1, rIndex, v3) = row->position;
+			*SoaArrayGet(array, 2, rIndex, u8) = row->flags;
+		}
+	}
+	else if (action == 1)
+	{
+		u64 rowIndex = GetRandU64(random, 0, test->numExpected);
+		SoaArrayRemove(array, rowIndex);
+		for (u64 rIndex = rowIndex; rIndex+1 < test->numExpected; rIndex++) { test->expected[rIndex] = test->expected[rIndex+1]; }
+		test->numExpected--;
+	}
+	else if (action == 2)
+	{
+		u64 rowIndex = GetRandU64(random, 0, test->numExpected);
+		SoaArrayRemoveSwap(array, rowIndex);
+		test->expected[rowIndex] = test->expected[test->numExpected-1];
+		test->numExpected--;
+	}
+	else if (action == 3 || action == 4)
+	{
+		SoaArrayClear(array, (action == 4));
+		test->numExpected = 0;
+	}
+}
+
+GY_TEST_SHADOW_CHECK_DEF(SoaArrayShadowTest_Check)
+{
+	SoaArrayShadowTest_t* test = (SoaArrayShadowTest_t*)context;
+	SoaArray_t* array = &test->array;
+	Assert(array->length == test->numExpected);
+	Assert(array->allocLength >= array->length);
+	Assert((array->allocLength % SOA_ARRAY_MIN_ALLOC_LENGTH) == 0);
+	for (u64 cIndex = 0; cIndex < array->numColumns && array->allocLength > 0; cIndex++)
+	{
+		Assert(IsAlignedTo(array->columns[cIndex].items, (AllocAlignment_t)SOA_ARRAY_COLUMN_ALIGNMENT));
+	}
+	const u64* ids = SoaArrayColumn(array, 0, u64);
+	const v3* positions = SoaArrayColumn(array, 1, v3);
+	const u8* flags = SoaArrayColumn(array, 2, u8);
+	SoaArrayLoop(array, rIndex)
+	{
+		Assert(ids[rIndex] == test->expected[rIndex].id);
+		Assert(positions[rIndex] == test->expected[rIndex].position);
+		Assert(flags[rIndex] == test->expected[rIndex].flags);
+	}
+	Assert(SoaArrayGetSoft(array, 1, array->length, v3) == nullptr);
+}
+
+void GyTestCase_SoaArray(MemArena_t* memArena, u64 seed, u64 numActions, u64 maxNumRows)
+{
+	NotNull(memArena);
+	RandomSeries_t random;
+	InitGyTestRandom(&random, seed);
+	
+	SoaArrayShadowTest_t test = {};
+	u64 columnSizes[] = { sizeof(u64), sizeof(v3), sizeof(u8) };
+	CreateSoaArray(&test.array, memArena, ArrayCount(columnSizes), columnSizes, GetRandU64(&random, 0, 40));
+	test.maxNumRows = maxNumRows;
+	test.expected = AllocArray(memArena, SoaArrayTestRow_t, maxNumRows);
+	NotNull(test.expected);
+	
+	GyTestShadowModel_t model;
+	InitGyTestShadowModel(&model, &test, 6, SoaArrayShadowTest_GetWeights, SoaArrayShadowTest_DoAction, SoaArrayShadowTest_Check);
+	RunGyTestShadowModel(&model, &random, numActions);
+	
+	FreeMem(memArena, test.expected, sizeof(SoaArrayTestRow_t) * maxNumRows);
+	FreeSoaArray(&test.array);
+}
+
+void RunSoaArrayBenchmark(MemArena_t* memArena, u64 numParticles, u64 numSteps, GyTestBenchmark_t* benchmarkOut)
+{
+	NotNull2(memArena, benchmarkOut);
+	InitGyTestBenchmark(benchmarkOut, "particle", numParticles, "particle step", numParticles * numSteps);
+	RandomSeries_t random;
+	InitGyTestRandom(&random, numParticles);
+	const r32 timeStep = 1.0f / 60.0f;
+	
+	VarArray_t aos;
+	CreateVarArray(&aos, memArena, sizeof(SoaArrayBenchmarkParticle_t), numParticles);
+	u64 columnSizes[] = { sizeof(v3), sizeof(v3), sizeof(r32), sizeof(r32), sizeof(v4), sizeof(u64) };
+	SoaArray_t soa;
+	CreateSoaArray(&soa, memArena, ArrayCount(columnSizes), columnSizes, numParticles);
+	SoaArrayAddRows(&soa, numParticles);
+	v3* soaPositions = SoaArrayColumn(&soa, 0, v3);
+	v3* soaVelocities = SoaArrayColumn(&soa, 1, v3);
+	for (u64 pIndex = 0; pIndex < numParticles; pIndex++)
+	{
+		SoaArrayBenchmarkParticle_t* particle = VarArrayAdd(&aos, SoaArrayBenchmarkParticle_t);
+		ClearPointer(particle);
+		particle->position = NewVec3(GetRandR32(&random, -100, 100), GetRandR32(&random, -100, 100), GetRandR32(&random, -100, 100));
+		particle->velocity = NewVec3(GetRandR32(&random, -1, 1), GetRandR32(&random, -1, 1), GetRandR32(&random, -1, 1));
+		particle->mass = 1.0f;
+		soaPositions[pIndex] = particle->position;
+		soaVelocities[pIndex] = particle->velocity;
+	}
+	
+	GyTestBenchmarkStart(benchmarkOut, "VarArray of structs");
+	for (u64 sIndex = 0; sIndex < numSteps; sIndex++)
+	{
+		SoaArrayBenchmarkParticle_t* particles = (SoaArrayBenchmarkParticle_t*)aos.items;
+		for (u64 pIndex = 0; pIndex < aos.length; pIndex++)
+		{
+			particles[pIndex].position.x += particles[pIndex].velocity.x * timeStep;
+			particles[pIndex].position.y += particles[pIndex].velocity.y * timeStep;
+			particles[pIndex].position.z += particles[pIndex].velocity.z * timeStep;
+		}
+	}
+	GyTestBenchmarkEnd(benchmarkOut, 0);
+	
+	//v3 columns are just interleaved r32s, so the whole update is one flat loop the compiler can vectorize
+	GyTestBenchmarkStart(benchmarkOut, "SoaArray");
+	for (u64 sIndex = 0; sIndex < numSteps; sIndex++)
+	{
+		r32* positionFloats = (r32*)SoaArrayColumn(&soa, 0, v3);
+		const r32* velocityFloats = (const r32*)SoaArrayColumn(&soa, 1, v3);
+		u64 numFloats = soa.length * 3;
+		for (u64 fIndex = 0; fIndex < numFloats; fIndex++)
+		{
+			positionFloats[fIndex] += velocityFloats[fIndex] * timeStep;
+		}
+	}
+	GyTestBenchmarkEnd(benchmarkOut, 0);
+	
+	//The floats won't match bit for bit between the two loops, so we compare them here rather than with a checksum
+	for (u64 pIndex = 0; pIndex < numParticles; pIndex++)
+	{
+		Assert(Vec3BasicallyEqual(VarArrayGet(&aos, pIndex, SoaArrayBenchmarkParticle_t)->position, *SoaArrayGet(&soa, 0, pIndex, v3)));
+	}
+	
+	FreeSoaArray(&soa);
+	FreeVarArray(&aos);
+}
+
+#endif //  _GY_TEST_SOA_ARRAY_H
+
+// +--------------------------------------------------------------+
+// |                   Autocomplete Dictionary                    |
+// +--------------------------------------------------------------+
+/*
+@Types
+SoaArrayTestRow_t
+SoaArrayShadowTest_t
+SoaArrayBenchmarkParticle_t
+@Functions
+void GyTestCase_SoaArray(MemArena_t* memArena, u64 seed, u64 numActions, u64 maxNumRows)
+void RunSoaArrayBenchmark(MemArena_t* memArena, u64 numParticles, u64 numSteps, GyTestBenchmark_t* benchmarkOut)
+*/
@@ -0,0 +1,304 @@
+/*
+File:   gy_test_str_hash_dictionary.h
+Author: Taylor Robbins
+Date:   10\16\2026
+Description:
+	** GyTestCase_StrHashDict runs a random mix of adds, removes, and lookups against a StrHashDict_t (optionally with incremental
+	** resizing turned on) and checks every result against a plain array. At the end it checks iteration, StrHashDictGetBatch,
+	** and a FrozenStrHashDict_t made from the final contents.
+	** GyTestCase_FrozenStrHashDict checks that frozen dicts of a few sizes are a minimal perfect hash, still work after the image is copied, and reject bad images.
+	** RunStrHashDictBatchBenchmark times the same random lookups done one at a time with StrHashDictGet and all at once with StrHashDictGetBatch
+*/
+
+#ifndef _GY_TEST_STR_HASH_DICTIONARY_H
+#define _GY_TEST_STR_HASH_DICTIONARY_H
+
+#include "gy_test_helpers.h"
+
+#define GY_TEST_STR_HASH_DICT_MAX_KEY_LENGTH 24
+
+struct StrHashDictTestItem_t
+{
+	u64 keyIndex;
+	u64 value;
+};
+
+//keysOut needs room for numKeys * GY_TEST_STR_HASH_DICT_MAX_KEY_LENGTH chars
+void GyTestMakeStrHashDictKeys(u64 numKeys, char* charsOut, MyStr_t* keysOut)
+{
+	for (u64 kIndex = 0; kIndex < numKeys; kIndex++)
+	{
+		char* keyChars = &charsOut[kIndex * GY_TEST_STR_HASH_DICT_MAX_KEY_LENGTH];
+		int keyLength = MyBufferPrintf(keyChars, GY_TEST_STR_HASH_DICT_MAX_KEY_LENGTH, "config.key_%llu", (unsigned long long)kIndex);
+		keysOut[kIndex] = NewStr((uxx)keyLength, keyChars);
+	}
+}
+
+struct StrHashDictShadowTest_t
+{
+	StrHashDict_t dict;
+	u64 numKeys;
+	MyStr_t* keys;
+	bool* present;
+	u64* values;
+	u64 numPresent;
+};
+
+GY_TEST_SHADOW_WEIGHTS_DEF(StrHashDictShadowTest_GetWeights)
+{
+	weightsOut[0] = 4; //add
+	weightsOut[1] = 3; //remove
+	weightsOut[2] = 3; //lookup
+}
+
+GY_TEST_SHADOW_ACTION_DEF(StrHashDictShadowTest_DoAction)
+{
+	StrHashDictShadowTest_t* test = (StrHashDictShadowTest_t*)context;
+	u64 keyIndex = GetRandU64(random, 0, test->numKeys);
+	if (action == 0)
+	{
+		bool isNewEntry = false;
+		StrHashDictTestItem_t* item = StrHashDictAddSoftEx(&test->dict, test->keys[keyIndex], &isNewEntry, StrHashDictTestItem_t);
+		NotNull(item);
+		Assert(isNewEntry == !test->present[keyIndex]);
+		if (isNewEntry)
+		{
+			Assert(item->keyIndex == 0 && item->value == 0);
+			item->keyIndex = keyIndex;
+			item->value = stepIndex;
+			test->values[keyIndex] = stepIndex;
+			test->present[keyIndex] = true;
+			test->numPresent++;
+		}
+	}
+	else if (action == 1)
+	{
+		bool wasRemoved = StrHashDictRemoveSoft(&test->dict, test->keys[keyIndex], StrHashDictTestItem_t);
+		Assert(wasRemoved == test->present[keyIndex]);
+		if (wasRemoved) { test->present[keyIndex] = false; test->numPresent--; }
+	}
+	else
+	{
+		StrHashDictTestItem_t* item = StrHashDictGetSoft(&test->dict, test->keys[keyIndex], StrHashDictTestItem_t);
+		Assert((item != nullptr) == test->present[keyIndex]);
+		if (item != nullptr) { Assert(item->keyIndex == keyIndex && item->value == test->values[keyIndex]); }
+	}
+}
+
+GY_TEST_SHADOW_CHECK_DEF(StrHashDictShadowTest_Check)
+{
+	StrHashDictShadowTest_t* test = (StrHashDictShadowTest_t*)context;
+	Assert(test->dict.numItems == test->numPresent);
+}
+
+void GyTestCase_StrHashDict(MemArena_t* memArena, u64 seed, u64 numActions, u64 numKeys, bool incrementalResize)
+{
+	NotNull(memArena);
+	Assert(numKeys > 0);
+	RandomSeries_t random;
+	InitGyTestRandom(&random, seed);
+	
+	StrHashDictShadowTest_t test = {};
+	test.numKeys = numKeys;
+	char* keyChars = AllocArray(memArena, char, numKeys * GY_TEST_STR_HASH_DICT_MAX_KEY_LENGTH);
+	MyStr_t* keys = AllocArray(memArena, MyStr_t, numKeys);
+	bool* present = AllocArray(memArena, bool, numKeys);
+	u64* values = AllocArray(memArena, u64, numKeys);
+	NotNull2(keyChars, keys);
+	NotNull2(present, values);
+	GyTestMakeStrHashDictKeys(numKeys, keyChars, keys);
+	MyMemSet(present, 0x00, sizeof(bool) * numKeys);
+	test.keys = keys;
+	test.present = present;
+	test.values = values;
+	
+	CreateStrHashDict(&test.dict, memArena, sizeof(StrHashDictTestItem_t));
+	if (incrementalResize) { SetStrHashDictIncrementalResize(&test.dict, true, 4); }
+	
+	GyTestShadowModel_t model;
+	InitGyTestShadowModel(&model, &test, 3, StrHashDictShadowTest_GetWeights, StrHashDictShadowTest_DoAction, StrHashDictShadowTest_Check);
+	RunGyTestShadowModel(&model, &random, numActions);
+	
+	u64 numIterated = 0;
+	StrHashDictIter_t iter = StrHashDictGetIter(&test.dict, StrHashDictTestItem_t);
+	StrHashDictTestItem_t* iterItem = nullptr;
+	while (StrHashDictIter(&iter, StrHashDictTestItem_t, &iterItem))
+	{
+		Assert(present[iterItem->keyIndex] && iterItem->value == values[iterItem->keyIndex]);
+		numIterated++;
+	}
+	Assert(numIterated == test.numPresent);
+	
+	void** batchResults = AllocArray(memArena, void*, numKeys);
+	NotNull(batchResults);
+	u64 numBatchFound = StrHashDictGetBatch(&test.dict, numKeys, keys, batchResults, StrHashDictTestItem_t);
+	Assert(numBatchFound == test.numPresent);
+	for (u64 kIndex = 0; kIndex < numKeys; kIndex++)
+	{
+		Assert((batchResults[kIndex] != nullptr) == present[kIndex]);
+		if (batchResults[kIndex] != nullptr) { Assert(((StrHashDictTestItem_t*)batchResults[kIndex])->keyIndex == kIndex); }
+	}
+	
+	MyStr_t frozenImage = FreezeStrHashDict(&test.dict, memArena);
+	FrozenStrHashDict_t frozen;
+	Assert(OpenFrozenStrHashDict(&frozen, frozenImage.chars, frozenImage.length));
+	Assert(frozen.numItems == test.numPresent);
+	for (u64 kIndex = 0; kIndex < numKeys; kIndex++)
+	{
+		const StrHashDictTestItem_t* frozenItem = FrozenStrHashDictGetSoft(&frozen, keys[kIndex], StrHashDictTestItem_t);
+		Assert((frozenItem != nullptr) == present[kIndex]);
+		if (frozenItem != nullptr) { Assert(frozenItem->keyIndex == kIndex && frozenItem->value == values[kIndex]); }
+	}
+	
+	FreeMem(memArena, frozenImage.chars, frozenImage.length);
+	FreeMem(memArena, batchResults, sizeof(void*) * numKeys);
+	FreeStrHashDict(&test.dict);
+	FreeMem(memArena, values, sizeof(u64) * numKeys);
+	FreeMem(memArena, present, sizeof(bool) * numKeys);
+	FreeMem(memArena, keys, sizeof(MyStr_t) * numKeys);
+	FreeMem(memArena, keyChars, sizeof(char) * numKeys * GY_TEST_STR_HASH_DICT_MAX_KEY_LENGTH);
+}
+
+//Freezes dicts of a few different sizes (including empty and single item ones). Every key has to land in it's own slot (a minimal perfect hash)
+//and the image has to work after being copied somewhere else, since it's meant to be written to disk and mapped back in
+void GyTestCase_FrozenStrHashDict(MemArena_t* memArena, u64 seed, u64 maxNumItems)
+{
+	NotNull(memArena);
+	Assert(maxNumItems >= FROZEN_STR_HASH_DICT_ITEMS_PER_BUCKET + 1);
+	RandomSeries_t random;
+	InitGyTestRandom(&random, seed);
+	
+	//Only the first half of the keys are added so the second half checks lookups that should fail
+	u64 maxNumKeys = maxNumItems * 2;
+	char* keyChars = AllocArray(memArena, char, maxNumKeys * GY_TEST_STR_HASH_DICT_MAX_KEY_LENGTH);
+	MyStr_t* keys = AllocArray(memArena, MyStr_t, maxNumKeys);
+	bool* slotUsed = AllocArray(memArena, bool, maxNumItems);
+	NotNull3(keyChars, keys, slotUsed);
+	GyTestMakeStrHashDictKeys(maxNumKeys, keyChars, keys);
+	
+	const u64 numItemsOptions[] = { 0, 1, 2, FROZEN_STR_HASH_DICT_ITEMS_PER_BUCKET + 1, GetRandU64(&random, 1, maxNumItems + 1), maxNumItems };
+	for (u64 oIndex = 0; oIndex < ArrayCount(numItemsOptions); oIndex++)
+	{
+		u64 numItems = numItemsOptions[oIndex];
+		StrHashDict_t dict;
+		CreateStrHashDict(&dict, memArena, sizeof(StrHashDictTestItem_t));
+		for (u64 kIndex = 0; kIndex < numItems; kIndex++)
+		{
+			StrHashDictTestItem_t* item = StrHashDictAdd(&dict, keys[kIndex], StrHashDictTestItem_t);
+			item->keyIndex = kIndex;
+			item->value = GetRandU64(&random);
+		}
+		
+		MyStr_t image = FreezeStrHashDict(&dict, memArena);
+		NotNull(image.chars);
+		FrozenStrHashDict_t frozen;
+		Assert(OpenFrozenStrHashDict(&frozen, image.chars, image.length));
+		Assert(frozen.numItems == numItems && frozen.header->imageSize == image.length);
+		
+		MyMemSet(slotUsed, 0x00, sizeof(bool) * maxNumItems);
+		for (u64 kIndex = 0; kIndex < numItems; kIndex++)
+		{
+			u64 keyHash = FnvHashStr(keys[kIndex]);
+			u32 bucketSeed = frozen.seeds[GetFrozenStrHashDictBucketIndex(keyHash, frozen.numBuckets)];
+			u64 slotIndex = GetFrozenStrHashDictSlotIndex(keyHash, bucketSeed, numItems);
+			Assert(slotIndex < numItems);
+			AssertMsg(!slotUsed[slotIndex], "Two keys landed in the same FrozenStrHashDict slot");
+			slotUsed[slotIndex] = true;
+			Assert(frozen.hashes[slotIndex] == keyHash);
+		}
+		
+		//Copy the image somewhere else and wipe the original, nothing in it can point back at where it was made
+		u8* imageCopy = (u8*)AllocMem(memArena, image.length);
+		NotNull(imageCopy);
+		Assert(IsAlignedTo(imageCopy, AllocAlignment_8Bytes)); //same as FreezeStrHashDict expects of memArena
+		MyMemCopy(imageCopy, image.chars, image.length);
+		MyMemSet(image.chars, 0xCD, image.length);
+		FrozenStrHashDict_t copied;
+		Assert(OpenFrozenStrHashDict(&copied, imageCopy, image.length));
+		for (u64 kIndex = 0; kIndex < maxNumKeys; kIndex++)
+		{
+			const StrHashDictTestItem_t* frozenItem = FrozenStrHashDictGetSoft(&copied, keys[kIndex], StrHashDictTestItem_t);
+			Assert((frozenItem != nullptr) == (kIndex < numItems));
+			if (frozenItem == nullptr) { continue; }
+			const StrHashDictTestItem_t* liveItem = StrHashDictGet(&dict, keys[kIndex], StrHashDictTestItem_t);
+			Assert(frozenItem->keyIndex == kIndex && frozenItem->value == liveItem->value);
+		}
+		
+		//A truncated or corrupted image is rejected instead of read out of bounds
+		FrozenStrHashDict_t rejected;
+		Assert(!OpenFrozenStrHashDict(&rejected, imageCopy, image.length - 1));
+		Assert(!OpenFrozenStrHashDict(&rejected, image.chars, image.length));
+		FrozenStrHashDictHeader_t* copiedHeader = (FrozenStrHashDictHeader_t*)imageCopy;
+		copiedHeader->numBuckets++;
+		Assert(!OpenFrozenStrHashDict(&rejected, imageCopy, image.length));
+		
+		FreeMem(memArena, imageCopy, image.length);
+		FreeMem(memArena, image.chars, image.length);
+		FreeStrHashDict(&dict);
+	}
+	
+	FreeMem(memArena, slotUsed, sizeof(bool) * maxNumItems);
+	FreeMem(memArena, keys, sizeof(MyStr_t) * maxNumKeys);
+	FreeMem(memArena, keyChars, sizeof(char) * maxNumKeys * GY_TEST_STR_HASH_DICT_MAX_KEY_LENGTH);
+}
+
+//numItems should be big enough that the table doesn't fit in cache, otherwise there is nothing for the prefetches to hide
+void RunStrHashDictBatchBenchmark(MemArena_t* memArena, u64 numItems, u64 numLookups, GyTestBenchmark_t* benchmarkOut)
+{
+	NotNull2(memArena, benchmarkOut);
+	Assert(numItems > 0);
+	InitGyTestBenchmark(benchmarkOut, "item", numItems, "lookup", numLookups);
+	RandomSeries_t random;
+	InitGyTestRandom(&random, numItems);
+	
+	char* keyChars = AllocArray(memArena, char, numItems * GY_TEST_STR_HASH_DICT_MAX_KEY_LENGTH);
+	MyStr_t* keys = AllocArray(memArena, MyStr_t, numItems);
+	MyStr_t* lookupKeys = AllocArray(memArena, MyStr_t, numLookups);
+	void** results = AllocArray(memArena, void*, numLookups);
+	NotNull2(keyChars, keys);
+	NotNull2(lookupKeys, results);
+	GyTestMakeStrHashDictKeys(numItems, keyChars, keys);
+	
+	StrHashDict_t dict;
+	CreateStrHashDict(&dict, memArena, sizeof(u64), numItems);
+	for (u64 iIndex = 0; iIndex < numItems; iIndex++) { *StrHashDictAdd(&dict, keys[iIndex], u64) = iIndex; }
+	for (u64 lIndex = 0; lIndex < numLookups; lIndex++) { lookupKeys[lIndex] = keys[GetRandU64(&random, 0, numItems)]; }
+	
+	u64 singleChecksum = 0;
+	GyTestBenchmarkStart(benchmarkOut, "StrHashDictGet");
+	for (u64 lIndex = 0; lIndex < numLookups; lIndex++)
+	{
+		singleChecksum += *StrHashDictGet(&dict, lookupKeys[lIndex], u64);
+	}
+	GyTestBenchmarkEnd(benchmarkOut, singleChecksum);
+	
+	u64 batchChecksum = 0;
+	GyTestBenchmarkStart(benchmarkOut, "StrHashDictGetBatch");
+	StrHashDictGetBatch(&dict, numLookups, lookupKeys, results, u64);
+	for (u64 lIndex = 0; lIndex < numLookups; lIndex++) { batchChecksum += *((u64*)results[lIndex]); }
+	GyTestBenchmarkEnd(benchmarkOut, batchChecksum);
+	
+	FreeStrHashDict(&dict);
+	FreeMem(memArena, results, sizeof(void*) * numLookups);
+	FreeMem(memArena, lookupKeys, sizeof(MyStr_t) * numLookups);
+	FreeMem(memArena, keys, sizeof(MyStr_t) * numItems);
+	FreeMem(memArena, keyChars, sizeof(char) * numItems * GY_TEST_STR_HASH_DICT_MAX_KEY_LENGTH);
+}
+
+#endif //  _GY_TEST_STR_HASH_DICTIONARY_H
+
+// +--------------------------------------------------------------+
+// |                   Autocomplete Dictionary                    |
+// +--------------------------------------------------------------+
+/*
+@Defines
+GY_TEST_STR_HASH_DICT_MAX_KEY_LENGTH
+@Types
+StrHashDictTestItem_t
+StrHashDictShadowTest_t
+@Functions
+void GyTestMakeStrHashDictKeys(u64 numKeys, char* charsOut, MyStr_t* keysOut)
+void GyTestCase_StrHashDict(MemArena_t* memArena, u64 seed, u64 numActions, u64 numKeys, bool incrementalResize)
+void GyTestCase_FrozenStrHashDict(MemArena_t* memArena, u64 seed, u64 maxNumItems)
+void RunStrHashDictBatchBenchmark(MemArena_t* memArena, u64 numItems, u64 numLookups, GyTestBenchmark_t* benchmarkOut)
+*/
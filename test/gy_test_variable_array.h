@@ -0,0 +1,274 @@
+/*
+File:   gy_test_variable_array.h
+Author: Taylor Robbins
+Date:   10\16\2026
+Description:
+	** Runs a random mix of adds, inserts, removes, range adds, and clears against a VarArray_t and checks every
+	** item against a plain array of the values it should hold (in order).
+	** GyTestCase_VarArrayVirtual does this to an array made with CreateVarArrayVirtual. The items can never move, the committed
+	** size has to stay a whole number of pages (and at least double every time it grows), and at the end the array has to be
+	** able to grow all the way to the maxLength it reserved.
+	** GyTestCase_VarArrayInline does this to an array made with CreateVarArrayInline. It has to stay in the inline buffer (without
+	** touching the arena) until it grows past it, stay in arena memory after that until VarArrayClear(array, true) puts it back,
+	** and never write past the end of the inline buffer.
+*/
+
+#ifndef _GY_TEST_VARIABLE_ARRAY_H
+#define _GY_TEST_VARIABLE_ARRAY_H
+
+#include "gy_test_helpers.h"
+
+struct VarArrayShadowTest_t
+{
+	VarArray_t array;
+	u64 maxNumItems;
+	u64 numItems;
+	u64* values;
+	u64 nextValue;
+	
+	void* virtualItems;
+	u64 prevCommittedSize;
+	
+	u64* inlineBuffer; //has one extra item on the end that has to keep holding inlineCanary
+	u64 inlineCanary;
+	bool outgrewInline;
+	u64 inlineNumAllocations;
+};
+
+GY_TEST_SHADOW_WEIGHTS_DEF(VarArrayShadowTest_GetWeights)
+{
+	VarArrayShadowTest_t* test = (VarArrayShadowTest_t*)context;
+	weightsOut[0] = (test->numItems < test->maxNumItems) ? 40 : 0; //add
+	weightsOut[1] = (test->numItems < test->maxNumItems) ? 10 : 0; //insert
+	weightsOut[2] = (test->numItems < test->maxNumItems) ? 8 : 0; //add range
+	weightsOut[3] = (test->numItems > 0) ? 25 : 0; //remove
+	weightsOut[4] = (test->numItems > 0) ? 15 : 0; //pop
+	weightsOut[5] = 1; //clear
+	weightsOut[6] = 1; //clear and deallocate
+}
+
+GY_TEST_SHADOW_ACTION_DEF(VarArrayShadowTest_DoAction)
+{
+	VarArrayShadowTest_t* test = (VarArrayShadowTest_t*)context;
+	VarArray_t* array = &test->array;
+	if (action == 0)
+	{
+		u64* newItem = VarArrayAdd(array, u64);
+		NotNull(newItem);
+		*newItem = test->nextValue;
+		test->values[test->numItems++] = test->nextValue++;
+	}
+	else if (action == 1)
+	{
+		u64 insertIndex = GetRandU64(random, 0, test->numItems + 1);
+		u64* newItem = VarArrayInsert(array, insertIndex, u64);
+		NotNull(newItem);
+		Assert(newItem == VarArrayGetHard(array, insertIndex, u64));
+		*newItem = test->nextValue;
+		MyMemMove(&test->values[insertIndex+1], &test->values[insertIndex], sizeof(u64) * (test->numItems - insertIndex));
+		test->values[insertIndex] = test->nextValue++;
+		test->numItems++;
+	}
+	else if (action == 2)
+	{
+		u64 numNewItems = GetRandU64(random, 2, 65);
+		if (numNewItems > test->maxNumItems - test->numItems) { numNewItems = test->maxNumItems - test->numItems; }
+		u64* newItems = VarArrayAddRange(array, test->numItems, numNewItems, u64);
+		NotNull(newItems);
+		for (u64 iIndex = 0; iIndex < numNewItems; iIndex++)
+		{
+			newItems[iIndex] = test->nextValue;
+			test->values[test->numItems++] = test->nextValue++;
+		}
+	}
+	else if (action == 3)
+	{
+		u64 removeIndex = GetRandU64(random, 0, test->numItems);
+		VarArrayRemove(array, removeIndex, u64);
+		MyMemMove(&test->values[removeIndex], &test->values[removeIndex+1], sizeof(u64) * (test->numItems - (removeIndex+1)));
+		test->numItems--;
+	}
+	else if (action == 4)
+	{
+		VarArrayPop(array, u64);
+		test->numItems--;
+	}
+	else
+	{
+		u64 allocLengthBefore = array->allocLength;
+		VarArrayClear(array, (action == 6));
+		if (IsVarArrayVirtual(array)) { Assert(array->allocLength == allocLengthBefore); }
+		if (test->inlineBuffer != nullptr && action == 6)
+		{
+			Assert(array->items == test->inlineBuffer && array->allocLength == array->inlineLength);
+			test->outgrewInline = false;
+		}
+		test->numItems = 0;
+	}
+}
+
+GY_TEST_SHADOW_CHECK_DEF(VarArrayShadowTest_Check)
+{
+	VarArrayShadowTest_t* test = (VarArrayShadowTest_t*)context;
+	VarArray_t* array = &test->array;
+	Assert(array->length == test->numItems);
+	Assert(array->allocLength >= array->length);
+	Assert(VarArrayGetSoft(array, test->numItems, u64) == nullptr);
+	
+	#if !ORCA_COMPILATION
+	if (test->virtualItems != nullptr)
+	{
+		Assert(IsVarArrayVirtual(array));
+		Assert(array->items == test->virtualItems);
+		u64 pageSize = OsGetMemoryPageSize();
+		u64 reservedSize = RoundUpToU64(array->reservedLength * array->itemSize, pageSize);
+		Assert((array->committedSize % pageSize) == 0);
+		Assert(array->committedSize <= reservedSize);
+		Assert(array->allocLength == MinU64(array->committedSize / array->itemSize, array->reservedLength));
+		if (array->wasExpanded)
+		{
+			Assert(array->committedSize > test->prevCommittedSize);
+			Assert(array->committedSize >= test->prevCommittedSize * 2 || array->committedSize == reservedSize);
+			array->wasExpanded = false;
+		}
+		else { Assert(array->committedSize == test->prevCommittedSize); }
+		test->prevCommittedSize = array->committedSize;
+	}
+	#endif
+	
+	if (test->inlineBuffer != nullptr)
+	{
+		Assert(array->inlineItems == test->inlineBuffer);
+		Assert(test->inlineBuffer[array->inlineLength] == test->inlineCanary);
+		if (test->numItems > array->inlineLength) { test->outgrewInline = true; }
+		if (test->outgrewInline)
+		{
+			Assert(!IsVarArrayUsingInlineItems(array));
+			Assert(array->allocLength > array->inlineLength);
+		}
+		else
+		{
+			Assert(IsVarArrayUsingInlineItems(array));
+			Assert(array->allocLength == array->inlineLength);
+			Assert(array->allocArena->numAllocations == test->inlineNumAllocations);
+		}
+	}
+	
+	//Going through every item is slow for big arrays so we only do it every so often (and always at the end)
+	if ((stepIndex % 64) == 0)
+	{
+		for (u64 iIndex = 0; iIndex < test->numItems; iIndex++) { Assert(*VarArrayGetHard(array, iIndex, u64) == test->values[iIndex]); }
+	}
+	else if (test->numItems > 0)
+	{
+		Assert(*VarArrayGetFirstHard(array, u64) == test->values[0]);
+		Assert(*VarArrayGetLastHard(array, u64) == test->values[test->numItems-1]);
+	}
+}
+
+void InitVarArrayShadowTest(VarArrayShadowTest_t* test, MemArena_t* memArena, u64 maxNumItems)
+{
+	NotNull2(test, memArena);
+	Assert(maxNumItems > 0);
+	test->maxNumItems = maxNumItems;
+	test->numItems = 0;
+	test->values = AllocArray(memArena, u64, maxNumItems);
+	NotNull(test->values);
+	test->nextValue = 1;
+}
+
+#if !ORCA_COMPILATION
+void GyTestCase_VarArrayVirtual(MemArena_t* memArena, u64 seed, u64 numActions, u64 maxLength)
+{
+	NotNull(memArena);
+	RandomSeries_t random;
+	InitGyTestRandom(&random, seed);
+	
+	VarArrayShadowTest_t test = {};
+	InitVarArrayShadowTest(&test, memArena, maxLength);
+	u64 initialRequiredCapacity = GetRandU64(&random, 0, MinU64(maxLength, 1024) + 1);
+	CreateVarArrayVirtual(&test.array, memArena, sizeof(u64), maxLength, initialRequiredCapacity);
+	Assert(IsVarArrayVirtual(&test.array) && test.array.reservedLength == maxLength);
+	Assert(test.array.allocLength >= initialRequiredCapacity);
+	test.virtualItems = test.array.items;
+	test.prevCommittedSize = test.array.committedSize;
+	
+	GyTestShadowModel_t model;
+	InitGyTestShadowModel(&model, &test, 7, VarArrayShadowTest_GetWeights, VarArrayShadowTest_DoAction, VarArrayShadowTest_Check);
+	RunGyTestShadowModel(&model, &random, numActions);
+	VarArrayShadowTest_Check(&test, 0);
+	
+	//Pointers taken before growing have to stay good after growing all the way to maxLength
+	u64* firstItem = VarArrayGetFirstSoft(&test.array, u64);
+	u64 numExpansionsBefore = test.array.numExpansions;
+	while (test.numItems < maxLength)
+	{
+		VarArrayShadowTest_DoAction(&test, &random, numActions, (test.numItems % 2) ? 0 : 2);
+		VarArrayShadowTest_Check(&test, test.numItems);
+	}
+	VarArrayShadowTest_Check(&test, 0);
+	Assert(test.array.allocLength == maxLength);
+	Assert(test.array.numExpansions - numExpansionsBefore <= 64);
+	if (firstItem != nullptr) { Assert(VarArrayGetFirstHard(&test.array, u64) == firstItem); }
+	
+	FreeVarArray(&test.array);
+	FreeMem(memArena, test.values, sizeof(u64) * maxLength);
+}
+#endif //!ORCA_COMPILATION
+
+//The arena can't be one whose numAllocations only goes up (like a MemArenaType_MarkedStack) since we check it goes back down when we're done
+void GyTestCase_VarArrayInline(MemArena_t* memArena, u64 seed, u64 numActions, u64 maxNumItems, u64 inlineLength)
+{
+	NotNull(memArena);
+	Assert(inlineLength > 0);
+	RandomSeries_t random;
+	InitGyTestRandom(&random, seed);
+	
+	VarArrayShadowTest_t test = {};
+	InitVarArrayShadowTest(&test, memArena, maxNumItems);
+	test.inlineBuffer = AllocArray(memArena, u64, inlineLength+1);
+	NotNull(test.inlineBuffer);
+	test.inlineCanary = GetRandU64(&random);
+	test.inlineBuffer[inlineLength] = test.inlineCanary;
+	test.inlineNumAllocations = memArena->numAllocations;
+	bool exponentialChunkSize = (GetRandU64(&random, 0, 2) == 0);
+	CreateVarArrayInline(&test.array, memArena, sizeof(u64), test.inlineBuffer, inlineLength, exponentialChunkSize, GetRandU64(&random, 1, 17));
+	Assert(IsVarArrayUsingInlineItems(&test.array) && test.array.allocLength == inlineLength);
+	
+	GyTestShadowModel_t model;
+	InitGyTestShadowModel(&model, &test, 7, VarArrayShadowTest_GetWeights, VarArrayShadowTest_DoAction, VarArrayShadowTest_Check);
+	RunGyTestShadowModel(&model, &random, numActions);
+	VarArrayShadowTest_Check(&test, 0);
+	
+	//Filling the inline buffer exactly can't spill it, one more item has to
+	VarArrayShadowTest_DoAction(&test, &random, numActions, 6);
+	VarArrayShadowTest_Check(&test, 0);
+	while (test.numItems < MinU64(inlineLength, maxNumItems)) { VarArrayShadowTest_DoAction(&test, &random, numActions, 0); }
+	VarArrayShadowTest_Check(&test, 0);
+	if (maxNumItems > inlineLength)
+	{
+		VarArrayShadowTest_DoAction(&test, &random, numActions, 1);
+		VarArrayShadowTest_Check(&test, 0);
+		Assert(!IsVarArrayUsingInlineItems(&test.array) && test.array.numExpansions > 0);
+	}
+	
+	FreeVarArray(&test.array);
+	Assert(memArena->numAllocations == test.inlineNumAllocations);
+	Assert(test.inlineBuffer[inlineLength] == test.inlineCanary);
+	FreeMem(memArena, test.inlineBuffer, sizeof(u64) * (inlineLength+1));
+	FreeMem(memArena, test.values, sizeof(u64) * maxNumItems);
+}
+
+#endif //  _GY_TEST_VARIABLE_ARRAY_H
+
+// +--------------------------------------------------------------+
+// |                   Autocomplete Dictionary                    |
+// +--------------------------------------------------------------+
+/*
+@Types
+VarArrayShadowTest_t
+@Functions
+void InitVarArrayShadowTest(VarArrayShadowTest_t* test, MemArena_t* memArena, u64 maxNumItems)
+void GyTestCase_VarArrayVirtual(MemArena_t* memArena, u64 seed, u64 numActions, u64 maxLength)
+void GyTestCase_VarArrayInline(MemArena_t* memArena, u64 seed, u64 numActions, u64 maxNumItems, u64 inlineLength)
+*/